@@ -1,6 +1,20 @@
 // Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
 // SPDX-License-Identifier: Apache-2.0
 
+//------------------------------------------------------------------------------
+// Exemplo: 03-image
+// O programa carrega as imagens test.bmp, test.jpg e test.png e as exibe lado
+// a lado na janela.
+//
+// `main <diretório>` carrega todas as imagens (.bmp, .jpg, .jpeg, .png) do
+// diretório indicado e as exibe como miniaturas (THUMBNAIL_SIZE).
+//
+// As imagens são decodificadas em paralelo, enquanto a janela é criada, e
+// agrupadas em um atlas de texturas (common/atlas.h): com milhares de imagens,
+// cada quadro troca de textura apenas uma vez por página do atlas, ao invés de
+// uma vez por imagem.
+//------------------------------------------------------------------------------
+
 //------------------------------------------------------------------------------
 // Includes
 //------------------------------------------------------------------------------
@@ -9,85 +23,208 @@
 #include <stdbool.h>
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
-#include <SDL3_image/SDL_image.h>
+#include "parallel.h"
+#include "atlas.h"
+#include "log.h"
 
 //------------------------------------------------------------------------------
-// 
+// Globals (argh!)
+//------------------------------------------------------------------------------
+static MyThreadPool g_threadPool;
+static MyAtlas g_atlas;
+static char **g_filenames = NULL;
+static int g_fileCount = 0;
+
+//------------------------------------------------------------------------------
+//
 //------------------------------------------------------------------------------
 void shutdown(void)
 {
-  SDL_Log("shutdown()");
+  MY_LOG_TRACE("shutdown()");
+
+  MyAtlas_destroy(&g_atlas);
+  MyThreadPool_destroy(&g_threadPool);
+
+  for (int i = 0; i < g_fileCount; ++i)
+    SDL_free(g_filenames[i]);
+  SDL_free(g_filenames);
+  g_filenames = NULL;
+  g_fileCount = 0;
+
+  MyLog_shutdown();
   SDL_Quit();
 }
 
 //------------------------------------------------------------------------------
-// 
+// Lista os arquivos de imagem de `directory` (caminhos completos, em ordem
+// alfabética).
+//------------------------------------------------------------------------------
+static int compare_filenames(const void *a, const void *b)
+{
+  return SDL_strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+static bool list_images(const char *directory)
+{
+  static const char *EXTENSIONS[] = { ".bmp", ".jpg", ".jpeg", ".png" };
+
+  int count = 0;
+  char **files = SDL_GlobDirectory(directory, "*", SDL_GLOB_CASEINSENSITIVE, &count);
+  if (!files)
+  {
+    MY_LOG_ERROR("Erro ao listar o diretório '%s': %s", directory, SDL_GetError());
+    return false;
+  }
+
+  g_filenames = (char **)SDL_calloc((size_t)SDL_max(count, 1), sizeof(char *));
+  if (!g_filenames)
+  {
+    SDL_free(files);
+    return false;
+  }
+
+  for (int i = 0; i < count; ++i)
+  {
+    const char *extension = SDL_strrchr(files[i], '.');
+    if (!extension)
+      continue;
+
+    for (int e = 0; e < (int)SDL_arraysize(EXTENSIONS); ++e)
+    {
+      if (SDL_strcasecmp(extension, EXTENSIONS[e]) == 0)
+      {
+        SDL_asprintf(&g_filenames[g_fileCount++], "%s/%s", directory, files[i]);
+        break;
+      }
+    }
+  }
+
+  SDL_free(files);
+
+  SDL_qsort(g_filenames, (size_t)g_fileCount, sizeof(char *), compare_filenames);
+
+  if (g_fileCount == 0)
+  {
+    MY_LOG_INFO("Nenhuma imagem encontrada em '%s'.", directory);
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
 //------------------------------------------------------------------------------
 int main(int argc, char *argv[])
 {
+  const Uint64 startNS = SDL_GetTicksNS();
+
   atexit(shutdown);
+  MyLog_initialize();
 
   if (!SDL_Init(SDL_INIT_VIDEO))
   {
-    SDL_Log("Erro ao iniciar a SDL: %s", SDL_GetError());
+    MY_LOG_ERROR("Erro ao iniciar a SDL: %s", SDL_GetError());
     return SDL_APP_FAILURE;
   }
 
   const char* WINDOW_TITLE = "Hello, SDL_image";
-  const char* IMAGE_TEST_BMP = "test.bmp";
-  const char* IMAGE_TEST_JPG = "test.jpg";
-  const char* IMAGE_TEST_PNG = "test.png";
+  const char* IMAGE_TEST_FILES[] = { "test.bmp", "test.jpg", "test.png" };
   enum constants
   {
     WINDOW_WIDTH = 640,
     WINDOW_HEIGHT = 480,
     WINDOW_TITLE_MAX_LENGTH = 64,
+    THUMBNAIL_SIZE = 64,
   };
 
+  // Imagens de teste (tamanho original) ou diretório (miniaturas).
+  const bool useThumbnails = (argc >= 2);
+  if (useThumbnails)
+  {
+    if (!list_images(argv[1]))
+      return SDL_APP_FAILURE;
+  }
+  else
+  {
+    g_fileCount = (int)SDL_arraysize(IMAGE_TEST_FILES);
+    g_filenames = (char **)SDL_calloc((size_t)g_fileCount, sizeof(char *));
+    if (!g_filenames)
+      return SDL_APP_FAILURE;
+
+    for (int i = 0; i < g_fileCount; ++i)
+      g_filenames[i] = SDL_strdup(IMAGE_TEST_FILES[i]);
+  }
+
+  // A decodificação começa antes da criação da janela e segue em paralelo.
+  if (!MyThreadPool_initialize(&g_threadPool, 0))
+    return SDL_APP_FAILURE;
+
+  if (!MyAtlas_begin_load(&g_atlas, (const char *const *)g_filenames, g_fileCount, 0, &g_threadPool))
+    return SDL_APP_FAILURE;
+
   SDL_Window *window = NULL;
   SDL_Renderer *renderer = NULL;
   if (!SDL_CreateWindowAndRenderer(WINDOW_TITLE, WINDOW_WIDTH, WINDOW_HEIGHT, 0,
     &window, &renderer))
   {
-    SDL_Log("Erro ao criar a janela e/ou renderizador: %s", SDL_GetError());
+    MY_LOG_ERROR("Erro ao criar a janela e/ou renderizador: %s", SDL_GetError());
     return SDL_APP_FAILURE;
   }
 
   char windowTitle[WINDOW_TITLE_MAX_LENGTH] = { 0 };
 
-  SDL_Texture *texBmp = IMG_LoadTexture(renderer, IMAGE_TEST_BMP);
-  if (!texBmp)
-  {
-    SDL_Log("Erro ao carregar a imagem '%s': %s", IMAGE_TEST_BMP, SDL_GetError());
-  }
-  SDL_FRect bmpRect =
-  {
-    .x = 0.0f,
-    .y = 0.0f,
-    .w = texBmp ? texBmp->w : 0.0f,
-    .h = texBmp ? texBmp->h : 0.0f,
-  };
+  if (!MyAtlas_finish_load(&g_atlas, renderer))
+    return SDL_APP_FAILURE;
 
-  SDL_Texture *texJpg = IMG_LoadTexture(renderer, IMAGE_TEST_JPG);
-  if (!texJpg)
+  // Posição de cada imagem: da esquerda para a direita, quebrando a linha
+  // quando a imagem não cabe na largura da janela. A ordem de desenho agrupa
+  // as imagens por página do atlas.
+  SDL_FRect *srcRects = (SDL_FRect *)SDL_calloc((size_t)g_fileCount, sizeof(SDL_FRect));
+  SDL_FRect *dstRects = (SDL_FRect *)SDL_calloc((size_t)g_fileCount, sizeof(SDL_FRect));
+  SDL_Texture **textures = (SDL_Texture **)SDL_calloc((size_t)g_fileCount, sizeof(SDL_Texture *));
+  if (!srcRects || !dstRects || !textures)
   {
-    SDL_Log("Erro ao carregar a imagem '%s': %s", IMAGE_TEST_JPG, SDL_GetError());
+    MY_LOG_ERROR("Erro ao alocar memória para %d imagens.", g_fileCount);
+    return SDL_APP_FAILURE;
   }
-  SDL_FRect jpgRect =
-  {
-    .x = bmpRect.x + bmpRect.w,
-    .y = 0.0f,
-    .w = texJpg ? texJpg->w : 0.0f,
-    .h = texJpg ? texJpg->h : 0.0f,
-  };
 
-  SDL_Texture *texPng = IMG_LoadTexture(renderer, IMAGE_TEST_PNG);
-  if (!texPng)
+  int drawCount = 0;
+  float x = 0.0f;
+  float y = 0.0f;
+  float rowHeight = 0.0f;
+  for (int page = 0; page < g_atlas.pageCount; ++page)
   {
-    SDL_Log("Erro ao carregar a imagem '%s': %s", IMAGE_TEST_PNG, SDL_GetError());
+    for (int i = 0; i < g_fileCount; ++i)
+    {
+      if (g_atlas.entries[i].page != page)
+        continue;
+
+      SDL_FRect *src = &srcRects[drawCount];
+      MyAtlas_get(&g_atlas, i, &textures[drawCount], src);
+
+      float scale = 1.0f;
+      if (useThumbnails)
+        scale = SDL_min(1.0f, THUMBNAIL_SIZE / SDL_max(src->w, src->h));
+
+      const float w = src->w * scale;
+      const float h = src->h * scale;
+      if (x > 0.0f && x + w > WINDOW_WIDTH)
+      {
+        x = 0.0f;
+        y += rowHeight;
+        rowHeight = 0.0f;
+      }
+
+      dstRects[drawCount] = (SDL_FRect){ .x = x, .y = y, .w = w, .h = h };
+      x += w;
+      rowHeight = SDL_max(rowHeight, h);
+      ++drawCount;
+    }
   }
-  SDL_FRect pngRect = { .x = jpgRect.x + jpgRect.w, .y = 0.0f };
-  SDL_GetTextureSize(texPng, &pngRect.w, &pngRect.h);
+
+  MY_LOG_INFO("Primeiro quadro em %.1f ms: %d imagem(ns), %d troca(s) de textura por quadro.",
+    (double)(SDL_GetTicksNS() - startNS) / SDL_NS_PER_MS, drawCount, g_atlas.pageCount);
 
   SDL_Event event;
   bool isRunning = true;
@@ -111,18 +248,23 @@ int main(int argc, char *argv[])
 
     SDL_SetRenderDrawColor(renderer, 128, 128, 128, 255);
     SDL_RenderClear(renderer);
-    SDL_RenderTexture(renderer, texBmp, NULL, &bmpRect);
-    SDL_RenderTexture(renderer, texJpg, NULL, &jpgRect);
-    SDL_RenderTexture(renderer, texPng, NULL, &pngRect);
+
+    // Chamadas consecutivas com a mesma textura são agrupadas pelo
+    // renderizador em um único lote.
+    for (int i = 0; i < drawCount; ++i)
+    {
+      if (dstRects[i].y < WINDOW_HEIGHT)
+        SDL_RenderTexture(renderer, textures[i], &srcRects[i], &dstRects[i]);
+    }
+
     SDL_RenderPresent(renderer);
   }
 
-  SDL_DestroyTexture(texBmp);
-  texBmp = NULL;
-  SDL_DestroyTexture(texJpg);
-  texJpg = NULL;
-  SDL_DestroyTexture(texPng);
-  texPng = NULL;
+  SDL_free(textures);
+  SDL_free(dstRects);
+  SDL_free(srcRects);
+
+  MyAtlas_destroy(&g_atlas);
 
   SDL_DestroyRenderer(renderer);
   SDL_DestroyWindow(window);
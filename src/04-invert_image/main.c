@@ -7,7 +7,8 @@
 // e exibe o conteúdo na janela ("kodim23.png" pertence ao "Kodak Image Set").
 // A tecla '1' aplica uma transformação de intensidade (negativo da imagem).
 // Caso a imagem seja maior do que WINDOW_WIDTHxWINDOW_HEIGHT, a janela é
-// redimensionada logo após a imagem ser carregada.
+// redimensionada logo após a imagem ser carregada. Imagens que não cabem na
+// área útil da tela são reduzidas antes (Lanczos-3, common/resample.h).
 //
 // Observação:
 // Em um projeto mais realista, o código abaixo provavelmente seria refatorado.
@@ -28,7 +29,12 @@
 #include <stdbool.h>
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
-#include <SDL3_image/SDL_image.h>
+#include "window.h"
+#include "image.h"
+#include "filters.h"
+#include "kernels.h"
+#include "frame_scheduler.h"
+#include "log.h"
 
 //------------------------------------------------------------------------------
 // Custom types, structs, constants, etc.
@@ -42,21 +48,6 @@ enum constants
   DEFAULT_WINDOW_HEIGHT = 480,
 };
 
-typedef struct MyWindow MyWindow;
-struct MyWindow
-{
-  SDL_Window *window;
-  SDL_Renderer *renderer;
-};
-
-typedef struct MyImage MyImage;
-struct MyImage
-{
-  SDL_Surface *surface;
-  SDL_Texture *texture;
-  SDL_FRect rect;
-};
-
 //------------------------------------------------------------------------------
 // Globals (argh!)
 //------------------------------------------------------------------------------
@@ -66,21 +57,11 @@ static MyImage g_image = {
   .texture = NULL,
   .rect = { .x = 0.0f, .y = 0.0f, .w = 0.0f, .h = 0.0f }
 };
+static MyFrameScheduler g_scheduler;
 
 //------------------------------------------------------------------------------
 // Function declaration
 //------------------------------------------------------------------------------
-static bool MyWindow_initialize(MyWindow *window, const char *title, int width, int height, SDL_WindowFlags window_flags);
-static void MyWindow_destroy(MyWindow *window);
-static void MyImage_destroy(MyImage *image);
-
-/**
- * Carrega a imagem indicada no parâmetro `filename` e a converte para o formato
- * RGBA32, eliminando dependência do formato original da imagem. A imagem
- * carregada é armazenada em output_image.
- */
-static void load_rgba32(const char *filename, SDL_Renderer *renderer, MyImage *output_image);
-
 /**
  * Acessa cada pixel da imagem (MyImage->surface) e inverte sua intensidade.
  * Altera MyImage->surface e atualiza MyImage->texture.
@@ -88,204 +69,42 @@ static void load_rgba32(const char *filename, SDL_Renderer *renderer, MyImage *o
  * Assumimos que os pixels da imagem estão no formato RGBA32 e que os níveis de
  * intensidade estão no intervalo [0-255].
  * 
- * Na verdade, podemos desconsiderar o canal Alpha, já que ele não terá seu
- * valor invertido. Neste caso, substituímos `SDL_GetRGBA()` e `SDL_MapRGBA()`
- * por `SDL_GetRGB()` e `SDL_MapRGB()`, respectivamente.
+ * O canal Alpha não tem seu valor invertido. A inversão em si é feita por
+ * MyFilter_invert() (biblioteca comum), que usa a versão do kernel mais rápida
+ * para a CPU (ex. AVX2 inverte 8 pixels por instrução).
  */
 static void invert_image(SDL_Renderer *renderer, MyImage *image);
 
-//------------------------------------------------------------------------------
-//
-//------------------------------------------------------------------------------
-bool MyWindow_initialize(MyWindow *window, const char *title, int width, int height, SDL_WindowFlags window_flags)
-{
-  SDL_Log("\tMyWindow_initialize(%s, %d, %d)", title, width, height);
-
-  if (!window)
-  {
-    SDL_Log("\t\t*** Erro: Janela/renderizador inválidos (window == NULL).");
-    return false;
-  }
-
-  return SDL_CreateWindowAndRenderer(title, width, height, window_flags, &window->window, &window->renderer);
-}
-
-//------------------------------------------------------------------------------
-//
-//------------------------------------------------------------------------------
-void MyWindow_destroy(MyWindow *window)
-{
-  SDL_Log(">>> MyWindow_destroy()");
-
-  if (!window)
-  {
-    SDL_Log("\t*** Erro: Janela/renderizador inválidos (window == NULL).");
-    SDL_Log("<<< MyWindow_destroy()");
-    return;
-  }
-
-  SDL_Log("\tDestruindo MyWindow->renderer...");
-  SDL_DestroyRenderer(window->renderer);
-  window->renderer = NULL;
-
-  SDL_Log("\tDestruindo MyWindow->window...");
-  SDL_DestroyWindow(window->window);
-  window->window = NULL;
-
-  SDL_Log("<<< MyWindow_destroy()");
-}
-
-//------------------------------------------------------------------------------
-//
-//------------------------------------------------------------------------------
-void MyImage_destroy(MyImage *image)
-{
-  SDL_Log(">>> MyImage_destroy()");
-
-  if (!image)
-  {
-    SDL_Log("\t*** Erro: Imagem inválida (image == NULL).");
-    SDL_Log("<<< MyImage_destroy()");
-    return;
-  }
-
-  if (image->texture)
-  {
-    SDL_Log("\tDestruindo MyImage->texture...");
-    SDL_DestroyTexture(image->texture);
-    image->texture = NULL;
-  }
-
-  if (image->surface)
-  {
-    SDL_Log("\tDestruindo MyImage->surface...");
-    SDL_DestroySurface(image->surface);
-    image->surface = NULL;
-  }
-
-  SDL_Log("\tRedefinindo MyImage->rect...");
-  image->rect.x = image->rect.y = image->rect.w = image->rect.h = 0.0f;
-
-  SDL_Log("<<< MyImage_destroy()");
-}
-
-//------------------------------------------------------------------------------
-//
-//------------------------------------------------------------------------------
-void load_rgba32(const char *filename, SDL_Renderer *renderer, MyImage *output_image)
-{
-  SDL_Log(">>> load_rgba32(\"%s\")", filename);
-
-  if (!filename)
-  {
-    SDL_Log("\t*** Erro: Nome do arquivo inválido (filename == NULL).");
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
-    return;
-  }
-
-  if (!renderer)
-  {
-    SDL_Log("\t*** Erro: Renderer inválido (renderer == NULL).");
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
-    return;
-  }
-
-  if (!output_image)
-  {
-    SDL_Log("\t*** Erro: Imagem de saída inválida (output_image == NULL).");
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
-    return;
-  }
-
-  MyImage_destroy(output_image);
-
-  SDL_Log("\tCarregando imagem \"%s\" em uma superfície...", filename);
-  SDL_Surface *surface = IMG_Load(filename);
-  if (!surface)
-  {
-    SDL_Log("\t*** Erro ao carregar a imagem: %s", SDL_GetError());
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
-    return;
-  }
-
-  SDL_Log("\tConvertendo superfície para formato RGBA32...");
-  output_image->surface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
-  SDL_DestroySurface(surface);
-  if (!output_image->surface)
-  {
-    SDL_Log("\t*** Erro ao converter superfície para formato RGBA32: %s", SDL_GetError());
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
-    return;
-  }
-
-  SDL_Log("\tCriando textura a partir da superfície...");
-  output_image->texture = SDL_CreateTextureFromSurface(renderer, output_image->surface);
-  if (!output_image->texture)
-  {
-    SDL_Log("\t*** Erro ao criar textura: %s", SDL_GetError());
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
-    return;
-  }
-
-  SDL_Log("\tObtendo dimensões da textura...");
-  SDL_GetTextureSize(output_image->texture, &output_image->rect.w, &output_image->rect.h);
-
-  SDL_Log("<<< load_rgba32(\"%s\")", filename);
-}
-
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
 void invert_image(SDL_Renderer *renderer, MyImage *image)
 {
-  SDL_Log(">>> invert_image()");
+  MY_LOG_TRACE(">>> invert_image()");
 
   if (!renderer)
   {
-    SDL_Log("\t*** Erro: Renderer inválido (renderer == NULL).");
-    SDL_Log("<<< invert_image()");
+    MY_LOG_ERROR("\t*** Erro: Renderer inválido (renderer == NULL).");
+    MY_LOG_TRACE("<<< invert_image()");
     return;
   }
 
   if (!image || !image->surface)
   {
-    SDL_Log("\t*** Erro: Imagem inválida (image == NULL ou image->surface == NULL).");
-    SDL_Log("<<< invert_image()");
+    MY_LOG_ERROR("\t*** Erro: Imagem inválida (image == NULL ou image->surface == NULL).");
+    MY_LOG_TRACE("<<< invert_image()");
     return;
   }
 
-  // Para acessar os pixels de uma superfície, precisamos chamar essa função.
-  SDL_LockSurface(image->surface);
-
-  const SDL_PixelFormatDetails *format = SDL_GetPixelFormatDetails(image->surface->format);
-  const size_t pixelCount = image->surface->w * image->surface->h;
-
-  Uint32 *pixels = (Uint32 *)image->surface->pixels;
-  Uint8 r = 0;
-  Uint8 g = 0;
-  Uint8 b = 0;
-  Uint8 a = 0;
-
-  for (size_t i = 0; i < pixelCount; ++i)
-  {
-    SDL_GetRGBA(pixels[i], format, NULL, &r, &g, &b, &a);
-
-    r = 255 - r;
-    g = 255 - g;
-    b = 255 - b;
-
-    pixels[i] = SDL_MapRGBA(format, NULL, r, g, b, a);
-  }
-
-  // Após manipularmos os pixels da superfície, liberamos a superfície.
-  SDL_UnlockSurface(image->surface);
+  // Negativo "in place": a superfície é ao mesmo tempo entrada e saída.
+  MyFilter_invert(image->surface, image->surface, NULL);
 
   // Atualizamos a textura a ser renderizada pelo SDL_Renderer, com base no
   // novo conteúdo da superfície.
   SDL_DestroyTexture(image->texture);
   image->texture = SDL_CreateTextureFromSurface(renderer, image->surface);
 
-  SDL_Log("<<< invert_image()");
+  MY_LOG_TRACE("<<< invert_image()");
 }
 
 //------------------------------------------------------------------------------
@@ -293,25 +112,29 @@ void invert_image(SDL_Renderer *renderer, MyImage *image)
 //------------------------------------------------------------------------------
 static SDL_AppResult initialize(void)
 {
-  SDL_Log(">>> initialize()");
+  MY_LOG_TRACE(">>> initialize()");
 
-  SDL_Log("\tIniciando SDL...");
+  MY_LOG_DEBUG("\tIniciando SDL...");
   if (!SDL_Init(SDL_INIT_VIDEO))
   {
-    SDL_Log("\t*** Erro ao iniciar a SDL: %s", SDL_GetError());
-    SDL_Log("<<< initialize()");
+    MY_LOG_ERROR("\t*** Erro ao iniciar a SDL: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< initialize()");
     return SDL_APP_FAILURE;
   }
 
-  SDL_Log("\tCriando janela e renderizador...");
+  MY_LOG_DEBUG("\tCriando janela e renderizador...");
   if (!MyWindow_initialize(&g_window, WINDOW_TITLE, DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, 0))
   {
-    SDL_Log("\t*** Erro ao criar a janela e/ou renderizador: %s", SDL_GetError());
-    SDL_Log("<<< initialize()");
+    MY_LOG_ERROR("\t*** Erro ao criar a janela e/ou renderizador: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< initialize()");
     return SDL_APP_FAILURE;
   }
 
-  SDL_Log("<<< initialize()");
+  // Escolhe, uma única vez, a versão dos kernels mais rápida para a CPU.
+  MY_LOG_DEBUG("\tSelecionando kernels...");
+  MyKernels_get();
+
+  MY_LOG_TRACE("<<< initialize()");
   return SDL_APP_CONTINUE;
 }
 
@@ -320,15 +143,17 @@ static SDL_AppResult initialize(void)
 //------------------------------------------------------------------------------
 static void shutdown(void)
 {
-  SDL_Log(">>> shutdown()");
+  MY_LOG_TRACE(">>> shutdown()");
 
   MyImage_destroy(&g_image);
   MyWindow_destroy(&g_window);
 
-  SDL_Log("\tEncerrando SDL...");
+  MyLog_shutdown();
+
+  MY_LOG_DEBUG("\tEncerrando SDL...");
   SDL_Quit();
 
-  SDL_Log("<<< shutdown()");
+  MY_LOG_TRACE("<<< shutdown()");
 }
 
 //------------------------------------------------------------------------------
@@ -349,19 +174,21 @@ static void render(void)
 //------------------------------------------------------------------------------
 static void loop(void)
 {
-  SDL_Log(">>> loop()");
+  MY_LOG_TRACE(">>> loop()");
 
   // Para melhorar o uso da CPU (e consumo de energia), só atualizaremos o
   // conteúdo da janela se realmente for necessário. Nesse exemplo, isso
-  // acontece quando invertemos os pixels da imagem.
-  bool mustRefresh = false;
-  render();
+  // acontece quando invertemos os pixels da imagem (ou quando a janela precisa
+  // ser redesenhada). Enquanto nada muda, o programa fica bloqueado à espera
+  // de eventos (MyFrameScheduler), ao invés de consultá-los sem parar.
+  // Conteúdo estático: sem intervalo entre quadros e sem vsync.
+  MyFrameScheduler_initialize(&g_scheduler, 0, false);
 
   SDL_Event event;
   bool isRunning = true;
   while (isRunning)
   {
-    while (SDL_PollEvent(&event))
+    while (isRunning && MyFrameScheduler_wait_event(&g_scheduler, &event))
     {
       switch (event.type)
       {
@@ -373,20 +200,22 @@ static void loop(void)
         if (event.key.key == SDLK_1 && !event.key.repeat)
         {
           invert_image(g_window.renderer, &g_image);
-          mustRefresh = true;
+          MyFrameScheduler_invalidate(&g_scheduler);
         }
         break;
       }
     }
 
-    if (mustRefresh)
+    if (isRunning && MyFrameScheduler_begin_frame(&g_scheduler) != MY_FRAME_NONE)
     {
       render();
-      mustRefresh = false;
+      MyFrameScheduler_end_frame(&g_scheduler);
     }
   }
+
+  MyFrameScheduler_log_stats(&g_scheduler);
   
-  SDL_Log("<<< loop()");
+  MY_LOG_TRACE("<<< loop()");
 }
 
 //------------------------------------------------------------------------------
@@ -395,11 +224,16 @@ static void loop(void)
 int main(int argc, char *argv[])
 {
   atexit(shutdown);
+  MyLog_initialize();
 
   if (initialize() == SDL_APP_FAILURE)
     return SDL_APP_FAILURE;
 
-  load_rgba32(IMAGE_FILENAME, g_window.renderer, &g_image);
+  // A janela nunca passa da área útil da tela: imagens maiores são reduzidas.
+  int maxWidth = 0;
+  int maxHeight = 0;
+  MyWindow_get_max_content_size(&g_window, &maxWidth, &maxHeight);
+  load_rgba32_fit(IMAGE_FILENAME, g_window.renderer, maxWidth, maxHeight, NULL, &g_image);
 
   // Altera tamanho da janela se a imagem for maior do que o tamanho padrão
   // e reposiciona no canto superior esquerdo da tela.
@@ -415,7 +249,7 @@ int main(int argc, char *argv[])
     int left = 0;
     SDL_GetWindowBordersSize(g_window.window, &top, &left, NULL, NULL);
 
-    SDL_Log("Redefinindo dimensões da janela, de (%d, %d) para (%d, %d), e alterando a posição para (%d, %d).",
+    MY_LOG_INFO("Redefinindo dimensões da janela, de (%d, %d) para (%d, %d), e alterando a posição para (%d, %d).",
       DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, imageWidth, imageHeight, left, top);
 
     SDL_SetWindowSize(g_window.window, imageWidth, imageHeight);
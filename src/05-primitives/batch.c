@@ -0,0 +1,334 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "batch.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static bool MyPrimitiveBatch_grow(MyPrimitiveBatch *batch);
+
+/**
+ * Reserva um quadrilátero e retorna o índice do seu primeiro vértice, ou -1 se
+ * não houver memória.
+ */
+static int MyPrimitiveBatch_reserve_quad(MyPrimitiveBatch *batch);
+static void MyPrimitiveBatch_add_quad(MyPrimitiveBatch *batch, float x0, float y0, float x1, float y1);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyPrimitiveBatch_initialize(MyPrimitiveBatch *batch, SDL_Renderer *renderer)
+{
+  MY_LOG_TRACE(">>> MyPrimitiveBatch_initialize()");
+
+  if (!batch || !renderer)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyPrimitiveBatch_initialize()");
+    return false;
+  }
+
+  SDL_zerop(batch);
+  batch->renderer = renderer;
+  batch->color = (SDL_FColor){ 1.0f, 1.0f, 1.0f, 1.0f };
+
+  if (!MyPrimitiveBatch_grow(batch))
+  {
+    MY_LOG_ERROR("\t*** Erro ao alocar memória para o lote.");
+    MyPrimitiveBatch_destroy(batch);
+    MY_LOG_TRACE("<<< MyPrimitiveBatch_initialize()");
+    return false;
+  }
+
+  MY_LOG_TRACE("<<< MyPrimitiveBatch_initialize()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPrimitiveBatch_destroy(MyPrimitiveBatch *batch)
+{
+  MY_LOG_TRACE(">>> MyPrimitiveBatch_destroy()");
+
+  if (!batch)
+  {
+    MY_LOG_ERROR("\t*** Erro: Lote inválido (batch == NULL).");
+    MY_LOG_TRACE("<<< MyPrimitiveBatch_destroy()");
+    return;
+  }
+
+  SDL_free(batch->xy);
+  SDL_free(batch->colors);
+  SDL_free(batch->indices);
+  SDL_zerop(batch);
+
+  MY_LOG_TRACE("<<< MyPrimitiveBatch_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyPrimitiveBatch_grow(MyPrimitiveBatch *batch)
+{
+  const int capacity = batch->quadCapacity ? SDL_min(batch->quadCapacity * 2, MY_BATCH_MAX_QUADS) : MY_BATCH_INITIAL_QUADS;
+  if (capacity <= batch->quadCapacity)
+    return false;
+
+  float *xy = (float *)SDL_realloc(batch->xy, (size_t)capacity * 4 * 2 * sizeof(float));
+  if (!xy)
+    return false;
+  batch->xy = xy;
+
+  SDL_FColor *colors = (SDL_FColor *)SDL_realloc(batch->colors, (size_t)capacity * 4 * sizeof(SDL_FColor));
+  if (!colors)
+    return false;
+  batch->colors = colors;
+
+  int *indices = (int *)SDL_realloc(batch->indices, (size_t)capacity * 6 * sizeof(int));
+  if (!indices)
+    return false;
+  batch->indices = indices;
+
+  // Dois triângulos por quadrilátero: (0, 1, 2) e (0, 2, 3).
+  for (int quad = batch->quadCapacity; quad < capacity; ++quad)
+  {
+    int *index = &indices[quad * 6];
+    const int vertex = quad * 4;
+    index[0] = vertex + 0;
+    index[1] = vertex + 1;
+    index[2] = vertex + 2;
+    index[3] = vertex + 0;
+    index[4] = vertex + 2;
+    index[5] = vertex + 3;
+  }
+
+  batch->quadCapacity = capacity;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int MyPrimitiveBatch_reserve_quad(MyPrimitiveBatch *batch)
+{
+  if (batch->quadCount == batch->quadCapacity)
+  {
+    // No limite de tamanho, o lote é enviado e o buffer reaproveitado.
+    if (batch->quadCapacity >= MY_BATCH_MAX_QUADS)
+      MyPrimitiveBatch_flush(batch);
+    else if (!MyPrimitiveBatch_grow(batch))
+      MyPrimitiveBatch_flush(batch);
+
+    if (batch->quadCount == batch->quadCapacity)
+    {
+      batch->failed = true;
+      return -1;
+    }
+  }
+
+  ++batch->stats.quadCount;
+  return 4 * batch->quadCount++;
+}
+
+//------------------------------------------------------------------------------
+// Quadrilátero alinhado aos eixos, de (x0, y0) até (x1, y1).
+//------------------------------------------------------------------------------
+void MyPrimitiveBatch_add_quad(MyPrimitiveBatch *batch, float x0, float y0, float x1, float y1)
+{
+  const int vertex = MyPrimitiveBatch_reserve_quad(batch);
+  if (vertex < 0)
+    return;
+
+  float *xy = &batch->xy[vertex * 2];
+  xy[0] = x0; xy[1] = y0;
+  xy[2] = x1; xy[3] = y0;
+  xy[4] = x1; xy[5] = y1;
+  xy[6] = x0; xy[7] = y1;
+
+  SDL_FColor *colors = &batch->colors[vertex];
+  colors[0] = colors[1] = colors[2] = colors[3] = batch->color;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPrimitiveBatch_begin(MyPrimitiveBatch *batch)
+{
+  SDL_zero(batch->stats);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPrimitiveBatch_set_color(MyPrimitiveBatch *batch, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+  const float scale = 1.0f / 255.0f;
+  batch->color = (SDL_FColor){ r * scale, g * scale, b * scale, a * scale };
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPrimitiveBatch_add_point(MyPrimitiveBatch *batch, float x, float y)
+{
+  ++batch->stats.primitiveCount;
+  MyPrimitiveBatch_add_quad(batch, x, y, x + 1.0f, y + 1.0f);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPrimitiveBatch_add_points(MyPrimitiveBatch *batch, const SDL_FPoint *points, int count)
+{
+  for (int i = 0; i < count; ++i)
+    MyPrimitiveBatch_add_point(batch, points[i].x, points[i].y);
+}
+
+//------------------------------------------------------------------------------
+// Escreve direto no buffer, em trechos do tamanho do espaço livre, sem passar
+// por MyPrimitiveBatch_reserve_quad() a cada ponto.
+//------------------------------------------------------------------------------
+void MyPrimitiveBatch_add_colored_points(MyPrimitiveBatch *batch, const float *x, const float *y, const Uint32 *colors, int count)
+{
+  const float scale = 1.0f / 255.0f;
+
+  batch->stats.primitiveCount += (Uint64)SDL_max(count, 0);
+
+  int i = 0;
+  while (i < count)
+  {
+    if (batch->quadCount == batch->quadCapacity)
+    {
+      if (batch->quadCapacity >= MY_BATCH_MAX_QUADS || !MyPrimitiveBatch_grow(batch))
+        MyPrimitiveBatch_flush(batch);
+    }
+
+    const int n = SDL_min(count - i, batch->quadCapacity - batch->quadCount);
+    float *xy = &batch->xy[batch->quadCount * 8];
+    SDL_FColor *vertexColors = &batch->colors[batch->quadCount * 4];
+    for (int k = 0; k < n; ++k, ++i, xy += 8, vertexColors += 4)
+    {
+      xy[0] = x[i];        xy[1] = y[i];
+      xy[2] = x[i] + 1.0f; xy[3] = y[i];
+      xy[4] = x[i] + 1.0f; xy[5] = y[i] + 1.0f;
+      xy[6] = x[i];        xy[7] = y[i] + 1.0f;
+
+      Uint8 bytes[4];
+      SDL_memcpy(bytes, &colors[i], sizeof(bytes));
+      const SDL_FColor color = { bytes[0] * scale, bytes[1] * scale, bytes[2] * scale, bytes[3] * scale };
+      vertexColors[0] = vertexColors[1] = vertexColors[2] = vertexColors[3] = color;
+    }
+
+    batch->quadCount += n;
+    batch->stats.quadCount += (Uint64)n;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPrimitiveBatch_add_line(MyPrimitiveBatch *batch, float x1, float y1, float x2, float y2)
+{
+  const float dx = x2 - x1;
+  const float dy = y2 - y1;
+  const float length = SDL_sqrtf(dx * dx + dy * dy);
+  if (length < 1.0f)
+  {
+    MyPrimitiveBatch_add_point(batch, x1, y1);
+    return;
+  }
+
+  ++batch->stats.primitiveCount;
+
+  const int vertex = MyPrimitiveBatch_reserve_quad(batch);
+  if (vertex < 0)
+    return;
+
+  // Meio pixel ao longo da linha (estende as extremidades até a borda dos
+  // pixels) e meio pixel na perpendicular (largura de 1 pixel).
+  const float ux = 0.5f * dx / length;
+  const float uy = 0.5f * dy / length;
+  const float cx1 = x1 + 0.5f - ux;
+  const float cy1 = y1 + 0.5f - uy;
+  const float cx2 = x2 + 0.5f + ux;
+  const float cy2 = y2 + 0.5f + uy;
+
+  float *xy = &batch->xy[vertex * 2];
+  xy[0] = cx1 - uy; xy[1] = cy1 + ux;
+  xy[2] = cx1 + uy; xy[3] = cy1 - ux;
+  xy[4] = cx2 + uy; xy[5] = cy2 - ux;
+  xy[6] = cx2 - uy; xy[7] = cy2 + ux;
+
+  SDL_FColor *colors = &batch->colors[vertex];
+  colors[0] = colors[1] = colors[2] = colors[3] = batch->color;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPrimitiveBatch_add_fill_rect(MyPrimitiveBatch *batch, const SDL_FRect *rect)
+{
+  ++batch->stats.primitiveCount;
+  MyPrimitiveBatch_add_quad(batch, rect->x, rect->y, rect->x + rect->w, rect->y + rect->h);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPrimitiveBatch_add_rect(MyPrimitiveBatch *batch, const SDL_FRect *rect)
+{
+  if (rect->w <= 0.0f || rect->h <= 0.0f)
+    return;
+
+  ++batch->stats.primitiveCount;
+
+  const float x0 = rect->x;
+  const float y0 = rect->y;
+  const float x1 = rect->x + rect->w;
+  const float y1 = rect->y + rect->h;
+
+  // Retângulos com até 2 pixels de largura/altura não têm "miolo".
+  if (rect->w <= 2.0f || rect->h <= 2.0f)
+  {
+    MyPrimitiveBatch_add_quad(batch, x0, y0, x1, y1);
+    return;
+  }
+
+  MyPrimitiveBatch_add_quad(batch, x0, y0, x1, y0 + 1.0f);                // Topo.
+  MyPrimitiveBatch_add_quad(batch, x0, y1 - 1.0f, x1, y1);                // Base.
+  MyPrimitiveBatch_add_quad(batch, x0, y0 + 1.0f, x0 + 1.0f, y1 - 1.0f);  // Esquerda.
+  MyPrimitiveBatch_add_quad(batch, x1 - 1.0f, y0 + 1.0f, x1, y1 - 1.0f);  // Direita.
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyPrimitiveBatch_flush(MyPrimitiveBatch *batch)
+{
+  bool ok = !batch->failed;
+  batch->failed = false;
+
+  if (batch->quadCount == 0)
+    return ok;
+
+  if (!SDL_RenderGeometryRaw(batch->renderer, NULL,
+    batch->xy, 2 * sizeof(float),
+    batch->colors, sizeof(SDL_FColor),
+    NULL, 0,
+    batch->quadCount * 4,
+    batch->indices, batch->quadCount * 6, sizeof(int)))
+  {
+    MY_LOG_ERROR("\t*** Erro ao enviar o lote (%d quadriláteros): %s", batch->quadCount, SDL_GetError());
+    ok = false;
+  }
+
+  ++batch->stats.submitCount;
+  batch->quadCount = 0;
+  return ok;
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Lote (batch) de primitivas 2D coloridas: pontos, linhas e retângulos
+// (preenchidos ou só o contorno).
+//
+// Ao invés de uma chamada SDL_RenderPoint/Line/Rect (e uma troca de cor) por
+// primitiva, cada primitiva vira um ou mais quadriláteros em um único buffer
+// de vértices (posição + cor) e o lote inteiro é enviado ao renderizador com
+// uma chamada SDL_RenderGeometryRaw():
+// - ponto: quadrado 1x1 no pixel (x, y), como SDL_RenderPoint();
+// - linha: retângulo de 1 pixel de largura entre os centros dos pixels das
+//   extremidades;
+// - retângulo preenchido: um quadrilátero;
+// - contorno: quatro quadriláteros de 1 pixel, dentro do retângulo, como
+//   SDL_RenderRect().
+//
+// Como todas as primitivas são quadriláteros, o buffer de índices tem sempre o
+// mesmo padrão (0, 1, 2, 0, 2, 3 + 4k) e só é gerado quando a capacidade do
+// lote aumenta. O lote cresce até MY_BATCH_MAX_QUADS; acima disso, o conteúdo
+// é enviado ao renderizador e o buffer é reaproveitado (limita a memória em
+// cenas com milhões de primitivas).
+//------------------------------------------------------------------------------
+#ifndef MY_BATCH_H
+#define MY_BATCH_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+
+enum batch_constants
+{
+  MY_BATCH_INITIAL_QUADS = 1024,
+  MY_BATCH_MAX_QUADS = 1 << 20,
+};
+
+typedef struct MyPrimitiveBatchStats MyPrimitiveBatchStats;
+struct MyPrimitiveBatchStats
+{
+  Uint64 primitiveCount;
+  Uint64 quadCount;
+  int submitCount;
+};
+
+typedef struct MyPrimitiveBatch MyPrimitiveBatch;
+struct MyPrimitiveBatch
+{
+  SDL_Renderer *renderer;
+
+  // Vértices (x, y) e cores, 4 por quadrilátero; índices, 6 por quadrilátero.
+  float *xy;
+  SDL_FColor *colors;
+  int *indices;
+  int quadCount;
+  int quadCapacity;
+  bool failed;
+
+  // Cor atual (equivalente a SDL_SetRenderDrawColor()).
+  SDL_FColor color;
+
+  MyPrimitiveBatchStats stats;
+};
+
+bool MyPrimitiveBatch_initialize(MyPrimitiveBatch *batch, SDL_Renderer *renderer);
+void MyPrimitiveBatch_destroy(MyPrimitiveBatch *batch);
+
+/**
+ * Zera as estatísticas (chamar no início de cada quadro).
+ */
+void MyPrimitiveBatch_begin(MyPrimitiveBatch *batch);
+
+void MyPrimitiveBatch_set_color(MyPrimitiveBatch *batch, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+void MyPrimitiveBatch_add_point(MyPrimitiveBatch *batch, float x, float y);
+void MyPrimitiveBatch_add_points(MyPrimitiveBatch *batch, const SDL_FPoint *points, int count);
+
+/**
+ * Pontos com cor própria, a partir de arrays separados (SoA) de coordenadas e
+ * cores RGBA32 (bytes R, G, B, A na memória). Não altera a cor atual.
+ */
+void MyPrimitiveBatch_add_colored_points(MyPrimitiveBatch *batch, const float *x, const float *y, const Uint32 *colors, int count);
+void MyPrimitiveBatch_add_line(MyPrimitiveBatch *batch, float x1, float y1, float x2, float y2);
+void MyPrimitiveBatch_add_fill_rect(MyPrimitiveBatch *batch, const SDL_FRect *rect);
+void MyPrimitiveBatch_add_rect(MyPrimitiveBatch *batch, const SDL_FRect *rect);
+
+/**
+ * Envia as primitivas acumuladas ao renderizador (uma chamada
+ * SDL_RenderGeometryRaw) e esvazia o lote. Retorna false se alguma primitiva
+ * foi descartada por falta de memória ou se o envio falhou.
+ */
+bool MyPrimitiveBatch_flush(MyPrimitiveBatch *batch);
+
+#endif // MY_BATCH_H
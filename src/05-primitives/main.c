@@ -1,6 +1,33 @@
 // Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
 // SPDX-License-Identifier: Apache-2.0
 
+//------------------------------------------------------------------------------
+// Exemplo: 05-primitives
+// O programa desenha pontos, um retângulo preenchido, o contorno de um
+// retângulo e uma linha do centro da janela até o cursor do mouse.
+//
+// As primitivas não são desenhadas uma a uma: elas são acumuladas em um lote
+// (batch.h) e enviadas ao renderizador com uma única chamada por quadro.
+//
+// Com `--software`, as mesmas primitivas são desenhadas pelo rasterizador por
+// software (raster.h) em um framebuffer na memória, enviado uma vez por
+// quadro para uma textura "streaming".
+//
+// Modo de estresse: `main --stress [--software] [máximo]` desenha quantidades
+// crescentes de primitivas aleatórias (1 mil, 10 mil, ..., até `máximo`,
+// padrão 10 milhões) e registra, para cada quantidade, o tempo médio de
+// montagem, envio (ou rasterização), upload da textura e apresentação.
+//
+// Benchmark sem janela: `main --bench [--threads N] [máximo]` mede apenas o
+// rasterizador por software, com 1 e com N threads, sem abrir janela nem usar
+// a GPU.
+//
+// Modo partículas: `main --particles [--software] [--threads N] [quantidade]`
+// anima `quantidade` partículas (padrão 1 milhão; veja particles.h), todas
+// desenhadas com um único lote. O título da janela mostra, a cada quadro, o
+// tempo de atualização (simulação) e o de desenho, separados.
+//------------------------------------------------------------------------------
+
 //------------------------------------------------------------------------------
 // Includes
 //------------------------------------------------------------------------------
@@ -10,6 +37,14 @@
 #include <time.h>
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
+#include "window.h"
+#include "frame_scheduler.h"
+#include "parallel.h"
+#include "batch.h"
+#include "raster.h"
+#include "particles.h"
+#include "random.h"
+#include "log.h"
 
 //------------------------------------------------------------------------------
 // Constants and enums
@@ -24,107 +59,244 @@ enum constants
   WINDOW_HEIGHT_HALF = WINDOW_HEIGHT >> 1,
   POINT_COUNT = 128,
   COLOR_MAX = 255,
+  FRAME_TIME_MS = 50,
+  WINDOW_TITLE_MAX_LENGTH = 128,
+};
+
+enum stress_constants
+{
+  STRESS_MIN_COUNT = 1000,
+  STRESS_DEFAULT_MAX_COUNT = 10000000,
+  STRESS_FRAMES = 30,
+  STRESS_MAX_MS_PER_STEP = 5000,
+  STRESS_MAX_LINE_LENGTH = 32,
+  STRESS_MAX_RECT_SIZE = 16,
 };
 
-typedef struct MyWindow MyWindow;
-struct MyWindow
+enum particles_mode_constants
 {
-  SDL_Window *window;
-  SDL_Renderer *renderer;
+  PARTICLES_DEFAULT_COUNT = 1000000,
+  // Passo máximo da simulação (ex. quando a janela é arrastada).
+  PARTICLES_MAX_STEP_MS = 50,
 };
 
 //------------------------------------------------------------------------------
 // Globals (argh!)
 //------------------------------------------------------------------------------
 static MyWindow g_window = { .window = NULL, .renderer = NULL };
+static MyFrameScheduler g_scheduler;
+static MyPrimitiveBatch g_batch;
 
-//------------------------------------------------------------------------------
-// Function declaration
-//------------------------------------------------------------------------------
-static bool MyWindow_initialize(MyWindow *window, const char *title, int width, int height, SDL_WindowFlags window_flags);
-static void MyWindow_destroy(MyWindow *window);
+// Caminho por software (--software e --bench).
+static bool g_software = false;
+static MyThreadPool g_threadPool;
+static MySoftwareRasterizer g_raster;
+static SDL_Texture *g_texture = NULL;
+
+static MyParticles g_particles;
 
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-bool MyWindow_initialize(MyWindow *window, const char *title, int width, int height, SDL_WindowFlags window_flags)
+static SDL_AppResult initialize(bool headless, bool useThreads, int threadCount)
 {
-  SDL_Log("\tMyWindow_initialize(%s, %d, %d)", title, width, height);
+  MY_LOG_TRACE(">>> initialize(headless = %d)", headless);
+
+  if (headless || g_software || useThreads)
+  {
+    if (!MyThreadPool_initialize(&g_threadPool, threadCount))
+    {
+      MY_LOG_TRACE("<<< initialize()");
+      return SDL_APP_FAILURE;
+    }
+  }
+
+  if (headless || g_software)
+  {
+    if (!MySoftwareRasterizer_initialize(&g_raster, WINDOW_WIDTH, WINDOW_HEIGHT, &g_threadPool))
+    {
+      MY_LOG_TRACE("<<< initialize()");
+      return SDL_APP_FAILURE;
+    }
+  }
 
-  if (!window)
+  // Sem janela, nem o subsistema de vídeo é iniciado.
+  if (headless)
   {
-    SDL_Log("\t\t*** Erro: Janela/renderizador inválidos (window == NULL).");
-    return false;
+    MY_LOG_TRACE("<<< initialize()");
+    return SDL_APP_CONTINUE;
   }
 
-  return SDL_CreateWindowAndRenderer(title, width, height, window_flags, &window->window, &window->renderer);
+  MY_LOG_DEBUG("\tIniciando SDL...");
+  if (!SDL_Init(SDL_INIT_VIDEO))
+  {
+    MY_LOG_ERROR("\t*** Erro ao iniciar a SDL: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< initialize()");
+    return SDL_APP_FAILURE;
+  }
+
+  MY_LOG_DEBUG("\tCriando janela e renderizador...");
+  if (!MyWindow_initialize(&g_window, WINDOW_TITLE, WINDOW_WIDTH, WINDOW_HEIGHT, 0))
+  {
+    MY_LOG_INFO("\tErro ao criar a janela e/ou renderizador: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< initialize()");
+    return SDL_APP_FAILURE;
+  }
+
+  if (g_software)
+  {
+    MY_LOG_DEBUG("\tCriando textura do framebuffer...");
+    g_texture = SDL_CreateTexture(g_window.renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING,
+      WINDOW_WIDTH, WINDOW_HEIGHT);
+    if (!g_texture)
+    {
+      MY_LOG_ERROR("\t*** Erro ao criar a textura: %s", SDL_GetError());
+      MY_LOG_TRACE("<<< initialize()");
+      return SDL_APP_FAILURE;
+    }
+  }
+  else
+  {
+    MY_LOG_DEBUG("\tCriando lote de primitivas...");
+    if (!MyPrimitiveBatch_initialize(&g_batch, g_window.renderer))
+    {
+      MY_LOG_TRACE("<<< initialize()");
+      return SDL_APP_FAILURE;
+    }
+  }
+
+  MY_LOG_TRACE("<<< initialize()");
+  return SDL_APP_CONTINUE;
 }
 
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-void MyWindow_destroy(MyWindow *window)
+static void shutdown(void)
 {
-  SDL_Log(">>> MyWindow_destroy()");
+  MY_LOG_TRACE(">>> shutdown()");
 
-  if (!window)
+  if (g_texture)
   {
-    SDL_Log("\t*** Erro: Janela/renderizador inválidos (window == NULL).");
-    SDL_Log("<<< MyWindow_destroy()");
-    return;
+    SDL_DestroyTexture(g_texture);
+    g_texture = NULL;
   }
 
-  SDL_Log("\tDestruindo MyWindow->renderer...");
-  SDL_DestroyRenderer(window->renderer);
-  window->renderer = NULL;
+  MyParticles_destroy(&g_particles);
+  MySoftwareRasterizer_destroy(&g_raster);
+  MyThreadPool_destroy(&g_threadPool);
+  MyPrimitiveBatch_destroy(&g_batch);
+  MyWindow_destroy(&g_window);
 
-  SDL_Log("\tDestruindo MyWindow->window...");
-  SDL_DestroyWindow(window->window);
-  window->window = NULL;
+  MyLog_shutdown();
 
-  SDL_Log("<<< MyWindow_destroy()");
+  MY_LOG_DEBUG("\tEncerrando SDL...");
+  SDL_Quit();
+
+  MY_LOG_TRACE("<<< shutdown()");
 }
 
 //------------------------------------------------------------------------------
-//
+// Destino das primitivas: o lote (renderizador da SDL) ou o rasterizador por
+// software, conforme `g_software`.
 //------------------------------------------------------------------------------
-static SDL_AppResult initialize(void)
+static void draw_begin(Uint8 r, Uint8 g, Uint8 b)
 {
-  SDL_Log(">>> initialize()");
-
-  SDL_Log("\tIniciando SDL...");
-  if (!SDL_Init(SDL_INIT_VIDEO))
+  if (g_software)
   {
-    SDL_Log("\t*** Erro ao iniciar a SDL: %s", SDL_GetError());
-    SDL_Log("<<< initialize()");
-    return SDL_APP_FAILURE;
+    MySoftwareRasterizer_begin(&g_raster);
+    MySoftwareRasterizer_clear(&g_raster, r, g, b, COLOR_MAX);
   }
-
-  SDL_Log("\tCriando janela e renderizador...");
-  if (!MyWindow_initialize(&g_window, WINDOW_TITLE, WINDOW_WIDTH, WINDOW_HEIGHT, 0))
+  else
   {
-    SDL_Log("\tErro ao criar a janela e/ou renderizador: %s", SDL_GetError());
-    SDL_Log("<<< initialize()");
-    return SDL_APP_FAILURE;
+    MyPrimitiveBatch_begin(&g_batch);
+    SDL_SetRenderDrawColor(g_window.renderer, r, g, b, COLOR_MAX);
+    SDL_RenderClear(g_window.renderer);
   }
+}
 
-  SDL_Log("<<< initialize()");
-  return SDL_APP_CONTINUE;
+static void draw_set_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+  if (g_software)
+    MySoftwareRasterizer_set_color(&g_raster, r, g, b, a);
+  else
+    MyPrimitiveBatch_set_color(&g_batch, r, g, b, a);
 }
 
-//------------------------------------------------------------------------------
-//
-//------------------------------------------------------------------------------
-static void shutdown(void)
+static void draw_point(float x, float y)
 {
-  SDL_Log(">>> shutdown()");
+  if (g_software)
+    MySoftwareRasterizer_add_point(&g_raster, x, y);
+  else
+    MyPrimitiveBatch_add_point(&g_batch, x, y);
+}
 
-  MyWindow_destroy(&g_window);
+static void draw_points(const SDL_FPoint *points, int count)
+{
+  if (g_software)
+    MySoftwareRasterizer_add_points(&g_raster, points, count);
+  else
+    MyPrimitiveBatch_add_points(&g_batch, points, count);
+}
 
-  SDL_Log("\tEncerrando SDL...");
-  SDL_Quit();
+static void draw_line(float x1, float y1, float x2, float y2)
+{
+  if (g_software)
+    MySoftwareRasterizer_add_line(&g_raster, x1, y1, x2, y2);
+  else
+    MyPrimitiveBatch_add_line(&g_batch, x1, y1, x2, y2);
+}
 
-  SDL_Log("<<< shutdown()");
+static void draw_fill_rect(const SDL_FRect *rect)
+{
+  if (g_software)
+    MySoftwareRasterizer_add_fill_rect(&g_raster, rect);
+  else
+    MyPrimitiveBatch_add_fill_rect(&g_batch, rect);
+}
+
+static void draw_rect(const SDL_FRect *rect)
+{
+  if (g_software)
+    MySoftwareRasterizer_add_rect(&g_raster, rect);
+  else
+    MyPrimitiveBatch_add_rect(&g_batch, rect);
+}
+
+static void draw_colored_points(const float *x, const float *y, const Uint32 *colors, int count)
+{
+  if (g_software)
+    MySoftwareRasterizer_add_colored_points(&g_raster, x, y, colors, count);
+  else
+    MyPrimitiveBatch_add_colored_points(&g_batch, x, y, colors, count);
+}
+
+/**
+ * Envia o lote ao renderizador ou rasteriza os comandos pendentes.
+ */
+static void draw_submit(void)
+{
+  if (g_software)
+    MySoftwareRasterizer_flush(&g_raster);
+  else
+    MyPrimitiveBatch_flush(&g_batch);
+}
+
+/**
+ * Software: envia o framebuffer para a textura e a desenha na janela inteira.
+ */
+static void draw_upload(void)
+{
+  if (!g_software)
+    return;
+
+  SDL_UpdateTexture(g_texture, NULL, g_raster.pixels, g_raster.width * (int)sizeof(Uint32));
+  SDL_RenderTexture(g_window.renderer, g_texture, NULL, NULL);
+}
+
+static int draw_get_submit_count(void)
+{
+  return g_software ? g_raster.stats.flushCount : g_batch.stats.submitCount;
 }
 
 //------------------------------------------------------------------------------
@@ -132,13 +304,14 @@ static void shutdown(void)
 //------------------------------------------------------------------------------
 static void loop(void)
 {
-  SDL_Log(">>> loop()");
+  MY_LOG_TRACE(">>> loop()");
 
   srand(time(NULL));
 
   SDL_Color color = { .r = 0, .g = 0, .b = 0, .a = COLOR_MAX };
 
-  SDL_FRect rect = { .x = 0.0f, .y = 0.0f, .w = 0.0f, .h = 0.0f };
+  SDL_FRect fillRect = { .x = 0.0f, .y = 0.0f, .w = 0.0f, .h = 0.0f };
+  SDL_FRect outlineRect = { .x = 0.0f, .y = 0.0f, .w = 0.0f, .h = 0.0f };
 
   SDL_FPoint points[POINT_COUNT];
   for (size_t i = 0; i < POINT_COUNT; ++i)
@@ -150,11 +323,17 @@ static void loop(void)
   SDL_FPoint mouseCursor = { .x = 0.0f, .y = 0.0f };
   SDL_HideCursor();
 
+  // A animação (cor e retângulos aleatórios) avança a cada FRAME_TIME_MS.
+  // Entre um quadro e outro, o programa fica bloqueado à espera de eventos ao
+  // invés de dormir um tempo fixo; assim, a linha até o cursor do mouse é
+  // redesenhada assim que o mouse se move, sem acelerar a animação.
+  MyFrameScheduler_initialize(&g_scheduler, FRAME_TIME_MS * SDL_NS_PER_MS, false);
+
   SDL_Event event;
   bool isRunning = true;
   while (isRunning)
   {
-    while (SDL_PollEvent(&event))
+    while (isRunning && MyFrameScheduler_wait_event(&g_scheduler, &event))
     {
       switch (event.type)
       {
@@ -165,45 +344,329 @@ static void loop(void)
       case SDL_EVENT_MOUSE_MOTION:
         mouseCursor.x = event.motion.x;
         mouseCursor.y = event.motion.y;
+        MyFrameScheduler_invalidate(&g_scheduler);
         break;
       }
     }
 
-    SDL_SetRenderDrawColor(g_window.renderer, 0, 0, 0, COLOR_MAX);
-    SDL_RenderClear(g_window.renderer);
+    const Uint32 reasons = isRunning ? MyFrameScheduler_begin_frame(&g_scheduler) : MY_FRAME_NONE;
+    if (reasons == MY_FRAME_NONE)
+      continue;
+
+    if (reasons & MY_FRAME_TICK)
+    {
+      color.r = rand() % COLOR_MAX;
+      color.g = rand() % COLOR_MAX;
+      color.b = rand() % COLOR_MAX;
+
+      fillRect.x = rand() % WINDOW_WIDTH;
+      fillRect.y = rand() % WINDOW_HEIGHT;
+      fillRect.w = rand() % WINDOW_WIDTH_HALF;
+      fillRect.h = rand() % WINDOW_HEIGHT_HALF;
+
+      outlineRect.x = rand() % WINDOW_WIDTH;
+      outlineRect.y = rand() % WINDOW_HEIGHT;
+      outlineRect.w = rand() % WINDOW_WIDTH_HALF;
+      outlineRect.h = rand() % WINDOW_HEIGHT_HALF;
+    }
 
-    color.r = rand() % COLOR_MAX;
-    color.g = rand() % COLOR_MAX;
-    color.b = rand() % COLOR_MAX;
-    SDL_SetRenderDrawColor(g_window.renderer, color.r, color.g, color.b, color.a);
+    draw_begin(0, 0, 0);
 
-    SDL_RenderPoints(g_window.renderer, points, POINT_COUNT);
+    draw_set_color(color.r, color.g, color.b, color.a);
+    draw_points(points, POINT_COUNT);
+    draw_fill_rect(&fillRect);
+    draw_rect(&outlineRect);
 
-    rect.x = rand() % WINDOW_WIDTH;
-    rect.y = rand() % WINDOW_HEIGHT;
-    rect.w = rand() % WINDOW_WIDTH_HALF;
-    rect.h = rand() % WINDOW_HEIGHT_HALF;
-    SDL_RenderFillRect(g_window.renderer, &rect);
+    draw_set_color(128, 128, 128, COLOR_MAX);
+    draw_line(WINDOW_WIDTH_HALF, WINDOW_HEIGHT_HALF, mouseCursor.x, mouseCursor.y);
 
-    rect.x = rand() % WINDOW_WIDTH;
-    rect.y = rand() % WINDOW_HEIGHT;
-    rect.w = rand() % WINDOW_WIDTH_HALF;
-    rect.h = rand() % WINDOW_HEIGHT_HALF;
-    SDL_RenderRect(g_window.renderer, &rect);
+    draw_set_color(255, 255, 255, COLOR_MAX);
+    draw_point(WINDOW_WIDTH_HALF, WINDOW_HEIGHT_HALF);
+    draw_point(mouseCursor.x, mouseCursor.y);
 
-    SDL_SetRenderDrawColor(g_window.renderer, 128, 128, 128, COLOR_MAX);
-    SDL_RenderLine(g_window.renderer, WINDOW_WIDTH_HALF, WINDOW_HEIGHT_HALF, mouseCursor.x, mouseCursor.y);
+    draw_submit();
+    draw_upload();
 
-    SDL_SetRenderDrawColor(g_window.renderer, 255, 255, 255, COLOR_MAX);
-    SDL_RenderPoint(g_window.renderer, WINDOW_WIDTH_HALF, WINDOW_HEIGHT_HALF);
-    SDL_RenderPoint(g_window.renderer, mouseCursor.x, mouseCursor.y);
+    SDL_RenderPresent(g_window.renderer);
+    MyFrameScheduler_end_frame(&g_scheduler);
+  }
+
+  MyFrameScheduler_log_stats(&g_scheduler);
+
+  MY_LOG_TRACE("<<< loop()");
+}
+
+//------------------------------------------------------------------------------
+// Grava `count` primitivas aleatórias (1/4 de cada tipo). A mesma semente
+// gera sempre a mesma cena.
+//------------------------------------------------------------------------------
+static void build_stress_frame(int count, Uint32 seed)
+{
+  Uint32 state = seed ? seed : 1;
+
+  for (int i = 0; i < count; ++i)
+  {
+    const Uint32 r = my_xorshift32(&state);
+    draw_set_color(r & 0xFF, (r >> 8) & 0xFF, (r >> 16) & 0xFF, COLOR_MAX);
+
+    const float x = (float)(my_xorshift32(&state) % WINDOW_WIDTH);
+    const float y = (float)(my_xorshift32(&state) % WINDOW_HEIGHT);
+
+    switch (i & 3)
+    {
+    case 0:
+      draw_point(x, y);
+      break;
+
+    case 1:
+    {
+      const Uint32 d = my_xorshift32(&state);
+      const float dx = (float)((int)(d & 0xFF) % (2 * STRESS_MAX_LINE_LENGTH + 1) - STRESS_MAX_LINE_LENGTH);
+      const float dy = (float)((int)((d >> 8) & 0xFF) % (2 * STRESS_MAX_LINE_LENGTH + 1) - STRESS_MAX_LINE_LENGTH);
+      draw_line(x, y, x + dx, y + dy);
+      break;
+    }
+
+    default:
+    {
+      const Uint32 s = my_xorshift32(&state);
+      const SDL_FRect rect = {
+        .x = x,
+        .y = y,
+        .w = (float)(1 + (s & 0xFF) % STRESS_MAX_RECT_SIZE),
+        .h = (float)(1 + ((s >> 8) & 0xFF) % STRESS_MAX_RECT_SIZE),
+      };
+
+      if (i & 1)
+        draw_rect(&rect);
+      else
+        draw_fill_rect(&rect);
+      break;
+    }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Quantidades do modo de estresse: STRESS_MIN_COUNT, x10, ..., até maxCount.
+// Retorna 0 depois da última.
+//------------------------------------------------------------------------------
+static int next_stress_count(int count, int maxCount)
+{
+  if (count == 0)
+    return STRESS_MIN_COUNT;
+
+  return count <= maxCount / 10 ? count * 10 : 0;
+}
+
+//------------------------------------------------------------------------------
+// Modo de estresse: para cada quantidade de primitivas, desenha
+// STRESS_FRAMES quadros (ou o que couber em STRESS_MAX_MS_PER_STEP) o mais
+// rápido possível e registra os tempos médios.
+//------------------------------------------------------------------------------
+static void loop_stress(int maxCount)
+{
+  MY_LOG_TRACE(">>> loop_stress(maxCount = %d, %s)", maxCount, g_software ? "software" : "SDL_Renderer");
+
+  MY_LOG_INFO("%10s %8s %10s %10s %10s %10s %10s %8s %10s",
+    "primitivas", "envios", "montar ms", "enviar ms", "upload ms", "apres. ms", "quadro ms", "FPS", "Mprim/s");
+
+  bool isRunning = true;
+  for (int count = next_stress_count(0, maxCount); isRunning && count > 0; count = next_stress_count(count, maxCount))
+  {
+    Uint64 buildNS = 0;
+    Uint64 submitNS = 0;
+    Uint64 uploadNS = 0;
+    Uint64 presentNS = 0;
+    int submitCount = 0;
+    int frames = 0;
+
+    const Uint64 stepStartNS = SDL_GetTicksNS();
+    while (isRunning && frames < STRESS_FRAMES)
+    {
+      SDL_Event event;
+      while (SDL_PollEvent(&event))
+      {
+        if (event.type == SDL_EVENT_QUIT)
+          isRunning = false;
+      }
+
+      // O lote (ou a lista de comandos) se esvazia sozinho quando chega ao
+      // tamanho máximo; no lote, esse envio parcial fica na montagem.
+      const Uint64 t0 = SDL_GetTicksNS();
+      draw_begin(0, 0, 0);
+      build_stress_frame(count, (Uint32)frames + 1);
+
+      const Uint64 t1 = SDL_GetTicksNS();
+      draw_submit();
+
+      const Uint64 t2 = SDL_GetTicksNS();
+      draw_upload();
+
+      const Uint64 t3 = SDL_GetTicksNS();
+      SDL_RenderPresent(g_window.renderer);
+
+      // No software, os envios automáticos feitos durante a montagem também
+      // contam como rasterização.
+      const Uint64 t4 = SDL_GetTicksNS();
+      const Uint64 frameSubmitNS = g_software ? g_raster.stats.rasterNS : t2 - t1;
+      buildNS += (t2 - t0) - frameSubmitNS;
+      submitNS += frameSubmitNS;
+      uploadNS += t3 - t2;
+      presentNS += t4 - t3;
+      submitCount = draw_get_submit_count();
+      ++frames;
+
+      if (t4 - stepStartNS >= (Uint64)STRESS_MAX_MS_PER_STEP * SDL_NS_PER_MS)
+        break;
+    }
+
+    if (frames > 0)
+    {
+      const double toMS = 1.0 / ((double)SDL_NS_PER_MS * frames);
+      const double frameMS = (double)(buildNS + submitNS + uploadNS + presentNS) * toMS;
+      MY_LOG_INFO("%10d %8d %10.3f %10.3f %10.3f %10.3f %10.3f %8.1f %10.2f",
+        count, submitCount,
+        (double)buildNS * toMS, (double)submitNS * toMS, (double)uploadNS * toMS, (double)presentNS * toMS,
+        frameMS, 1000.0 / frameMS, count / (frameMS * 1000.0));
+    }
+  }
 
+  MY_LOG_TRACE("<<< loop_stress()");
+}
+
+//------------------------------------------------------------------------------
+// Benchmark sem janela do rasterizador por software. Para cada quantidade de
+// primitivas, mede a gravação dos comandos e a rasterização com uma única
+// thread e com o pool inteiro (mesma cena, mesmo resultado).
+//------------------------------------------------------------------------------
+static void run_bench(int maxCount)
+{
+  MY_LOG_TRACE(">>> run_bench(maxCount = %d)", maxCount);
+
+  const int threadCount = MyThreadPool_get_thread_count(&g_threadPool);
+  MY_LOG_INFO("Framebuffer %dx%d, %d thread(s), kernels %s.", g_raster.width, g_raster.height, threadCount,
+    MyKernels_get_level_name(g_raster.kernels->level));
+  MY_LOG_INFO("%10s %10s %12s %12s %8s %10s", "primitivas", "gravar ms", "raster 1T ms", "raster NT ms", "speedup", "Mprim/s");
+
+  for (int count = next_stress_count(0, maxCount); count > 0; count = next_stress_count(count, maxCount))
+  {
+    // Tempo médio de cada configuração, com o primeiro quadro descartado
+    // (aquecimento: alocação da lista de comandos e das faixas).
+    double rasterMS[2] = { 0.0, 0.0 };
+    double buildMS = 0.0;
+    int frames = 0;
+
+    for (int config = 0; config < 2; ++config)
+    {
+      g_raster.threadPool = config == 0 ? NULL : &g_threadPool;
+
+      Uint64 buildNS = 0;
+      Uint64 rasterNS = 0;
+      const Uint64 stepStartNS = SDL_GetTicksNS();
+      for (frames = 0; frames <= STRESS_FRAMES; ++frames)
+      {
+        // Com milhões de primitivas, parte da rasterização acontece durante a
+        // gravação (envios automáticos); stats.rasterNS inclui esses envios.
+        const Uint64 t0 = SDL_GetTicksNS();
+        draw_begin(0, 0, 0);
+        build_stress_frame(count, (Uint32)frames + 1);
+        draw_submit();
+
+        const Uint64 t2 = SDL_GetTicksNS();
+        if (frames == 0)
+          continue;
+
+        buildNS += (t2 - t0) - g_raster.stats.rasterNS;
+        rasterNS += g_raster.stats.rasterNS;
+
+        if (t2 - stepStartNS >= (Uint64)STRESS_MAX_MS_PER_STEP * SDL_NS_PER_MS)
+        {
+          ++frames;
+          break;
+        }
+      }
+
+      const double toMS = 1.0 / ((double)SDL_NS_PER_MS * SDL_max(frames - 1, 1));
+      rasterMS[config] = (double)rasterNS * toMS;
+      if (config == 1)
+        buildMS = (double)buildNS * toMS;
+    }
+
+    MY_LOG_INFO("%10d %10.3f %12.3f %12.3f %7.2fx %10.2f",
+      count, buildMS, rasterMS[0], rasterMS[1], rasterMS[0] / SDL_max(rasterMS[1], 1e-6),
+      count / ((buildMS + rasterMS[1]) * 1000.0));
+  }
+
+  g_raster.threadPool = &g_threadPool;
+
+  MY_LOG_TRACE("<<< run_bench()");
+}
+
+//------------------------------------------------------------------------------
+// Modo partículas: a simulação avança pelo tempo real decorrido entre os
+// quadros, sem agendador (a animação nunca para).
+//------------------------------------------------------------------------------
+static void loop_particles(int count)
+{
+  MY_LOG_TRACE(">>> loop_particles(count = %d, %s)", count, g_software ? "software" : "SDL_Renderer");
+
+  if (!MyParticles_initialize(&g_particles, count, WINDOW_WIDTH, WINDOW_HEIGHT, &g_threadPool))
+  {
+    MY_LOG_TRACE("<<< loop_particles()");
+    return;
+  }
+
+  char windowTitle[WINDOW_TITLE_MAX_LENGTH] = { 0 };
+  Uint64 updateTotalNS = 0;
+  Uint64 renderTotalNS = 0;
+  Uint64 frames = 0;
+
+  Uint64 lastNS = SDL_GetTicksNS();
+  bool isRunning = true;
+  while (isRunning)
+  {
+    SDL_Event event;
+    while (SDL_PollEvent(&event))
+    {
+      if (event.type == SDL_EVENT_QUIT)
+        isRunning = false;
+    }
+
+    const Uint64 t0 = SDL_GetTicksNS();
+    const Uint64 stepNS = SDL_min(t0 - lastNS, (Uint64)PARTICLES_MAX_STEP_MS * SDL_NS_PER_MS);
+    lastNS = t0;
+
+    MyParticles_update(&g_particles, (float)((double)stepNS / SDL_NS_PER_SECOND));
+
+    const Uint64 t1 = SDL_GetTicksNS();
+    draw_begin(0, 0, 0);
+    draw_colored_points(g_particles.x, g_particles.y, g_particles.colors, g_particles.count);
+    draw_submit();
+    draw_upload();
     SDL_RenderPresent(g_window.renderer);
 
-    SDL_Delay(50);
+    const Uint64 t2 = SDL_GetTicksNS();
+    updateTotalNS += t1 - t0;
+    renderTotalNS += t2 - t1;
+    ++frames;
+
+    snprintf(windowTitle, WINDOW_TITLE_MAX_LENGTH, "%s - %d partículas | atualizar %.2f ms | desenhar %.2f ms (%d envio(s))",
+      WINDOW_TITLE, count, (double)(t1 - t0) / SDL_NS_PER_MS, (double)(t2 - t1) / SDL_NS_PER_MS, draw_get_submit_count());
+    SDL_SetWindowTitle(g_window.window, windowTitle);
   }
 
-  SDL_Log("<<< loop()");
+  if (frames > 0)
+  {
+    MY_LOG_INFO("\t%llu quadro(s): atualizar %.3f ms, desenhar %.3f ms (médias por quadro).",
+      (unsigned long long)frames,
+      (double)updateTotalNS / ((double)SDL_NS_PER_MS * frames),
+      (double)renderTotalNS / ((double)SDL_NS_PER_MS * frames));
+  }
+
+  MyParticles_destroy(&g_particles);
+
+  MY_LOG_TRACE("<<< loop_particles()");
 }
 
 //------------------------------------------------------------------------------
@@ -212,11 +675,44 @@ static void loop(void)
 int main(int argc, char *argv[])
 {
   atexit(shutdown);
+  MyLog_initialize();
+
+  bool stress = false;
+  bool bench = false;
+  bool particles = false;
+  int threadCount = 0;
+  int count = 0;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (SDL_strcmp(argv[i], "--stress") == 0)
+      stress = true;
+    else if (SDL_strcmp(argv[i], "--software") == 0)
+      g_software = true;
+    else if (SDL_strcmp(argv[i], "--bench") == 0)
+      bench = true;
+    else if (SDL_strcmp(argv[i], "--particles") == 0)
+      particles = true;
+    else if (SDL_strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+      threadCount = SDL_atoi(argv[++i]);
+    else
+      count = SDL_atoi(argv[i]);
+  }
+
+  if (bench)
+    g_software = true;
 
-  if (initialize() == SDL_APP_FAILURE)
+  if (initialize(bench, particles, threadCount) == SDL_APP_FAILURE)
     return SDL_APP_FAILURE;
 
-  loop();
+  const int maxCount = count > 0 ? SDL_max(count, (int)STRESS_MIN_COUNT) : STRESS_DEFAULT_MAX_COUNT;
+  if (bench)
+    run_bench(maxCount);
+  else if (stress)
+    loop_stress(maxCount);
+  else if (particles)
+    loop_particles(count > 0 ? count : PARTICLES_DEFAULT_COUNT);
+  else
+    loop();
 
   return 0;
 }
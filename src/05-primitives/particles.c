@@ -0,0 +1,258 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "particles.h"
+#include "random.h"
+#include "log.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MY_PARTICLES_SSE2 1
+#else
+#define MY_PARTICLES_SSE2 0
+#endif
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+
+// Velocidade inicial máxima, em pixels por segundo.
+static const float MAX_SPEED = 120.0f;
+// Aceleração aleatória máxima, em pixels por segundo ao quadrado.
+static const float JITTER = 400.0f;
+// Fração da velocidade perdida por segundo.
+static const float DRAG = 0.5f;
+
+typedef struct UpdateJob UpdateJob;
+struct UpdateJob
+{
+  MyParticles *particles;
+  float dt;
+};
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static void update_particles(void *userdata, int begin, int end, int threadIndex);
+
+//------------------------------------------------------------------------------
+// Número aleatório em [-1, 1): os 24 bits mais altos cabem exatos em um float.
+//------------------------------------------------------------------------------
+static inline float random_signed(Uint32 *state)
+{
+  return (float)(my_xorshift32(state) >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+#if MY_PARTICLES_SSE2
+//------------------------------------------------------------------------------
+// 4 xorshift32 independentes, um por lane.
+//------------------------------------------------------------------------------
+static inline __m128 random_signed_sse2(__m128i *state)
+{
+  __m128i x = *state;
+  x = _mm_xor_si128(x, _mm_slli_epi32(x, 13));
+  x = _mm_xor_si128(x, _mm_srli_epi32(x, 17));
+  x = _mm_xor_si128(x, _mm_slli_epi32(x, 5));
+  *state = x;
+
+  const __m128 r = _mm_cvtepi32_ps(_mm_srli_epi32(x, 8));
+  return _mm_sub_ps(_mm_mul_ps(r, _mm_set1_ps(2.0f / 16777216.0f)), _mm_set1_ps(1.0f));
+}
+
+//------------------------------------------------------------------------------
+// Reflete as posições fora de [0, limit] e inverte o sinal da velocidade
+// correspondente.
+//------------------------------------------------------------------------------
+static inline void bounce_sse2(__m128 *position, __m128 *velocity, __m128 limit)
+{
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 signBit = _mm_set1_ps(-0.0f);
+
+  const __m128 below = _mm_cmplt_ps(*position, zero);
+  const __m128 above = _mm_cmpgt_ps(*position, limit);
+
+  __m128 p = *position;
+  p = _mm_or_ps(_mm_and_ps(below, _mm_sub_ps(zero, p)), _mm_andnot_ps(below, p));
+  p = _mm_or_ps(_mm_and_ps(above, _mm_sub_ps(_mm_add_ps(limit, limit), p)), _mm_andnot_ps(above, p));
+
+  // Velocidades muito altas poderiam refletir para fora do outro lado.
+  *position = _mm_min_ps(_mm_max_ps(p, zero), limit);
+  *velocity = _mm_xor_ps(*velocity, _mm_and_ps(_mm_or_ps(below, above), signBit));
+}
+#endif
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static inline void bounce(float *position, float *velocity, float limit)
+{
+  if (*position < 0.0f)
+  {
+    *position = -*position;
+    *velocity = -*velocity;
+  }
+  else if (*position > limit)
+  {
+    *position = 2.0f * limit - *position;
+    *velocity = -*velocity;
+  }
+
+  *position = SDL_clamp(*position, 0.0f, limit);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyParticles_initialize(MyParticles *particles, int count, float width, float height, MyThreadPool *threadPool)
+{
+  MY_LOG_TRACE(">>> MyParticles_initialize(%d)", count);
+
+  if (!particles || count <= 0 || width <= 0.0f || height <= 0.0f)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyParticles_initialize()");
+    return false;
+  }
+
+  SDL_zerop(particles);
+  particles->count = count;
+  particles->width = width;
+  particles->height = height;
+  particles->threadPool = threadPool;
+
+  const size_t n = (size_t)count;
+  particles->x = (float *)SDL_malloc(n * sizeof(float));
+  particles->y = (float *)SDL_malloc(n * sizeof(float));
+  particles->vx = (float *)SDL_malloc(n * sizeof(float));
+  particles->vy = (float *)SDL_malloc(n * sizeof(float));
+  particles->colors = (Uint32 *)SDL_malloc(n * sizeof(Uint32));
+  if (!particles->x || !particles->y || !particles->vx || !particles->vy || !particles->colors)
+  {
+    MY_LOG_ERROR("\t*** Erro ao alocar memória para %d partículas.", count);
+    MyParticles_destroy(particles);
+    MY_LOG_TRACE("<<< MyParticles_initialize()");
+    return false;
+  }
+
+  // Sementes diferentes (e não nulas) para cada lane de cada thread.
+  Uint32 seed = (Uint32)SDL_GetTicksNS() | 1;
+  for (int t = 0; t < MY_THREAD_POOL_MAX_THREADS; ++t)
+  {
+    for (int lane = 0; lane < 4; ++lane)
+    {
+      particles->rng[t][lane] = my_xorshift32(&seed);
+    }
+  }
+
+  Uint32 state = seed;
+  for (int i = 0; i < count; ++i)
+  {
+    particles->x[i] = (random_signed(&state) * 0.5f + 0.5f) * width;
+    particles->y[i] = (random_signed(&state) * 0.5f + 0.5f) * height;
+    particles->vx[i] = random_signed(&state) * MAX_SPEED;
+    particles->vy[i] = random_signed(&state) * MAX_SPEED;
+
+    // Cores claras: cada canal em [64, 255].
+    const Uint32 r = my_xorshift32(&state) | 0x00404040;
+    const Uint8 bytes[4] = { (Uint8)r, (Uint8)(r >> 8), (Uint8)(r >> 16), 255 };
+    SDL_memcpy(&particles->colors[i], bytes, sizeof(Uint32));
+  }
+
+  MY_LOG_TRACE("<<< MyParticles_initialize()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyParticles_destroy(MyParticles *particles)
+{
+  MY_LOG_TRACE(">>> MyParticles_destroy()");
+
+  if (!particles)
+  {
+    MY_LOG_ERROR("\t*** Erro: Partículas inválidas (particles == NULL).");
+    MY_LOG_TRACE("<<< MyParticles_destroy()");
+    return;
+  }
+
+  SDL_free(particles->x);
+  SDL_free(particles->y);
+  SDL_free(particles->vx);
+  SDL_free(particles->vy);
+  SDL_free(particles->colors);
+  SDL_zerop(particles);
+
+  MY_LOG_TRACE("<<< MyParticles_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyParticles_update(MyParticles *particles, float dt)
+{
+  UpdateJob job = { .particles = particles, .dt = dt };
+  MyThreadPool_parallel_for(particles->threadPool, particles->count, MY_PARTICLES_PER_BLOCK, update_particles, &job);
+}
+
+//------------------------------------------------------------------------------
+// v = v * (1 - DRAG * dt) + aleatório * JITTER * dt; p = p + v * dt.
+//------------------------------------------------------------------------------
+void update_particles(void *userdata, int begin, int end, int threadIndex)
+{
+  const UpdateJob *job = (const UpdateJob *)userdata;
+  MyParticles *particles = job->particles;
+  Uint32 *rng = particles->rng[threadIndex];
+
+  const float dt = job->dt;
+  const float drag = 1.0f - DRAG * dt;
+  const float jitter = JITTER * dt;
+
+  float *px = particles->x;
+  float *py = particles->y;
+  float *vx = particles->vx;
+  float *vy = particles->vy;
+
+  int i = begin;
+
+#if MY_PARTICLES_SSE2
+  const __m128 vdt = _mm_set1_ps(dt);
+  const __m128 vdrag = _mm_set1_ps(drag);
+  const __m128 vjitter = _mm_set1_ps(jitter);
+  const __m128 width = _mm_set1_ps(particles->width);
+  const __m128 height = _mm_set1_ps(particles->height);
+
+  __m128i state = _mm_loadu_si128((const __m128i *)rng);
+  for (; i + 4 <= end; i += 4)
+  {
+    __m128 velocityX = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vx + i), vdrag), _mm_mul_ps(random_signed_sse2(&state), vjitter));
+    __m128 velocityY = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), vdrag), _mm_mul_ps(random_signed_sse2(&state), vjitter));
+    __m128 positionX = _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(velocityX, vdt));
+    __m128 positionY = _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(velocityY, vdt));
+
+    bounce_sse2(&positionX, &velocityX, width);
+    bounce_sse2(&positionY, &velocityY, height);
+
+    _mm_storeu_ps(px + i, positionX);
+    _mm_storeu_ps(py + i, positionY);
+    _mm_storeu_ps(vx + i, velocityX);
+    _mm_storeu_ps(vy + i, velocityY);
+  }
+  _mm_storeu_si128((__m128i *)rng, state);
+#endif
+
+  // Sobras do bloco (ou tudo, sem SSE2).
+  for (; i < end; ++i)
+  {
+    vx[i] = vx[i] * drag + random_signed(&rng[0]) * jitter;
+    vy[i] = vy[i] * drag + random_signed(&rng[0]) * jitter;
+    px[i] += vx[i] * dt;
+    py[i] += vy[i] * dt;
+
+    bounce(&px[i], &vx[i], particles->width);
+    bounce(&py[i], &vy[i], particles->height);
+  }
+}
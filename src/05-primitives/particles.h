@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Sistema de partículas para o modo `--particles` do 05-primitives.
+//
+// As partículas são guardadas como estrutura de arrays (SoA): um array para
+// cada campo (x, y, vx, vy e cor), de modo que o integrador lê e escreve
+// posições e velocidades de 4 partículas consecutivas com uma instrução SSE2.
+//
+// A cada quadro, MyParticles_update() divide as partículas em blocos entre as
+// threads do MyThreadPool. Cada partícula recebe uma pequena aceleração
+// aleatória, perde um pouco de velocidade (atrito) e é refletida nas bordas
+// da área. Os números aleatórios vêm de um xorshift32 com 4 estados (um por
+// lane SSE2) por thread, sem nenhuma sincronização entre threads.
+//
+// SSE2 faz parte do conjunto básico do x86-64, então não há despacho em tempo
+// de execução (kernels.h); em outras arquiteturas, usa-se a versão escalar.
+//------------------------------------------------------------------------------
+#ifndef MY_PARTICLES_H
+#define MY_PARTICLES_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+#include "parallel.h"
+
+enum particles_constants
+{
+  MY_PARTICLES_PER_BLOCK = 16384,
+  // Estado do gerador de cada thread ocupa uma linha de cache (16 x 4 bytes),
+  // para que threads diferentes não disputem a mesma linha.
+  MY_PARTICLES_RNG_STRIDE = 16,
+};
+
+typedef struct MyParticles MyParticles;
+struct MyParticles
+{
+  int count;
+  float width;
+  float height;
+
+  float *x;
+  float *y;
+  float *vx;
+  float *vy;
+  Uint32 *colors;  // RGBA32 (bytes R, G, B, A na memória).
+
+  MyThreadPool *threadPool;
+  Uint32 rng[MY_THREAD_POOL_MAX_THREADS][MY_PARTICLES_RNG_STRIDE];
+};
+
+/**
+ * Cria `count` partículas com posição, velocidade e cor aleatórias dentro de
+ * `width x height`. `threadPool` pode ser NULL.
+ */
+bool MyParticles_initialize(MyParticles *particles, int count, float width, float height, MyThreadPool *threadPool);
+void MyParticles_destroy(MyParticles *particles);
+
+/**
+ * Avança a simulação em `dt` segundos.
+ */
+void MyParticles_update(MyParticles *particles, float dt);
+
+#endif // MY_PARTICLES_H
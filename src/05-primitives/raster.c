@@ -0,0 +1,629 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "raster.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+
+// Coordenadas fora deste intervalo são limitadas antes da conversão para int
+// (evita overflow nas contas das linhas).
+static const float COORDINATE_LIMIT = 1 << 24;
+
+typedef struct ClearJob ClearJob;
+struct ClearJob
+{
+  MySoftwareRasterizer *raster;
+  Uint32 color;
+};
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static Uint32 pack_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+static int to_pixel(float value);
+static int ceil_div(Sint64 numerator, Sint64 denominator);
+
+static bool MySoftwareRasterizer_grow(MySoftwareRasterizer *raster);
+static MyRasterCommand *MySoftwareRasterizer_push(MySoftwareRasterizer *raster, MyRasterCommandType type);
+
+/**
+ * Faixas [*firstTile, *lastTile] cobertas por `command`; false se o comando
+ * está totalmente fora do framebuffer.
+ */
+static bool get_tile_range(const MySoftwareRasterizer *raster, const MyRasterCommand *command, int *firstTile, int *lastTile);
+
+static void raster_tiles(void *userdata, int begin, int end, int threadIndex);
+static void clear_tiles(void *userdata, int begin, int end, int threadIndex);
+
+static void draw_span(const MySoftwareRasterizer *raster, int y, int x0, int x1, Uint32 color);
+static void draw_fill_rect(const MySoftwareRasterizer *raster, const MyRasterCommand *command, int tileY0, int tileY1);
+static void draw_rect(const MySoftwareRasterizer *raster, const MyRasterCommand *command, int tileY0, int tileY1);
+static void draw_line(const MySoftwareRasterizer *raster, const MyRasterCommand *command, int tileY0, int tileY1);
+
+//------------------------------------------------------------------------------
+// Cor RGBA32: bytes R, G, B, A na memória, independente da ordem dos bytes
+// da CPU.
+//------------------------------------------------------------------------------
+Uint32 pack_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+  const Uint8 bytes[4] = { r, g, b, a };
+  Uint32 color;
+  SDL_memcpy(&color, bytes, sizeof(color));
+  return color;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int to_pixel(float value)
+{
+  return (int)SDL_floorf(SDL_clamp(value, -COORDINATE_LIMIT, COORDINATE_LIMIT));
+}
+
+//------------------------------------------------------------------------------
+// Divisão arredondada para cima (denominator > 0).
+//------------------------------------------------------------------------------
+int ceil_div(Sint64 numerator, Sint64 denominator)
+{
+  if (numerator >= 0)
+    return (int)((numerator + denominator - 1) / denominator);
+
+  return (int)-((-numerator) / denominator);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MySoftwareRasterizer_initialize(MySoftwareRasterizer *raster, int width, int height, MyThreadPool *threadPool)
+{
+  MY_LOG_TRACE(">>> MySoftwareRasterizer_initialize(%d, %d)", width, height);
+
+  if (!raster || width <= 0 || height <= 0)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MySoftwareRasterizer_initialize()");
+    return false;
+  }
+
+  SDL_zerop(raster);
+  raster->width = width;
+  raster->height = height;
+  raster->threadPool = threadPool;
+  raster->kernels = MyKernels_get();
+  raster->color = pack_color(255, 255, 255, 255);
+  raster->tileCount = (height + MY_RASTER_TILE_HEIGHT - 1) / MY_RASTER_TILE_HEIGHT;
+
+  raster->pixels = (Uint32 *)SDL_calloc((size_t)width * height, sizeof(Uint32));
+  raster->binOffsets = (int *)SDL_calloc((size_t)raster->tileCount + 1, sizeof(int));
+  if (!raster->pixels || !raster->binOffsets || !MySoftwareRasterizer_grow(raster))
+  {
+    MY_LOG_ERROR("\t*** Erro ao alocar memória para o rasterizador.");
+    MySoftwareRasterizer_destroy(raster);
+    MY_LOG_TRACE("<<< MySoftwareRasterizer_initialize()");
+    return false;
+  }
+
+  MY_LOG_INFO("\t%d faixa(s) de %d linhas, kernels %s.", raster->tileCount, MY_RASTER_TILE_HEIGHT,
+    MyKernels_get_level_name(raster->kernels->level));
+
+  MY_LOG_TRACE("<<< MySoftwareRasterizer_initialize()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySoftwareRasterizer_destroy(MySoftwareRasterizer *raster)
+{
+  MY_LOG_TRACE(">>> MySoftwareRasterizer_destroy()");
+
+  if (!raster)
+  {
+    MY_LOG_ERROR("\t*** Erro: Rasterizador inválido (raster == NULL).");
+    MY_LOG_TRACE("<<< MySoftwareRasterizer_destroy()");
+    return;
+  }
+
+  SDL_free(raster->pixels);
+  SDL_free(raster->commands);
+  SDL_free(raster->binOffsets);
+  SDL_free(raster->binCommands);
+  SDL_zerop(raster);
+
+  MY_LOG_TRACE("<<< MySoftwareRasterizer_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MySoftwareRasterizer_grow(MySoftwareRasterizer *raster)
+{
+  const int capacity = raster->commandCapacity
+    ? SDL_min(raster->commandCapacity * 2, MY_RASTER_MAX_COMMANDS)
+    : MY_RASTER_INITIAL_COMMANDS;
+  if (capacity <= raster->commandCapacity)
+    return false;
+
+  MyRasterCommand *commands = (MyRasterCommand *)SDL_realloc(raster->commands, (size_t)capacity * sizeof(MyRasterCommand));
+  if (!commands)
+    return false;
+
+  raster->commands = commands;
+  raster->commandCapacity = capacity;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+MyRasterCommand *MySoftwareRasterizer_push(MySoftwareRasterizer *raster, MyRasterCommandType type)
+{
+  if (raster->commandCount == raster->commandCapacity)
+  {
+    // No limite de tamanho, os comandos são desenhados e a lista reaproveitada.
+    if (raster->commandCapacity >= MY_RASTER_MAX_COMMANDS || !MySoftwareRasterizer_grow(raster))
+      MySoftwareRasterizer_flush(raster);
+
+    if (raster->commandCount == raster->commandCapacity)
+    {
+      raster->failed = true;
+      return NULL;
+    }
+  }
+
+  ++raster->stats.primitiveCount;
+
+  MyRasterCommand *command = &raster->commands[raster->commandCount++];
+  command->type = type;
+  command->color = raster->color;
+  return command;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySoftwareRasterizer_begin(MySoftwareRasterizer *raster)
+{
+  SDL_zero(raster->stats);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySoftwareRasterizer_clear(MySoftwareRasterizer *raster, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+  MySoftwareRasterizer_flush(raster);
+
+  ClearJob job = { .raster = raster, .color = pack_color(r, g, b, a) };
+  MyThreadPool_parallel_for(raster->threadPool, raster->tileCount, 1, clear_tiles, &job);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySoftwareRasterizer_set_color(MySoftwareRasterizer *raster, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+  raster->color = pack_color(r, g, b, a);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySoftwareRasterizer_add_point(MySoftwareRasterizer *raster, float x, float y)
+{
+  MyRasterCommand *command = MySoftwareRasterizer_push(raster, MY_RASTER_POINT);
+  if (!command)
+    return;
+
+  command->x0 = command->x1 = to_pixel(x);
+  command->y0 = command->y1 = to_pixel(y);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySoftwareRasterizer_add_points(MySoftwareRasterizer *raster, const SDL_FPoint *points, int count)
+{
+  for (int i = 0; i < count; ++i)
+    MySoftwareRasterizer_add_point(raster, points[i].x, points[i].y);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySoftwareRasterizer_add_colored_points(MySoftwareRasterizer *raster, const float *x, const float *y, const Uint32 *colors, int count)
+{
+  for (int i = 0; i < count; ++i)
+  {
+    MyRasterCommand *command = MySoftwareRasterizer_push(raster, MY_RASTER_POINT);
+    if (!command)
+      return;
+
+    command->color = colors[i];
+    command->x0 = command->x1 = to_pixel(x[i]);
+    command->y0 = command->y1 = to_pixel(y[i]);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySoftwareRasterizer_add_line(MySoftwareRasterizer *raster, float x1, float y1, float x2, float y2)
+{
+  MyRasterCommand *command = MySoftwareRasterizer_push(raster, MY_RASTER_LINE);
+  if (!command)
+    return;
+
+  command->x0 = to_pixel(x1);
+  command->y0 = to_pixel(y1);
+  command->x1 = to_pixel(x2);
+  command->y1 = to_pixel(y2);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySoftwareRasterizer_add_fill_rect(MySoftwareRasterizer *raster, const SDL_FRect *rect)
+{
+  MyRasterCommand *command = MySoftwareRasterizer_push(raster, MY_RASTER_FILL_RECT);
+  if (!command)
+    return;
+
+  command->x0 = to_pixel(rect->x);
+  command->y0 = to_pixel(rect->y);
+  command->x1 = to_pixel(rect->x + rect->w);
+  command->y1 = to_pixel(rect->y + rect->h);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySoftwareRasterizer_add_rect(MySoftwareRasterizer *raster, const SDL_FRect *rect)
+{
+  MyRasterCommand *command = MySoftwareRasterizer_push(raster, MY_RASTER_RECT);
+  if (!command)
+    return;
+
+  command->x0 = to_pixel(rect->x);
+  command->y0 = to_pixel(rect->y);
+  command->x1 = to_pixel(rect->x + rect->w);
+  command->y1 = to_pixel(rect->y + rect->h);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool get_tile_range(const MySoftwareRasterizer *raster, const MyRasterCommand *command, int *firstTile, int *lastTile)
+{
+  int minX, maxX, minY, maxY;
+  if (command->type == MY_RASTER_FILL_RECT || command->type == MY_RASTER_RECT)
+  {
+    minX = command->x0;
+    maxX = command->x1 - 1;
+    minY = command->y0;
+    maxY = command->y1 - 1;
+  }
+  else
+  {
+    minX = SDL_min(command->x0, command->x1);
+    maxX = SDL_max(command->x0, command->x1);
+    minY = SDL_min(command->y0, command->y1);
+    maxY = SDL_max(command->y0, command->y1);
+  }
+
+  if (maxX < 0 || minX >= raster->width || maxY < 0 || minY >= raster->height || minX > maxX || minY > maxY)
+    return false;
+
+  *firstTile = SDL_max(minY, 0) / MY_RASTER_TILE_HEIGHT;
+  *lastTile = SDL_min(maxY, raster->height - 1) / MY_RASTER_TILE_HEIGHT;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MySoftwareRasterizer_flush(MySoftwareRasterizer *raster)
+{
+  bool ok = !raster->failed;
+  raster->failed = false;
+
+  if (raster->commandCount == 0)
+    return ok;
+
+  const Uint64 startNS = SDL_GetTicksNS();
+
+  // Contagem de comandos por faixa (binOffsets[t + 1]) e soma de prefixos.
+  int *offsets = raster->binOffsets;
+  SDL_memset(offsets, 0, ((size_t)raster->tileCount + 1) * sizeof(int));
+
+  for (int i = 0; i < raster->commandCount; ++i)
+  {
+    int firstTile, lastTile;
+    if (get_tile_range(raster, &raster->commands[i], &firstTile, &lastTile))
+    {
+      for (int tile = firstTile; tile <= lastTile; ++tile)
+        ++offsets[tile + 1];
+    }
+  }
+
+  size_t binnedCount = 0;
+  for (int tile = 1; tile <= raster->tileCount; ++tile)
+  {
+    binnedCount += (size_t)offsets[tile];
+    offsets[tile] = (int)binnedCount;
+  }
+
+  if (binnedCount > raster->binCapacity)
+  {
+    MyRasterCommand *binCommands = (MyRasterCommand *)SDL_realloc(raster->binCommands, binnedCount * sizeof(MyRasterCommand));
+    if (!binCommands)
+    {
+      MY_LOG_ERROR("\t*** Erro ao alocar memória para %zu comandos distribuídos.", binnedCount);
+      raster->commandCount = 0;
+      return false;
+    }
+
+    raster->binCommands = binCommands;
+    raster->binCapacity = binnedCount;
+  }
+
+  // Distribuição na ordem de gravação; offsets[t] avança até o início da
+  // faixa t + 1 e é restaurado depois. Cada faixa recebe uma cópia dos seus
+  // comandos: ao desenhar, a thread lê a faixa em sequência, ao invés de
+  // saltar pela lista inteira.
+  for (int i = 0; i < raster->commandCount; ++i)
+  {
+    int firstTile, lastTile;
+    if (get_tile_range(raster, &raster->commands[i], &firstTile, &lastTile))
+    {
+      for (int tile = firstTile; tile <= lastTile; ++tile)
+        raster->binCommands[offsets[tile]++] = raster->commands[i];
+    }
+  }
+
+  for (int tile = raster->tileCount; tile > 0; --tile)
+    offsets[tile] = offsets[tile - 1];
+  offsets[0] = 0;
+
+  MyThreadPool_parallel_for(raster->threadPool, raster->tileCount, 1, raster_tiles, raster);
+
+  raster->stats.binnedCount += binnedCount;
+  raster->stats.rasterNS += SDL_GetTicksNS() - startNS;
+  ++raster->stats.flushCount;
+  raster->commandCount = 0;
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void raster_tiles(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+
+  const MySoftwareRasterizer *raster = (const MySoftwareRasterizer *)userdata;
+
+  for (int tile = begin; tile < end; ++tile)
+  {
+    const int tileY0 = tile * MY_RASTER_TILE_HEIGHT;
+    const int tileY1 = SDL_min(tileY0 + MY_RASTER_TILE_HEIGHT, raster->height);
+
+    for (int i = raster->binOffsets[tile]; i < raster->binOffsets[tile + 1]; ++i)
+    {
+      const MyRasterCommand *command = &raster->binCommands[i];
+      switch (command->type)
+      {
+      case MY_RASTER_POINT:
+        // O binning já descartou pontos fora do framebuffer.
+        raster->pixels[(size_t)command->y0 * raster->width + command->x0] = command->color;
+        break;
+
+      case MY_RASTER_LINE:
+        draw_line(raster, command, tileY0, tileY1);
+        break;
+
+      case MY_RASTER_FILL_RECT:
+        draw_fill_rect(raster, command, tileY0, tileY1);
+        break;
+
+      case MY_RASTER_RECT:
+        draw_rect(raster, command, tileY0, tileY1);
+        break;
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void clear_tiles(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+
+  const ClearJob *job = (const ClearJob *)userdata;
+  const MySoftwareRasterizer *raster = job->raster;
+
+  const int y0 = begin * MY_RASTER_TILE_HEIGHT;
+  const int y1 = SDL_min(end * MY_RASTER_TILE_HEIGHT, raster->height);
+  raster->kernels->fill_u32(raster->pixels + (size_t)y0 * raster->width, job->color, (size_t)(y1 - y0) * raster->width);
+}
+
+//------------------------------------------------------------------------------
+// Pixels [x0, x1) da linha y (y já dentro do framebuffer).
+//------------------------------------------------------------------------------
+void draw_span(const MySoftwareRasterizer *raster, int y, int x0, int x1, Uint32 color)
+{
+  x0 = SDL_max(x0, 0);
+  x1 = SDL_min(x1, raster->width);
+  if (x0 >= x1)
+    return;
+
+  // Spans curtos (a maioria, em cenas com muitas primitivas pequenas) não
+  // compensam a chamada indireta do kernel.
+  Uint32 *row = raster->pixels + (size_t)y * raster->width;
+  if (x1 - x0 < MY_RASTER_MIN_SIMD_SPAN)
+  {
+    for (int x = x0; x < x1; ++x)
+      row[x] = color;
+    return;
+  }
+
+  raster->kernels->fill_u32(row + x0, color, (size_t)(x1 - x0));
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void draw_fill_rect(const MySoftwareRasterizer *raster, const MyRasterCommand *command, int tileY0, int tileY1)
+{
+  const int y0 = SDL_max(command->y0, tileY0);
+  const int y1 = SDL_min(command->y1, tileY1);
+  for (int y = y0; y < y1; ++y)
+    draw_span(raster, y, command->x0, command->x1, command->color);
+}
+
+//------------------------------------------------------------------------------
+// Contorno de 1 pixel dentro do retângulo, como SDL_RenderRect().
+//------------------------------------------------------------------------------
+void draw_rect(const MySoftwareRasterizer *raster, const MyRasterCommand *command, int tileY0, int tileY1)
+{
+  // Retângulos com até 2 pixels de largura/altura não têm "miolo".
+  if (command->x1 - command->x0 <= 2 || command->y1 - command->y0 <= 2)
+  {
+    draw_fill_rect(raster, command, tileY0, tileY1);
+    return;
+  }
+
+  if (command->y0 >= tileY0 && command->y0 < tileY1)
+    draw_span(raster, command->y0, command->x0, command->x1, command->color);
+
+  if (command->y1 - 1 >= tileY0 && command->y1 - 1 < tileY1)
+    draw_span(raster, command->y1 - 1, command->x0, command->x1, command->color);
+
+  const int y0 = SDL_max(command->y0 + 1, tileY0);
+  const int y1 = SDL_min(command->y1 - 1, tileY1);
+  const bool left = command->x0 >= 0 && command->x0 < raster->width;
+  const bool right = command->x1 - 1 >= 0 && command->x1 - 1 < raster->width;
+  for (int y = y0; y < y1; ++y)
+  {
+    Uint32 *row = raster->pixels + (size_t)y * raster->width;
+    if (left)
+      row[command->x0] = command->color;
+    if (right)
+      row[command->x1 - 1] = command->color;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Bresenham, restrito às linhas [tileY0, tileY1) da faixa.
+//
+// Com n passos no eixo principal e d pixels de deslocamento no secundário, o
+// passo k (0..n) desloca m(k) = floor((2kd + n) / 2n) pixels no eixo
+// secundário (k * d / n arredondado). Essa forma fechada dá o ponto de
+// entrada na faixa sem percorrer a linha desde o início; a partir dele, o
+// erro é atualizado incrementalmente, como no algoritmo original.
+//------------------------------------------------------------------------------
+void draw_line(const MySoftwareRasterizer *raster, const MyRasterCommand *command, int tileY0, int tileY1)
+{
+  const int x0 = command->x0;
+  const int y0 = command->y0;
+  const int dx = command->x1 - x0;
+  const int dy = command->y1 - y0;
+  const int adx = SDL_abs(dx);
+  const int ady = SDL_abs(dy);
+  const int sx = dx >= 0 ? 1 : -1;
+  const int sy = dy >= 0 ? 1 : -1;
+
+  // Horizontal (ou um único ponto): um span.
+  if (ady == 0)
+  {
+    if (y0 >= tileY0 && y0 < tileY1)
+      draw_span(raster, y0, SDL_min(x0, command->x1), SDL_max(x0, command->x1) + 1, command->color);
+    return;
+  }
+
+  if (ady >= adx)
+  {
+    // Eixo principal y: o passo k desenha a linha y0 + sy * k.
+    const Sint64 n = ady;
+    int kBegin = sy > 0 ? tileY0 - y0 : y0 - (tileY1 - 1);
+    int kEnd = sy > 0 ? tileY1 - 1 - y0 : y0 - tileY0;
+    kBegin = SDL_max(kBegin, 0);
+    kEnd = SDL_min(kEnd, ady);
+
+    // Divisões só quando a linha começa antes da faixa (caso comum: linhas
+    // curtas, inteiramente dentro de uma faixa).
+    int m = 0;
+    Sint64 error = n;
+    if (kBegin > 0)
+    {
+      const Sint64 numerator = 2 * (Sint64)kBegin * adx + n;
+      m = (int)(numerator / (2 * n));
+      error = numerator % (2 * n);
+    }
+
+    for (int k = kBegin; k <= kEnd; ++k)
+    {
+      const int x = x0 + sx * m;
+      if (x >= 0 && x < raster->width)
+        raster->pixels[(size_t)(y0 + sy * k) * raster->width + x] = command->color;
+
+      error += 2 * adx;
+      if (error >= 2 * n)
+      {
+        error -= 2 * n;
+        ++m;
+      }
+    }
+  }
+  else
+  {
+    // Eixo principal x: os passos cujo deslocamento m(k) cai na faixa.
+    const Sint64 n = adx;
+    int mBegin = sy > 0 ? tileY0 - y0 : y0 - (tileY1 - 1);
+    int mEnd = sy > 0 ? tileY1 - 1 - y0 : y0 - tileY0;
+    mBegin = SDL_max(mBegin, 0);
+    mEnd = SDL_min(mEnd, ady);
+    if (mBegin > mEnd)
+      return;
+
+    // m(k) >= mBegin  <=>  k >= (2n * mBegin - n) / 2d
+    // m(k) <= mEnd    <=>  k <  (2n * (mEnd + 1) - n) / 2d
+    int kBegin = mBegin > 0 ? ceil_div(2 * n * mBegin - n, 2 * (Sint64)ady) : 0;
+    int kEnd = mEnd < ady ? ceil_div(2 * n * (mEnd + 1) - n, 2 * (Sint64)ady) - 1 : adx;
+
+    // Recorte horizontal: x0 + sx * k dentro de [0, width).
+    const int kMinX = sx > 0 ? -x0 : x0 - (raster->width - 1);
+    const int kMaxX = sx > 0 ? raster->width - 1 - x0 : x0;
+    kBegin = SDL_max(SDL_max(kBegin, kMinX), 0);
+    kEnd = SDL_min(SDL_min(kEnd, kMaxX), adx);
+
+    int m = 0;
+    Sint64 error = n;
+    if (kBegin > 0)
+    {
+      const Sint64 numerator = 2 * (Sint64)kBegin * ady + n;
+      m = (int)(numerator / (2 * n));
+      error = numerator % (2 * n);
+    }
+
+    for (int k = kBegin; k <= kEnd; ++k)
+    {
+      raster->pixels[(size_t)(y0 + sy * m) * raster->width + (x0 + sx * k)] = command->color;
+
+      error += 2 * ady;
+      if (error >= 2 * n)
+      {
+        error -= 2 * n;
+        ++m;
+      }
+    }
+  }
+}
@@ -0,0 +1,142 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Rasterizador por software: desenha as mesmas primitivas do lote (batch.h) -
+// pontos, linhas e retângulos preenchidos ou só o contorno - em um
+// framebuffer RGBA32 na memória, sem janela nem GPU.
+//
+// As primitivas são gravadas em uma lista de comandos e desenhadas em
+// MySoftwareRasterizer_flush():
+// 1. cada comando é distribuído (binning) entre as faixas horizontais de
+//    MY_RASTER_TILE_HEIGHT linhas que ele cobre, mantendo a ordem de gravação;
+// 2. as faixas são desenhadas em paralelo (MyThreadPool), uma por vez em cada
+//    thread; cada thread só escreve nas linhas da sua faixa, então não há
+//    sincronização nem diferença no resultado em relação a uma única thread.
+//
+// Linhas usam o algoritmo de Bresenham (extremidades incluídas), com o ponto
+// de entrada de cada faixa calculado diretamente; linhas horizontais e
+// retângulos são preenchidos por spans, os mais longos com o kernel SIMD
+// fill_u32 (kernels.h).
+//
+// Assim como no lote, a lista de comandos tem tamanho máximo
+// (MY_RASTER_MAX_COMMANDS); ao chegar nele, os comandos são desenhados e a
+// lista é reaproveitada.
+//------------------------------------------------------------------------------
+#ifndef MY_RASTER_H
+#define MY_RASTER_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+#include "kernels.h"
+#include "parallel.h"
+
+enum raster_constants
+{
+  MY_RASTER_TILE_HEIGHT = 16,
+  // Spans mais curtos do que isso são preenchidos sem o kernel SIMD.
+  MY_RASTER_MIN_SIMD_SPAN = 16,
+  MY_RASTER_INITIAL_COMMANDS = 1024,
+  MY_RASTER_MAX_COMMANDS = 1 << 20,
+};
+
+typedef enum MyRasterCommandType
+{
+  MY_RASTER_POINT,
+  MY_RASTER_LINE,
+  MY_RASTER_FILL_RECT,
+  MY_RASTER_RECT,
+} MyRasterCommandType;
+
+typedef struct MyRasterCommand MyRasterCommand;
+struct MyRasterCommand
+{
+  MyRasterCommandType type;
+  Uint32 color;
+
+  // Linha: extremidades (x0, y0) e (x1, y1), incluídas.
+  // Retângulo: pixels de [x0, x1) x [y0, y1).
+  int x0;
+  int y0;
+  int x1;
+  int y1;
+};
+
+typedef struct MySoftwareRasterizerStats MySoftwareRasterizerStats;
+struct MySoftwareRasterizerStats
+{
+  Uint64 primitiveCount;
+  Uint64 binnedCount;
+  int flushCount;
+  // Tempo gasto em flush() (distribuição + desenho), inclusive nos envios
+  // automáticos ao atingir MY_RASTER_MAX_COMMANDS.
+  Uint64 rasterNS;
+};
+
+typedef struct MySoftwareRasterizer MySoftwareRasterizer;
+struct MySoftwareRasterizer
+{
+  // Framebuffer RGBA32 (bytes R, G, B, A na memória), sem espaço extra no fim
+  // das linhas (pitch = width * 4).
+  Uint32 *pixels;
+  int width;
+  int height;
+
+  // NULL = desenha tudo na thread que chamou flush().
+  MyThreadPool *threadPool;
+  const MyKernels *kernels;
+
+  MyRasterCommand *commands;
+  int commandCount;
+  int commandCapacity;
+  bool failed;
+
+  // Comandos de cada faixa: binCommands[binOffsets[t]] até
+  // binCommands[binOffsets[t + 1] - 1].
+  int tileCount;
+  int *binOffsets;
+  MyRasterCommand *binCommands;
+  size_t binCapacity;
+
+  Uint32 color;
+
+  MySoftwareRasterizerStats stats;
+};
+
+/**
+ * Cria o framebuffer `width x height`. `threadPool` pode ser NULL.
+ */
+bool MySoftwareRasterizer_initialize(MySoftwareRasterizer *raster, int width, int height, MyThreadPool *threadPool);
+void MySoftwareRasterizer_destroy(MySoftwareRasterizer *raster);
+
+/**
+ * Zera as estatísticas (chamar no início de cada quadro).
+ */
+void MySoftwareRasterizer_begin(MySoftwareRasterizer *raster);
+
+/**
+ * Desenha os comandos pendentes e preenche o framebuffer inteiro com a cor.
+ */
+void MySoftwareRasterizer_clear(MySoftwareRasterizer *raster, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+void MySoftwareRasterizer_set_color(MySoftwareRasterizer *raster, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+void MySoftwareRasterizer_add_point(MySoftwareRasterizer *raster, float x, float y);
+void MySoftwareRasterizer_add_points(MySoftwareRasterizer *raster, const SDL_FPoint *points, int count);
+
+/**
+ * Pontos com cor própria (RGBA32), a partir de arrays separados de
+ * coordenadas e cores. Não altera a cor atual.
+ */
+void MySoftwareRasterizer_add_colored_points(MySoftwareRasterizer *raster, const float *x, const float *y, const Uint32 *colors, int count);
+void MySoftwareRasterizer_add_line(MySoftwareRasterizer *raster, float x1, float y1, float x2, float y2);
+void MySoftwareRasterizer_add_fill_rect(MySoftwareRasterizer *raster, const SDL_FRect *rect);
+void MySoftwareRasterizer_add_rect(MySoftwareRasterizer *raster, const SDL_FRect *rect);
+
+/**
+ * Desenha os comandos pendentes no framebuffer e esvazia a lista. Retorna
+ * false se algum comando foi descartado por falta de memória.
+ */
+bool MySoftwareRasterizer_flush(MySoftwareRasterizer *raster);
+
+#endif // MY_RASTER_H
@@ -7,18 +7,55 @@
 // e exibe o conteúdo na janela ("kodim23.png" pertence ao "Kodak Image Set").
 //
 // Caso a imagem seja maior do que WINDOW_WIDTHxWINDOW_HEIGHT, a janela é
-// redimensionada logo após a imagem ser carregada.
+// redimensionada logo após a imagem ser carregada. Imagens (e quadros da
+// sequência) que não cabem na área útil da tela são reduzidas antes, com o
+// redimensionamento separável de common/resample.h.
 //
 // As teclas '0' e 'R' restauram a imagem original e a exibe na janela.
 // As teclas '1' a '9' aplicam um filtro de média na imagem original e exibem
 // a imagem filtrada na janela (cada tecla corresponde a um tamanho diferente
 // do filtro - veja o código da função loop()).
+// A tecla 'E' aplica a equalização global do histograma da luminância na
+// imagem original, mantendo as cores (veja common/histogram.h).
+// As teclas 'S', 'O' e 'C' mostram as bordas da imagem original (veja
+// common/edges.h): magnitude do gradiente de Sobel, a mesma magnitude colorida
+// pela direção do gradiente e o detector de Canny, respectivamente.
+// A tecla 'H' mostra/esconde o histograma (R, G, B e luminância) da imagem
+// exibida, desenhado sobre o canto inferior esquerdo da janela.
+//
+// Modo sequência: `main --sequence <arquivo.y4m | diretório de PNGs> [fps]`
+// reproduz uma sequência de quadros (veja sequence.h) no lugar da imagem
+// IMAGE_FILENAME. As teclas '0' a '9' escolhem o tamanho do filtro de média,
+// 'E' liga/desliga a equalização e 'S', 'O' e 'C' ligam/desligam a etapa de
+// bordas, aplicados a cada quadro pela thread decodificadora. O título da
+// janela mostra os quadros descartados e a latência do último quadro exibido.
+//
+// Os laços principais usam o agendador de quadros compartilhado
+// (common/frame_scheduler.h): a janela só é redesenhada quando algo muda e,
+// enquanto isso, o programa fica bloqueado à espera de eventos (ou do horário
+// do próximo quadro da sequência). Ao sair, são registradas a latência entre
+// a entrada (teclado/mouse) e a apresentação e a fração de tempo ociosa.
 //
 // Observações:
-// O código não está focado em performance e filtros grandes (ex. 29x29) levam
-// um certo tempo para processar toda a imagem. Para indicar que o programa
-// ainda está filtrando a imagem, o cursor do mouse é alterado para um
-// SDL_SYSTEM_CURSOR_WAIT e volta para o padrão após a filtragem ser concluída.
+// Em imagens grandes, o filtro ainda pode levar um certo tempo para processar
+// toda a imagem. Para indicar que o programa ainda está filtrando a imagem, o
+// cursor do mouse é alterado para um SDL_SYSTEM_CURSOR_WAIT e volta para o
+// padrão após a filtragem ser concluída.
+//
+// A superfície com o resultado do filtro e a memória temporária do filtro não
+// são alocadas a cada execução: a superfície vem de um pool de buffers
+// (MyImagePool) e as somas do filtro usam a arena da thread (MyArena), ambos
+// definidos em image_pool.h/.c. Após a primeira execução de cada tamanho de
+// imagem, nenhuma nova alocação (nem page fault) deveria acontecer.
+//
+// MyWindow, MyImage, load_rgba32(), os pools, o histograma e os filtros fazem
+// parte da biblioteca comum dos exemplos (src/common, libcompvis). O filtro de
+// média usa somas incrementais e os kernels SIMD escolhidos para a CPU na
+// inicialização (kernels.h), dividindo as linhas entre as threads do pool.
+//
+// O histograma é calculado em paralelo (MyThreadPool, parallel.h/.c) apenas
+// quando a imagem exibida muda; o desenho do histograma reaproveita os pontos
+// calculados nessa atualização, então cada quadro só envia as linhas prontas.
 //
 // Em um projeto mais realista, o código abaixo provavelmente seria refatorado.
 // Alguns exemplos de refatoração do projeto:
@@ -39,7 +76,17 @@
 #include <stdbool.h>
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
-#include <SDL3_image/SDL_image.h>
+#include "window.h"
+#include "image.h"
+#include "kernels.h"
+#include "image_pool.h"
+#include "parallel.h"
+#include "histogram.h"
+#include "filters.h"
+#include "edges.h"
+#include "sequence.h"
+#include "frame_scheduler.h"
+#include "log.h"
 
 //------------------------------------------------------------------------------
 // Custom types, structs, constants, etc.
@@ -51,22 +98,16 @@ enum constants
 {
   DEFAULT_WINDOW_WIDTH = 640,
   DEFAULT_WINDOW_HEIGHT = 480,
+  HISTOGRAM_OVERLAY_WIDTH = MY_HISTOGRAM_BINS,
+  HISTOGRAM_OVERLAY_HEIGHT = 100,
+  HISTOGRAM_OVERLAY_MARGIN = 8,
+  WINDOW_TITLE_MAX_LENGTH = 128,
+  TITLE_UPDATE_INTERVAL_MS = 250,
+  SEQUENCE_RETRY_MS = 2,
 };
 
-typedef struct MyWindow MyWindow;
-struct MyWindow
-{
-  SDL_Window *window;
-  SDL_Renderer *renderer;
-};
-
-typedef struct MyImage MyImage;
-struct MyImage
-{
-  SDL_Surface *surface;
-  SDL_Texture *texture;
-  SDL_FRect rect;
-};
+// Tamanhos do filtro de média associados às teclas '0' a '9' (0 = sem filtro).
+static const Uint32 FILTER_SIZES[] = { 0, 3, 5, 7, 11, 15, 29, 41, 73, 101 };
 
 //------------------------------------------------------------------------------
 // Globals (argh!)
@@ -78,7 +119,17 @@ static MyImage g_image = {
   .rect = { .x = 0.0f, .y = 0.0f, .w = 0.0f, .h = 0.0f }
 };
 
-static SDL_Surface *surfaceFilter = NULL;
+static MyImagePool g_pool;
+static MyThreadPool g_threadPool;
+
+static MyHistogram g_histogram;
+static SDL_FPoint g_histogramPoints[MY_HISTOGRAM_CHANNEL_COUNT][MY_HISTOGRAM_BINS];
+static SDL_FRect g_histogramRect = { .x = 0.0f, .y = 0.0f, .w = 0.0f, .h = 0.0f };
+static bool g_showHistogram = false;
+
+static MySequencePlayer g_sequence;
+
+static MyFrameScheduler g_scheduler;
 
 static SDL_Cursor *defaultMouseCursor = NULL;
 static SDL_Cursor *hourglassMouseCursor = NULL;
@@ -86,25 +137,30 @@ static SDL_Cursor *hourglassMouseCursor = NULL;
 //------------------------------------------------------------------------------
 // Function declaration
 //------------------------------------------------------------------------------
-static bool MyWindow_initialize(MyWindow *window, const char *title, int width, int height, SDL_WindowFlags window_flags);
-static void MyWindow_destroy(MyWindow *window);
-static void MyImage_destroy(MyImage *image);
-static bool MyImage_update_texture_with_surface(MyImage* image, SDL_Renderer *renderer, SDL_Surface *surface);
-static bool MyImage_restore_texture(MyImage* image, SDL_Renderer *renderer);
+/**
+ * Aplica um filtro de média na imagem original, salva o resultado em uma
+ * superfície emprestada do pool g_pool e atualiza o conteúdo da janela.
+ */
+static bool MyImage_blur(MyImage* image, SDL_Renderer *renderer, Uint32 filter_size);
 
 /**
- * Carrega a imagem indicada no parâmetro `filename` e a converte para o formato
- * RGBA32, eliminando dependência do formato original da imagem. A imagem
- * carregada é armazenada em output_image.
- * Caso ocorra algum erro no processo, a função retorna false.
+ * Equaliza o histograma da imagem original (veja MyHistogram_equalize()) e
+ * exibe o resultado na janela.
  */
-static bool load_rgba32(const char *filename, SDL_Renderer *renderer, MyImage *output_image);
+static bool MyImage_equalize(MyImage* image, SDL_Renderer *renderer);
 
 /**
- * Aplica um filtro de média na imagem original, salva o resultado na variável
- * global surfaceFilter e atualiza o conteúdo da janela.
+ * Detecta as bordas da imagem original (veja MyEdges_apply()), com os
+ * parâmetros padrão, e exibe o resultado na janela.
  */
-static bool MyImage_blur(MyImage* image, SDL_Renderer *renderer, Uint32 filter_size);
+static bool MyImage_detect_edges(MyImage* image, SDL_Renderer *renderer, MyEdgeMode mode);
+
+/**
+ * Recalcula o histograma da superfície exibida e os pontos usados para
+ * desenhá-lo. Deve ser chamada sempre que o conteúdo exibido mudar.
+ */
+static void update_histogram(SDL_Surface *surface);
+static void render_histogram(void);
 
 static void reset_image(void);
 
@@ -113,310 +169,219 @@ static void shutdown(void);
 static void render(void);
 static void loop(void);
 
-//------------------------------------------------------------------------------
-//
-//------------------------------------------------------------------------------
-bool MyWindow_initialize(MyWindow *window, const char *title, int width, int height, SDL_WindowFlags window_flags)
-{
-  SDL_Log("\tMyWindow_initialize(%s, %d, %d)", title, width, height);
-
-  if (!window)
-  {
-    SDL_Log("\t\t*** Erro: Janela/renderizador inválidos (window == NULL).");
-    return false;
-  }
-
-  return SDL_CreateWindowAndRenderer(title, width, height, window_flags, &window->window, &window->renderer);
-}
-
-//------------------------------------------------------------------------------
-//
-//------------------------------------------------------------------------------
-void MyWindow_destroy(MyWindow *window)
-{
-  SDL_Log(">>> MyWindow_destroy()");
-
-  if (!window)
-  {
-    SDL_Log("\t*** Erro: Janela/renderizador inválidos (window == NULL).");
-    SDL_Log("<<< MyWindow_destroy()");
-    return;
-  }
-
-  SDL_Log("\tDestruindo MyWindow->renderer...");
-  SDL_DestroyRenderer(window->renderer);
-  window->renderer = NULL;
-
-  SDL_Log("\tDestruindo MyWindow->window...");
-  SDL_DestroyWindow(window->window);
-  window->window = NULL;
+/**
+ * Redimensiona a janela para `width x height` caso a imagem seja maior do que
+ * o tamanho padrão, e a reposiciona no canto superior esquerdo da tela.
+ */
+static void resize_window_to_fit(int width, int height);
 
-  SDL_Log("<<< MyWindow_destroy()");
-}
+static void render_sequence(void);
+static void loop_sequence(void);
 
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-void MyImage_destroy(MyImage *image)
-{
-  SDL_Log(">>> MyImage_destroy()");
-
-  if (!image)
-  {
-    SDL_Log("\t*** Erro: Imagem inválida (image == NULL).");
-    SDL_Log("<<< MyImage_destroy()");
-    return;
-  }
-
-  if (image->texture)
-  {
-    SDL_Log("\tDestruindo MyImage->texture...");
-    SDL_DestroyTexture(image->texture);
-    image->texture = NULL;
-  }
-
-  if (image->surface)
-  {
-    SDL_Log("\tDestruindo MyImage->surface...");
-    SDL_DestroySurface(image->surface);
-    image->surface = NULL;
-  }
-
-  SDL_Log("\tRedefinindo MyImage->rect...");
-  image->rect.x = image->rect.y = image->rect.w = image->rect.h = 0.0f;
-
-  SDL_Log("<<< MyImage_destroy()");
-}
-
-//------------------------------------------------------------------------------
-// 
-//------------------------------------------------------------------------------
-bool MyImage_update_texture_with_surface(MyImage* image, SDL_Renderer *renderer, SDL_Surface *surface)
+bool MyImage_blur(MyImage* image, SDL_Renderer *renderer, Uint32 filter_size)
 {
-  SDL_Log(">>> MyImage_update_texture_with_surface()");
+  MY_LOG_TRACE(">>> MyImage_blur(filter_size: %u)", filter_size);
 
-  if (!image)
+  if (!image || !image->surface)
   {
-    SDL_Log("\t*** Erro: Imagem inválida (image == NULL).");
-    SDL_Log("<<< MyImage_update_texture_with_surface()");
+    MY_LOG_ERROR("\t*** Erro: Imagem inválida (image == NULL ou image->surface == NULL).");
+    MY_LOG_TRACE("<<< MyImage_blur(filter_size: %u)", filter_size);
     return false;
   }
 
   if (!renderer)
   {
-    SDL_Log("\t*** Erro: Renderer inválido (renderer == NULL).");
-    SDL_Log("<<< MyImage_update_texture_with_surface()");
+    MY_LOG_ERROR("\t*** Erro: Renderer inválido (renderer == NULL).");
+    MY_LOG_TRACE("<<< MyImage_blur(filter_size: %u)", filter_size);
     return false;
   }
 
-  if (!surface)
+  SDL_Surface *surfaceFilter = MyImagePool_acquire_surface(&g_pool, image->surface->w, image->surface->h, image->surface->format);
+  if (!surfaceFilter)
   {
-    SDL_Log("\t*** Erro: Superfície inválida (surface == NULL).");
-    SDL_Log("<<< MyImage_update_texture_with_surface()");
+    MY_LOG_ERROR("*** Erro: Superfície extra (filter) inválida: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< MyImage_blur(filter_size: %u)", filter_size);
     return false;
   }
 
-  SDL_DestroyTexture(image->texture);
+  MY_LOG_DEBUG("\tExecutando blur com filter_size: %u...", filter_size);
+  SDL_SetCursor(hourglassMouseCursor);
 
-  image->texture = SDL_CreateTextureFromSurface(renderer, surface);
-  if (!image->texture)
+  if (!MyFilter_blur(image->surface, surfaceFilter, filter_size, &g_threadPool))
   {
-    SDL_Log("\t*** Erro ao criar textura: %s", SDL_GetError());
-    SDL_Log("<<< MyImage_update_texture_with_surface()");
+    MyImagePool_release_surface(&g_pool, surfaceFilter);
+    SDL_SetCursor(defaultMouseCursor);
+    MY_LOG_TRACE("<<< MyImage_blur(filter_size: %u)", filter_size);
     return false;
   }
 
-  SDL_Log("\tObtendo dimensões da textura...");
-  SDL_GetTextureSize(image->texture, &image->rect.w, &image->rect.h);
+  // A textura recebe uma cópia dos pixels, então a superfície pode voltar
+  // para o pool logo em seguida.
+  MyImage_update_texture_with_surface(image, renderer, surfaceFilter);
+  update_histogram(surfaceFilter);
+  MyImagePool_release_surface(&g_pool, surfaceFilter);
+  MyFrameScheduler_invalidate(&g_scheduler);
 
-  SDL_Log("<<< MyImage_update_texture_with_surface()");
-  return true;
-}
+  MyImagePool_log_stats(&g_pool);
+  MY_LOG_INFO("\tArena da thread: %llu alocações de bloco.", (unsigned long long)MyArena_get_thread_local()->allocationCount);
 
-//------------------------------------------------------------------------------
-//
-//------------------------------------------------------------------------------
-bool MyImage_restore_texture(MyImage* image, SDL_Renderer *renderer)
-{
-  SDL_Log(">>> MyImage_restore_texture()");
-  
-  if (!MyImage_update_texture_with_surface(image, renderer, image->surface))
-  {
-    SDL_Log("\t*** Erro ao restaurar a textura da imagem.");
-    return false;
-  }
+  MY_LOG_DEBUG("\tBlur com filter_size: %u finalizado...", filter_size);
+  SDL_SetCursor(defaultMouseCursor);
 
-  SDL_Log("<<< MyImage_restore_texture()");
-  return true;  
+  MY_LOG_TRACE("<<< MyImage_blur(filter_size: %u)", filter_size);
+  return true;
 }
 
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-bool load_rgba32(const char *filename, SDL_Renderer *renderer, MyImage *output_image)
+bool MyImage_equalize(MyImage* image, SDL_Renderer *renderer)
 {
-  SDL_Log(">>> load_rgba32(\"%s\")", filename);
-
-  if (!filename)
-  {
-    SDL_Log("\t*** Erro: Nome do arquivo inválido (filename == NULL).");
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
-    return false;
-  }
+  MY_LOG_TRACE(">>> MyImage_equalize()");
 
-  if (!renderer)
+  if (!image || !image->surface)
   {
-    SDL_Log("\t*** Erro: Renderer inválido (renderer == NULL).");
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
+    MY_LOG_ERROR("\t*** Erro: Imagem inválida (image == NULL ou image->surface == NULL).");
+    MY_LOG_TRACE("<<< MyImage_equalize()");
     return false;
   }
 
-  if (!output_image)
+  SDL_Surface *surfaceEqualized = MyImagePool_acquire_surface(&g_pool, image->surface->w, image->surface->h, image->surface->format);
+  if (!surfaceEqualized)
   {
-    SDL_Log("\t*** Erro: Imagem de saída inválida (output_image == NULL).");
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
+    MY_LOG_ERROR("\t*** Erro: Superfície extra (equalize) inválida: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< MyImage_equalize()");
     return false;
   }
 
-  MyImage_destroy(output_image);
-
-  SDL_Log("\tCarregando imagem \"%s\" em uma superfície...", filename);
-  SDL_Surface *surface = IMG_Load(filename);
-  if (!surface)
-  {
-    SDL_Log("\t*** Erro ao carregar a imagem: %s", SDL_GetError());
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
-    return false;
-  }
+  // A equalização parte sempre do histograma da imagem original.
+  MyHistogram original;
+  bool ok = MyHistogram_compute(&original, image->surface, &g_threadPool)
+    && MyHistogram_equalize(&original, image->surface, surfaceEqualized, &g_threadPool);
 
-  SDL_Log("\tConvertendo superfície para formato RGBA32...");
-  output_image->surface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
-  SDL_DestroySurface(surface);
-  if (!output_image->surface)
+  if (ok)
   {
-    SDL_Log("\t*** Erro ao converter superfície para formato RGBA32: %s", SDL_GetError());
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
-    return false;
+    MyImage_update_texture_with_surface(image, renderer, surfaceEqualized);
+    update_histogram(surfaceEqualized);
+    MyFrameScheduler_invalidate(&g_scheduler);
   }
 
-  SDL_Log("\tCriando textura a partir da superfície...");
-  if (!MyImage_update_texture_with_surface(output_image, renderer, output_image->surface))
-  {
-    SDL_Log("\t*** Erro ao criar textura.");
-    SDL_Log("<<< load_rgba32(\"%s\")", filename);
-    return false;
-  }
+  MyImagePool_release_surface(&g_pool, surfaceEqualized);
 
-  SDL_Log("<<< load_rgba32(\"%s\")", filename);
-  return true;
+  MY_LOG_TRACE("<<< MyImage_equalize()");
+  return ok;
 }
 
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-bool MyImage_blur(MyImage* image, SDL_Renderer *renderer, Uint32 filter_size)
+bool MyImage_detect_edges(MyImage* image, SDL_Renderer *renderer, MyEdgeMode mode)
 {
-  SDL_Log(">>> MyImage_blur(filter_size: %u)", filter_size);
+  MY_LOG_TRACE(">>> MyImage_detect_edges(%s)", MyEdges_get_mode_name(mode));
 
   if (!image || !image->surface)
   {
-    SDL_Log("\t*** Erro: Imagem inválida (image == NULL ou image->surface == NULL).");
-    SDL_Log("<<< MyImage_blur(filter_size: %u)", filter_size);
+    MY_LOG_ERROR("\t*** Erro: Imagem inválida (image == NULL ou image->surface == NULL).");
+    MY_LOG_TRACE("<<< MyImage_detect_edges(%s)", MyEdges_get_mode_name(mode));
     return false;
   }
 
-  if (!renderer)
+  SDL_Surface *surfaceEdges = MyImagePool_acquire_surface(&g_pool, image->surface->w, image->surface->h, image->surface->format);
+  if (!surfaceEdges)
   {
-    SDL_Log("\t*** Erro: Renderer inválido (renderer == NULL).");
-    SDL_Log("<<< MyImage_blur(filter_size: %u)", filter_size);
+    MY_LOG_ERROR("\t*** Erro: Superfície extra (edges) inválida: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< MyImage_detect_edges(%s)", MyEdges_get_mode_name(mode));
     return false;
   }
 
-  if (!surfaceFilter)
-  {
-    surfaceFilter = SDL_CreateSurface(g_image.surface->w, g_image.surface->h, g_image.surface->format);
-    if (!surfaceFilter)
-    {
-      SDL_Log("*** Erro: Superfície extra (filter) inválida!");
-      SDL_Log("<<< MyImage_blur(filter_size: %u)", filter_size);
-      return false;
-    }
-  }
-
-  SDL_Log("\tExecutando blur com filter_size: %u...", filter_size);
   SDL_SetCursor(hourglassMouseCursor);
 
-  SDL_LockSurface(image->surface);
-  SDL_LockSurface(surfaceFilter);
+  const MyEdgeParams params = MyEdges_get_default_params();
+  const Uint64 start = SDL_GetPerformanceCounter();
+  const bool ok = MyEdges_apply(image->surface, surfaceEdges, mode, &params, &g_threadPool);
+  const double seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
 
-  const SDL_PixelFormatDetails *format = SDL_GetPixelFormatDetails(image->surface->format);
-  Uint32 *pixels = (Uint32 *)image->surface->pixels;
-  Uint32 *output = (Uint32 *)surfaceFilter->pixels;
-  
-  const int filterFinalSize = filter_size * filter_size;
-  const int filterHalfSize = filter_size >> 1;
-  const float average = 1.0f / filterFinalSize;
-
-  SDL_Color filter[filterFinalSize] = { };
-  SDL_Color filteredPixel = { .r = 0, .g = 0, .b = 0, .a = 255 };
-  Uint32 r = 0;
-  Uint32 g = 0;
-  Uint32 b = 0;
-  Uint32 filterIndex = 0;
-  
-  for (int row = 0; row < image->surface->h; ++row)
+  if (ok)
   {
-    for (int col = 0; col < image->surface->w; ++col)
-    {
-      // Obtém as intensidades de cada pixel que "batem" com o filtro.
-      filterIndex = 0;
-      for (int rowNeighbour = -filterHalfSize; rowNeighbour <= filterHalfSize; ++rowNeighbour)
-      {
-        for (int colNeighbour = -filterHalfSize; colNeighbour <= filterHalfSize; ++colNeighbour)
-        {
-          // Casos em que parte do filtro está fora da imagem. Neste exemplo,
-          // apenas zeramos a intensidade das posições fora da imagem.
-          if ((row + rowNeighbour < 0) || (row + rowNeighbour >= image->surface->h)
-            || (col + colNeighbour < 0) || (col + colNeighbour >= image->surface->w))
-          {
-            filter[filterIndex].r = filter[filterIndex].g = filter[filterIndex].b = 0;
-          }
-          else
-          {
-            SDL_GetRGB(pixels[((row + rowNeighbour) * image->surface->w + (col + colNeighbour))], format, NULL,
-              &filter[filterIndex].r, &filter[filterIndex].g, &filter[filterIndex].b);
-          }
-          ++filterIndex;
-        }
-      }
-    
-      // Calcula a média dos pixels usados na filtragem e salva na saída.
-      r = g = b = 0;
-      for (int i = 0; i < filterFinalSize; ++i)
-      {
-        r += filter[i].r;
-        g += filter[i].g;
-        b += filter[i].b;
-      }
-      filteredPixel.r = (Uint8)(r * average);
-      filteredPixel.g = (Uint8)(g * average);
-      filteredPixel.b = (Uint8)(b * average);
+    MY_LOG_INFO("\tBordas (%s, %d threads): %.3f ms.", MyEdges_get_mode_name(mode),
+      MyThreadPool_get_thread_count(&g_threadPool), seconds * 1000.0);
+    MyImage_update_texture_with_surface(image, renderer, surfaceEdges);
+    update_histogram(surfaceEdges);
+    MyFrameScheduler_invalidate(&g_scheduler);
+  }
 
-      output[row * image->surface->w + col] = SDL_MapRGB(format, NULL, filteredPixel.r, filteredPixel.g, filteredPixel.b);
-    }
-  }  
+  MyImagePool_release_surface(&g_pool, surfaceEdges);
+  SDL_SetCursor(defaultMouseCursor);
 
-  SDL_UnlockSurface(surfaceFilter);
-  SDL_UnlockSurface(image->surface);
+  MY_LOG_TRACE("<<< MyImage_detect_edges(%s)", MyEdges_get_mode_name(mode));
+  return ok;
+}
 
-  MyImage_update_texture_with_surface(image, renderer, surfaceFilter);
-  render();
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void update_histogram(SDL_Surface *surface)
+{
+  const Uint64 start = SDL_GetPerformanceCounter();
+  if (!MyHistogram_compute(&g_histogram, surface, &g_threadPool))
+    return;
+  const Uint64 end = SDL_GetPerformanceCounter();
+
+  const double seconds = (double)(end - start) / SDL_GetPerformanceFrequency();
+  MY_LOG_INFO("\tHistograma (%d threads): %.3f ms, %.1f MP/s.", MyThreadPool_get_thread_count(&g_threadPool),
+    seconds * 1000.0, seconds > 0.0 ? g_histogram.pixelCount / seconds / 1.0e6 : 0.0);
+
+  // Área do histograma no canto inferior esquerdo da janela.
+  int outputWidth = 0;
+  int outputHeight = 0;
+  SDL_GetCurrentRenderOutputSize(g_window.renderer, &outputWidth, &outputHeight);
+  g_histogramRect.x = HISTOGRAM_OVERLAY_MARGIN;
+  g_histogramRect.y = (float)(outputHeight - HISTOGRAM_OVERLAY_HEIGHT - HISTOGRAM_OVERLAY_MARGIN);
+  g_histogramRect.w = HISTOGRAM_OVERLAY_WIDTH;
+  g_histogramRect.h = HISTOGRAM_OVERLAY_HEIGHT;
+
+  // Normaliza cada canal pelo seu maior bin.
+  for (int c = 0; c < MY_HISTOGRAM_CHANNEL_COUNT; ++c)
+  {
+    Uint32 maxCount = 1;
+    for (int i = 0; i < MY_HISTOGRAM_BINS; ++i)
+      maxCount = SDL_max(maxCount, g_histogram.bins[c][i]);
 
-  SDL_Log("\tBlur com filter_size: %u finalizado...", filter_size);
-  SDL_SetCursor(defaultMouseCursor);
+    const float scale = (float)HISTOGRAM_OVERLAY_HEIGHT / maxCount;
+    for (int i = 0; i < MY_HISTOGRAM_BINS; ++i)
+    {
+      g_histogramPoints[c][i].x = g_histogramRect.x + i * (g_histogramRect.w / MY_HISTOGRAM_BINS);
+      g_histogramPoints[c][i].y = g_histogramRect.y + g_histogramRect.h - g_histogram.bins[c][i] * scale;
+    }
+  }
+}
 
-  SDL_Log("<<< MyImage_blur(filter_size: %u)", filter_size);
-  return true;
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void render_histogram(void)
+{
+  static const SDL_Color CHANNEL_COLORS[MY_HISTOGRAM_CHANNEL_COUNT] = {
+    { .r = 255, .g = 64, .b = 64, .a = 255 },
+    { .r = 64, .g = 255, .b = 64, .a = 255 },
+    { .r = 64, .g = 64, .b = 255, .a = 255 },
+    { .r = 255, .g = 255, .b = 255, .a = 255 },
+  };
+
+  SDL_SetRenderDrawBlendMode(g_window.renderer, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(g_window.renderer, 0, 0, 0, 160);
+  SDL_RenderFillRect(g_window.renderer, &g_histogramRect);
+  SDL_SetRenderDrawBlendMode(g_window.renderer, SDL_BLENDMODE_NONE);
+
+  for (int c = 0; c < MY_HISTOGRAM_CHANNEL_COUNT; ++c)
+  {
+    const SDL_Color *color = &CHANNEL_COLORS[c];
+    SDL_SetRenderDrawColor(g_window.renderer, color->r, color->g, color->b, color->a);
+    SDL_RenderLines(g_window.renderer, g_histogramPoints[c], MY_HISTOGRAM_BINS);
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -424,12 +389,13 @@ bool MyImage_blur(MyImage* image, SDL_Renderer *renderer, Uint32 filter_size)
 //------------------------------------------------------------------------------
 void reset_image(void)
 {
-  SDL_Log(">>> reset_image()");
+  MY_LOG_TRACE(">>> reset_image()");
 
   MyImage_restore_texture(&g_image, g_window.renderer);
-  render();
+  update_histogram(g_image.surface);
+  MyFrameScheduler_invalidate(&g_scheduler);
 
-  SDL_Log("<<< reset_image()");
+  MY_LOG_TRACE("<<< reset_image()");
 }
 
 //------------------------------------------------------------------------------
@@ -437,25 +403,29 @@ void reset_image(void)
 //------------------------------------------------------------------------------
 SDL_AppResult initialize(void)
 {
-  SDL_Log(">>> initialize()");
+  MY_LOG_TRACE(">>> initialize()");
 
-  SDL_Log("\tIniciando SDL...");
+  MY_LOG_DEBUG("\tIniciando SDL...");
   if (!SDL_Init(SDL_INIT_VIDEO))
   {
-    SDL_Log("\t*** Erro ao iniciar a SDL: %s", SDL_GetError());
-    SDL_Log("<<< initialize()");
+    MY_LOG_ERROR("\t*** Erro ao iniciar a SDL: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< initialize()");
     return SDL_APP_FAILURE;
   }
 
-  SDL_Log("\tCriando janela e renderizador...");
+  MY_LOG_DEBUG("\tCriando janela e renderizador...");
   if (!MyWindow_initialize(&g_window, WINDOW_TITLE, DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, 0))
   {
-    SDL_Log("\t*** Erro ao criar a janela e/ou renderizador: %s", SDL_GetError());
-    SDL_Log("<<< initialize()");
+    MY_LOG_ERROR("\t*** Erro ao criar a janela e/ou renderizador: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< initialize()");
     return SDL_APP_FAILURE;
   }
 
-  SDL_Log("<<< initialize()");
+  // Escolhe, uma única vez, a versão dos kernels mais rápida para a CPU.
+  MY_LOG_DEBUG("\tSelecionando kernels...");
+  MyKernels_get();
+
+  MY_LOG_TRACE("<<< initialize()");
   return SDL_APP_CONTINUE;
 }
 
@@ -464,25 +434,32 @@ SDL_AppResult initialize(void)
 //------------------------------------------------------------------------------
 void shutdown(void)
 {
-  SDL_Log(">>> shutdown()");
+  MY_LOG_TRACE(">>> shutdown()");
 
-  SDL_Log("Destruindo cursores do mouse...");
+  MY_LOG_INFO("Destruindo cursores do mouse...");
   SDL_DestroyCursor(hourglassMouseCursor);
   SDL_DestroyCursor(defaultMouseCursor);
   defaultMouseCursor = NULL;
   hourglassMouseCursor = NULL;
 
-  SDL_Log("Destruindo superfície extra (filter)...");
-  SDL_DestroySurface(surfaceFilter);
-  surfaceFilter = NULL;
+  if (g_sequence.mutex)
+    MySequencePlayer_close(&g_sequence);
+
+  MY_LOG_INFO("Destruindo pool de threads...");
+  MyThreadPool_destroy(&g_threadPool);
+
+  MY_LOG_INFO("Destruindo pool de superfícies...");
+  MyImagePool_destroy(&g_pool);
 
   MyImage_destroy(&g_image);
   MyWindow_destroy(&g_window);
 
-  SDL_Log("\tEncerrando SDL...");
+  MyLog_shutdown();
+
+  MY_LOG_DEBUG("\tEncerrando SDL...");
   SDL_Quit();
 
-  SDL_Log("<<< shutdown()");
+  MY_LOG_TRACE("<<< shutdown()");
 }
 
 //------------------------------------------------------------------------------
@@ -495,6 +472,9 @@ void render(void)
 
   SDL_RenderTexture(g_window.renderer, g_image.texture, &g_image.rect, &g_image.rect);
 
+  if (g_showHistogram)
+    render_histogram();
+
   SDL_RenderPresent(g_window.renderer);
 }
 
@@ -503,15 +483,18 @@ void render(void)
 //------------------------------------------------------------------------------
 void loop(void)
 {
-  SDL_Log(">>> loop()");
+  MY_LOG_TRACE(">>> loop()");
 
-  render();
+  // Imagem estática: a janela só é redesenhada quando a imagem exibida muda
+  // (ou quando o sistema pede). No restante do tempo, o programa fica
+  // bloqueado à espera de eventos.
+  MyFrameScheduler_initialize(&g_scheduler, 0, false);
 
   SDL_Event event;
   bool isRunning = true;
   while (isRunning)
   {
-    while (SDL_PollEvent(&event))
+    while (isRunning && MyFrameScheduler_wait_event(&g_scheduler, &event))
     {
       switch (event.type)
       {
@@ -535,17 +518,180 @@ void loop(void)
             case SDLK_7: MyImage_blur(&g_image, g_window.renderer, 41); break;
             case SDLK_8: MyImage_blur(&g_image, g_window.renderer, 73); break;
             case SDLK_9: MyImage_blur(&g_image, g_window.renderer, 101); break;
+            case SDLK_E: MyImage_equalize(&g_image, g_window.renderer); break;
+            case SDLK_S: MyImage_detect_edges(&g_image, g_window.renderer, MY_EDGES_GRADIENT); break;
+            case SDLK_O: MyImage_detect_edges(&g_image, g_window.renderer, MY_EDGES_ORIENTATION); break;
+            case SDLK_C: MyImage_detect_edges(&g_image, g_window.renderer, MY_EDGES_CANNY); break;
+            case SDLK_H: g_showHistogram = !g_showHistogram; MyFrameScheduler_invalidate(&g_scheduler); break;
           }
         }
         break;
       }
     }
 
-    // Breve pausa para diminuir o processamento contínuo do programa...
-    SDL_Delay(50);
+    if (isRunning && MyFrameScheduler_begin_frame(&g_scheduler) != MY_FRAME_NONE)
+    {
+      render();
+      MyFrameScheduler_end_frame(&g_scheduler);
+    }
   }
+
+  MyFrameScheduler_log_stats(&g_scheduler);
   
-  SDL_Log("<<< loop()");
+  MY_LOG_TRACE("<<< loop()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void render_sequence(void)
+{
+  SDL_SetRenderDrawColor(g_window.renderer, 128, 128, 128, 255);
+  SDL_RenderClear(g_window.renderer);
+
+  SDL_Texture *texture = MySequencePlayer_get_texture(&g_sequence);
+  if (texture)
+    SDL_RenderTexture(g_window.renderer, texture, NULL, NULL);
+
+  SDL_RenderPresent(g_window.renderer);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void loop_sequence(void)
+{
+  MY_LOG_TRACE(">>> loop_sequence()");
+
+  MyFilterChain chain = { .blurSize = 0, .equalize = false, .edges = MY_EDGES_NONE };
+  char windowTitle[WINDOW_TITLE_MAX_LENGTH] = { 0 };
+  Uint64 lastTitleUpdate = 0;
+  bool failed = false;
+
+  // O ritmo vem da sequência: o agendador acorda no horário do próximo quadro
+  // (MyFrameScheduler_request_wakeup()) ou quando chega um evento.
+  MyFrameScheduler_initialize(&g_scheduler, 0, false);
+
+  SDL_Event event;
+  bool isRunning = true;
+  while (isRunning)
+  {
+    bool chainChanged = false;
+    while (isRunning && MyFrameScheduler_wait_event(&g_scheduler, &event))
+    {
+      switch (event.type)
+      {
+      case SDL_EVENT_QUIT:
+        isRunning = false;
+        break;
+
+      case SDL_EVENT_KEY_DOWN:
+        if (!event.key.repeat)
+        {
+          if (event.key.key >= SDLK_0 && event.key.key <= SDLK_9)
+          {
+            chain.blurSize = FILTER_SIZES[event.key.key - SDLK_0];
+            chainChanged = true;
+          }
+          else if (event.key.key == SDLK_R)
+          {
+            chain.blurSize = 0;
+            chain.equalize = false;
+            chain.edges = MY_EDGES_NONE;
+            chainChanged = true;
+          }
+          else if (event.key.key == SDLK_E)
+          {
+            chain.equalize = !chain.equalize;
+            chainChanged = true;
+          }
+          else if (event.key.key == SDLK_S || event.key.key == SDLK_O || event.key.key == SDLK_C)
+          {
+            const MyEdgeMode mode = (event.key.key == SDLK_S) ? MY_EDGES_GRADIENT
+              : (event.key.key == SDLK_O) ? MY_EDGES_ORIENTATION : MY_EDGES_CANNY;
+            chain.edges = (chain.edges == mode) ? MY_EDGES_NONE : mode;
+            chainChanged = true;
+          }
+        }
+        break;
+      }
+    }
+
+    if (!isRunning)
+      break;
+
+    if (chainChanged)
+      MySequencePlayer_set_filter_chain(&g_sequence, &chain);
+
+    Uint32 reasons = MyFrameScheduler_begin_frame(&g_scheduler);
+    const Uint64 now = SDL_GetTicksNS();
+    if (MySequencePlayer_update(&g_sequence, now))
+      reasons |= MY_FRAME_DIRTY;
+
+    if (reasons & MY_FRAME_DIRTY)
+    {
+      render_sequence();
+      MyFrameScheduler_end_frame(&g_scheduler);
+    }
+
+    // Sem novos quadros, o título avisa na hora (a espera por eventos deixa
+    // de ter prazo).
+    const bool wasFailed = failed;
+    failed = MySequencePlayer_has_failed(&g_sequence);
+
+    if (failed != wasFailed || now - lastTitleUpdate >= SDL_MS_TO_NS(TITLE_UPDATE_INTERVAL_MS))
+    {
+      const MySequenceStats *stats = &g_sequence.stats;
+      SDL_snprintf(windowTitle, WINDOW_TITLE_MAX_LENGTH,
+        "%s - quadro %llu | descartados %llu | latência %.1f ms (filtro %.1f ms) | blur %u%s%s%s%s",
+        WINDOW_TITLE, (unsigned long long)stats->presentedCount, (unsigned long long)stats->droppedCount,
+        stats->latencyMS, stats->processingMS, chain.blurSize, chain.equalize ? " + eq" : "",
+        chain.edges != MY_EDGES_NONE ? " + " : "", chain.edges != MY_EDGES_NONE ? MyEdges_get_mode_name(chain.edges) : "",
+        failed ? " | decodificação interrompida (erros)" : "");
+      SDL_SetWindowTitle(g_window.window, windowTitle);
+      lastTitleUpdate = now;
+    }
+
+    // A reprodução parou: só eventos (ex. fechar a janela) acordam o laço.
+    if (failed)
+      continue;
+
+    // Acorda no horário do próximo quadro. Se o horário já passou (a thread
+    // decodificadora ainda não entregou o quadro), tenta de novo em breve.
+    const Uint64 deadline = MySequencePlayer_get_next_deadline(&g_sequence);
+    const Uint64 after = SDL_GetTicksNS();
+    MyFrameScheduler_request_wakeup(&g_scheduler,
+      deadline > after ? deadline : after + SDL_MS_TO_NS(SEQUENCE_RETRY_MS));
+  }
+
+  MyFrameScheduler_log_stats(&g_scheduler);
+
+  MY_LOG_TRACE("<<< loop_sequence()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void resize_window_to_fit(int width, int height)
+{
+  if (width <= DEFAULT_WINDOW_WIDTH && height <= DEFAULT_WINDOW_HEIGHT)
+    return;
+
+  // Obtém o tamanho da borda da janela. Neste exemplo, só queremos saber
+  // o lado superior e o lado esquerdo, para posicionar a janela corretamente
+  // (posicionar a janela na coordenada (0, 0) faria com que a borda do
+  // programa ficasse fora da região da tela).
+  int top = 0;
+  int left = 0;
+  SDL_GetWindowBordersSize(g_window.window, &top, &left, NULL, NULL);
+
+  MY_LOG_INFO("Redefinindo dimensões da janela, de (%d, %d) para (%d, %d), e alterando a posição para (%d, %d).",
+    DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, width, height, left, top);
+
+  SDL_SetWindowSize(g_window.window, width, height);
+  SDL_SetWindowPosition(g_window.window, left, top);
+
+  SDL_SyncWindow(g_window.window);
 }
 
 //------------------------------------------------------------------------------
@@ -554,43 +700,54 @@ void loop(void)
 int main(int argc, char *argv[])
 {
   atexit(shutdown);
+  MyLog_initialize();
 
   if (initialize() == SDL_APP_FAILURE)
     return SDL_APP_FAILURE;
 
-  if (!load_rgba32(IMAGE_FILENAME, g_window.renderer, &g_image))
+  MY_LOG_INFO("Criando pool de superfícies...");
+  if (!MyImagePool_initialize(&g_pool))
+    return SDL_APP_FAILURE;
+
+  MY_LOG_INFO("Criando pool de threads...");
+  if (!MyThreadPool_initialize(&g_threadPool, 0))
+    return SDL_APP_FAILURE;
+
+  // A janela nunca passa da área útil da tela: imagens maiores são reduzidas.
+  int maxWidth = 0;
+  int maxHeight = 0;
+  MyWindow_get_max_content_size(&g_window, &maxWidth, &maxHeight);
+
+  if (argc >= 3 && SDL_strcmp(argv[1], "--sequence") == 0)
+  {
+    const double fps = (argc >= 4) ? SDL_atof(argv[3]) : 0.0;
+    if (!MySequencePlayer_open(&g_sequence, argv[2], fps, maxWidth, maxHeight, g_window.renderer, &g_pool, &g_threadPool))
+      return SDL_APP_FAILURE;
+
+    resize_window_to_fit(g_sequence.outputWidth, g_sequence.outputHeight);
+    loop_sequence();
+    return 0;
+  }
+
+  if (!load_rgba32_fit(IMAGE_FILENAME, g_window.renderer, maxWidth, maxHeight, &g_threadPool, &g_image))
     return SDL_APP_FAILURE;
 
-  SDL_Log("Criando cursores do mouse...");
+  MY_LOG_INFO("Criando cursores do mouse...");
   defaultMouseCursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_DEFAULT);
   hourglassMouseCursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_WAIT);
   SDL_SetCursor(defaultMouseCursor);
 
-  SDL_Log("Criando superfície extra (filter)...");
-  surfaceFilter = SDL_CreateSurface(g_image.surface->w, g_image.surface->h, g_image.surface->format);
+  // Pré-aquece o pool com um buffer do tamanho da imagem, para que o primeiro
+  // filtro já encontre a memória alocada (e as páginas tocadas).
+  MY_LOG_INFO("Pré-alocando superfície extra (filter) no pool...");
+  MyImagePool_release_surface(&g_pool,
+    MyImagePool_acquire_surface(&g_pool, g_image.surface->w, g_image.surface->h, g_image.surface->format));
 
   // Altera tamanho da janela se a imagem for maior do que o tamanho padrão
   // e reposiciona no canto superior esquerdo da tela.
-  int imageWidth = (int)g_image.rect.w;
-  int imageHeight = (int)g_image.rect.h;
-  if (imageWidth > DEFAULT_WINDOW_WIDTH || imageHeight > DEFAULT_WINDOW_HEIGHT)
-  {
-    // Obtém o tamanho da borda da janela. Neste exemplo, só queremos saber
-    // o lado superior e o lado esquerdo, para posicionar a janela corretamente
-    // (posicionar a janela na coordenada (0, 0) faria com que a borda do
-    // programa ficasse fora da região da tela).
-    int top = 0;
-    int left = 0;
-    SDL_GetWindowBordersSize(g_window.window, &top, &left, NULL, NULL);
+  resize_window_to_fit((int)g_image.rect.w, (int)g_image.rect.h);
 
-    SDL_Log("Redefinindo dimensões da janela, de (%d, %d) para (%d, %d), e alterando a posição para (%d, %d).",
-      DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, imageWidth, imageHeight, left, top);
-
-    SDL_SetWindowSize(g_window.window, imageWidth, imageHeight);
-    SDL_SetWindowPosition(g_window.window, left, top);
-
-    SDL_SyncWindow(g_window.window);
-  }
+  update_histogram(g_image.surface);
 
   loop();
 
@@ -0,0 +1,678 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "sequence.h"
+#include "resample.h"
+#include "log.h"
+#include <SDL3_image/SDL_image.h>
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+enum
+{
+  Y4M_LINE_MAX_LENGTH = 1024,
+  MAX_CONSECUTIVE_DECODE_ERRORS = 8,
+};
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static Uint8 clamp_u8(int value);
+static int compare_filenames(const void *a, const void *b);
+static bool read_line(SDL_IOStream *io, char *line, size_t maxLength);
+static bool MySequencePlayer_open_y4m(MySequencePlayer *player);
+static bool MySequencePlayer_open_png_directory(MySequencePlayer *player);
+static bool MySequencePlayer_decode_y4m(MySequencePlayer *player, SDL_Surface *dst);
+static bool MySequencePlayer_decode_png(MySequencePlayer *player, SDL_Surface *dst);
+static int MySequencePlayer_decode_thread(void *data);
+static double MySequencePlayer_get_period_ns(const MySequencePlayer *player);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+Uint8 clamp_u8(int value)
+{
+  return (Uint8)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+//------------------------------------------------------------------------------
+// Ordenação "natural": trechos numéricos são comparados pelo valor, então
+// "frame_10.png" vem depois de "frame_9.png".
+//------------------------------------------------------------------------------
+int compare_filenames(const void *a, const void *b)
+{
+  const char *s1 = *(const char * const *)a;
+  const char *s2 = *(const char * const *)b;
+
+  while (*s1 && *s2)
+  {
+    if (SDL_isdigit((unsigned char)*s1) && SDL_isdigit((unsigned char)*s2))
+    {
+      char *end1 = NULL;
+      char *end2 = NULL;
+      const long n1 = SDL_strtol(s1, &end1, 10);
+      const long n2 = SDL_strtol(s2, &end2, 10);
+      if (n1 != n2)
+        return n1 < n2 ? -1 : 1;
+
+      s1 = end1;
+      s2 = end2;
+      continue;
+    }
+
+    if (*s1 != *s2)
+      return (unsigned char)*s1 - (unsigned char)*s2;
+
+    ++s1;
+    ++s2;
+  }
+
+  return (unsigned char)*s1 - (unsigned char)*s2;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool read_line(SDL_IOStream *io, char *line, size_t maxLength)
+{
+  size_t length = 0;
+  char c = 0;
+  while (SDL_ReadIO(io, &c, 1) == 1)
+  {
+    if (c == '\n')
+    {
+      line[length] = '\0';
+      return true;
+    }
+
+    if (length + 1 < maxLength)
+      line[length++] = c;
+  }
+
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MySequencePlayer_open_y4m(MySequencePlayer *player)
+{
+  player->y4m = SDL_IOFromFile(player->path, "rb");
+  if (!player->y4m)
+  {
+    MY_LOG_ERROR("\t*** Erro ao abrir \"%s\": %s", player->path, SDL_GetError());
+    return false;
+  }
+
+  char header[Y4M_LINE_MAX_LENGTH];
+  if (!read_line(player->y4m, header, sizeof(header)) || SDL_strncmp(header, "YUV4MPEG2", 9) != 0)
+  {
+    MY_LOG_ERROR("\t*** Erro: \"%s\" não é um arquivo YUV4MPEG2.", player->path);
+    return false;
+  }
+
+  // Parâmetros separados por espaço: W<largura> H<altura> F<num>:<den>
+  // C<croma> (e outros, ignorados).
+  player->y4mChroma = MY_Y4M_CHROMA_420;
+  double fileFps = 0.0;
+  for (char *token = header + 9; *token; )
+  {
+    while (*token == ' ')
+      ++token;
+
+    char *end = token;
+    while (*end && *end != ' ')
+      ++end;
+
+    const char saved = *end;
+    *end = '\0';
+
+    switch (*token)
+    {
+      case 'W': player->width = SDL_atoi(token + 1); break;
+      case 'H': player->height = SDL_atoi(token + 1); break;
+      case 'F':
+      {
+        char *colon = NULL;
+        const long num = SDL_strtol(token + 1, &colon, 10);
+        const long den = (colon && *colon == ':') ? SDL_strtol(colon + 1, NULL, 10) : 1;
+        if (num > 0 && den > 0)
+          fileFps = (double)num / den;
+        break;
+      }
+      case 'C':
+      {
+        // Só 8 bits por amostra: "420p10", "444p16" etc. têm 2 bytes por
+        // amostra e outro tamanho de quadro.
+        const char *depth = SDL_strchr(token + 1, 'p');
+        if (depth && SDL_isdigit((unsigned char)depth[1]))
+        {
+          MY_LOG_ERROR("\t*** Erro: Y4M com mais de 8 bits por amostra não suportado: \"%s\".", token + 1);
+          return false;
+        }
+
+        // As variantes de 4:2:0 só mudam a posição do croma.
+        if (SDL_strcmp(token + 1, "420") == 0 || SDL_strcmp(token + 1, "420jpeg") == 0
+          || SDL_strcmp(token + 1, "420paldv") == 0 || SDL_strcmp(token + 1, "420mpeg2") == 0)
+          player->y4mChroma = MY_Y4M_CHROMA_420;
+        else if (SDL_strcmp(token + 1, "422") == 0)
+          player->y4mChroma = MY_Y4M_CHROMA_422;
+        else if (SDL_strcmp(token + 1, "444") == 0)
+          player->y4mChroma = MY_Y4M_CHROMA_444;
+        else if (SDL_strcmp(token + 1, "mono") == 0)
+          player->y4mChroma = MY_Y4M_CHROMA_MONO;
+        else
+        {
+          MY_LOG_ERROR("\t*** Erro: Formato de croma Y4M não suportado: \"%s\".", token + 1);
+          return false;
+        }
+        break;
+      }
+      case 'X':
+        if (SDL_strcmp(token + 1, "COLORRANGE=FULL") == 0)
+          player->y4mFullRange = true;
+        break;
+    }
+
+    *end = saved;
+    token = end;
+  }
+
+  if (player->width <= 0 || player->height <= 0)
+  {
+    MY_LOG_ERROR("\t*** Erro: Dimensões inválidas no cabeçalho Y4M.");
+    return false;
+  }
+
+  if (player->fps <= 0.0)
+    player->fps = fileFps;
+
+  const size_t lumaSize = (size_t)player->width * player->height;
+  const size_t chromaWidth = (player->y4mChroma == MY_Y4M_CHROMA_444) ? player->width : (player->width + 1) / 2;
+  const size_t chromaHeight = (player->y4mChroma == MY_Y4M_CHROMA_420) ? (player->height + 1) / 2 : player->height;
+  const size_t chromaSize = (player->y4mChroma == MY_Y4M_CHROMA_MONO) ? 0 : chromaWidth * chromaHeight;
+
+  player->y4mFrameSize = lumaSize + 2 * chromaSize;
+  player->y4mBuffer = SDL_malloc(player->y4mFrameSize);
+  player->y4mDataOffset = SDL_TellIO(player->y4m);
+  return player->y4mBuffer != NULL;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MySequencePlayer_open_png_directory(MySequencePlayer *player)
+{
+  player->files = SDL_GlobDirectory(player->path, "*.png", SDL_GLOB_CASEINSENSITIVE, &player->fileCount);
+  if (!player->files || player->fileCount == 0)
+  {
+    MY_LOG_ERROR("\t*** Erro: Nenhum arquivo PNG em \"%s\".", player->path);
+    return false;
+  }
+
+  SDL_qsort(player->files, player->fileCount, sizeof(char *), compare_filenames);
+
+  // O primeiro quadro define as dimensões da sequência.
+  char filename[Y4M_LINE_MAX_LENGTH];
+  SDL_snprintf(filename, sizeof(filename), "%s/%s", player->path, player->files[0]);
+  SDL_Surface *first = IMG_Load(filename);
+  if (!first)
+  {
+    MY_LOG_ERROR("\t*** Erro ao carregar \"%s\": %s", filename, SDL_GetError());
+    return false;
+  }
+
+  player->width = first->w;
+  player->height = first->h;
+  SDL_DestroySurface(first);
+
+  MY_LOG_INFO("\t%d arquivos PNG encontrados (%d x %d).", player->fileCount, player->width, player->height);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MySequencePlayer_decode_y4m(MySequencePlayer *player, SDL_Surface *dst)
+{
+  char line[Y4M_LINE_MAX_LENGTH];
+
+  // Ao final do arquivo, volta para o primeiro quadro (reprodução em loop).
+  if (!read_line(player->y4m, line, sizeof(line)))
+  {
+    SDL_SeekIO(player->y4m, player->y4mDataOffset, SDL_IO_SEEK_SET);
+    if (!read_line(player->y4m, line, sizeof(line)))
+      return false;
+  }
+
+  if (SDL_strncmp(line, "FRAME", 5) != 0
+    || SDL_ReadIO(player->y4m, player->y4mBuffer, player->y4mFrameSize) != player->y4mFrameSize)
+  {
+    MY_LOG_ERROR("\t*** Erro: Quadro Y4M inválido ou incompleto.");
+    SDL_SeekIO(player->y4m, player->y4mDataOffset, SDL_IO_SEEK_SET);
+    return false;
+  }
+
+  const int width = player->width;
+  const int height = player->height;
+  const int chromaWidth = (player->y4mChroma == MY_Y4M_CHROMA_444) ? width : (width + 1) / 2;
+  const int chromaHeight = (player->y4mChroma == MY_Y4M_CHROMA_420) ? (height + 1) / 2 : height;
+  const int chromaShiftX = (player->y4mChroma == MY_Y4M_CHROMA_444) ? 0 : 1;
+  const int chromaShiftY = (player->y4mChroma == MY_Y4M_CHROMA_420) ? 1 : 0;
+  const bool hasChroma = player->y4mChroma != MY_Y4M_CHROMA_MONO;
+
+  const Uint8 *planeY = player->y4mBuffer;
+  const Uint8 *planeU = planeY + (size_t)width * height;
+  const Uint8 *planeV = planeU + (size_t)chromaWidth * chromaHeight;
+
+  // Conversão BT.601 em ponto fixo (8 bits de fração). Faixa limitada
+  // (Y em [16, 235]) é o padrão do Y4M; XCOLORRANGE=FULL usa [0, 255].
+  const int lumaOffset = player->y4mFullRange ? 0 : 16;
+  const int lumaScale = player->y4mFullRange ? 256 : 298;
+  const int rv = player->y4mFullRange ? 359 : 409;
+  const int gu = player->y4mFullRange ? 88 : 100;
+  const int gv = player->y4mFullRange ? 183 : 208;
+  const int bu = player->y4mFullRange ? 454 : 516;
+
+  SDL_LockSurface(dst);
+  for (int row = 0; row < height; ++row)
+  {
+    const Uint8 *y = planeY + (size_t)row * width;
+    const Uint8 *u = planeU + (size_t)(row >> chromaShiftY) * chromaWidth;
+    const Uint8 *v = planeV + (size_t)(row >> chromaShiftY) * chromaWidth;
+    Uint8 *out = (Uint8 *)dst->pixels + (size_t)row * dst->pitch;
+
+    for (int col = 0; col < width; ++col, out += 4)
+    {
+      const int c = lumaScale * (y[col] - lumaOffset) + 128;
+      const int d = hasChroma ? u[col >> chromaShiftX] - 128 : 0;
+      const int e = hasChroma ? v[col >> chromaShiftX] - 128 : 0;
+
+      out[0] = clamp_u8((c + rv * e) >> 8);
+      out[1] = clamp_u8((c - gu * d - gv * e) >> 8);
+      out[2] = clamp_u8((c + bu * d) >> 8);
+      out[3] = 255;
+    }
+  }
+  SDL_UnlockSurface(dst);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MySequencePlayer_decode_png(MySequencePlayer *player, SDL_Surface *dst)
+{
+  const char *file = player->files[player->decodedCount % player->fileCount];
+
+  char filename[Y4M_LINE_MAX_LENGTH];
+  SDL_snprintf(filename, sizeof(filename), "%s/%s", player->path, file);
+
+  SDL_Surface *surface = IMG_Load(filename);
+  if (!surface)
+  {
+    MY_LOG_ERROR("\t*** Erro ao carregar \"%s\": %s", filename, SDL_GetError());
+    return false;
+  }
+
+  bool ok = surface->w == dst->w && surface->h == dst->h;
+  if (!ok)
+  {
+    MY_LOG_ERROR("\t*** Erro: \"%s\" tem dimensões diferentes do primeiro quadro.", filename);
+  }
+  else
+  {
+    // Converte direto para o buffer do pool (sem superfície intermediária).
+    SDL_LockSurface(surface);
+    SDL_LockSurface(dst);
+    ok = SDL_ConvertPixels(surface->w, surface->h, surface->format, surface->pixels, surface->pitch,
+      dst->format, dst->pixels, dst->pitch);
+    SDL_UnlockSurface(dst);
+    SDL_UnlockSurface(surface);
+  }
+
+  SDL_DestroySurface(surface);
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int MySequencePlayer_decode_thread(void *data)
+{
+  MySequencePlayer *player = (MySequencePlayer *)data;
+  int consecutiveErrors = 0;
+
+  for (;;)
+  {
+    SDL_LockMutex(player->mutex);
+    while (!player->quit && player->readyCount == MY_SEQUENCE_QUEUE_SIZE)
+      SDL_WaitCondition(player->slotFree, player->mutex);
+
+    if (player->quit)
+    {
+      SDL_UnlockMutex(player->mutex);
+      break;
+    }
+
+    const MyFilterChain chain = player->chain;
+    MySequenceFrame *frame = &player->frames[player->writeIndex];
+    SDL_UnlockMutex(player->mutex);
+
+    // Cada etapa (decodificação, redução, filtros) grava direto na superfície
+    // do quadro quando é a última.
+    const Uint64 start = SDL_GetTicksNS();
+    const bool direct = MyFilterChain_is_empty(&chain);
+    const bool resize = player->resized != NULL;
+    SDL_Surface *filterInput = resize ? player->resized : player->decoded;
+    SDL_Surface *target = (direct && !resize) ? frame->surface : player->decoded;
+
+    bool ok = (player->kind == MY_SEQUENCE_Y4M)
+      ? MySequencePlayer_decode_y4m(player, target)
+      : MySequencePlayer_decode_png(player, target);
+    if (ok && resize)
+      ok = MyResample_surface(player->decoded, direct ? frame->surface : player->resized, MY_RESAMPLE_BILINEAR, player->threadPool);
+    if (ok && !direct)
+      ok = MyFilterChain_apply(&chain, filterInput, frame->surface, player->threadPool);
+
+    if (!ok)
+    {
+      // Quadros PNG com erro são pulados; erros seguidos encerram a thread.
+      ++player->decodedCount;
+      if (++consecutiveErrors >= MAX_CONSECUTIVE_DECODE_ERRORS)
+      {
+        MY_LOG_ERROR("\t*** Erro: Muitos erros seguidos, encerrando a decodificação.");
+        SDL_LockMutex(player->mutex);
+        player->failed = true;
+        SDL_UnlockMutex(player->mutex);
+        break;
+      }
+      continue;
+    }
+
+    consecutiveErrors = 0;
+    frame->index = player->decodedCount++;
+    frame->decodeStartNS = start;
+    frame->readyNS = SDL_GetTicksNS();
+
+    SDL_LockMutex(player->mutex);
+    player->writeIndex = (player->writeIndex + 1) % MY_SEQUENCE_QUEUE_SIZE;
+    ++player->readyCount;
+    SDL_UnlockMutex(player->mutex);
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MySequencePlayer_open(MySequencePlayer *player, const char *path, double fps, int maxWidth, int maxHeight,
+  SDL_Renderer *renderer, MyImagePool *imagePool, MyThreadPool *threadPool)
+{
+  MY_LOG_TRACE(">>> MySequencePlayer_open(\"%s\")", path);
+
+  if (!player || !path || !renderer || !imagePool)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MySequencePlayer_open(\"%s\")", path);
+    return false;
+  }
+
+  SDL_zerop(player);
+  player->path = SDL_strdup(path);
+  player->fps = fps;
+  player->imagePool = imagePool;
+  player->threadPool = threadPool;
+
+  SDL_PathInfo info;
+  const bool isDirectory = SDL_GetPathInfo(path, &info) && info.type == SDL_PATHTYPE_DIRECTORY;
+  player->kind = isDirectory ? MY_SEQUENCE_PNG_DIRECTORY : MY_SEQUENCE_Y4M;
+
+  const bool opened = isDirectory
+    ? MySequencePlayer_open_png_directory(player)
+    : MySequencePlayer_open_y4m(player);
+  if (!opened)
+  {
+    MySequencePlayer_close(player);
+    MY_LOG_TRACE("<<< MySequencePlayer_open(\"%s\")", path);
+    return false;
+  }
+
+  if (player->fps <= 0.0)
+    player->fps = MY_SEQUENCE_DEFAULT_FPS;
+
+  MY_LOG_INFO("\tSequência %s: %d x %d, %.3f quadros/s.", isDirectory ? "PNG" : "Y4M",
+    player->width, player->height, player->fps);
+
+  MyResample_fit_size(player->width, player->height, maxWidth, maxHeight, &player->outputWidth, &player->outputHeight);
+  const bool resize = player->outputWidth != player->width || player->outputHeight != player->height;
+  if (resize)
+    MY_LOG_INFO("\tQuadros reduzidos para %d x %d.", player->outputWidth, player->outputHeight);
+
+  // Superfícies da fila e superfícies intermediárias vêm do pool.
+  player->decoded = MyImagePool_acquire_surface(imagePool, player->width, player->height, SDL_PIXELFORMAT_RGBA32);
+  bool ok = player->decoded != NULL;
+  if (ok && resize)
+  {
+    player->resized = MyImagePool_acquire_surface(imagePool, player->outputWidth, player->outputHeight, SDL_PIXELFORMAT_RGBA32);
+    ok = player->resized != NULL;
+  }
+
+  for (int i = 0; i < MY_SEQUENCE_QUEUE_SIZE && ok; ++i)
+  {
+    player->frames[i].surface = MyImagePool_acquire_surface(imagePool, player->outputWidth, player->outputHeight,
+      SDL_PIXELFORMAT_RGBA32);
+    ok = player->frames[i].surface != NULL;
+  }
+
+  for (int i = 0; i < MY_SEQUENCE_TEXTURE_COUNT && ok; ++i)
+  {
+    player->textures[i] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING,
+      player->outputWidth, player->outputHeight);
+    ok = player->textures[i] != NULL;
+  }
+
+  player->mutex = SDL_CreateMutex();
+  player->slotFree = SDL_CreateCondition();
+  ok = ok && player->mutex && player->slotFree;
+
+  if (ok)
+  {
+    player->thread = SDL_CreateThread(MySequencePlayer_decode_thread, "MySequenceDecoder", player);
+    ok = player->thread != NULL;
+  }
+
+  if (!ok)
+  {
+    MY_LOG_ERROR("\t*** Erro ao criar recursos da sequência: %s", SDL_GetError());
+    MySequencePlayer_close(player);
+    MY_LOG_TRACE("<<< MySequencePlayer_open(\"%s\")", path);
+    return false;
+  }
+
+  MY_LOG_TRACE("<<< MySequencePlayer_open(\"%s\")", path);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySequencePlayer_close(MySequencePlayer *player)
+{
+  MY_LOG_TRACE(">>> MySequencePlayer_close()");
+
+  if (!player)
+  {
+    MY_LOG_ERROR("\t*** Erro: Sequência inválida (player == NULL).");
+    MY_LOG_TRACE("<<< MySequencePlayer_close()");
+    return;
+  }
+
+  if (player->thread)
+  {
+    SDL_LockMutex(player->mutex);
+    player->quit = true;
+    SDL_BroadcastCondition(player->slotFree);
+    SDL_UnlockMutex(player->mutex);
+
+    SDL_WaitThread(player->thread, NULL);
+  }
+
+  MY_LOG_INFO("\tQuadros exibidos: %llu, descartados: %llu.",
+    (unsigned long long)player->stats.presentedCount, (unsigned long long)player->stats.droppedCount);
+
+  for (int i = 0; i < MY_SEQUENCE_TEXTURE_COUNT; ++i)
+    SDL_DestroyTexture(player->textures[i]);
+
+  for (int i = 0; i < MY_SEQUENCE_QUEUE_SIZE; ++i)
+    MyImagePool_release_surface(player->imagePool, player->frames[i].surface);
+  MyImagePool_release_surface(player->imagePool, player->resized);
+  MyImagePool_release_surface(player->imagePool, player->decoded);
+
+  SDL_DestroyCondition(player->slotFree);
+  SDL_DestroyMutex(player->mutex);
+
+  if (player->y4m)
+    SDL_CloseIO(player->y4m);
+
+  SDL_free(player->y4mBuffer);
+  SDL_free(player->files);
+  SDL_free(player->path);
+  SDL_zerop(player);
+
+  MY_LOG_TRACE("<<< MySequencePlayer_close()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MySequencePlayer_set_filter_chain(MySequencePlayer *player, const MyFilterChain *chain)
+{
+  if (!player || !player->mutex || !chain)
+    return;
+
+  SDL_LockMutex(player->mutex);
+  player->chain = *chain;
+  SDL_UnlockMutex(player->mutex);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+double MySequencePlayer_get_period_ns(const MySequencePlayer *player)
+{
+  return (double)SDL_NS_PER_SECOND / player->fps;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+Uint64 MySequencePlayer_get_next_deadline(const MySequencePlayer *player)
+{
+  // Antes do primeiro quadro, verifica a fila novamente em 1 ms.
+  if (!player || player->startNS == 0)
+    return SDL_GetTicksNS() + SDL_NS_PER_MS;
+
+  return player->startNS + (Uint64)(player->presentIndex * MySequencePlayer_get_period_ns(player));
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MySequencePlayer_update(MySequencePlayer *player, Uint64 nowNS)
+{
+  if (!player || !player->mutex)
+    return false;
+
+  const double periodNS = MySequencePlayer_get_period_ns(player);
+  MySequenceFrame *frame = NULL;
+  Uint64 dueNS = 0;
+
+  SDL_LockMutex(player->mutex);
+
+  // O relógio da sequência começa quando o primeiro quadro fica pronto.
+  if (player->startNS == 0 && player->readyCount > 0)
+    player->startNS = nowNS;
+
+  while (player->startNS != 0 && player->readyCount > 0)
+  {
+    dueNS = player->startNS + (Uint64)(player->presentIndex * periodNS);
+    if (nowNS < dueNS)
+      break;
+
+    // Atrasado e já existe um quadro mais novo pronto: descarta este.
+    if (player->readyCount > 1 && nowNS >= dueNS + periodNS)
+    {
+      player->readIndex = (player->readIndex + 1) % MY_SEQUENCE_QUEUE_SIZE;
+      --player->readyCount;
+      ++player->presentIndex;
+      ++player->stats.droppedCount;
+      SDL_SignalCondition(player->slotFree);
+      continue;
+    }
+
+    frame = &player->frames[player->readIndex];
+    break;
+  }
+
+  SDL_UnlockMutex(player->mutex);
+
+  if (!frame)
+    return false;
+
+  // O quadro chegou depois do seu horário (fila estava vazia): os horários
+  // de exibição que passaram sem quadro novo contam como descartados.
+  const Uint64 missed = (Uint64)((nowNS - dueNS) / periodNS);
+  player->presentIndex += missed;
+  player->stats.droppedCount += missed;
+
+  // Envia para a textura de trás, que passa a ser a da frente.
+  const int back = (player->frontTexture + 1) % MY_SEQUENCE_TEXTURE_COUNT;
+  SDL_UpdateTexture(player->textures[back], NULL, frame->surface->pixels, frame->surface->pitch);
+  player->frontTexture = back;
+
+  player->stats.latencyMS = (double)(nowNS - frame->decodeStartNS) / SDL_NS_PER_MS;
+  player->stats.processingMS = (double)(frame->readyNS - frame->decodeStartNS) / SDL_NS_PER_MS;
+  ++player->stats.presentedCount;
+
+  SDL_LockMutex(player->mutex);
+  player->readIndex = (player->readIndex + 1) % MY_SEQUENCE_QUEUE_SIZE;
+  --player->readyCount;
+  ++player->presentIndex;
+  SDL_SignalCondition(player->slotFree);
+  SDL_UnlockMutex(player->mutex);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+SDL_Texture *MySequencePlayer_get_texture(const MySequencePlayer *player)
+{
+  if (!player || player->stats.presentedCount == 0)
+    return NULL;
+
+  return player->textures[player->frontTexture];
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MySequencePlayer_has_failed(const MySequencePlayer *player)
+{
+  if (!player || !player->mutex)
+    return false;
+
+  SDL_LockMutex(player->mutex);
+  const bool failed = player->failed && player->readyCount == 0;
+  SDL_UnlockMutex(player->mutex);
+
+  return failed;
+}
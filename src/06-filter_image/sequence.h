@@ -0,0 +1,157 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Reprodutor de sequências de imagens (modo sequência do 06-filter_image).
+//
+// Fontes aceitas:
+// - Arquivo YUV4MPEG2 (.y4m) de 8 bits por amostra, com croma 4:2:0, 4:2:2,
+//   4:4:4 ou mono;
+// - Diretório com arquivos PNG numerados (ex. frame_0001.png, ...), ordenados
+//   pelo número no nome do arquivo.
+//
+// Uma thread decodificadora lê os quadros à frente da exibição, reduz quadros
+// maiores do que o tamanho máximo de saída (MyResample_surface, bilinear),
+// aplica a cadeia de filtros atual (MyFilterChain) e deixa o resultado em uma
+// fila circular de MY_SEQUENCE_QUEUE_SIZE superfícies (vindas do MyImagePool).
+// A thread principal consome a fila no ritmo da taxa de quadros da fonte e
+// envia cada quadro para uma de duas texturas streaming, alternadamente
+// (double buffering): enquanto uma textura é exibida, a outra recebe o
+// próximo quadro.
+//
+// Um quadro é contado como descartado (dropped) quando o seu horário de
+// exibição passa sem que ele seja exibido (decodificação/filtro atrasados).
+// A latência de cada quadro vai do início da decodificação até a exibição.
+//------------------------------------------------------------------------------
+#ifndef MY_SEQUENCE_H
+#define MY_SEQUENCE_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+#include "image_pool.h"
+#include "parallel.h"
+#include "filters.h"
+
+enum sequence_constants
+{
+  MY_SEQUENCE_QUEUE_SIZE = 4,
+  MY_SEQUENCE_TEXTURE_COUNT = 2,
+  MY_SEQUENCE_DEFAULT_FPS = 30,
+};
+
+typedef enum MySequenceKind
+{
+  MY_SEQUENCE_Y4M,
+  MY_SEQUENCE_PNG_DIRECTORY,
+} MySequenceKind;
+
+typedef enum MyY4MChroma
+{
+  MY_Y4M_CHROMA_420,
+  MY_Y4M_CHROMA_422,
+  MY_Y4M_CHROMA_444,
+  MY_Y4M_CHROMA_MONO,
+} MyY4MChroma;
+
+typedef struct MySequenceFrame MySequenceFrame;
+struct MySequenceFrame
+{
+  SDL_Surface *surface;
+  Uint64 index;
+  Uint64 decodeStartNS;
+  Uint64 readyNS;
+};
+
+typedef struct MySequenceStats MySequenceStats;
+struct MySequenceStats
+{
+  Uint64 presentedCount;
+  Uint64 droppedCount;
+  double latencyMS;
+  double processingMS;
+};
+
+typedef struct MySequencePlayer MySequencePlayer;
+struct MySequencePlayer
+{
+  // Fonte.
+  MySequenceKind kind;
+  char *path;
+  SDL_IOStream *y4m;
+  Sint64 y4mDataOffset;
+  MyY4MChroma y4mChroma;
+  bool y4mFullRange;
+  Uint8 *y4mBuffer;
+  size_t y4mFrameSize;
+  char **files;
+  int fileCount;
+  int width;
+  int height;
+  int outputWidth;
+  int outputHeight;
+  double fps;
+  Uint64 decodedCount;
+
+  // Fila de quadros decodificados/filtrados (produtor: thread decodificadora;
+  // consumidor: thread principal).
+  MyImagePool *imagePool;
+  MyThreadPool *threadPool;
+  SDL_Thread *thread;
+  SDL_Mutex *mutex;
+  SDL_Condition *slotFree;
+  bool quit;
+  bool failed;              // A thread decodificadora parou por erros seguidos.
+  SDL_Surface *decoded;
+  SDL_Surface *resized;
+  MySequenceFrame frames[MY_SEQUENCE_QUEUE_SIZE];
+  int readIndex;
+  int writeIndex;
+  int readyCount;
+  MyFilterChain chain;
+
+  // Exibição.
+  SDL_Texture *textures[MY_SEQUENCE_TEXTURE_COUNT];
+  int frontTexture;
+  Uint64 startNS;
+  Uint64 presentIndex;
+  MySequenceStats stats;
+};
+
+/**
+ * Abre a sequência em `path` (arquivo .y4m ou diretório de PNGs), cria as
+ * texturas streaming em `renderer` e inicia a thread decodificadora. Se
+ * `fps <= 0`, usa a taxa do arquivo Y4M ou MY_SEQUENCE_DEFAULT_FPS. Quadros
+ * maiores do que `maxWidth x maxHeight` são reduzidos (mantendo a proporção)
+ * para MySequencePlayer->outputWidth x MySequencePlayer->outputHeight.
+ */
+bool MySequencePlayer_open(MySequencePlayer *player, const char *path, double fps, int maxWidth, int maxHeight,
+  SDL_Renderer *renderer, MyImagePool *imagePool, MyThreadPool *threadPool);
+void MySequencePlayer_close(MySequencePlayer *player);
+
+/**
+ * Troca a cadeia de filtros. Quadros já presentes na fila mantêm a cadeia com
+ * que foram processados.
+ */
+void MySequencePlayer_set_filter_chain(MySequencePlayer *player, const MyFilterChain *chain);
+
+/**
+ * Verifica se há um quadro a exibir no instante `nowNS` (SDL_GetTicksNS()) e,
+ * se houver, envia-o para a textura de trás e a torna a textura da frente.
+ * Retorna true se a textura da frente mudou.
+ */
+bool MySequencePlayer_update(MySequencePlayer *player, Uint64 nowNS);
+
+/**
+ * Instante (SDL_GetTicksNS()) em que o próximo quadro deve ser exibido.
+ */
+Uint64 MySequencePlayer_get_next_deadline(const MySequencePlayer *player);
+
+SDL_Texture *MySequencePlayer_get_texture(const MySequencePlayer *player);
+
+/**
+ * Retorna true se a decodificação parou por erros seguidos e os quadros que
+ * já estavam na fila foram exibidos: não haverá mais quadros.
+ */
+bool MySequencePlayer_has_failed(const MySequencePlayer *player);
+
+#endif // MY_SEQUENCE_H
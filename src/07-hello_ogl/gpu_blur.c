@@ -0,0 +1,243 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "gpu_blur.h"
+#include "shader.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Vertex shader code: um triângulo que cobre o viewport inteiro.
+//------------------------------------------------------------------------------
+static const char *FULLSCREEN_VERTEX_SHADER_CODE =
+  "#version 330 core\n"
+  "void main() {\n"
+  "  vec2 pos = vec2(float((gl_VertexID & 1) << 2), float((gl_VertexID & 2) << 1)) - 1.0;\n"
+  "  gl_Position = vec4(pos, 0.0, 1.0);\n"
+  "}\0";
+
+//------------------------------------------------------------------------------
+// Fragment shader code: passe horizontal (somas, em 0..255 por canal).
+// gl_FragCoord está no centro do texel, então a amostragem com GL_NEAREST lê
+// exatamente o texel vizinho.
+//------------------------------------------------------------------------------
+static const char *HORIZONTAL_FRAGMENT_SHADER_CODE =
+  "#version 330 core\n"
+  "uniform sampler2D u_Image;\n"
+  "uniform int u_Radius;\n"
+  "out vec4 f_Sum;\n"
+  "void main() {\n"
+  "  vec2 size = vec2(textureSize(u_Image, 0));\n"
+  "  vec4 sum = vec4(0.0);\n"
+  "  for (int i = -u_Radius; i <= u_Radius; ++i)\n"
+  "    sum += round(texture(u_Image, (gl_FragCoord.xy + vec2(float(i), 0.0)) / size) * 255.0);\n"
+  "  f_Sum = sum;\n"
+  "}\0";
+
+//------------------------------------------------------------------------------
+// Fragment shader code: passe vertical (soma das somas, média truncada).
+//------------------------------------------------------------------------------
+static const char *VERTICAL_FRAGMENT_SHADER_CODE =
+  "#version 330 core\n"
+  "uniform sampler2D u_Sums;\n"
+  "uniform int u_Radius;\n"
+  "uniform float u_Scale;\n"
+  "out vec4 f_Color;\n"
+  "void main() {\n"
+  "  vec2 size = vec2(textureSize(u_Sums, 0));\n"
+  "  vec4 sum = vec4(0.0);\n"
+  "  for (int i = -u_Radius; i <= u_Radius; ++i)\n"
+  "    sum += texture(u_Sums, (gl_FragCoord.xy + vec2(0.0, float(i))) / size);\n"
+  "  f_Color = vec4(floor(sum.rgb * u_Scale) / 255.0, 1.0);\n"
+  "}\0";
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static void create_texture(GLuint texture, GLint internalFormat, int width, int height, GLenum type);
+
+//------------------------------------------------------------------------------
+// GL_NEAREST (sem interpolação) e borda zero em todas as direções.
+//------------------------------------------------------------------------------
+void create_texture(GLuint texture, GLint internalFormat, int width, int height, GLenum type)
+{
+  static const GLfloat BORDER_COLOR[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+  glBindTexture(GL_TEXTURE_2D, texture);
+  glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, GL_RGBA, type, NULL);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+  glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, BORDER_COLOR);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyGpuBlur_initialize(MyGpuBlur *blur, int width, int height)
+{
+  MY_LOG_TRACE(">>> MyGpuBlur_initialize(%d, %d)", width, height);
+
+  if (!blur || width <= 0 || height <= 0)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyGpuBlur_initialize()");
+    return false;
+  }
+
+  SDL_zerop(blur);
+  blur->width = width;
+  blur->height = height;
+
+  blur->horizontalProgram = MyShader_create_program("blur (horizontal)", FULLSCREEN_VERTEX_SHADER_CODE, HORIZONTAL_FRAGMENT_SHADER_CODE);
+  blur->verticalProgram = MyShader_create_program("blur (vertical)", FULLSCREEN_VERTEX_SHADER_CODE, VERTICAL_FRAGMENT_SHADER_CODE);
+  if (!blur->horizontalProgram || !blur->verticalProgram)
+  {
+    MyGpuBlur_destroy(blur);
+    MY_LOG_TRACE("<<< MyGpuBlur_initialize()");
+    return false;
+  }
+
+  blur->horizontalRadius = glGetUniformLocation(blur->horizontalProgram, "u_Radius");
+  blur->verticalRadius = glGetUniformLocation(blur->verticalProgram, "u_Radius");
+  blur->verticalScale = glGetUniformLocation(blur->verticalProgram, "u_Scale");
+
+  // Os dois programas leem da unidade de textura 0.
+  glUseProgram(blur->horizontalProgram);
+  glUniform1i(glGetUniformLocation(blur->horizontalProgram, "u_Image"), 0);
+  glUseProgram(blur->verticalProgram);
+  glUniform1i(glGetUniformLocation(blur->verticalProgram, "u_Sums"), 0);
+  glUseProgram(0);
+
+  glGenVertexArrays(1, &blur->vao);
+  glGenTextures(3, blur->textures);
+  glGenFramebuffers(2, blur->framebuffers);
+
+  create_texture(blur->textures[0], GL_RGBA8, width, height, GL_UNSIGNED_BYTE);
+  create_texture(blur->textures[1], GL_RGBA32F, width, height, GL_FLOAT);
+  create_texture(blur->textures[2], GL_RGBA8, width, height, GL_UNSIGNED_BYTE);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  bool complete = true;
+  for (int i = 0; i < 2; ++i)
+  {
+    glBindFramebuffer(GL_FRAMEBUFFER, blur->framebuffers[i]);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, blur->textures[i + 1], 0);
+    complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  }
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  if (!complete || glGetError() != GL_NO_ERROR)
+  {
+    MY_LOG_ERROR("\t*** Erro ao criar texturas e framebuffers %dx%d.", width, height);
+    MyGpuBlur_destroy(blur);
+    MY_LOG_TRACE("<<< MyGpuBlur_initialize()");
+    return false;
+  }
+
+  MY_LOG_TRACE("<<< MyGpuBlur_initialize()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyGpuBlur_destroy(MyGpuBlur *blur)
+{
+  MY_LOG_TRACE(">>> MyGpuBlur_destroy()");
+
+  if (!blur)
+  {
+    MY_LOG_ERROR("\t*** Erro: Blur inválido (blur == NULL).");
+    MY_LOG_TRACE("<<< MyGpuBlur_destroy()");
+    return;
+  }
+
+  glDeleteProgram(blur->horizontalProgram);
+  glDeleteProgram(blur->verticalProgram);
+  glDeleteVertexArrays(1, &blur->vao);
+  glDeleteTextures(3, blur->textures);
+  glDeleteFramebuffers(2, blur->framebuffers);
+  SDL_zerop(blur);
+
+  MY_LOG_TRACE("<<< MyGpuBlur_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyGpuBlur_upload(MyGpuBlur *blur, SDL_Surface *surface)
+{
+  if (!surface || surface->format != SDL_PIXELFORMAT_RGBA32 || surface->w != blur->width || surface->h != blur->height)
+  {
+    MY_LOG_ERROR("\t*** Erro: Superfície inválida para o blur na GPU.");
+    return false;
+  }
+
+  SDL_LockSurface(surface);
+  glBindTexture(GL_TEXTURE_2D, blur->textures[0]);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, surface->pitch / 4);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, blur->width, blur->height, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  SDL_UnlockSurface(surface);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyGpuBlur_apply(MyGpuBlur *blur, Uint32 filter_size)
+{
+  const GLint radius = (GLint)(filter_size >> 1);
+  // Mesma expressão de MyFilter_blur(), para o mesmo float.
+  const float scale = 1.0f / (filter_size * filter_size);
+
+  glViewport(0, 0, blur->width, blur->height);
+  glBindVertexArray(blur->vao);
+  glActiveTexture(GL_TEXTURE0);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, blur->framebuffers[0]);
+  glUseProgram(blur->horizontalProgram);
+  glUniform1i(blur->horizontalRadius, radius);
+  glBindTexture(GL_TEXTURE_2D, blur->textures[0]);
+  glDrawArrays(GL_TRIANGLES, 0, 3);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, blur->framebuffers[1]);
+  glUseProgram(blur->verticalProgram);
+  glUniform1i(blur->verticalRadius, radius);
+  glUniform1f(blur->verticalScale, scale);
+  glBindTexture(GL_TEXTURE_2D, blur->textures[1]);
+  glDrawArrays(GL_TRIANGLES, 0, 3);
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyGpuBlur_read(MyGpuBlur *blur, SDL_Surface *surface)
+{
+  if (!surface || surface->format != SDL_PIXELFORMAT_RGBA32 || surface->w != blur->width || surface->h != blur->height)
+  {
+    MY_LOG_ERROR("\t*** Erro: Superfície inválida para o blur na GPU.");
+    return false;
+  }
+
+  SDL_LockSurface(surface);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, blur->framebuffers[1]);
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  glPixelStorei(GL_PACK_ROW_LENGTH, surface->pitch / 4);
+  glReadPixels(0, 0, blur->width, blur->height, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
+  glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+  SDL_UnlockSurface(surface);
+
+  return glGetError() == GL_NO_ERROR;
+}
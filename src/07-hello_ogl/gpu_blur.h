@@ -0,0 +1,74 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Filtro de média (blur) na GPU, com o mesmo resultado de MyFilter_blur()
+// (filters.h) da biblioteca comum.
+//
+// O filtro `size x size` é separável: a média da janela é a soma das somas
+// horizontais de cada linha da janela, dividida por `size * size`. Por isso
+// são dois passes de fragment shader, cada um desenhando um triângulo que
+// cobre um framebuffer (FBO) inteiro:
+// 1. horizontal: imagem RGBA8 -> FBO com textura RGBA32F, que guarda as
+//    somas (inteiros exatos em float, sem arredondar para 8 bits);
+// 2. vertical: somas -> FBO com textura RGBA8, já com a divisão.
+//
+// Para reproduzir a CPU bit a bit:
+// - as texturas usam GL_CLAMP_TO_BORDER com borda preta e transparente, então
+//   posições fora da imagem valem zero, como em MyFilter_blur();
+// - o raio é `size / 2` e a escala é `1.0f / (size * size)`, calculada na CPU
+//   com a mesma expressão, e o resultado é truncado (floor);
+// - o alpha da saída é 255.
+// As somas são exatas em float enquanto não passam de 2^24, o que vale para
+// `size` até 255; acima disso, os resultados podem diferir em 1.
+//
+// Só precisa de OpenGL 3.3 (funciona com o llvmpipe do Mesa, sem GPU).
+//------------------------------------------------------------------------------
+#ifndef MY_GPU_BLUR_H
+#define MY_GPU_BLUR_H
+
+#include <stdbool.h>
+#include <GL/glew.h>
+#include <SDL3/SDL.h>
+
+typedef struct MyGpuBlur MyGpuBlur;
+struct MyGpuBlur
+{
+  int width;
+  int height;
+
+  GLuint horizontalProgram;
+  GLuint verticalProgram;
+  GLint horizontalRadius;
+  GLint verticalRadius;
+  GLint verticalScale;
+
+  // Um VAO vazio: os vértices do triângulo vêm de gl_VertexID.
+  GLuint vao;
+
+  // [0] = imagem original, [1] = somas horizontais, [2] = resultado.
+  GLuint textures[3];
+  // [0] = passe horizontal (textures[1]), [1] = passe vertical (textures[2]).
+  GLuint framebuffers[2];
+};
+
+bool MyGpuBlur_initialize(MyGpuBlur *blur, int width, int height);
+void MyGpuBlur_destroy(MyGpuBlur *blur);
+
+/**
+ * Envia uma superfície RGBA32 com as dimensões de initialize().
+ */
+bool MyGpuBlur_upload(MyGpuBlur *blur, SDL_Surface *surface);
+
+/**
+ * Executa os dois passes. Altera o viewport, o FBO e o programa atuais.
+ */
+void MyGpuBlur_apply(MyGpuBlur *blur, Uint32 filter_size);
+
+/**
+ * Lê o resultado para uma superfície RGBA32 com as mesmas dimensões (espera a
+ * GPU terminar).
+ */
+bool MyGpuBlur_read(MyGpuBlur *blur, SDL_Surface *surface);
+
+#endif // MY_GPU_BLUR_H
@@ -0,0 +1,121 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "gpu_timer.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyGpuTimer_initialize(MyGpuTimer *timer)
+{
+  MY_LOG_TRACE("\tMyGpuTimer_initialize()");
+
+  if (!timer)
+  {
+    MY_LOG_ERROR("\t\t*** Erro: Temporizador inválido (timer == NULL).");
+    return false;
+  }
+
+  SDL_zerop(timer);
+  glGenQueries(MY_GPU_TIMER_QUERY_COUNT, timer->queries);
+  return glGetError() == GL_NO_ERROR;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyGpuTimer_destroy(MyGpuTimer *timer)
+{
+  MY_LOG_TRACE("\tMyGpuTimer_destroy()");
+
+  if (!timer)
+  {
+    MY_LOG_ERROR("\t\t*** Erro: Temporizador inválido (timer == NULL).");
+    return;
+  }
+
+  if (timer->running)
+    glEndQuery(GL_TIME_ELAPSED);
+
+  glDeleteQueries(MY_GPU_TIMER_QUERY_COUNT, timer->queries);
+  SDL_zerop(timer);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyGpuTimer_begin(MyGpuTimer *timer)
+{
+  if (timer->pendingCount == MY_GPU_TIMER_QUERY_COUNT)
+  {
+    // Todas as consultas em uso: a GPU está mais de QUERY_COUNT quadros
+    // atrasada e a CPU precisa esperar.
+    ++timer->stallCount;
+    MyGpuTimer_read(timer);
+  }
+
+  glBeginQuery(GL_TIME_ELAPSED, timer->queries[timer->head]);
+  timer->running = true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyGpuTimer_end(MyGpuTimer *timer)
+{
+  glEndQuery(GL_TIME_ELAPSED);
+  timer->running = false;
+  timer->head = (timer->head + 1) % MY_GPU_TIMER_QUERY_COUNT;
+  ++timer->pendingCount;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyGpuTimer_poll(MyGpuTimer *timer)
+{
+  bool updated = false;
+  while (MyGpuTimer_is_ready(timer))
+  {
+    MyGpuTimer_read(timer);
+    updated = true;
+  }
+
+  return updated;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyGpuTimer_is_ready(const MyGpuTimer *timer)
+{
+  if (timer->pendingCount == 0)
+    return false;
+
+  const int tail = (timer->head - timer->pendingCount + MY_GPU_TIMER_QUERY_COUNT) % MY_GPU_TIMER_QUERY_COUNT;
+
+  GLint available = GL_FALSE;
+  glGetQueryObjectiv(timer->queries[tail], GL_QUERY_RESULT_AVAILABLE, &available);
+  return available != GL_FALSE;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+Uint64 MyGpuTimer_read(MyGpuTimer *timer)
+{
+  const int tail = (timer->head - timer->pendingCount + MY_GPU_TIMER_QUERY_COUNT) % MY_GPU_TIMER_QUERY_COUNT;
+
+  GLuint64 elapsedNS = 0;
+  glGetQueryObjectui64v(timer->queries[tail], GL_QUERY_RESULT, &elapsedNS);
+
+  timer->lastNS = elapsedNS;
+  timer->totalNS += elapsedNS;
+  ++timer->resultCount;
+  --timer->pendingCount;
+  return elapsedNS;
+}
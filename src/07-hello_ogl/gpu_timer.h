@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Medição do tempo de GPU com consultas GL_TIME_ELAPSED (OpenGL 3.3).
+//
+// O resultado de uma consulta só fica pronto quando a GPU termina os comandos
+// medidos, alguns quadros depois de enviá-los. Ler o resultado logo após
+// glEndQuery() faria a CPU esperar pela GPU a cada quadro. Por isso, o
+// temporizador usa um anel de MY_GPU_TIMER_QUERY_COUNT consultas: a cada
+// quadro uma nova é iniciada e MyGpuTimer_poll() lê, sem bloquear, as que já
+// terminaram. Só se todas ainda estiverem pendentes é que begin() espera pela
+// mais antiga (contada em `stallCount`).
+//
+// Quem precisa de cada resultado (ex. o perfilador de quadros, profiler.h)
+// usa MyGpuTimer_is_ready() e MyGpuTimer_read() no lugar de poll(): os
+// resultados saem na mesma ordem dos pares begin()/end().
+//------------------------------------------------------------------------------
+#ifndef MY_GPU_TIMER_H
+#define MY_GPU_TIMER_H
+
+#include <stdbool.h>
+#include <GL/glew.h>
+#include <SDL3/SDL.h>
+
+enum gpu_timer_constants
+{
+  MY_GPU_TIMER_QUERY_COUNT = 4,
+};
+
+typedef struct MyGpuTimer MyGpuTimer;
+struct MyGpuTimer
+{
+  GLuint queries[MY_GPU_TIMER_QUERY_COUNT];
+  int head;          // Próxima consulta a iniciar.
+  int pendingCount;  // Consultas encerradas e ainda não lidas.
+  bool running;
+
+  Uint64 lastNS;     // Resultado mais recente.
+  Uint64 totalNS;    // Soma de todos os resultados lidos.
+  Uint64 resultCount;
+  Uint64 stallCount;
+};
+
+bool MyGpuTimer_initialize(MyGpuTimer *timer);
+void MyGpuTimer_destroy(MyGpuTimer *timer);
+
+/**
+ * Início e fim do trecho medido. Não podem ser aninhados com outras consultas
+ * GL_TIME_ELAPSED.
+ */
+void MyGpuTimer_begin(MyGpuTimer *timer);
+void MyGpuTimer_end(MyGpuTimer *timer);
+
+/**
+ * Lê os resultados já disponíveis, sem esperar pela GPU. Retorna true se
+ * `lastNS` foi atualizado.
+ */
+bool MyGpuTimer_poll(MyGpuTimer *timer);
+
+/**
+ * Retorna true se há um resultado pendente e o mais antigo já pode ser lido
+ * sem esperar pela GPU.
+ */
+bool MyGpuTimer_is_ready(const MyGpuTimer *timer);
+
+/**
+ * Lê o resultado pendente mais antigo (em ns), esperando pela GPU se
+ * necessário, e atualiza `lastNS`. Só pode ser chamada com `pendingCount > 0`.
+ */
+Uint64 MyGpuTimer_read(MyGpuTimer *timer);
+
+#endif // MY_GPU_TIMER_H
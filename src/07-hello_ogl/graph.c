@@ -0,0 +1,189 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "graph.h"
+#include "shader.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Vertex shader code.
+//------------------------------------------------------------------------------
+static const char *GRAPH_VERTEX_SHADER_CODE =
+  "#version 330 core\n"
+  "layout(location = 0) in vec2 a_Pos;\n"
+  "layout(location = 1) in vec3 a_Color;\n"
+  "out vec3 v_FragColor;\n"
+  "void main() {\n"
+  "  gl_Position = vec4(a_Pos, 0.0, 1.0);\n"
+  "  v_FragColor = a_Color;\n"
+  "}\0";
+
+//------------------------------------------------------------------------------
+// Fragment shader code.
+//------------------------------------------------------------------------------
+static const char *GRAPH_FRAGMENT_SHADER_CODE =
+  "#version 330 core\n"
+  "in vec3 v_FragColor;\n"
+  "out vec4 f_Color;\n"
+  "void main() {\n"
+  "  f_Color = vec4(v_FragColor, 1.0);\n"
+  "}\0";
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+enum graph_constants
+{
+  // X, Y, R, G, B de cada vértice.
+  GRAPH_VERTEX_FLOATS = 5,
+  GRAPH_VERTEX_SIZE = GRAPH_VERTEX_FLOATS * sizeof(GLfloat),
+  GRAPH_REFERENCE_LINES = 2,
+  // Duas barras (CPU e GPU) por quadro do histórico, mais as referências.
+  GRAPH_MAX_VERTICES = (MY_PROFILER_HISTORY_SIZE * 2 + GRAPH_REFERENCE_LINES) * 2,
+};
+
+// Tempo correspondente ao topo do gráfico.
+static const float GRAPH_MAX_MS = 1000.0f / 30.0f;
+
+static const float CPU_COLOR[3] = { 1.0f, 0.85f, 0.2f };
+static const float GPU_COLOR[3] = { 0.2f, 0.9f, 1.0f };
+static const float REFERENCE_COLOR[3] = { 0.8f, 0.8f, 0.8f };
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static GLfloat *write_line(GLfloat *dst, float x0, float y0, float x1, float y1, const float color[3]);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyFrameGraph_initialize(MyFrameGraph *graph, float left, float bottom, float width, float height)
+{
+  MY_LOG_TRACE(">>> MyFrameGraph_initialize()");
+
+  if (!graph || width <= 0.0f || height <= 0.0f)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyFrameGraph_initialize()");
+    return false;
+  }
+
+  SDL_zerop(graph);
+  graph->left = left;
+  graph->bottom = bottom;
+  graph->width = width;
+  graph->height = height;
+
+  graph->program = MyShader_create_program("graph", GRAPH_VERTEX_SHADER_CODE, GRAPH_FRAGMENT_SHADER_CODE);
+  if (!graph->program
+    || !MyVertexStream_initialize(&graph->stream, (GLsizeiptr)GRAPH_MAX_VERTICES * GRAPH_VERTEX_SIZE, MY_STREAM_MAP_UNSYNCHRONIZED))
+  {
+    MyFrameGraph_destroy(graph);
+    MY_LOG_TRACE("<<< MyFrameGraph_initialize()");
+    return false;
+  }
+
+  // Como em loop_stream(), os atributos partem do início do VBO e cada quadro
+  // escolhe seus vértices pelo parâmetro `first` de glDrawArrays().
+  glGenVertexArrays(1, &graph->vao);
+  glBindVertexArray(graph->vao);
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, graph->stream.vbo);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, GRAPH_VERTEX_SIZE, (GLvoid *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, GRAPH_VERTEX_SIZE, (GLvoid *)(2 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+  glBindVertexArray(0);
+
+  MY_LOG_TRACE("<<< MyFrameGraph_initialize()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameGraph_destroy(MyFrameGraph *graph)
+{
+  MY_LOG_TRACE(">>> MyFrameGraph_destroy()");
+
+  if (!graph)
+  {
+    MY_LOG_ERROR("\t*** Erro: Gráfico inválido (graph == NULL).");
+    MY_LOG_TRACE("<<< MyFrameGraph_destroy()");
+    return;
+  }
+
+  if (graph->stream.vbo)
+    MyVertexStream_destroy(&graph->stream);
+  glDeleteVertexArrays(1, &graph->vao);
+  glDeleteProgram(graph->program);
+  SDL_zerop(graph);
+
+  MY_LOG_TRACE("<<< MyFrameGraph_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+GLfloat *write_line(GLfloat *dst, float x0, float y0, float x1, float y1, const float color[3])
+{
+  *dst++ = x0;
+  *dst++ = y0;
+  *dst++ = color[0];
+  *dst++ = color[1];
+  *dst++ = color[2];
+  *dst++ = x1;
+  *dst++ = y1;
+  *dst++ = color[0];
+  *dst++ = color[1];
+  *dst++ = color[2];
+  return dst;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameGraph_draw(MyFrameGraph *graph, const MyFrameProfiler *profiler)
+{
+  const int sampleCount = profiler->historyCount;
+  const int vertexCount = (sampleCount * 2 + GRAPH_REFERENCE_LINES) * 2;
+  const float msToHeight = graph->height / GRAPH_MAX_MS;
+  const float columnWidth = graph->width / (float)MY_PROFILER_HISTORY_SIZE;
+  const float right = graph->left + graph->width;
+
+  GLintptr offset = 0;
+  GLfloat *dst = (GLfloat *)MyVertexStream_map(&graph->stream, (GLsizeiptr)vertexCount * GRAPH_VERTEX_SIZE, &offset);
+  if (!dst)
+    return;
+
+  for (int i = 1; i <= GRAPH_REFERENCE_LINES; ++i)
+  {
+    const float y = graph->bottom + graph->height * (float)i / (float)GRAPH_REFERENCE_LINES;
+    dst = write_line(dst, graph->left, y, right, y, REFERENCE_COLOR);
+  }
+
+  for (int age = 0; age < sampleCount; ++age)
+  {
+    const MyFrameProfile *profile = MyFrameProfiler_get_history(profiler, age);
+    const float x = right - ((float)age + 0.5f) * columnWidth;
+    const float cpuHeight = SDL_min((float)profile->cpuFrameMS, GRAPH_MAX_MS) * msToHeight;
+    const float gpuHeight = SDL_min((float)profile->gpuFrameMS, GRAPH_MAX_MS) * msToHeight;
+
+    dst = write_line(dst, x, graph->bottom, x, graph->bottom + cpuHeight, CPU_COLOR);
+    dst = write_line(dst, x, graph->bottom, x, graph->bottom + gpuHeight, GPU_COLOR);
+  }
+
+  MyVertexStream_unmap(&graph->stream);
+
+  glUseProgram(graph->program);
+  glBindVertexArray(graph->vao);
+  glDrawArrays(GL_LINES, (GLint)(offset / GRAPH_VERTEX_SIZE), vertexCount);
+  glBindVertexArray(0);
+
+  MyVertexStream_end_frame(&graph->stream);
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Gráfico de tempo por quadro desenhado sobre a cena (overlay), a partir do
+// histórico de um MyFrameProfiler (profiler.h).
+//
+// Cada quadro do histórico é uma coluna: uma barra amarela com o tempo de CPU
+// e, por cima, uma barra ciano com o tempo de GPU. As linhas horizontais
+// marcam 16,7 ms (60 quadros/s) e 33,3 ms, o topo do gráfico; barras maiores
+// são cortadas. O quadro mais recente fica à direita.
+//
+// As linhas (GL_LINES) são regravadas a cada quadro em um fluxo de vértices
+// (stream.h), sem esperar a GPU terminar o quadro anterior.
+//------------------------------------------------------------------------------
+#ifndef MY_GRAPH_H
+#define MY_GRAPH_H
+
+#include <stdbool.h>
+#include <GL/glew.h>
+#include <SDL3/SDL.h>
+#include "profiler.h"
+#include "stream.h"
+
+typedef struct MyFrameGraph MyFrameGraph;
+struct MyFrameGraph
+{
+  GLuint program;
+  GLuint vao;
+  MyVertexStream stream;
+
+  // Retângulo do gráfico, em coordenadas normalizadas (-1 a 1).
+  float left;
+  float bottom;
+  float width;
+  float height;
+};
+
+/**
+ * Cria o programa e o fluxo de vértices. O gráfico ocupa o retângulo
+ * (`left`, `bottom`, `width`, `height`), em coordenadas normalizadas.
+ */
+bool MyFrameGraph_initialize(MyFrameGraph *graph, float left, float bottom, float width, float height);
+void MyFrameGraph_destroy(MyFrameGraph *graph);
+
+/**
+ * Desenha o histórico de `profiler` no framebuffer atual.
+ */
+void MyFrameGraph_draw(MyFrameGraph *graph, const MyFrameProfiler *profiler);
+
+#endif // MY_GRAPH_H
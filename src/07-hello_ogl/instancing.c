@@ -0,0 +1,211 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "instancing.h"
+#include "shader.h"
+#include "random.h"
+#include "log.h"
+
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+// Vertex shader code.
+//------------------------------------------------------------------------------
+static const char *INSTANCED_VERTEX_SHADER_CODE =
+  "#version 330 core\n"
+  "layout(location = 0) in vec3 a_Pos;\n"
+  "layout(location = 1) in vec3 a_Color;\n"
+  "layout(location = 2) in vec4 a_Transform;\n"
+  "layout(location = 3) in vec4 a_InstanceColor;\n"
+  "out vec3 v_FragColor;\n"
+  "uniform mat4 u_MVPMatrix;\n"
+  "uniform float u_Time;\n"
+  "void main() {\n"
+  "  float angle = a_Transform.w + u_Time;\n"
+  "  float c = cos(angle);\n"
+  "  float s = sin(angle);\n"
+  "  vec2 pos = mat2(c, s, -s, c) * (a_Pos.xy * a_Transform.z) + a_Transform.xy;\n"
+  "  gl_Position = u_MVPMatrix * vec4(pos, a_Pos.z, 1.0);\n"
+  "  v_FragColor = a_Color * a_InstanceColor.rgb;\n"
+  "}\0";
+
+//------------------------------------------------------------------------------
+// Fragment shader code.
+//------------------------------------------------------------------------------
+static const char *INSTANCED_FRAGMENT_SHADER_CODE =
+  "#version 330 core\n"
+  "in vec3 v_FragColor;\n"
+  "out vec4 f_Color;\n"
+  "void main() {\n"
+  "  f_Color = vec4(v_FragColor, 1.0);\n"
+  "}\0";
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+
+// O triângulo vai de -0.5 a 0.5; girando, ele cabe em um círculo de raio
+// ~0.71. Com essa escala, instâncias vizinhas não se sobrepõem.
+static const float CELL_FILL = 0.65f;
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static void fill_instances(MyInstance *instances, int count, float halfWidth, float halfHeight);
+
+//------------------------------------------------------------------------------
+// Grade de `cols x rows` células (proporcional à área), preenchida linha a
+// linha; a última linha pode ficar incompleta.
+//------------------------------------------------------------------------------
+void fill_instances(MyInstance *instances, int count, float halfWidth, float halfHeight)
+{
+  const int cols = SDL_max(1, (int)SDL_ceil(SDL_sqrt((double)count * halfWidth / halfHeight)));
+  const int rows = (count + cols - 1) / cols;
+  const float cellWidth = 2.0f * halfWidth / (float)cols;
+  const float cellHeight = 2.0f * halfHeight / (float)rows;
+  const float scale = SDL_min(cellWidth, cellHeight) * CELL_FILL;
+
+  Uint32 state = 0x9E3779B9u;
+  for (int i = 0; i < count; ++i)
+  {
+    const int row = i / cols;
+    const int col = i % cols;
+    const Uint32 r = my_xorshift32(&state);
+
+    MyInstance *instance = &instances[i];
+    instance->transform[0] = -halfWidth + ((float)col + 0.5f) * cellWidth;
+    instance->transform[1] = halfHeight - ((float)row + 0.5f) * cellHeight;
+    instance->transform[2] = scale;
+    instance->transform[3] = (float)(r >> 8) * (2.0f * SDL_PI_F / 16777216.0f);
+
+    // Cores claras: cada canal em [96, 255].
+    const Uint32 c = my_xorshift32(&state) | 0x00606060;
+    instance->color[0] = (GLubyte)c;
+    instance->color[1] = (GLubyte)(c >> 8);
+    instance->color[2] = (GLubyte)(c >> 16);
+    instance->color[3] = 255;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyInstancedTriangles_initialize(MyInstancedTriangles *triangles, GLuint vertexBuffer, int count, float halfWidth, float halfHeight)
+{
+  MY_LOG_TRACE(">>> MyInstancedTriangles_initialize(%d)", count);
+
+  if (!triangles || count <= 0 || halfWidth <= 0.0f || halfHeight <= 0.0f)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyInstancedTriangles_initialize()");
+    return false;
+  }
+
+  SDL_zerop(triangles);
+  triangles->mvp = -1;
+  triangles->time = -1;
+  triangles->count = SDL_min(count, (int)MY_INSTANCING_MAX_COUNT);
+
+  triangles->program = MyShader_create_program("instanced", INSTANCED_VERTEX_SHADER_CODE, INSTANCED_FRAGMENT_SHADER_CODE);
+  if (!triangles->program)
+  {
+    MY_LOG_TRACE("<<< MyInstancedTriangles_initialize()");
+    return false;
+  }
+
+  triangles->mvp = glGetUniformLocation(triangles->program, "u_MVPMatrix");
+  triangles->time = glGetUniformLocation(triangles->program, "u_Time");
+
+  const size_t instancesSize = (size_t)triangles->count * sizeof(MyInstance);
+  MyInstance *instances = (MyInstance *)SDL_malloc(instancesSize);
+  if (!instances)
+  {
+    MY_LOG_ERROR("\t*** Erro ao alocar memória para %d instâncias.", triangles->count);
+    MyInstancedTriangles_destroy(triangles);
+    MY_LOG_TRACE("<<< MyInstancedTriangles_initialize()");
+    return false;
+  }
+
+  fill_instances(instances, triangles->count, halfWidth, halfHeight);
+
+  MY_LOG_DEBUG("\tEnviando %d instâncias (%zu KiB) para a GPU...", triangles->count, instancesSize / 1024);
+  glGenVertexArrays(1, &triangles->vao);
+  glGenBuffers(1, &triangles->instanceVbo);
+
+  glBindVertexArray(triangles->vao);
+  {
+    // Atributos por vértice, lidos do VBO do triângulo.
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid *)(3 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(1);
+
+    // Atributos por instância (divisor 1).
+    glBindBuffer(GL_ARRAY_BUFFER, triangles->instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)instancesSize, instances, GL_STATIC_DRAW);
+
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(MyInstance), (GLvoid *)offsetof(MyInstance, transform));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(MyInstance), (GLvoid *)offsetof(MyInstance, color));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+  glBindVertexArray(0);
+
+  SDL_free(instances);
+
+  if (glGetError() != GL_NO_ERROR)
+  {
+    MY_LOG_ERROR("\t*** Erro ao criar o buffer de instâncias.");
+    MyInstancedTriangles_destroy(triangles);
+    MY_LOG_TRACE("<<< MyInstancedTriangles_initialize()");
+    return false;
+  }
+
+  MY_LOG_TRACE("<<< MyInstancedTriangles_initialize()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyInstancedTriangles_destroy(MyInstancedTriangles *triangles)
+{
+  MY_LOG_TRACE(">>> MyInstancedTriangles_destroy()");
+
+  if (!triangles)
+  {
+    MY_LOG_ERROR("\t*** Erro: Instâncias inválidas (triangles == NULL).");
+    MY_LOG_TRACE("<<< MyInstancedTriangles_destroy()");
+    return;
+  }
+
+  glDeleteProgram(triangles->program);
+  glDeleteVertexArrays(1, &triangles->vao);
+  glDeleteBuffers(1, &triangles->instanceVbo);
+  SDL_zerop(triangles);
+  triangles->mvp = -1;
+  triangles->time = -1;
+
+  MY_LOG_TRACE("<<< MyInstancedTriangles_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyInstancedTriangles_draw(const MyInstancedTriangles *triangles, mat4 mvpMatrix, float seconds)
+{
+  glUseProgram(triangles->program);
+  glUniformMatrix4fv(triangles->mvp, 1, GL_FALSE, (const GLfloat *)mvpMatrix);
+  glUniform1f(triangles->time, seconds);
+  glBindVertexArray(triangles->vao);
+  glDrawArraysInstanced(GL_TRIANGLES, 0, 3, triangles->count);
+}
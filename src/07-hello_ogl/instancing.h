@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Desenho instanciado: muitas cópias do mesmo triângulo com uma única chamada
+// glDrawArraysInstanced() por quadro.
+//
+// O VAO lê dois buffers:
+// - o VBO do triângulo (posição e cor de cada vértice), o mesmo do modo
+//   normal, avançando a cada vértice;
+// - um VBO com um MyInstance por cópia (posição, escala, ângulo e cor),
+//   avançando a cada instância (glVertexAttribDivisor(..., 1)).
+//
+// As instâncias são criadas uma vez, em uma grade que cobre a área visível, e
+// ficam na GPU (GL_STATIC_DRAW). A rotação é animada no vertex shader a partir
+// de um uniform de tempo, então a CPU não toca nos dados a cada quadro e o
+// custo medido é o da GPU (ou do llvmpipe, sem GPU).
+//------------------------------------------------------------------------------
+#ifndef MY_INSTANCING_H
+#define MY_INSTANCING_H
+
+#include <stdbool.h>
+#include <GL/glew.h>
+#include <SDL3/SDL.h>
+#include <cglm/cglm.h>
+
+enum instancing_constants
+{
+  MY_INSTANCING_MAX_COUNT = 1000000,
+};
+
+typedef struct MyInstance MyInstance;
+struct MyInstance
+{
+  GLfloat transform[4];  // x, y, escala, ângulo inicial (radianos).
+  GLubyte color[4];      // RGBA, multiplicada pela cor de cada vértice.
+};
+
+typedef struct MyInstancedTriangles MyInstancedTriangles;
+struct MyInstancedTriangles
+{
+  GLuint program;
+  GLint mvp;
+  GLint time;
+
+  GLuint vao;
+  GLuint instanceVbo;
+  int count;
+};
+
+/**
+ * Cria `count` instâncias (limitado a MY_INSTANCING_MAX_COUNT) em uma grade
+ * sobre [-halfWidth, halfWidth] x [-halfHeight, halfHeight] no plano z = 0.
+ * `vertexBuffer` é o VBO do triângulo (X, Y, Z, R, G, B por vértice).
+ */
+bool MyInstancedTriangles_initialize(MyInstancedTriangles *triangles, GLuint vertexBuffer, int count, float halfWidth, float halfHeight);
+void MyInstancedTriangles_destroy(MyInstancedTriangles *triangles);
+
+/**
+ * Desenha todas as instâncias, giradas de `seconds` radianos.
+ */
+void MyInstancedTriangles_draw(const MyInstancedTriangles *triangles, mat4 mvpMatrix, float seconds);
+
+#endif // MY_INSTANCING_H
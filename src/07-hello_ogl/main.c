@@ -9,6 +9,73 @@
 // - GLEW: The OpenGL Extension Wrangler Library.
 // - OpenGL Mathematics (glm) for C.
 //
+// Perfil de quadros: `main --profile [--csv arquivo] [--frames N]` mede o
+// tempo de CPU (SDL_GetPerformanceCounter) e de GPU (consultas
+// GL_TIME_ELAPSED, lidas alguns quadros depois) de cada etapa do quadro do
+// triângulo: limpar, desenhar, overlay e trocar buffers (veja profiler.h). Um
+// gráfico com os últimos quadros é desenhado sobre a cena (veja graph.h) e,
+// com `--csv`, cada quadro é gravado em `arquivo` para análise posterior.
+// Ao encerrar, o log mostra as médias por etapa.
+//
+// Modo instanciado: `main --instances [quantidade] [--frames N]` desenha
+// `quantidade` cópias do triângulo (padrão 100 mil, máximo 1 milhão) com uma
+// única chamada glDrawArraysInstanced() por quadro (veja instancing.h). O
+// título da janela mostra o tempo de CPU (envio dos comandos e troca de
+// buffers) e o de GPU (consultas GL_TIME_ELAPSED, veja gpu_timer.h) de cada
+// quadro. Com `--frames N`, o programa encerra após N quadros e registra as
+// médias, para medições automatizadas (ex. com o llvmpipe do Mesa, em
+// máquinas sem GPU).
+//
+// Modo cena: `main --scene [quantidade] [--frames N]` guarda `quantidade`
+// triângulos (padrão 20 mil) espalhados em 3D em uma cena SoA (veja scene.h).
+// A cada quadro, só as matrizes dos objetos que giram (1 em
+// SCENE_ANIMATED_STRIDE) são recalculadas, em lotes; os objetos fora do
+// frustum são descartados antes do desenho. As setas movem a câmera no plano
+// XY e W/S a aproximam ou afastam (o que recalcula todas as MVPs). O título
+// mostra os objetos desenhados, descartados e atualizados e os tempos de
+// atualização e de descarte.
+//
+// Malha: `main --mesh [arquivo.obj] [--frames N]` carrega uma malha Wavefront
+// OBJ (padrão cube.obj) com o carregador de mesh.h (arquivo mapeado na
+// memória, parser de números próprio e deduplicação de vértices) e a desenha
+// girando, com glDrawElements() e teste de profundidade. O log mostra o tempo
+// de carga (mapeamento, leitura e envio para a GPU) e o título, o número de
+// triângulos e o tempo de CPU por quadro.
+//
+// Modo fluxo: `main --stream [quantidade] [--orphan] [--frames N]` recalcula
+// na CPU, a cada quadro, `quantidade` triângulos animados (padrão 50 mil) e
+// os envia por um fluxo de vértices dinâmico (veja stream.h): um anel de
+// segmentos com glMapBufferRange não sincronizado e cercas ou, com
+// `--orphan`, um VBO "abandonado" a cada quadro. O título mostra os bytes
+// enviados por quadro e as esperas por cercas.
+//
+// Blur na GPU: `main --blur [tamanho] [--image arquivo]` aplica o filtro de
+// média `tamanho x tamanho` (padrão 15) em uma imagem (padrão kodim23.png)
+// com dois passes de fragment shader (veja gpu_blur.h), lê o resultado de
+// volta e o compara com MyFilter_blur() da biblioteca comum, registrando os
+// tempos e o número de pixels diferentes. A janela fica oculta; sem servidor
+// gráfico, use SDL_VIDEO_DRIVER=offscreen (com o llvmpipe). O programa
+// retorna 1 se os resultados forem diferentes.
+//
+// Modo offscreen: `main --offscreen [quantidade] [--frames N] [--output
+// destino]` desenha a cena do modo instanciado em um framebuffer (FBO), sem
+// janela visível nem SDL_GL_SwapWindow(), por N quadros (padrão 300) com
+// passo de tempo fixo (1/60 s, resultado reprodutível). Os quadros são lidos
+// de volta por um anel de PBOs com cercas (veja readback.h) e, conforme
+// `destino`:
+// - nenhum: só leitura (medição de vazão);
+// - um diretório: um arquivo PPM por quadro;
+// - `-`: quadros RGBA crus na saída padrão (o log vai para a saída de erro),
+//   para um codificador. Ex.: `main --offscreen --output - | ffmpeg -f
+//   rawvideo -pix_fmt rgba -s 640x480 -r 60 -i - video.mp4`.
+// Sem servidor gráfico, use SDL_VIDEO_DRIVER=offscreen (com o llvmpipe).
+//
+// Cache de programas: os programas GLSL linkados são guardados em disco, em
+// PROGRAM_CACHE_DIRECTORY (veja program_cache.h), e carregados de lá nas
+// execuções seguintes. O log mostra o tempo de partida e quantos programas
+// vieram do cache ou foram compilados, para comparar uma partida "fria"
+// (cache vazio) com uma "quente". `--no-program-cache` desativa o cache.
+//
 // Observação:
 // - Para simplificar o código de exemplo, o programa não verifica possíveis
 // erros que podem acontecer na inicialização do OpenGL e operações seguintes.
@@ -20,20 +87,87 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
 #include <GL/glew.h>    // GLEW: The OpenGL Extension Wrangler Library.
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
 #include <cglm/cglm.h>  // OpenGL Mathematics (glm) for C.
+#include <SDL3_image/SDL_image.h>
+#include "filters.h"
+#include "parallel.h"
+#include "shader.h"
+#include "gpu_timer.h"
+#include "instancing.h"
+#include "stream.h"
+#include "gpu_blur.h"
+#include "readback.h"
+#include "profiler.h"
+#include "graph.h"
+#include "scene.h"
+#include "mesh.h"
+#include "log.h"
 
 //------------------------------------------------------------------------------
 // Constants, enums and custom types.
 //------------------------------------------------------------------------------
 static const char *WINDOW_TITLE = "Hello, OpenGL (SDL + GLEW + CGLM)";
+static const char *BLUR_DEFAULT_IMAGE = "kodim23.png";
+static const char *PROGRAM_CACHE_DIRECTORY = "program_cache";
+static const char *MESH_DEFAULT_FILE = "cube.obj";
 
 enum constants
 {
   WINDOW_WIDTH = 640,
   WINDOW_HEIGHT = 480,
+  WINDOW_TITLE_MAX_LENGTH = 256,
+  INSTANCES_DEFAULT_COUNT = 100000,
+  STREAM_DEFAULT_COUNT = 50000,
+  STREAM_MAX_COUNT = 500000,
+  BLUR_DEFAULT_SIZE = 15,
+  // Execuções do blur na GPU para a média do tempo (a primeira é descartada).
+  BLUR_RUNS = 10,
+  OFFSCREEN_DEFAULT_FRAMES = 300,
+  OFFSCREEN_FRAMES_PER_SECOND = 60,
+  OFFSCREEN_PATH_MAX_LENGTH = 512,
+  // Gráfico de tempo por quadro, no canto inferior esquerdo (em pixels).
+  GRAPH_MARGIN = 8,
+  GRAPH_WIDTH = 360,
+  GRAPH_HEIGHT = 120,
+  SCENE_DEFAULT_COUNT = 20000,
+  // Um em cada SCENE_ANIMATED_STRIDE objetos gira (e é recalculado) a cada quadro.
+  SCENE_ANIMATED_STRIDE = 8,
+  SCENE_SEED = 42,
+  // X, Y, Z, R, G, B de cada vértice, como no VBO do triângulo.
+  VERTEX_FLOATS = 6,
+  VERTEX_SIZE = VERTEX_FLOATS * sizeof(GLfloat),
+};
+
+// Distância da câmera ao plano z = 0 e campo de visão vertical.
+static const float CAMERA_DISTANCE = 3.0f;
+static const float CAMERA_FOV_DEGREES = 45.0f;
+static const float CAMERA_NEAR = 0.1f;
+static const float CAMERA_FAR = 100.0f;
+
+// Volume ocupado pelos objetos do modo cena (X e Y em [-extensão, extensão],
+// Z em [-profundidade, 0]), velocidade da câmera (unidades/s) e raio da
+// esfera envolvente do triângulo (distância da origem ao vértice mais longe).
+static const float SCENE_HALF_EXTENT = 30.0f;
+static const float SCENE_DEPTH = 60.0f;
+static const float SCENE_CAMERA_SPEED = 10.0f;
+static const float TRIANGLE_RADIUS = 0.7072f;
+
+// Destino dos quadros lidos no modo offscreen.
+typedef struct FrameWriter FrameWriter;
+struct FrameWriter
+{
+  const char *directory;  // NULL = não grava arquivos.
+  FILE *stream;           // Quadros crus: stdout (a SDL não o expõe como SDL_IOStream) ou NULL.
+  Uint8 *row;             // Uma linha RGB (PPM).
+  Uint64 bytesWritten;
+  bool failed;
 };
 
 typedef struct MyOGLWindow MyOGLWindow;
@@ -51,6 +185,19 @@ static GLuint g_shaderProgram = 0;
 static GLuint g_vao = 0;
 static GLuint g_vbo = 0;
 static GLint g_mvp = -1;
+static MyGpuTimer g_gpuTimer;
+static MyInstancedTriangles g_instanced;
+static MyVertexStream g_stream;
+static GLuint g_streamVao = 0;
+static MyGpuBlur g_gpuBlur;
+static MyProgramCache g_programCache;
+static MyReadback g_readback;
+static GLuint g_offscreenFbo = 0;
+static GLuint g_offscreenColor = 0;
+static MyFrameProfiler g_profiler;
+static MyFrameGraph g_frameGraph;
+static MyScene g_scene;
+static MyMesh g_mesh;
 
 //------------------------------------------------------------------------------
 // Vertex shader code.
@@ -83,17 +230,20 @@ static const char *FRAGMENT_SHADER_CODE =
 static bool MyOGLWindow_initialize(MyOGLWindow *window, const char *title, int width, int height, SDL_WindowFlags window_flags);
 static bool MyOGLWindow_create_context(MyOGLWindow *window);
 static void MyOGLWindow_destroy(MyOGLWindow *window);
+static void compute_mvp(mat4 mvpMatrix);
+static void compute_view_projection(vec3 cameraPos, mat4 viewProjection);
+static void write_wave_triangles(GLfloat *dst, int count, float halfWidth, float halfHeight, float seconds);
 
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
 bool MyOGLWindow_initialize(MyOGLWindow *window, const char *title, int width, int height, SDL_WindowFlags window_flags)
 {
-  SDL_Log("\tMyOGLWindow_initialize(\"%s\", %d, %d)", title, width, height);
+  MY_LOG_TRACE("\tMyOGLWindow_initialize(\"%s\", %d, %d)", title, width, height);
 
   if (!window)
   {
-    SDL_Log("\t\t*** Erro: Janela inválida (window == NULL).");
+    MY_LOG_ERROR("\t\t*** Erro: Janela inválida (window == NULL).");
     return false;
   }
 
@@ -106,11 +256,11 @@ bool MyOGLWindow_initialize(MyOGLWindow *window, const char *title, int width, i
 //------------------------------------------------------------------------------
 bool MyOGLWindow_create_context(MyOGLWindow *window)
 {
-  SDL_Log("\tMyOGL_create_context()");
+  MY_LOG_TRACE("\tMyOGL_create_context()");
 
   if (!window)
   {
-    SDL_Log("\t\t*** Erro: Janela inválida (window == NULL).");
+    MY_LOG_ERROR("\t\t*** Erro: Janela inválida (window == NULL).");
     return false;
   }
 
@@ -123,19 +273,19 @@ bool MyOGLWindow_create_context(MyOGLWindow *window)
 //------------------------------------------------------------------------------
 void MyOGLWindow_destroy(MyOGLWindow *window)
 {
-  SDL_Log("\tMyOGLWindow_destroy()");
+  MY_LOG_TRACE("\tMyOGLWindow_destroy()");
 
   if (!window)
   {
-    SDL_Log("\t\t*** Erro: Janela inválida (window == NULL).");
+    MY_LOG_ERROR("\t\t*** Erro: Janela inválida (window == NULL).");
     return;
   }
 
-  SDL_Log("\t\tDestruindo MyOGLWindow->context...");
+  MY_LOG_DEBUG("\t\tDestruindo MyOGLWindow->context...");
   SDL_GL_DestroyContext(window->context);
   window->context = NULL;
 
-  SDL_Log("\t\tDestruindo MyOGLWindow->window...");
+  MY_LOG_DEBUG("\t\tDestruindo MyOGLWindow->window...");
   SDL_DestroyWindow(window->window);
   window->window = NULL;
 }
@@ -143,76 +293,79 @@ void MyOGLWindow_destroy(MyOGLWindow *window)
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-static SDL_AppResult initialize(void)
+static SDL_AppResult initialize(bool hidden, bool useProgramCache)
 {
-  SDL_Log(">>> initialize()");
+  MY_LOG_TRACE(">>> initialize(hidden = %s, useProgramCache = %s)", hidden ? "true" : "false", useProgramCache ? "true" : "false");
+
+  const Uint64 startNS = SDL_GetTicksNS();
 
-  SDL_Log("\tIniciando SDL...");
+  MY_LOG_DEBUG("\tIniciando SDL...");
   if (!SDL_Init(SDL_INIT_VIDEO))
   {
-    SDL_Log("\t*** Erro ao iniciar a SDL: %s", SDL_GetError());
-    SDL_Log("<<< initialize()");
+    MY_LOG_ERROR("\t*** Erro ao iniciar a SDL: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< initialize()");
     return SDL_APP_FAILURE;
   }
 
-  SDL_Log("\tConfigurando atributos OpenGL (3.3 core)...");
+  MY_LOG_DEBUG("\tConfigurando atributos OpenGL (3.3 core)...");
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
   SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+  SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
 
-  SDL_Log("\tCriando janela...");
-  if (!MyOGLWindow_initialize(&g_window, WINDOW_TITLE, WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_OPENGL))
+  MY_LOG_DEBUG("\tCriando janela...");
+  if (!MyOGLWindow_initialize(&g_window, WINDOW_TITLE, WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_OPENGL | (hidden ? SDL_WINDOW_HIDDEN : 0)))
   {
-    SDL_Log("\t*** Erro ao criar a janela: %s", SDL_GetError());
-    SDL_Log("<<< initialize()");
+    MY_LOG_ERROR("\t*** Erro ao criar a janela: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< initialize()");
     return SDL_APP_FAILURE;
   }
 
-  SDL_Log("\tCriando contexto OpenGL...");
+  MY_LOG_DEBUG("\tCriando contexto OpenGL...");
   if (!MyOGLWindow_create_context(&g_window))
   {
-    SDL_Log("\t*** Erro ao criar contexto OpenGL: %s", SDL_GetError());
-    SDL_Log("<<< initialize()");
+    MY_LOG_ERROR("\t*** Erro ao criar contexto OpenGL: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< initialize()");
     return SDL_APP_FAILURE;
   }
 
-  SDL_Log("\tCarregando funções OpenGL (GLEW)...");
+  MY_LOG_DEBUG("\tCarregando funções OpenGL (GLEW)...");
   glewExperimental = GL_TRUE;
   GLenum err = glewInit();
   if (err != GLEW_OK)
   {
-    SDL_Log("\t*** Erro ao iniciar GLEW: %s", glewGetErrorString(err));
-    SDL_Log("<<< initialize()");
+    MY_LOG_ERROR("\t*** Erro ao iniciar GLEW: %s", glewGetErrorString(err));
+    MY_LOG_TRACE("<<< initialize()");
     return SDL_APP_FAILURE;
   }
 
-  SDL_Log("\tCompilando vertex shader...");
-  GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-  glShaderSource(vertexShader, 1, &VERTEX_SHADER_CODE, NULL);
-  glCompileShader(vertexShader);
+  // O glewInit() pode deixar um GL_INVALID_ENUM pendente em contextos core;
+  // descarta para não confundir as verificações seguintes.
+  while (glGetError() != GL_NO_ERROR)
+    ;
 
-  SDL_Log("\tCompilando fragment shader...");
-  GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-  glShaderSource(fragmentShader, 1, &FRAGMENT_SHADER_CODE, NULL);
-  glCompileShader(fragmentShader);
-
-  SDL_Log("\tLinkando programa...");
-  g_shaderProgram = glCreateProgram();
-  glAttachShader(g_shaderProgram, vertexShader);
-  glAttachShader(g_shaderProgram, fragmentShader);
-  glLinkProgram(g_shaderProgram);
+  if (useProgramCache)
+  {
+    MY_LOG_DEBUG("\tPreparando cache de programas...");
+    if (MyProgramCache_initialize(&g_programCache, PROGRAM_CACHE_DIRECTORY))
+      MyShader_set_program_cache(&g_programCache);
+  }
 
-  SDL_Log("\tLiberando shaders...");
-  glDeleteShader(vertexShader);
-  glDeleteShader(fragmentShader);
+  MY_LOG_DEBUG("\tCompilando e linkando shaders...");
+  g_shaderProgram = MyShader_create_program("triangle", VERTEX_SHADER_CODE, FRAGMENT_SHADER_CODE);
+  if (!g_shaderProgram)
+  {
+    MY_LOG_TRACE("<<< initialize()");
+    return SDL_APP_FAILURE;
+  }
 
-  SDL_Log("\tObtendo uniform \"u_MVPMatrix\" do shader...");
+  MY_LOG_DEBUG("\tObtendo uniform \"u_MVPMatrix\" do shader...");
   g_mvp = glGetUniformLocation(g_shaderProgram, "u_MVPMatrix");
   if (g_mvp == -1)
   {
-    SDL_Log("\t*** Erro ao obter a variável uniform 'u_MVPMatrix' do vertex shader.");
-    SDL_Log("<<< initialize()");
+    MY_LOG_ERROR("\t*** Erro ao obter a variável uniform 'u_MVPMatrix' do vertex shader.");
+    MY_LOG_TRACE("<<< initialize()");
     return SDL_APP_FAILURE;
   }
 
@@ -223,7 +376,7 @@ static SDL_AppResult initialize(void)
      0.0f,  0.5f, 0.0f, 0.0f, 0.0f, 1.0f // Cima, azul.
   };
 
-  SDL_Log("\tCriando e configurando Vertex Array Object (VAO) e Vertex Buffer Object (VBO)...");
+  MY_LOG_DEBUG("\tCriando e configurando Vertex Array Object (VAO) e Vertex Buffer Object (VBO)...");
   glGenVertexArrays(1, &g_vao);
   glGenBuffers(1, &g_vbo);
 
@@ -246,10 +399,16 @@ static SDL_AppResult initialize(void)
   }
   glBindVertexArray(0);
 
-  SDL_Log("\tConfigurando viewport OpenGL...");
+  MY_LOG_DEBUG("\tConfigurando viewport OpenGL...");
   glViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
 
-  SDL_Log("<<< initialize()");
+  const MyShaderStats *shaderStats = MyShader_get_stats();
+  MY_LOG_INFO("\tPartida em %.3f ms (%s): %d programa(s) do cache (%.3f ms), %d compilado(s) (%.3f ms).",
+    (double)(SDL_GetTicksNS() - startNS) / SDL_NS_PER_MS, g_programCache.enabled ? "com cache" : "sem cache",
+    shaderStats->cachedCount, (double)shaderStats->cachedNS / SDL_NS_PER_MS,
+    shaderStats->compiledCount, (double)shaderStats->compiledNS / SDL_NS_PER_MS);
+
+  MY_LOG_TRACE("<<< initialize()");
   return SDL_APP_CONTINUE;
 }
 
@@ -258,9 +417,33 @@ static SDL_AppResult initialize(void)
 //------------------------------------------------------------------------------
 static void shutdown(void)
 {
-  SDL_Log(">>> shutdown()");
+  MY_LOG_TRACE(">>> shutdown()");
 
-  SDL_Log("\tLiberando recursos OpenGL...");
+  MY_LOG_DEBUG("\tLiberando recursos OpenGL...");
+  if (g_instanced.vao)
+    MyInstancedTriangles_destroy(&g_instanced);
+  if (g_gpuTimer.queries[0])
+    MyGpuTimer_destroy(&g_gpuTimer);
+  if (g_stream.vbo)
+    MyVertexStream_destroy(&g_stream);
+  glDeleteVertexArrays(1, &g_streamVao);
+  g_streamVao = 0;
+  if (g_gpuBlur.vao)
+    MyGpuBlur_destroy(&g_gpuBlur);
+  if (g_readback.pbos[0])
+    MyReadback_destroy(&g_readback);
+  if (g_frameGraph.program)
+    MyFrameGraph_destroy(&g_frameGraph);
+  if (g_profiler.timers[0].queries[0])
+    MyFrameProfiler_destroy(&g_profiler);
+  if (g_scene.program)
+    MyScene_destroy(&g_scene);
+  if (g_mesh.vao)
+    MyMesh_destroy(&g_mesh);
+  glDeleteFramebuffers(1, &g_offscreenFbo);
+  glDeleteRenderbuffers(1, &g_offscreenColor);
+  g_offscreenFbo = 0;
+  g_offscreenColor = 0;
   glDeleteProgram(g_shaderProgram);
   glDeleteVertexArrays(1, &g_vao);
   glDeleteBuffers(1, &g_vbo);
@@ -269,49 +452,99 @@ static void shutdown(void)
   g_vbo = 0;
   g_mvp = -1;
 
+  const MyShaderStats *shaderStats = MyShader_get_stats();
+  MY_LOG_INFO("\tProgramas: %d do cache (%.3f ms), %d compilado(s) (%.3f ms).",
+    shaderStats->cachedCount, (double)shaderStats->cachedNS / SDL_NS_PER_MS,
+    shaderStats->compiledCount, (double)shaderStats->compiledNS / SDL_NS_PER_MS);
+  MyShader_set_program_cache(NULL);
+
   MyOGLWindow_destroy(&g_window);
 
-  SDL_Log("\tEncerrando SDL...");
+  MyLog_shutdown();
+
+  MY_LOG_DEBUG("\tEncerrando SDL...");
   SDL_Quit();
 
-  SDL_Log("<<< shutdown()");
+  MY_LOG_TRACE("<<< shutdown()");
 }
 
 //------------------------------------------------------------------------------
-//
+// Matriz MVP (Model-View-Projection) usada por todos os modos: modelo na
+// origem e câmera em (0, 0, CAMERA_DISTANCE), olhando para a origem.
 //------------------------------------------------------------------------------
-static void loop(void)
+void compute_mvp(mat4 mvpMatrix)
 {
-  SDL_Log(">>> loop()");
-
-  SDL_Log("\tCriando matriz do modelo...");
+  MY_LOG_DEBUG("\tCriando matriz do modelo...");
   mat4 modelMatrix;
   glm_mat4_identity(modelMatrix);
 
-  SDL_Log("\tCriando matriz de visão (câmera)...");
-  vec3 cameraPos = { 0.0f, 0.0f, 3.0f };
+  MY_LOG_DEBUG("\tCriando matriz de visão (câmera)...");
+  vec3 cameraPos = { 0.0f, 0.0f, CAMERA_DISTANCE };
   vec3 cameraTarget = { 0.0f, 0.0f, 0.0f };
   vec3 cameraUp = { 0.0f, 1.0f, 0.0f };
   mat4 viewMatrix;
   glm_lookat(cameraPos, cameraTarget, cameraUp, viewMatrix);
 
-  SDL_Log("\tCriando matriz de projeção perspectiva...");
-  float fov = glm_rad(45.0f);
+  MY_LOG_DEBUG("\tCriando matriz de projeção perspectiva...");
+  float fov = glm_rad(CAMERA_FOV_DEGREES);
   float aspect = (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT;
-  float nearPlane = 0.1f;
-  float farPlane = 100.0f;
+  float nearPlane = CAMERA_NEAR;
+  float farPlane = CAMERA_FAR;
   mat4 projectionMatrix;
   glm_perspective(fov, aspect, nearPlane, farPlane, projectionMatrix);
 
-  SDL_Log("\tCalculando matriz MVP (Model-View-Projection)...");
-  mat4 mvpMatrix;
+  MY_LOG_DEBUG("\tCalculando matriz MVP (Model-View-Projection)...");
   glm_mat4_mul(projectionMatrix, viewMatrix, mvpMatrix);
   glm_mat4_mul(mvpMatrix, modelMatrix, mvpMatrix);
+}
+
+//------------------------------------------------------------------------------
+// Projeção * visão de uma câmera em `cameraPos` olhando para -Z, com a mesma
+// projeção de compute_mvp(). Chamada a cada movimento da câmera (sem log).
+//------------------------------------------------------------------------------
+void compute_view_projection(vec3 cameraPos, mat4 viewProjection)
+{
+  vec3 cameraTarget = { cameraPos[0], cameraPos[1], cameraPos[2] - 1.0f };
+  vec3 cameraUp = { 0.0f, 1.0f, 0.0f };
+  mat4 viewMatrix;
+  glm_lookat(cameraPos, cameraTarget, cameraUp, viewMatrix);
+
+  mat4 projectionMatrix;
+  glm_perspective(glm_rad(CAMERA_FOV_DEGREES), (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT, CAMERA_NEAR, CAMERA_FAR, projectionMatrix);
+  glm_mat4_mul(projectionMatrix, viewMatrix, viewProjection);
+}
 
-  SDL_Log("\tExibindo triângulo colorido...");
+//------------------------------------------------------------------------------
+// Quadro do triângulo. Com `profile`, cada etapa é medida por g_profiler e o
+// gráfico é desenhado por cima; sem, o quadro é o do exemplo original.
+//------------------------------------------------------------------------------
+static void loop(bool profile, const char *csvFile, int maxFrames)
+{
+  MY_LOG_TRACE(">>> loop(profile = %s, csvFile = \"%s\", maxFrames = %d)", profile ? "true" : "false", csvFile ? csvFile : "", maxFrames);
+
+  mat4 mvpMatrix;
+  compute_mvp(mvpMatrix);
+
+  if (profile)
+  {
+    const float graphLeft = -1.0f + 2.0f * (float)GRAPH_MARGIN / (float)WINDOW_WIDTH;
+    const float graphBottom = -1.0f + 2.0f * (float)GRAPH_MARGIN / (float)WINDOW_HEIGHT;
+    if (!MyFrameProfiler_initialize(&g_profiler)
+      || (csvFile && !MyFrameProfiler_open_csv(&g_profiler, csvFile))
+      || !MyFrameGraph_initialize(&g_frameGraph, graphLeft, graphBottom,
+        2.0f * (float)GRAPH_WIDTH / (float)WINDOW_WIDTH, 2.0f * (float)GRAPH_HEIGHT / (float)WINDOW_HEIGHT))
+    {
+      MY_LOG_TRACE("<<< loop()");
+      return;
+    }
+  }
+
+  MY_LOG_DEBUG("\tExibindo triângulo colorido...");
+  char windowTitle[WINDOW_TITLE_MAX_LENGTH] = { 0 };
+  Uint64 frames = 0;
   SDL_Event event;
   bool isRunning = true;
-  while (isRunning)
+  while (isRunning && (maxFrames <= 0 || frames < (Uint64)maxFrames))
   {
     while (SDL_PollEvent(&event))
     {
@@ -321,18 +554,782 @@ static void loop(void)
       }
     }
 
+    if (!profile)
+    {
+      glClearColor(0.25f, 0.25f, 0.25f, 1.0f);
+      glClear(GL_COLOR_BUFFER_BIT);
+
+      glUseProgram(g_shaderProgram);
+      glUniformMatrix4fv(g_mvp, 1, GL_FALSE, (const GLfloat *)mvpMatrix);
+      glBindVertexArray(g_vao);
+      glDrawArrays(GL_TRIANGLES, 0, 3);
+
+      SDL_GL_SwapWindow(g_window.window);
+      ++frames;
+      continue;
+    }
+
+    MyFrameProfiler_begin_frame(&g_profiler);
+
+    MyFrameProfiler_begin_section(&g_profiler, MY_PROFILER_CLEAR);
     glClearColor(0.25f, 0.25f, 0.25f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
+    MyFrameProfiler_end_section(&g_profiler, MY_PROFILER_CLEAR);
 
+    MyFrameProfiler_begin_section(&g_profiler, MY_PROFILER_DRAW);
     glUseProgram(g_shaderProgram);
     glUniformMatrix4fv(g_mvp, 1, GL_FALSE, (const GLfloat *)mvpMatrix);
     glBindVertexArray(g_vao);
     glDrawArrays(GL_TRIANGLES, 0, 3);
+    MyFrameProfiler_end_section(&g_profiler, MY_PROFILER_DRAW);
+
+    MyFrameProfiler_begin_section(&g_profiler, MY_PROFILER_OVERLAY);
+    MyFrameGraph_draw(&g_frameGraph, &g_profiler);
+    MyFrameProfiler_end_section(&g_profiler, MY_PROFILER_OVERLAY);
+
+    MyFrameProfiler_begin_section(&g_profiler, MY_PROFILER_SWAP);
+    SDL_GL_SwapWindow(g_window.window);
+    MyFrameProfiler_end_section(&g_profiler, MY_PROFILER_SWAP);
+
+    MyFrameProfiler_end_frame(&g_profiler);
+    ++frames;
+
+    const MyFrameProfile *last = MyFrameProfiler_get_history(&g_profiler, 0);
+    if (last)
+    {
+      snprintf(windowTitle, WINDOW_TITLE_MAX_LENGTH, "%s - CPU %.2f ms | GPU %.2f ms (quadro %llu)",
+        WINDOW_TITLE, last->cpuFrameMS, last->gpuFrameMS, (unsigned long long)last->frameIndex);
+      SDL_SetWindowTitle(g_window.window, windowTitle);
+    }
+  }
+
+  if (profile)
+  {
+    MyFrameProfiler_flush(&g_profiler);
+
+    const Uint64 count = g_profiler.completedCount;
+    if (count > 0)
+    {
+      MY_LOG_INFO("\t%llu quadro(s); médias por etapa (CPU / GPU):", (unsigned long long)count);
+      for (int s = 0; s < MY_PROFILER_SECTION_COUNT; ++s)
+      {
+        MY_LOG_INFO("\t\t%-8s %8.3f ms / %8.3f ms", MyFrameProfiler_get_section_name((MyProfilerSection)s),
+          g_profiler.sum.cpuMS[s] / (double)count, g_profiler.sum.gpuMS[s] / (double)count);
+      }
+      MY_LOG_INFO("\t\t%-8s %8.3f ms / %8.3f ms", "quadro",
+        g_profiler.sum.cpuFrameMS / (double)count, g_profiler.sum.gpuFrameMS / (double)count);
+      MY_LOG_INFO("\tEsperas por consultas: %llu.", (unsigned long long)g_profiler.stallCount);
+    }
+
+    MyFrameGraph_destroy(&g_frameGraph);
+    MyFrameProfiler_destroy(&g_profiler);
+  }
+
+  MY_LOG_TRACE("<<< loop()");
+}
+
+//------------------------------------------------------------------------------
+// Modo instanciado. O tempo de CPU vai do início do quadro até o retorno de
+// SDL_GL_SwapWindow() (inclui uma eventual espera do driver); o de GPU é o da
+// limpeza + desenho, medido com GL_TIME_ELAPSED e lido alguns quadros depois.
+//------------------------------------------------------------------------------
+static void loop_instanced(int count, int maxFrames)
+{
+  MY_LOG_TRACE(">>> loop_instanced(count = %d, maxFrames = %d)", count, maxFrames);
+
+  mat4 mvpMatrix;
+  compute_mvp(mvpMatrix);
+
+  // Área visível no plano z = 0, onde ficam as instâncias.
+  const float halfHeight = CAMERA_DISTANCE * SDL_tanf(glm_rad(CAMERA_FOV_DEGREES) * 0.5f);
+  const float halfWidth = halfHeight * (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT;
+
+  if (!MyInstancedTriangles_initialize(&g_instanced, g_vbo, count, halfWidth, halfHeight)
+    || !MyGpuTimer_initialize(&g_gpuTimer))
+  {
+    MY_LOG_TRACE("<<< loop_instanced()");
+    return;
+  }
+
+  // Sem sincronização vertical, para medir o custo real de cada quadro.
+  SDL_GL_SetSwapInterval(0);
+
+  char windowTitle[WINDOW_TITLE_MAX_LENGTH] = { 0 };
+  Uint64 cpuTotalNS = 0;
+  Uint64 frames = 0;
+
+  const Uint64 startNS = SDL_GetTicksNS();
+  bool isRunning = true;
+  while (isRunning && (maxFrames <= 0 || frames < (Uint64)maxFrames))
+  {
+    SDL_Event event;
+    while (SDL_PollEvent(&event))
+    {
+      if (event.type == SDL_EVENT_QUIT)
+        isRunning = false;
+    }
+
+    const Uint64 t0 = SDL_GetTicksNS();
+    const float seconds = (float)((double)(t0 - startNS) / SDL_NS_PER_SECOND);
+
+    MyGpuTimer_begin(&g_gpuTimer);
+    glClearColor(0.25f, 0.25f, 0.25f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    MyInstancedTriangles_draw(&g_instanced, mvpMatrix, seconds);
+    MyGpuTimer_end(&g_gpuTimer);
+
+    SDL_GL_SwapWindow(g_window.window);
+    MyGpuTimer_poll(&g_gpuTimer);
+
+    const Uint64 t1 = SDL_GetTicksNS();
+    cpuTotalNS += t1 - t0;
+    ++frames;
+
+    snprintf(windowTitle, WINDOW_TITLE_MAX_LENGTH, "%s - %d instâncias | CPU %.2f ms | GPU %.2f ms",
+      WINDOW_TITLE, g_instanced.count, (double)(t1 - t0) / SDL_NS_PER_MS, (double)g_gpuTimer.lastNS / SDL_NS_PER_MS);
+    SDL_SetWindowTitle(g_window.window, windowTitle);
+  }
+
+  // Espera a GPU terminar para ler as últimas consultas.
+  glFinish();
+  MyGpuTimer_poll(&g_gpuTimer);
+
+  if (frames > 0)
+  {
+    MY_LOG_INFO("\t%llu quadro(s), %d instâncias: CPU %.3f ms, GPU %.3f ms (médias por quadro); %llu espera(s) por consultas.",
+      (unsigned long long)frames, g_instanced.count,
+      (double)cpuTotalNS / ((double)SDL_NS_PER_MS * frames),
+      g_gpuTimer.resultCount ? (double)g_gpuTimer.totalNS / ((double)SDL_NS_PER_MS * g_gpuTimer.resultCount) : 0.0,
+      (unsigned long long)g_gpuTimer.stallCount);
+  }
+
+  MyGpuTimer_destroy(&g_gpuTimer);
+  MyInstancedTriangles_destroy(&g_instanced);
+
+  MY_LOG_TRACE("<<< loop_instanced()");
+}
+
+//------------------------------------------------------------------------------
+// Modo cena. O tempo de CPU vai do início do quadro até o retorno de
+// SDL_GL_SwapWindow(); atualização e descarte são medidos pela cena.
+//------------------------------------------------------------------------------
+static void loop_scene(int count, int maxFrames)
+{
+  MY_LOG_TRACE(">>> loop_scene(count = %d, maxFrames = %d)", count, maxFrames);
+
+  if (!MyScene_initialize(&g_scene, count, g_vbo))
+  {
+    MY_LOG_TRACE("<<< loop_scene()");
+    return;
+  }
+
+  MY_LOG_DEBUG("\tCriando %d objetos...", g_scene.capacity);
+  SDL_srand(SCENE_SEED);
+  for (int i = 0; i < g_scene.capacity; ++i)
+  {
+    const float x = (2.0f * SDL_randf() - 1.0f) * SCENE_HALF_EXTENT;
+    const float y = (2.0f * SDL_randf() - 1.0f) * SCENE_HALF_EXTENT;
+    const float z = -SDL_randf() * SCENE_DEPTH;
+    const float scale = 0.3f + 0.7f * SDL_randf();
+    const float angle = SDL_randf() * 2.0f * SDL_PI_F;
+    // Cores claras: cada canal em [96, 255].
+    const Uint32 color = SDL_rand_bits() | 0xFF606060u;
+    MyScene_add(&g_scene, x, y, z, scale, angle, TRIANGLE_RADIUS, color);
+  }
+
+  vec3 cameraPos = { 0.0f, 0.0f, CAMERA_DISTANCE };
+  mat4 viewProjection;
+  compute_view_projection(cameraPos, viewProjection);
+  MyScene_set_view_projection(&g_scene, viewProjection);
+
+  SDL_GL_SetSwapInterval(0);
+
+  char windowTitle[WINDOW_TITLE_MAX_LENGTH] = { 0 };
+  Uint64 updateTotalNS = 0;
+  Uint64 cullTotalNS = 0;
+  Uint64 cpuTotalNS = 0;
+  Uint64 drawnTotal = 0;
+  Uint64 updatedTotal = 0;
+  Uint64 frames = 0;
+
+  Uint64 previousNS = SDL_GetTicksNS();
+  bool isRunning = true;
+  while (isRunning && (maxFrames <= 0 || frames < (Uint64)maxFrames))
+  {
+    SDL_Event event;
+    while (SDL_PollEvent(&event))
+    {
+      if (event.type == SDL_EVENT_QUIT)
+        isRunning = false;
+    }
+
+    const Uint64 t0 = SDL_GetTicksNS();
+    const float dt = (float)((double)(t0 - previousNS) / SDL_NS_PER_SECOND);
+    previousNS = t0;
+
+    const bool *keys = SDL_GetKeyboardState(NULL);
+    const float step = SCENE_CAMERA_SPEED * dt;
+    vec3 move = {
+      (keys[SDL_SCANCODE_RIGHT] ? step : 0.0f) - (keys[SDL_SCANCODE_LEFT] ? step : 0.0f),
+      (keys[SDL_SCANCODE_UP] ? step : 0.0f) - (keys[SDL_SCANCODE_DOWN] ? step : 0.0f),
+      (keys[SDL_SCANCODE_S] ? step : 0.0f) - (keys[SDL_SCANCODE_W] ? step : 0.0f),
+    };
+    if (move[0] != 0.0f || move[1] != 0.0f || move[2] != 0.0f)
+    {
+      glm_vec3_add(cameraPos, move, cameraPos);
+      compute_view_projection(cameraPos, viewProjection);
+      MyScene_set_view_projection(&g_scene, viewProjection);
+    }
+
+    for (int i = 0; i < g_scene.count; i += SCENE_ANIMATED_STRIDE)
+      MyScene_set_angle(&g_scene, i, g_scene.angle[i] + dt);
+
+    MyScene_update(&g_scene);
+    MyScene_cull(&g_scene);
+
+    glClearColor(0.25f, 0.25f, 0.25f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    MyScene_draw(&g_scene);
+    SDL_GL_SwapWindow(g_window.window);
+
+    const Uint64 t1 = SDL_GetTicksNS();
+    const MySceneStats *stats = &g_scene.stats;
+    updateTotalNS += stats->updateNS;
+    cullTotalNS += stats->cullNS;
+    cpuTotalNS += t1 - t0;
+    drawnTotal += (Uint64)stats->drawnCount;
+    updatedTotal += (Uint64)stats->updatedCount;
+    ++frames;
+
+    snprintf(windowTitle, WINDOW_TITLE_MAX_LENGTH, "%s - %d desenhados, %d descartados | %d atualizados em %.3f ms | descarte %.3f ms | CPU %.2f ms",
+      WINDOW_TITLE, stats->drawnCount, stats->culledCount, stats->updatedCount, (double)stats->updateNS / SDL_NS_PER_MS,
+      (double)stats->cullNS / SDL_NS_PER_MS, (double)(t1 - t0) / SDL_NS_PER_MS);
+    SDL_SetWindowTitle(g_window.window, windowTitle);
+  }
+
+  if (frames > 0)
+  {
+    MY_LOG_INFO("\t%llu quadro(s), %d objetos: %.0f desenhados, %.0f atualizados (médias por quadro).",
+      (unsigned long long)frames, g_scene.count, (double)drawnTotal / frames, (double)updatedTotal / frames);
+    MY_LOG_INFO("\tAtualização %.3f ms, descarte %.3f ms, CPU %.3f ms (médias por quadro).",
+      (double)updateTotalNS / ((double)SDL_NS_PER_MS * frames),
+      (double)cullTotalNS / ((double)SDL_NS_PER_MS * frames),
+      (double)cpuTotalNS / ((double)SDL_NS_PER_MS * frames));
+  }
+
+  MyScene_destroy(&g_scene);
+
+  MY_LOG_TRACE("<<< loop_scene()");
+}
+
+//------------------------------------------------------------------------------
+// Malha OBJ. A matriz do modelo leva a esfera envolvente da malha para a
+// origem com raio 1 e gira em torno de Y.
+//------------------------------------------------------------------------------
+static void loop_mesh(const char *filename, int maxFrames)
+{
+  MY_LOG_TRACE(">>> loop_mesh(\"%s\", maxFrames = %d)", filename, maxFrames);
+
+  if (!MyMesh_load_obj(&g_mesh, filename))
+  {
+    MY_LOG_TRACE("<<< loop_mesh()");
+    return;
+  }
+
+  vec3 cameraPos = { 0.0f, 0.0f, CAMERA_DISTANCE };
+  mat4 viewProjection;
+  compute_view_projection(cameraPos, viewProjection);
+
+  vec3 offset;
+  glm_vec3_negate_to(g_mesh.center, offset);
+  mat4 normalizeMatrix;
+  glm_scale_make(normalizeMatrix, (vec3){ 1.0f / g_mesh.radius, 1.0f / g_mesh.radius, 1.0f / g_mesh.radius });
+  glm_translate(normalizeMatrix, offset);
+
+  glEnable(GL_DEPTH_TEST);
+  SDL_GL_SetSwapInterval(0);
+
+  char windowTitle[WINDOW_TITLE_MAX_LENGTH] = { 0 };
+  Uint64 cpuTotalNS = 0;
+  Uint64 frames = 0;
+
+  const Uint64 startNS = SDL_GetTicksNS();
+  bool isRunning = true;
+  while (isRunning && (maxFrames <= 0 || frames < (Uint64)maxFrames))
+  {
+    SDL_Event event;
+    while (SDL_PollEvent(&event))
+    {
+      if (event.type == SDL_EVENT_QUIT)
+        isRunning = false;
+    }
+
+    const Uint64 t0 = SDL_GetTicksNS();
+    const float seconds = (float)((double)(t0 - startNS) / SDL_NS_PER_SECOND);
+
+    mat4 rotation;
+    glm_rotate_make(rotation, seconds * 0.5f, (vec3){ 0.0f, 1.0f, 0.0f });
+    mat4 modelMatrix;
+    glm_mat4_mul(rotation, normalizeMatrix, modelMatrix);
+    mat4 mvpMatrix;
+    glm_mat4_mul(viewProjection, modelMatrix, mvpMatrix);
+
+    glClearColor(0.25f, 0.25f, 0.25f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    MyMesh_draw(&g_mesh, mvpMatrix, rotation);
+    SDL_GL_SwapWindow(g_window.window);
+
+    const Uint64 t1 = SDL_GetTicksNS();
+    cpuTotalNS += t1 - t0;
+    ++frames;
+
+    snprintf(windowTitle, WINDOW_TITLE_MAX_LENGTH, "%s - %s | %d triângulos | CPU %.2f ms",
+      WINDOW_TITLE, filename, g_mesh.stats.triangleCount, (double)(t1 - t0) / SDL_NS_PER_MS);
+    SDL_SetWindowTitle(g_window.window, windowTitle);
+  }
+
+  if (frames > 0)
+  {
+    MY_LOG_INFO("\t%llu quadro(s), %d triângulos: CPU %.3f ms (média por quadro).",
+      (unsigned long long)frames, g_mesh.stats.triangleCount, (double)cpuTotalNS / ((double)SDL_NS_PER_MS * frames));
+  }
+
+  glDisable(GL_DEPTH_TEST);
+  MyMesh_destroy(&g_mesh);
+
+  MY_LOG_TRACE("<<< loop_mesh()");
+}
+
+//------------------------------------------------------------------------------
+// Triângulos em grade que giram e ondulam com o tempo, escritos direto na
+// memória mapeada do VBO (apenas escrita, em ordem: a memória pode não ter
+// cache para leitura).
+//------------------------------------------------------------------------------
+void write_wave_triangles(GLfloat *dst, int count, float halfWidth, float halfHeight, float seconds)
+{
+  // Vértices do triângulo original, antes de escala e rotação.
+  static const float CORNERS[3][2] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.0f, 0.5f } };
+
+  const int cols = SDL_max(1, (int)SDL_ceil(SDL_sqrt((double)count * halfWidth / halfHeight)));
+  const int rows = (count + cols - 1) / cols;
+  const float cellWidth = 2.0f * halfWidth / (float)cols;
+  const float cellHeight = 2.0f * halfHeight / (float)rows;
+  const float scale = SDL_min(cellWidth, cellHeight) * 0.65f;
+
+  for (int i = 0; i < count; ++i)
+  {
+    const float u = ((float)(i % cols) + 0.5f) / (float)cols;
+    const float v = ((float)(i / cols) + 0.5f) / (float)rows;
+    const float wave = SDL_sinf(seconds * 2.0f + u * 12.0f);
+    const float cx = (2.0f * u - 1.0f) * halfWidth;
+    const float cy = (1.0f - 2.0f * v) * halfHeight + wave * cellHeight;
+
+    const float angle = seconds + (u + v) * 6.0f;
+    const float c = SDL_cosf(angle) * scale;
+    const float s = SDL_sinf(angle) * scale;
+
+    for (int k = 0; k < 3; ++k)
+    {
+      *dst++ = cx + CORNERS[k][0] * c - CORNERS[k][1] * s;
+      *dst++ = cy + CORNERS[k][0] * s + CORNERS[k][1] * c;
+      *dst++ = 0.0f;
+      *dst++ = u;
+      *dst++ = v;
+      *dst++ = wave * 0.5f + 0.5f;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Modo fluxo. Todos os triângulos são regravados a cada quadro e desenhados
+// com o programa do triângulo, a partir da posição devolvida pelo fluxo.
+//------------------------------------------------------------------------------
+static void loop_stream(int count, MyVertexStreamMode mode, int maxFrames)
+{
+  MY_LOG_TRACE(">>> loop_stream(count = %d, %s, maxFrames = %d)", count, MyVertexStream_get_mode_name(mode), maxFrames);
+
+  mat4 mvpMatrix;
+  compute_mvp(mvpMatrix);
+
+  const float halfHeight = CAMERA_DISTANCE * SDL_tanf(glm_rad(CAMERA_FOV_DEGREES) * 0.5f);
+  const float halfWidth = halfHeight * (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT;
+
+  count = SDL_min(count, (int)STREAM_MAX_COUNT);
+  const GLsizeiptr frameSize = (GLsizeiptr)count * 3 * VERTEX_SIZE;
+  if (!MyVertexStream_initialize(&g_stream, frameSize, mode))
+  {
+    MY_LOG_TRACE("<<< loop_stream()");
+    return;
+  }
+
+  // Os atributos partem do início do VBO; cada quadro escolhe seus vértices
+  // pelo parâmetro `first` de glDrawArrays(). Os segmentos começam em
+  // múltiplos de VERTEX_SIZE, já que frameSize também é.
+  glGenVertexArrays(1, &g_streamVao);
+  glBindVertexArray(g_streamVao);
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, g_stream.vbo);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE, (GLvoid *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE, (GLvoid *)(3 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+  glBindVertexArray(0);
+
+  SDL_GL_SetSwapInterval(0);
+
+  char windowTitle[WINDOW_TITLE_MAX_LENGTH] = { 0 };
+  Uint64 writeTotalNS = 0;
+  Uint64 cpuTotalNS = 0;
+  Uint64 frames = 0;
 
+  const Uint64 startNS = SDL_GetTicksNS();
+  bool isRunning = true;
+  while (isRunning && (maxFrames <= 0 || frames < (Uint64)maxFrames))
+  {
+    SDL_Event event;
+    while (SDL_PollEvent(&event))
+    {
+      if (event.type == SDL_EVENT_QUIT)
+        isRunning = false;
+    }
+
+    const Uint64 t0 = SDL_GetTicksNS();
+    const float seconds = (float)((double)(t0 - startNS) / SDL_NS_PER_SECOND);
+
+    GLintptr offset = 0;
+    GLfloat *dst = (GLfloat *)MyVertexStream_map(&g_stream, frameSize, &offset);
+    if (!dst)
+    {
+      MY_LOG_ERROR("\t*** Erro ao mapear %lld bytes do fluxo.", (long long)frameSize);
+      break;
+    }
+    write_wave_triangles(dst, count, halfWidth, halfHeight, seconds);
+    MyVertexStream_unmap(&g_stream);
+    const Uint64 t1 = SDL_GetTicksNS();
+
+    glClearColor(0.25f, 0.25f, 0.25f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glUseProgram(g_shaderProgram);
+    glUniformMatrix4fv(g_mvp, 1, GL_FALSE, (const GLfloat *)mvpMatrix);
+    glBindVertexArray(g_streamVao);
+    glDrawArrays(GL_TRIANGLES, (GLint)(offset / VERTEX_SIZE), count * 3);
+
+    MyVertexStream_end_frame(&g_stream);
     SDL_GL_SwapWindow(g_window.window);
+
+    const Uint64 t2 = SDL_GetTicksNS();
+    writeTotalNS += t1 - t0;
+    cpuTotalNS += t2 - t0;
+    ++frames;
+
+    snprintf(windowTitle, WINDOW_TITLE_MAX_LENGTH, "%s - %s | %.2f MiB/quadro | escrita %.2f ms | CPU %.2f ms | %llu espera(s)",
+      WINDOW_TITLE, MyVertexStream_get_mode_name(mode), (double)g_stream.stats.frameBytes / (1024.0 * 1024.0),
+      (double)(t1 - t0) / SDL_NS_PER_MS, (double)(t2 - t0) / SDL_NS_PER_MS, (unsigned long long)g_stream.stats.waitCount);
+    SDL_SetWindowTitle(g_window.window, windowTitle);
+  }
+
+  if (frames > 0)
+  {
+    MY_LOG_INFO("\t%llu quadro(s), %s: %.2f MiB/quadro, escrita %.3f ms, CPU %.3f ms (médias por quadro).",
+      (unsigned long long)frames, MyVertexStream_get_mode_name(mode),
+      (double)g_stream.stats.totalBytes / (1024.0 * 1024.0 * frames),
+      (double)writeTotalNS / ((double)SDL_NS_PER_MS * frames),
+      (double)cpuTotalNS / ((double)SDL_NS_PER_MS * frames));
+    MY_LOG_INFO("\tEsperas por cercas: %llu (%.3f ms no total).",
+      (unsigned long long)g_stream.stats.waitCount, (double)g_stream.stats.waitNS / SDL_NS_PER_MS);
+  }
+
+  glDeleteVertexArrays(1, &g_streamVao);
+  g_streamVao = 0;
+  MyVertexStream_destroy(&g_stream);
+
+  MY_LOG_TRACE("<<< loop_stream()");
+}
+
+//------------------------------------------------------------------------------
+// Pixels (R, G e B) diferentes entre duas superfícies RGBA32 do mesmo tamanho.
+//------------------------------------------------------------------------------
+static Uint64 count_different_pixels(SDL_Surface *a, SDL_Surface *b, int *maxDifference)
+{
+  Uint64 count = 0;
+  *maxDifference = 0;
+  for (int y = 0; y < a->h; ++y)
+  {
+    const Uint8 *rowA = (const Uint8 *)a->pixels + (size_t)y * a->pitch;
+    const Uint8 *rowB = (const Uint8 *)b->pixels + (size_t)y * b->pitch;
+    for (int x = 0; x < a->w * 4; x += 4)
+    {
+      bool different = false;
+      for (int c = 0; c < 3; ++c)
+      {
+        const int difference = SDL_abs((int)rowA[x + c] - (int)rowB[x + c]);
+        *maxDifference = SDL_max(*maxDifference, difference);
+        different = different || difference != 0;
+      }
+      count += different;
+    }
+  }
+
+  return count;
+}
+
+//------------------------------------------------------------------------------
+// Blur de `image` na GPU (resultado em `gpuResult`) e na CPU (`cpuResult`),
+// com a comparação dos dois. O tempo de GPU é a média de BLUR_RUNS - 1
+// execuções (a primeira pode incluir a compilação tardia dos shaders em
+// alguns drivers); o de "ida e volta" inclui o envio da imagem e a leitura.
+//------------------------------------------------------------------------------
+static bool compare_blur(SDL_Surface *image, SDL_Surface *gpuResult, SDL_Surface *cpuResult, Uint32 size)
+{
+  if (!MyGpuBlur_initialize(&g_gpuBlur, image->w, image->h) || !MyGpuTimer_initialize(&g_gpuTimer))
+    return false;
+
+  MY_LOG_DEBUG("\tBlur na GPU (%dx%d, filtro %ux%u)...", image->w, image->h, size, size);
+  const Uint64 t0 = SDL_GetTicksNS();
+  MyGpuBlur_upload(&g_gpuBlur, image);
+  for (int run = 0; run < BLUR_RUNS; ++run)
+  {
+    MyGpuTimer_begin(&g_gpuTimer);
+    MyGpuBlur_apply(&g_gpuBlur, size);
+    MyGpuTimer_end(&g_gpuTimer);
+
+    // Descarta a primeira medição.
+    if (run == 0)
+    {
+      glFinish();
+      MyGpuTimer_poll(&g_gpuTimer);
+      g_gpuTimer.totalNS = 0;
+      g_gpuTimer.resultCount = 0;
+    }
+  }
+  const bool gpuOk = MyGpuBlur_read(&g_gpuBlur, gpuResult);
+  const Uint64 t1 = SDL_GetTicksNS();
+
+  glFinish();
+  MyGpuTimer_poll(&g_gpuTimer);
+  if (!gpuOk)
+  {
+    MY_LOG_ERROR("\t*** Erro ao ler o resultado da GPU.");
+    return false;
+  }
+
+  MY_LOG_DEBUG("\tBlur na CPU (MyFilter_blur)...");
+  MyThreadPool threadPool;
+  const bool hasThreadPool = MyThreadPool_initialize(&threadPool, 0);
+  const int threadCount = hasThreadPool ? MyThreadPool_get_thread_count(&threadPool) : 1;
+
+  const Uint64 t2 = SDL_GetTicksNS();
+  const bool cpuOk = MyFilter_blur(image, cpuResult, size, hasThreadPool ? &threadPool : NULL);
+  const Uint64 t3 = SDL_GetTicksNS();
+
+  if (hasThreadPool)
+    MyThreadPool_destroy(&threadPool);
+  if (!cpuOk)
+    return false;
+
+  int maxDifference = 0;
+  const Uint64 different = count_different_pixels(gpuResult, cpuResult, &maxDifference);
+
+  MY_LOG_INFO("\tGPU: %.3f ms por blur (média de %llu), %.3f ms ida e volta (%d blurs).",
+    g_gpuTimer.resultCount ? (double)g_gpuTimer.totalNS / ((double)SDL_NS_PER_MS * g_gpuTimer.resultCount) : 0.0,
+    (unsigned long long)g_gpuTimer.resultCount, (double)(t1 - t0) / SDL_NS_PER_MS, (int)BLUR_RUNS);
+  MY_LOG_INFO("\tCPU: %.3f ms (%d thread(s)).", (double)(t3 - t2) / SDL_NS_PER_MS, threadCount);
+  MY_LOG_INFO("\tVerificação: %s (%llu pixel(s) diferente(s), diferença máxima %d).",
+    different == 0 ? "resultados idênticos" : "*** resultados diferentes", (unsigned long long)different, maxDifference);
+
+  return different == 0;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static bool run_blur(Uint32 size, const char *filename)
+{
+  MY_LOG_TRACE(">>> run_blur(size = %u, \"%s\")", size, filename);
+
+  SDL_Surface *loaded = IMG_Load(filename);
+  if (!loaded)
+  {
+    MY_LOG_ERROR("\t*** Erro ao carregar \"%s\": %s", filename, SDL_GetError());
+    MY_LOG_TRACE("<<< run_blur()");
+    return false;
   }
 
-  SDL_Log("<<< loop()");
+  SDL_Surface *image = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+  SDL_DestroySurface(loaded);
+  SDL_Surface *gpuResult = image ? SDL_CreateSurface(image->w, image->h, SDL_PIXELFORMAT_RGBA32) : NULL;
+  SDL_Surface *cpuResult = image ? SDL_CreateSurface(image->w, image->h, SDL_PIXELFORMAT_RGBA32) : NULL;
+
+  bool ok = false;
+  if (!image || !gpuResult || !cpuResult)
+    MY_LOG_ERROR("\t*** Erro ao criar superfícies: %s", SDL_GetError());
+  else
+    ok = compare_blur(image, gpuResult, cpuResult, size);
+
+  if (g_gpuTimer.queries[0])
+    MyGpuTimer_destroy(&g_gpuTimer);
+  if (g_gpuBlur.vao)
+    MyGpuBlur_destroy(&g_gpuBlur);
+  SDL_DestroySurface(cpuResult);
+  SDL_DestroySurface(gpuResult);
+  SDL_DestroySurface(image);
+
+  MY_LOG_TRACE("<<< run_blur()");
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+// Função de entrega do MyReadback: grava o quadro de cima para baixo (as
+// linhas chegam de baixo para cima).
+//------------------------------------------------------------------------------
+static void write_frame(void *userdata, const Uint8 *pixels, int width, int height, Uint64 frameIndex)
+{
+  FrameWriter *writer = (FrameWriter *)userdata;
+  if (writer->failed)
+    return;
+
+  const size_t rowSize = (size_t)width * 4;
+  if (writer->stream)
+  {
+    for (int y = height - 1; y >= 0; --y)
+      writer->failed = writer->failed || fwrite(pixels + (size_t)y * rowSize, 1, rowSize, writer->stream) != rowSize;
+    writer->bytesWritten += rowSize * height;
+  }
+
+  if (writer->directory)
+  {
+    char path[OFFSCREEN_PATH_MAX_LENGTH];
+    SDL_snprintf(path, OFFSCREEN_PATH_MAX_LENGTH, "%s/frame_%05llu.ppm", writer->directory, (unsigned long long)frameIndex);
+    SDL_IOStream *file = SDL_IOFromFile(path, "wb");
+    if (!file)
+    {
+      MY_LOG_ERROR("\t*** Erro ao criar \"%s\": %s", path, SDL_GetError());
+      writer->failed = true;
+      return;
+    }
+
+    writer->failed = SDL_IOprintf(file, "P6\n%d %d\n255\n", width, height) == 0;
+    for (int y = height - 1; y >= 0; --y)
+    {
+      const Uint8 *src = pixels + (size_t)y * rowSize;
+      for (int x = 0; x < width; ++x)
+      {
+        writer->row[x * 3 + 0] = src[x * 4 + 0];
+        writer->row[x * 3 + 1] = src[x * 4 + 1];
+        writer->row[x * 3 + 2] = src[x * 4 + 2];
+      }
+      writer->failed = writer->failed || SDL_WriteIO(file, writer->row, (size_t)width * 3) != (size_t)width * 3;
+    }
+    writer->bytesWritten += (size_t)width * height * 3;
+    writer->failed = !SDL_CloseIO(file) || writer->failed;
+  }
+
+  if (writer->failed)
+    MY_LOG_ERROR("\t*** Erro ao gravar o quadro %llu.", (unsigned long long)frameIndex);
+}
+
+//------------------------------------------------------------------------------
+// Modo offscreen. O tempo de cada quadro avança 1/OFFSCREEN_FRAMES_PER_SECOND,
+// independente do tempo real, então a saída é sempre a mesma.
+//------------------------------------------------------------------------------
+static void run_offscreen(int count, int frameCount, const char *output)
+{
+  MY_LOG_TRACE(">>> run_offscreen(count = %d, frameCount = %d, \"%s\")", count, frameCount, output ? output : "");
+
+  FrameWriter writer = { 0 };
+  if (output && SDL_strcmp(output, "-") == 0)
+  {
+#ifdef _WIN32
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    writer.stream = stdout;
+  }
+  else if (output)
+  {
+    writer.directory = output;
+    SDL_CreateDirectory(output);
+    writer.row = (Uint8 *)SDL_malloc((size_t)WINDOW_WIDTH * 3);
+    if (!writer.row)
+    {
+      MY_LOG_TRACE("<<< run_offscreen()");
+      return;
+    }
+  }
+
+  mat4 mvpMatrix;
+  compute_mvp(mvpMatrix);
+
+  const float halfHeight = CAMERA_DISTANCE * SDL_tanf(glm_rad(CAMERA_FOV_DEGREES) * 0.5f);
+  const float halfWidth = halfHeight * (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT;
+
+  MY_LOG_DEBUG("\tCriando framebuffer %dx%d...", WINDOW_WIDTH, WINDOW_HEIGHT);
+  glGenRenderbuffers(1, &g_offscreenColor);
+  glBindRenderbuffer(GL_RENDERBUFFER, g_offscreenColor);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, WINDOW_WIDTH, WINDOW_HEIGHT);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glGenFramebuffers(1, &g_offscreenFbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, g_offscreenFbo);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, g_offscreenColor);
+  const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+  if (!complete
+    || !MyInstancedTriangles_initialize(&g_instanced, g_vbo, count, halfWidth, halfHeight)
+    || !MyReadback_initialize(&g_readback, WINDOW_WIDTH, WINDOW_HEIGHT, write_frame, &writer))
+  {
+    if (!complete)
+      MY_LOG_ERROR("\t*** Erro: Framebuffer incompleto.");
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    SDL_free(writer.row);
+    MY_LOG_TRACE("<<< run_offscreen()");
+    return;
+  }
+
+  MY_LOG_DEBUG("\tDesenhando %d quadro(s)...", frameCount);
+  const Uint64 startNS = SDL_GetTicksNS();
+  for (int frame = 0; frame < frameCount && !writer.failed; ++frame)
+  {
+    const float seconds = (float)frame / (float)OFFSCREEN_FRAMES_PER_SECOND;
+
+    // O FBO continua ligado para desenho e leitura (GL_FRAMEBUFFER).
+    glViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+    glClearColor(0.25f, 0.25f, 0.25f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    MyInstancedTriangles_draw(&g_instanced, mvpMatrix, seconds);
+
+    MyReadback_capture(&g_readback);
+    MyReadback_poll(&g_readback);
+  }
+  MyReadback_flush(&g_readback);
+  const Uint64 elapsedNS = SDL_GetTicksNS() - startNS;
+
+  if (writer.stream)
+    fflush(writer.stream);
+
+  const MyReadbackStats *stats = &g_readback.stats;
+  const double seconds = (double)elapsedNS / SDL_NS_PER_SECOND;
+  MY_LOG_INFO("\t%llu quadro(s) lido(s) em %.3f s: %.1f quadros/s, %.1f MiB/s lidos, %.1f MiB gravados.",
+    (unsigned long long)stats->deliveredCount, seconds,
+    seconds > 0.0 ? (double)stats->deliveredCount / seconds : 0.0,
+    seconds > 0.0 ? (double)stats->deliveredCount * WINDOW_WIDTH * WINDOW_HEIGHT * 4 / (1024.0 * 1024.0 * seconds) : 0.0,
+    (double)writer.bytesWritten / (1024.0 * 1024.0));
+  MY_LOG_INFO("\tEsperas por PBO livre: %llu (%.3f ms); entrega (map + gravação): %.3f ms por quadro.",
+    (unsigned long long)stats->stallCount, (double)stats->stallNS / SDL_NS_PER_MS,
+    stats->deliveredCount ? (double)stats->deliverNS / ((double)SDL_NS_PER_MS * stats->deliveredCount) : 0.0);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  MyReadback_destroy(&g_readback);
+  MyInstancedTriangles_destroy(&g_instanced);
+  glDeleteFramebuffers(1, &g_offscreenFbo);
+  glDeleteRenderbuffers(1, &g_offscreenColor);
+  g_offscreenFbo = 0;
+  g_offscreenColor = 0;
+  SDL_free(writer.row);
+
+  MY_LOG_TRACE("<<< run_offscreen()");
 }
 
 //------------------------------------------------------------------------------
@@ -341,11 +1338,74 @@ static void loop(void)
 int main(int argc, char *argv[])
 {
   atexit(shutdown);
+  MyLog_initialize();
+
+  bool instanced = false;
+  bool stream = false;
+  bool blur = false;
+  bool useProgramCache = true;
+  bool offscreen = false;
+  bool profile = false;
+  bool scene = false;
+  const char *meshFile = NULL;
+  const char *csvFile = NULL;
+  const char *output = NULL;
+  const char *imageFile = BLUR_DEFAULT_IMAGE;
+  MyVertexStreamMode streamMode = MY_STREAM_MAP_UNSYNCHRONIZED;
+  int count = 0;
+  int maxFrames = 0;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (SDL_strcmp(argv[i], "--instances") == 0)
+      instanced = true;
+    else if (SDL_strcmp(argv[i], "--stream") == 0)
+      stream = true;
+    else if (SDL_strcmp(argv[i], "--orphan") == 0)
+      streamMode = MY_STREAM_ORPHAN;
+    else if (SDL_strcmp(argv[i], "--blur") == 0)
+      blur = true;
+    else if (SDL_strcmp(argv[i], "--image") == 0 && i + 1 < argc)
+      imageFile = argv[++i];
+    else if (SDL_strcmp(argv[i], "--no-program-cache") == 0)
+      useProgramCache = false;
+    else if (SDL_strcmp(argv[i], "--offscreen") == 0)
+      offscreen = true;
+    else if (SDL_strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+      output = argv[++i];
+    else if (SDL_strcmp(argv[i], "--mesh") == 0)
+      meshFile = i + 1 < argc && argv[i + 1][0] != '-' ? argv[++i] : MESH_DEFAULT_FILE;
+    else if (SDL_strcmp(argv[i], "--scene") == 0)
+      scene = true;
+    else if (SDL_strcmp(argv[i], "--profile") == 0)
+      profile = true;
+    else if (SDL_strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+    {
+      profile = true;
+      csvFile = argv[++i];
+    }
+    else if (SDL_strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+      maxFrames = SDL_atoi(argv[++i]);
+    else
+      count = SDL_atoi(argv[i]);
+  }
 
-  if (initialize() == SDL_APP_FAILURE)
+  if (initialize(blur || offscreen, useProgramCache) == SDL_APP_FAILURE)
     return SDL_APP_FAILURE;
 
-  loop();
+  if (blur)
+    return run_blur(count > 0 ? (Uint32)count : BLUR_DEFAULT_SIZE, imageFile) ? 0 : SDL_APP_FAILURE;
+  else if (offscreen)
+    run_offscreen(count > 0 ? count : INSTANCES_DEFAULT_COUNT, maxFrames > 0 ? maxFrames : OFFSCREEN_DEFAULT_FRAMES, output);
+  else if (instanced)
+    loop_instanced(count > 0 ? count : INSTANCES_DEFAULT_COUNT, maxFrames);
+  else if (meshFile)
+    loop_mesh(meshFile, maxFrames);
+  else if (scene)
+    loop_scene(count > 0 ? count : SCENE_DEFAULT_COUNT, maxFrames);
+  else if (stream)
+    loop_stream(count > 0 ? count : STREAM_DEFAULT_COUNT, streamMode, maxFrames);
+  else
+    loop(profile, csvFile, maxFrames);
 
   return 0;
 }
@@ -0,0 +1,844 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+// mmap() e posix_madvise() não fazem parte do C23 (-std=c23).
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "mesh.h"
+#include "shader.h"
+#include "log.h"
+
+#include <stddef.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//------------------------------------------------------------------------------
+// Vertex shader code.
+//------------------------------------------------------------------------------
+static const char *MESH_VERTEX_SHADER_CODE =
+  "#version 330 core\n"
+  "layout(location = 0) in vec3 a_Pos;\n"
+  "layout(location = 1) in vec3 a_Normal;\n"
+  "out vec3 v_Normal;\n"
+  "uniform mat4 u_MVPMatrix;\n"
+  "uniform mat4 u_ModelMatrix;\n"
+  "void main() {\n"
+  "  gl_Position = u_MVPMatrix * vec4(a_Pos, 1.0);\n"
+  "  v_Normal = mat3(u_ModelMatrix) * a_Normal;\n"
+  "}\0";
+
+//------------------------------------------------------------------------------
+// Fragment shader code.
+//------------------------------------------------------------------------------
+static const char *MESH_FRAGMENT_SHADER_CODE =
+  "#version 330 core\n"
+  "in vec3 v_Normal;\n"
+  "out vec4 f_Color;\n"
+  "void main() {\n"
+  "  vec3 light = normalize(vec3(0.4, 0.7, 1.0));\n"
+  "  float diffuse = abs(dot(normalize(v_Normal), light));\n"
+  "  f_Color = vec4(vec3(0.15 + 0.85 * diffuse), 1.0);\n"
+  "}\0";
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+
+// Arquivo mapeado na memória (somente leitura).
+typedef struct MappedFile MappedFile;
+struct MappedFile
+{
+  const char *data;
+  size_t size;
+#ifdef _WIN32
+  HANDLE file;
+  HANDLE mapping;
+#endif
+};
+
+// Entrada da tabela hash: índices (base 1) de posição, textura e normal de um
+// vértice de face e o vértice único correspondente. position == 0: vazia.
+typedef struct VertexSlot VertexSlot;
+struct VertexSlot
+{
+  Uint32 position;
+  Uint32 texcoord;
+  Uint32 normal;
+  Uint32 vertex;
+};
+
+typedef struct ObjParser ObjParser;
+struct ObjParser
+{
+  const char *cursor;
+  const char *end;
+  int line;
+
+  float *positions;
+  size_t positionCount;
+  size_t positionCapacity;
+  float *texcoords;
+  size_t texcoordCount;
+  size_t texcoordCapacity;
+  float *normals;
+  size_t normalCount;
+  size_t normalCapacity;
+
+  MyMeshVertex *vertices;
+  size_t vertexCount;
+  size_t vertexCapacity;
+  Uint32 *indices;
+  size_t indexCount;
+  size_t indexCapacity;
+
+  VertexSlot *table;
+  size_t tableMask;
+
+  Uint64 referenceCount;
+  size_t missingNormalCount;  // Vértices criados sem índice de normal.
+};
+
+enum mesh_constants
+{
+  // Dígitos significativos lidos por número (o resto só conta no expoente).
+  MAX_MANTISSA_DIGITS = 19,
+  MAX_FACE_CORNERS = 64,
+  INITIAL_TABLE_SIZE = 1 << 16,
+};
+
+static const double POWERS_OF_10[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static bool map_file(MappedFile *file, const char *filename);
+static void unmap_file(MappedFile *file);
+static void *grow(void *array, size_t *capacity, size_t needed, size_t elementSize);
+static const char *skip_spaces(const char *p, const char *end);
+static const char *skip_line(const char *p, const char *end);
+static bool parse_float(const char **cursor, const char *end, float *value);
+static bool parse_int(const char **cursor, const char *end, int *value);
+static bool parse_floats(ObjParser *parser, float **array, size_t *count, size_t *capacity, int n);
+static bool resolve_index(int index, size_t count, Uint32 *resolved);
+static bool rehash(ObjParser *parser);
+static bool find_vertex(ObjParser *parser, Uint32 position, Uint32 texcoord, Uint32 normal, Uint32 *vertex);
+static bool parse_face(ObjParser *parser);
+static bool parse_obj(ObjParser *parser);
+static bool compute_normals(ObjParser *parser);
+static void free_parser(ObjParser *parser);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool map_file(MappedFile *file, const char *filename)
+{
+  SDL_zerop(file);
+
+#ifdef _WIN32
+  file->file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file->file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file->file, &size) || size.QuadPart == 0)
+  {
+    CloseHandle(file->file);
+    return false;
+  }
+
+  file->mapping = CreateFileMappingA(file->file, NULL, PAGE_READONLY, 0, 0, NULL);
+  file->data = file->mapping ? (const char *)MapViewOfFile(file->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+  if (!file->data)
+  {
+    if (file->mapping)
+      CloseHandle(file->mapping);
+    CloseHandle(file->file);
+    return false;
+  }
+  file->size = (size_t)size.QuadPart;
+#else
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  // O mapeamento continua válido depois de fechar o descritor.
+  void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+
+  // Leitura sequencial: o kernel pode ler as páginas seguintes antecipadamente.
+  posix_madvise(data, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+  file->data = (const char *)data;
+  file->size = (size_t)info.st_size;
+#endif
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void unmap_file(MappedFile *file)
+{
+  if (!file->data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(file->data);
+  CloseHandle(file->mapping);
+  CloseHandle(file->file);
+#else
+  munmap((void *)file->data, file->size);
+#endif
+
+  SDL_zerop(file);
+}
+
+//------------------------------------------------------------------------------
+// Garante espaço para `needed` elementos, dobrando a capacidade. Retorna o
+// array (talvez realocado) ou NULL, sem liberar o original, se faltar memória.
+//------------------------------------------------------------------------------
+void *grow(void *array, size_t *capacity, size_t needed, size_t elementSize)
+{
+  if (needed <= *capacity)
+    return array;
+
+  size_t newCapacity = SDL_max(*capacity * 2, (size_t)1024);
+  while (newCapacity < needed)
+    newCapacity *= 2;
+
+  void *newArray = SDL_realloc(array, newCapacity * elementSize);
+  if (newArray)
+    *capacity = newCapacity;
+
+  return newArray;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const char *skip_spaces(const char *p, const char *end)
+{
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    ++p;
+
+  return p;
+}
+
+//------------------------------------------------------------------------------
+// Retorna o início da próxima linha.
+//------------------------------------------------------------------------------
+const char *skip_line(const char *p, const char *end)
+{
+  const char *newline = (const char *)memchr(p, '\n', (size_t)(end - p));
+  return newline ? newline + 1 : end;
+}
+
+//------------------------------------------------------------------------------
+// [sinal] dígitos [. dígitos] [e [sinal] dígitos]. Até MAX_MANTISSA_DIGITS
+// dígitos significativos vão para um inteiro de 64 bits, multiplicado ou
+// dividido pela potência de 10 do expoente no fim: um único arredondamento
+// em double para os números usuais de um OBJ, bem abaixo da precisão do float.
+//------------------------------------------------------------------------------
+bool parse_float(const char **cursor, const char *end, float *value)
+{
+  const char *p = skip_spaces(*cursor, end);
+
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+  {
+    negative = *p == '-';
+    ++p;
+  }
+
+  Uint64 mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool anyDigit = false;
+
+  for (; p < end && *p >= '0' && *p <= '9'; ++p)
+  {
+    anyDigit = true;
+    if (digits < MAX_MANTISSA_DIGITS)
+    {
+      mantissa = mantissa * 10 + (Uint64)(*p - '0');
+      digits += mantissa != 0;
+    }
+    else
+    {
+      ++exponent;
+    }
+  }
+
+  if (p < end && *p == '.')
+  {
+    for (++p; p < end && *p >= '0' && *p <= '9'; ++p)
+    {
+      anyDigit = true;
+      if (digits < MAX_MANTISSA_DIGITS)
+      {
+        mantissa = mantissa * 10 + (Uint64)(*p - '0');
+        digits += mantissa != 0;
+        --exponent;
+      }
+    }
+  }
+
+  if (!anyDigit)
+    return false;
+
+  if (p < end && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+    bool negativeExponent = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+      negativeExponent = *p == '-';
+      ++p;
+    }
+
+    int e = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p)
+      e = SDL_min(e * 10 + (*p - '0'), 9999);
+    exponent += negativeExponent ? -e : e;
+  }
+
+  double result = (double)mantissa;
+  const int maxPower = (int)SDL_arraysize(POWERS_OF_10) - 1;
+  for (int e = exponent; e > 0; e -= maxPower)
+    result *= POWERS_OF_10[SDL_min(e, maxPower)];
+  for (int e = -exponent; e > 0; e -= maxPower)
+    result /= POWERS_OF_10[SDL_min(e, maxPower)];
+
+  *value = (float)(negative ? -result : result);
+  *cursor = p;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool parse_int(const char **cursor, const char *end, int *value)
+{
+  const char *p = *cursor;
+
+  bool negative = false;
+  if (p < end && *p == '-')
+  {
+    negative = true;
+    ++p;
+  }
+
+  if (p == end || *p < '0' || *p > '9')
+    return false;
+
+  Sint64 result = 0;
+  for (; p < end && *p >= '0' && *p <= '9'; ++p)
+    result = SDL_min(result * 10 + (*p - '0'), (Sint64)SDL_MAX_SINT32);
+
+  *value = (int)(negative ? -result : result);
+  *cursor = p;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// `n` números de uma linha `v`, `vt` ou `vn` (componentes extras, como o `w`,
+// são ignorados).
+//------------------------------------------------------------------------------
+bool parse_floats(ObjParser *parser, float **array, size_t *count, size_t *capacity, int n)
+{
+  float *values = (float *)grow(*array, capacity, (*count + 1) * (size_t)n, sizeof(float));
+  if (!values)
+    return false;
+  *array = values;
+
+  float *dst = values + *count * (size_t)n;
+  for (int i = 0; i < n; ++i)
+  {
+    if (!parse_float(&parser->cursor, parser->end, &dst[i]))
+      return false;
+  }
+
+  ++*count;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Índice do OBJ (base 1, ou negativo: relativo ao fim) para base 1 validado.
+//------------------------------------------------------------------------------
+bool resolve_index(int index, size_t count, Uint32 *resolved)
+{
+  const Sint64 value = index < 0 ? (Sint64)count + index + 1 : (Sint64)index;
+  if (value < 1 || value > (Sint64)count)
+    return false;
+
+  *resolved = (Uint32)value;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static inline size_t hash_slot(Uint32 position, Uint32 texcoord, Uint32 normal)
+{
+  Uint32 h = position * 0x9E3779B1u ^ texcoord * 0x85EBCA77u ^ normal * 0xC2B2AE3Du;
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  h ^= h >> 12;
+  return (size_t)h;
+}
+
+//------------------------------------------------------------------------------
+// Dobra a tabela e reinsere as entradas.
+//------------------------------------------------------------------------------
+bool rehash(ObjParser *parser)
+{
+  const size_t oldSize = parser->table ? parser->tableMask + 1 : 0;
+  const size_t newSize = oldSize ? oldSize * 2 : (size_t)INITIAL_TABLE_SIZE;
+  VertexSlot *table = (VertexSlot *)SDL_calloc(newSize, sizeof(VertexSlot));
+  if (!table)
+    return false;
+
+  const size_t mask = newSize - 1;
+  for (size_t i = 0; i < oldSize; ++i)
+  {
+    const VertexSlot *slot = &parser->table[i];
+    if (!slot->position)
+      continue;
+
+    size_t j = hash_slot(slot->position, slot->texcoord, slot->normal) & mask;
+    while (table[j].position)
+      j = (j + 1) & mask;
+    table[j] = *slot;
+  }
+
+  SDL_free(parser->table);
+  parser->table = table;
+  parser->tableMask = mask;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Vértice único para a combinação (posição, textura, normal); cria se for
+// nova. A tabela fica no máximo meio cheia (sondagem linear curta).
+//------------------------------------------------------------------------------
+bool find_vertex(ObjParser *parser, Uint32 position, Uint32 texcoord, Uint32 normal, Uint32 *vertex)
+{
+  ++parser->referenceCount;
+
+  size_t i = hash_slot(position, texcoord, normal) & parser->tableMask;
+  while (parser->table[i].position)
+  {
+    const VertexSlot *slot = &parser->table[i];
+    if (slot->position == position && slot->texcoord == texcoord && slot->normal == normal)
+    {
+      *vertex = slot->vertex;
+      return true;
+    }
+    i = (i + 1) & parser->tableMask;
+  }
+
+  MyMeshVertex *vertices = (MyMeshVertex *)grow(parser->vertices, &parser->vertexCapacity, parser->vertexCount + 1, sizeof(MyMeshVertex));
+  if (!vertices)
+    return false;
+  parser->vertices = vertices;
+
+  MyMeshVertex *v = &vertices[parser->vertexCount];
+  SDL_memcpy(v->position, &parser->positions[(position - 1) * 3], sizeof(v->position));
+  if (normal)
+    SDL_memcpy(v->normal, &parser->normals[(normal - 1) * 3], sizeof(v->normal));
+  else
+  {
+    SDL_zeroa(v->normal);
+    ++parser->missingNormalCount;
+  }
+  if (texcoord)
+    SDL_memcpy(v->texcoord, &parser->texcoords[(texcoord - 1) * 2], sizeof(v->texcoord));
+  else
+    SDL_zeroa(v->texcoord);
+
+  *vertex = (Uint32)parser->vertexCount++;
+  parser->table[i] = (VertexSlot){ position, texcoord, normal, *vertex };
+
+  if (parser->vertexCount * 2 > parser->tableMask + 1)
+    return rehash(parser);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// f v1[/vt1][/vn1] v2... : o polígono vira um leque (v1, vk-1, vk).
+//------------------------------------------------------------------------------
+bool parse_face(ObjParser *parser)
+{
+  const char *end = parser->end;
+  Uint32 corners[MAX_FACE_CORNERS];
+  int cornerCount = 0;
+
+  for (;;)
+  {
+    const char *p = skip_spaces(parser->cursor, end);
+    if (p == end || *p == '\n' || *p == '#')
+      break;
+
+    int index = 0;
+    Uint32 position = 0;
+    Uint32 texcoord = 0;
+    Uint32 normal = 0;
+
+    if (!parse_int(&p, end, &index) || !resolve_index(index, parser->positionCount, &position))
+      return false;
+
+    if (p < end && *p == '/')
+    {
+      ++p;
+      if (p < end && *p != '/')
+      {
+        if (!parse_int(&p, end, &index) || !resolve_index(index, parser->texcoordCount, &texcoord))
+          return false;
+      }
+      if (p < end && *p == '/')
+      {
+        ++p;
+        if (!parse_int(&p, end, &index) || !resolve_index(index, parser->normalCount, &normal))
+          return false;
+      }
+    }
+    parser->cursor = p;
+
+    if (cornerCount == MAX_FACE_CORNERS)
+      return false;
+
+    if (!find_vertex(parser, position, texcoord, normal, &corners[cornerCount]))
+      return false;
+    ++cornerCount;
+  }
+
+  if (cornerCount < 3)
+    return false;
+
+  const size_t triangleCount = (size_t)cornerCount - 2;
+  Uint32 *indices = (Uint32 *)grow(parser->indices, &parser->indexCapacity, parser->indexCount + triangleCount * 3, sizeof(Uint32));
+  if (!indices)
+    return false;
+  parser->indices = indices;
+
+  Uint32 *dst = indices + parser->indexCount;
+  for (int k = 2; k < cornerCount; ++k)
+  {
+    *dst++ = corners[0];
+    *dst++ = corners[k - 1];
+    *dst++ = corners[k];
+  }
+  parser->indexCount += triangleCount * 3;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool parse_obj(ObjParser *parser)
+{
+  if (!rehash(parser))
+    return false;
+
+  while (parser->cursor < parser->end)
+  {
+    ++parser->line;
+    const char *p = skip_spaces(parser->cursor, parser->end);
+    const size_t remaining = (size_t)(parser->end - p);
+    bool ok = true;
+
+    if (remaining >= 2 && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t'))
+    {
+      parser->cursor = p + 1;
+      ok = parse_floats(parser, &parser->positions, &parser->positionCount, &parser->positionCapacity, 3);
+    }
+    else if (remaining >= 3 && p[0] == 'v' && p[1] == 't' && (p[2] == ' ' || p[2] == '\t'))
+    {
+      parser->cursor = p + 2;
+      ok = parse_floats(parser, &parser->texcoords, &parser->texcoordCount, &parser->texcoordCapacity, 2);
+    }
+    else if (remaining >= 3 && p[0] == 'v' && p[1] == 'n' && (p[2] == ' ' || p[2] == '\t'))
+    {
+      parser->cursor = p + 2;
+      ok = parse_floats(parser, &parser->normals, &parser->normalCount, &parser->normalCapacity, 3);
+    }
+    else if (remaining >= 2 && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+    {
+      parser->cursor = p + 1;
+      ok = parse_face(parser);
+    }
+    else
+    {
+      parser->cursor = p;
+    }
+
+    if (!ok)
+    {
+      MY_LOG_ERROR("\t*** Erro na linha %d do arquivo OBJ.", parser->line);
+      return false;
+    }
+
+    parser->cursor = skip_line(parser->cursor, parser->end);
+  }
+
+  return parser->indexCount > 0;
+}
+
+//------------------------------------------------------------------------------
+// Normal de cada vértice criado sem índice de normal = soma das normais (não
+// normalizadas, ou seja, ponderadas pela área) das faces que o usam. Vértices
+// com normal do arquivo não mudam.
+//------------------------------------------------------------------------------
+bool compute_normals(ObjParser *parser)
+{
+  // A tabela hash diz quais vértices vieram sem normal (slot->normal == 0).
+  bool *missing = (bool *)SDL_calloc(parser->vertexCount, sizeof(bool));
+  if (!missing)
+    return false;
+
+  for (size_t i = 0; i <= parser->tableMask; ++i)
+  {
+    const VertexSlot *slot = &parser->table[i];
+    if (slot->position && !slot->normal)
+      missing[slot->vertex] = true;
+  }
+
+  MyMeshVertex *vertices = parser->vertices;
+  for (size_t i = 0; i < parser->indexCount; i += 3)
+  {
+    const Uint32 corners[3] = { parser->indices[i], parser->indices[i + 1], parser->indices[i + 2] };
+    if (!missing[corners[0]] && !missing[corners[1]] && !missing[corners[2]])
+      continue;
+
+    vec3 ab, ac, n;
+    glm_vec3_sub(vertices[corners[1]].position, vertices[corners[0]].position, ab);
+    glm_vec3_sub(vertices[corners[2]].position, vertices[corners[0]].position, ac);
+    glm_vec3_cross(ab, ac, n);
+
+    for (int k = 0; k < 3; ++k)
+    {
+      if (missing[corners[k]])
+        glm_vec3_add(vertices[corners[k]].normal, n, vertices[corners[k]].normal);
+    }
+  }
+
+  for (size_t i = 0; i < parser->vertexCount; ++i)
+  {
+    if (!missing[i])
+      continue;
+
+    // Só em faces degeneradas (área zero): uma normal qualquer, para o shader
+    // não normalizar um vetor nulo.
+    if (glm_vec3_norm2(vertices[i].normal) == 0.0f)
+      glm_vec3_copy((vec3){ 0.0f, 1.0f, 0.0f }, vertices[i].normal);
+    else
+      glm_vec3_normalize(vertices[i].normal);
+  }
+
+  SDL_free(missing);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void free_parser(ObjParser *parser)
+{
+  SDL_free(parser->positions);
+  SDL_free(parser->texcoords);
+  SDL_free(parser->normals);
+  SDL_free(parser->vertices);
+  SDL_free(parser->indices);
+  SDL_free(parser->table);
+  SDL_zerop(parser);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyMesh_load_obj(MyMesh *mesh, const char *filename)
+{
+  MY_LOG_TRACE(">>> MyMesh_load_obj(\"%s\")", filename);
+
+  if (!mesh || !filename)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyMesh_load_obj()");
+    return false;
+  }
+
+  SDL_zerop(mesh);
+  mesh->mvp = -1;
+  mesh->model = -1;
+
+  const Uint64 t0 = SDL_GetTicksNS();
+  MappedFile file;
+  if (!map_file(&file, filename))
+  {
+    MY_LOG_ERROR("\t*** Erro ao mapear \"%s\" (arquivo inexistente ou vazio?).", filename);
+    MY_LOG_TRACE("<<< MyMesh_load_obj()");
+    return false;
+  }
+
+  const Uint64 t1 = SDL_GetTicksNS();
+  ObjParser parser;
+  SDL_zero(parser);
+  parser.cursor = file.data;
+  parser.end = file.data + file.size;
+  const bool parsed = parse_obj(&parser)
+    && (parser.missingNormalCount == 0 || compute_normals(&parser));
+  const Uint64 t2 = SDL_GetTicksNS();
+
+  mesh->stats.fileBytes = (Uint64)file.size;
+  unmap_file(&file);
+
+  if (!parsed || parser.vertexCount > SDL_MAX_UINT32 || parser.indexCount > (size_t)SDL_MAX_SINT32)
+  {
+    MY_LOG_ERROR("\t*** Erro ao ler \"%s\" (sem faces, índice inválido ou falta de memória).", filename);
+    free_parser(&parser);
+    MY_LOG_TRACE("<<< MyMesh_load_obj()");
+    return false;
+  }
+
+  // Esfera envolvente (centro da caixa envolvente).
+  vec3 lower = { parser.vertices[0].position[0], parser.vertices[0].position[1], parser.vertices[0].position[2] };
+  vec3 upper = { lower[0], lower[1], lower[2] };
+  for (size_t i = 1; i < parser.vertexCount; ++i)
+  {
+    glm_vec3_minv(lower, parser.vertices[i].position, lower);
+    glm_vec3_maxv(upper, parser.vertices[i].position, upper);
+  }
+  glm_vec3_center(lower, upper, mesh->center);
+  mesh->radius = SDL_max(glm_vec3_distance(lower, upper) * 0.5f, 1e-6f);
+
+  mesh->program = MyShader_create_program("mesh", MESH_VERTEX_SHADER_CODE, MESH_FRAGMENT_SHADER_CODE);
+  if (!mesh->program)
+  {
+    free_parser(&parser);
+    MY_LOG_TRACE("<<< MyMesh_load_obj()");
+    return false;
+  }
+  mesh->mvp = glGetUniformLocation(mesh->program, "u_MVPMatrix");
+  mesh->model = glGetUniformLocation(mesh->program, "u_ModelMatrix");
+
+  glGenVertexArrays(1, &mesh->vao);
+  glGenBuffers(1, &mesh->vbo);
+  glGenBuffers(1, &mesh->ebo);
+
+  glBindVertexArray(mesh->vao);
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(parser.vertexCount * sizeof(MyMeshVertex)), parser.vertices, GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MyMeshVertex), (GLvoid *)offsetof(MyMeshVertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MyMeshVertex), (GLvoid *)offsetof(MyMeshVertex, normal));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(MyMeshVertex), (GLvoid *)offsetof(MyMeshVertex, texcoord));
+    glEnableVertexAttribArray(2);
+
+    // O EBO fica associado ao VAO (não desligar antes do VAO).
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(parser.indexCount * sizeof(Uint32)), parser.indices, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+  glBindVertexArray(0);
+
+  // glFinish(): o tempo de envio inclui a cópia do driver.
+  glFinish();
+  const Uint64 t3 = SDL_GetTicksNS();
+
+  mesh->indexCount = (GLsizei)parser.indexCount;
+  mesh->stats.mapNS = t1 - t0;
+  mesh->stats.parseNS = t2 - t1;
+  mesh->stats.uploadNS = t3 - t2;
+  mesh->stats.positionCount = (int)parser.positionCount;
+  mesh->stats.triangleCount = (int)(parser.indexCount / 3);
+  mesh->stats.vertexCount = (int)parser.vertexCount;
+  mesh->stats.referenceCount = parser.referenceCount;
+  free_parser(&parser);
+
+  if (glGetError() != GL_NO_ERROR)
+  {
+    MY_LOG_ERROR("\t*** Erro ao enviar a malha para a GPU.");
+    MyMesh_destroy(mesh);
+    MY_LOG_TRACE("<<< MyMesh_load_obj()");
+    return false;
+  }
+
+  const MyMeshStats *stats = &mesh->stats;
+  MY_LOG_INFO("\t%d triângulos, %d vértices únicos (de %llu vértices de face), %d posições.",
+    stats->triangleCount, stats->vertexCount, (unsigned long long)stats->referenceCount, stats->positionCount);
+  MY_LOG_INFO("\tCarregado em %.3f ms: mapeamento %.3f ms, leitura %.3f ms (%.1f MiB/s), envio %.3f ms.",
+    (double)(t3 - t0) / SDL_NS_PER_MS, (double)stats->mapNS / SDL_NS_PER_MS, (double)stats->parseNS / SDL_NS_PER_MS,
+    stats->parseNS ? (double)stats->fileBytes / (1024.0 * 1024.0) / ((double)stats->parseNS / SDL_NS_PER_SECOND) : 0.0,
+    (double)stats->uploadNS / SDL_NS_PER_MS);
+
+  MY_LOG_TRACE("<<< MyMesh_load_obj()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyMesh_destroy(MyMesh *mesh)
+{
+  MY_LOG_TRACE(">>> MyMesh_destroy()");
+
+  if (!mesh)
+  {
+    MY_LOG_ERROR("\t*** Erro: Malha inválida (mesh == NULL).");
+    MY_LOG_TRACE("<<< MyMesh_destroy()");
+    return;
+  }
+
+  glDeleteProgram(mesh->program);
+  glDeleteVertexArrays(1, &mesh->vao);
+  glDeleteBuffers(1, &mesh->vbo);
+  glDeleteBuffers(1, &mesh->ebo);
+  SDL_zerop(mesh);
+  mesh->mvp = -1;
+  mesh->model = -1;
+
+  MY_LOG_TRACE("<<< MyMesh_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyMesh_draw(const MyMesh *mesh, mat4 mvpMatrix, mat4 modelMatrix)
+{
+  glUseProgram(mesh->program);
+  glUniformMatrix4fv(mesh->mvp, 1, GL_FALSE, (const GLfloat *)mvpMatrix);
+  glUniformMatrix4fv(mesh->model, 1, GL_FALSE, (const GLfloat *)modelMatrix);
+  glBindVertexArray(mesh->vao);
+  glDrawElements(GL_TRIANGLES, mesh->indexCount, GL_UNSIGNED_INT, (GLvoid *)0);
+  glBindVertexArray(0);
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Malha carregada de um arquivo Wavefront OBJ e desenhada com índices
+// (glDrawElements).
+//
+// O carregador foi feito para arquivos grandes (milhões de triângulos):
+//
+// - O arquivo é mapeado na memória (mmap/MapViewOfFile) e lido direto das
+//   páginas mapeadas, sem cópia para um buffer.
+// - Os números são lidos por um parser próprio, sem strtof() (que consulta a
+//   localidade e, em alguns sistemas, copia a string).
+// - Cada vértice de face (posição/coordenada de textura/normal) passa por uma
+//   tabela hash: combinações repetidas reutilizam o mesmo vértice, e a malha
+//   vira um VBO de vértices únicos intercalados (posição, normal, textura) e
+//   um EBO de índices de 32 bits.
+//
+// Suporta `v`, `vt`, `vn` e `f` (polígonos viram leques de triângulos,
+// índices negativos são relativos); as demais linhas são ignoradas. Vértices
+// de face sem índice de normal (o arquivo todo ou só algumas faces) recebem a
+// média das normais das faces que os usam.
+//------------------------------------------------------------------------------
+#ifndef MY_MESH_H
+#define MY_MESH_H
+
+#include <stdbool.h>
+#include <GL/glew.h>
+#include <SDL3/SDL.h>
+#include <cglm/cglm.h>
+
+typedef struct MyMeshVertex MyMeshVertex;
+struct MyMeshVertex
+{
+  GLfloat position[3];
+  GLfloat normal[3];
+  GLfloat texcoord[2];
+};
+
+typedef struct MyMeshStats MyMeshStats;
+struct MyMeshStats
+{
+  Uint64 fileBytes;
+  Uint64 mapNS;
+  Uint64 parseNS;   // Leitura, deduplicação e normais.
+  Uint64 uploadNS;
+  int positionCount;
+  int triangleCount;
+  int vertexCount;  // Vértices únicos.
+  Uint64 referenceCount;  // Vértices de face lidos (antes da deduplicação).
+};
+
+typedef struct MyMesh MyMesh;
+struct MyMesh
+{
+  GLuint program;
+  GLint mvp;
+  GLint model;
+  GLuint vao;
+  GLuint vbo;
+  GLuint ebo;
+  GLsizei indexCount;
+
+  // Esfera envolvente, para enquadrar a malha.
+  vec3 center;
+  float radius;
+
+  MyMeshStats stats;
+};
+
+bool MyMesh_load_obj(MyMesh *mesh, const char *filename);
+void MyMesh_destroy(MyMesh *mesh);
+
+/**
+ * `modelMatrix` só deve girar e escalar uniformemente (usada nas normais).
+ */
+void MyMesh_draw(const MyMesh *mesh, mat4 mvpMatrix, mat4 modelMatrix);
+
+#endif // MY_MESH_H
@@ -0,0 +1,248 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "profiler.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static bool is_oldest_ready(const MyFrameProfiler *profiler);
+static void read_oldest(MyFrameProfiler *profiler);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyFrameProfiler_initialize(MyFrameProfiler *profiler)
+{
+  MY_LOG_TRACE(">>> MyFrameProfiler_initialize()");
+
+  if (!profiler)
+  {
+    MY_LOG_ERROR("\t*** Erro: Perfilador inválido (profiler == NULL).");
+    MY_LOG_TRACE("<<< MyFrameProfiler_initialize()");
+    return false;
+  }
+
+  SDL_zerop(profiler);
+  profiler->ticksToMS = 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+  bool ok = true;
+  for (int s = 0; s < MY_PROFILER_SECTION_COUNT; ++s)
+    ok = MyGpuTimer_initialize(&profiler->timers[s]) && ok;
+
+  MY_LOG_TRACE("<<< MyFrameProfiler_initialize()");
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameProfiler_destroy(MyFrameProfiler *profiler)
+{
+  MY_LOG_TRACE(">>> MyFrameProfiler_destroy()");
+
+  if (!profiler)
+  {
+    MY_LOG_ERROR("\t*** Erro: Perfilador inválido (profiler == NULL).");
+    MY_LOG_TRACE("<<< MyFrameProfiler_destroy()");
+    return;
+  }
+
+  if (profiler->csv && !SDL_CloseIO(profiler->csv))
+    MY_LOG_ERROR("\t*** Erro ao gravar o arquivo CSV: %s", SDL_GetError());
+
+  for (int s = 0; s < MY_PROFILER_SECTION_COUNT; ++s)
+    MyGpuTimer_destroy(&profiler->timers[s]);
+
+  SDL_zerop(profiler);
+
+  MY_LOG_TRACE("<<< MyFrameProfiler_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyFrameProfiler_open_csv(MyFrameProfiler *profiler, const char *filename)
+{
+  MY_LOG_TRACE("\tMyFrameProfiler_open_csv(\"%s\")", filename);
+
+  if (profiler->csv)
+    SDL_CloseIO(profiler->csv);
+
+  profiler->csv = SDL_IOFromFile(filename, "w");
+  if (!profiler->csv)
+  {
+    MY_LOG_ERROR("\t\t*** Erro ao criar \"%s\": %s", filename, SDL_GetError());
+    return false;
+  }
+
+  SDL_IOprintf(profiler->csv, "frame");
+  for (int s = 0; s < MY_PROFILER_SECTION_COUNT; ++s)
+    SDL_IOprintf(profiler->csv, ",cpu_%s_ms", MyFrameProfiler_get_section_name((MyProfilerSection)s));
+  SDL_IOprintf(profiler->csv, ",cpu_frame_ms");
+  for (int s = 0; s < MY_PROFILER_SECTION_COUNT; ++s)
+    SDL_IOprintf(profiler->csv, ",gpu_%s_ms", MyFrameProfiler_get_section_name((MyProfilerSection)s));
+  SDL_IOprintf(profiler->csv, ",gpu_frame_ms\n");
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Todas as consultas do quadro pendente mais antigo têm resultado?
+//------------------------------------------------------------------------------
+bool is_oldest_ready(const MyFrameProfiler *profiler)
+{
+  for (int s = 0; s < MY_PROFILER_SECTION_COUNT; ++s)
+  {
+    if (!MyGpuTimer_is_ready(&profiler->timers[s]))
+      return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Lê (esperando, se preciso) o quadro pendente mais antigo e o move para o
+// histórico.
+//------------------------------------------------------------------------------
+void read_oldest(MyFrameProfiler *profiler)
+{
+  const int tail = (profiler->head - profiler->pendingCount + MY_PROFILER_LATENCY) % MY_PROFILER_LATENCY;
+  MyFrameProfile *profile = &profiler->pending[tail];
+
+  profile->gpuFrameMS = 0.0;
+  for (int s = 0; s < MY_PROFILER_SECTION_COUNT; ++s)
+  {
+    profile->gpuMS[s] = (double)MyGpuTimer_read(&profiler->timers[s]) / SDL_NS_PER_MS;
+    profile->gpuFrameMS += profile->gpuMS[s];
+  }
+
+  profiler->history[profiler->historyHead] = *profile;
+  profiler->historyHead = (profiler->historyHead + 1) % MY_PROFILER_HISTORY_SIZE;
+  profiler->historyCount = SDL_min(profiler->historyCount + 1, (int)MY_PROFILER_HISTORY_SIZE);
+  --profiler->pendingCount;
+
+  for (int s = 0; s < MY_PROFILER_SECTION_COUNT; ++s)
+  {
+    profiler->sum.cpuMS[s] += profile->cpuMS[s];
+    profiler->sum.gpuMS[s] += profile->gpuMS[s];
+  }
+  profiler->sum.cpuFrameMS += profile->cpuFrameMS;
+  profiler->sum.gpuFrameMS += profile->gpuFrameMS;
+  ++profiler->completedCount;
+
+  if (profiler->csv)
+  {
+    SDL_IOprintf(profiler->csv, "%llu", (unsigned long long)profile->frameIndex);
+    for (int s = 0; s < MY_PROFILER_SECTION_COUNT; ++s)
+      SDL_IOprintf(profiler->csv, ",%.4f", profile->cpuMS[s]);
+    SDL_IOprintf(profiler->csv, ",%.4f", profile->cpuFrameMS);
+    for (int s = 0; s < MY_PROFILER_SECTION_COUNT; ++s)
+      SDL_IOprintf(profiler->csv, ",%.4f", profile->gpuMS[s]);
+    SDL_IOprintf(profiler->csv, ",%.4f\n", profile->gpuFrameMS);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameProfiler_begin_frame(MyFrameProfiler *profiler)
+{
+  if (profiler->pendingCount == MY_PROFILER_LATENCY)
+  {
+    // Anéis cheios: a GPU está MY_PROFILER_LATENCY quadros atrasada. Ler o
+    // quadro aqui evita que MyGpuTimer_begin() descarte um resultado.
+    ++profiler->stallCount;
+    read_oldest(profiler);
+  }
+
+  MyFrameProfile *profile = &profiler->pending[profiler->head];
+  SDL_zerop(profile);
+  profile->frameIndex = profiler->frameCount;
+  profiler->frameStart = SDL_GetPerformanceCounter();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameProfiler_begin_section(MyFrameProfiler *profiler, MyProfilerSection section)
+{
+  MyGpuTimer_begin(&profiler->timers[section]);
+  profiler->sectionStart = SDL_GetPerformanceCounter();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameProfiler_end_section(MyFrameProfiler *profiler, MyProfilerSection section)
+{
+  const Uint64 now = SDL_GetPerformanceCounter();
+  MyGpuTimer_end(&profiler->timers[section]);
+  profiler->pending[profiler->head].cpuMS[section] = (double)(now - profiler->sectionStart) * profiler->ticksToMS;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameProfiler_end_frame(MyFrameProfiler *profiler)
+{
+  MyFrameProfile *profile = &profiler->pending[profiler->head];
+  profile->cpuFrameMS = (double)(SDL_GetPerformanceCounter() - profiler->frameStart) * profiler->ticksToMS;
+
+  profiler->head = (profiler->head + 1) % MY_PROFILER_LATENCY;
+  ++profiler->pendingCount;
+  ++profiler->frameCount;
+
+  while (profiler->pendingCount > 0 && is_oldest_ready(profiler))
+    read_oldest(profiler);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameProfiler_flush(MyFrameProfiler *profiler)
+{
+  while (profiler->pendingCount > 0)
+    read_oldest(profiler);
+
+  if (profiler->csv)
+    SDL_FlushIO(profiler->csv);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const MyFrameProfile *MyFrameProfiler_get_history(const MyFrameProfiler *profiler, int age)
+{
+  if (age < 0 || age >= profiler->historyCount)
+    return NULL;
+
+  const int index = (profiler->historyHead - 1 - age + MY_PROFILER_HISTORY_SIZE) % MY_PROFILER_HISTORY_SIZE;
+  return &profiler->history[index];
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const char *MyFrameProfiler_get_section_name(MyProfilerSection section)
+{
+  switch (section)
+  {
+    case MY_PROFILER_CLEAR:
+      return "clear";
+    case MY_PROFILER_DRAW:
+      return "draw";
+    case MY_PROFILER_OVERLAY:
+      return "overlay";
+    case MY_PROFILER_SWAP:
+      return "swap";
+    case MY_PROFILER_SECTION_COUNT:
+      break;
+  }
+
+  return "?";
+}
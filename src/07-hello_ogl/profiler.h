@@ -0,0 +1,122 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Perfil de quadros: tempo de CPU e de GPU de cada etapa do quadro (limpar,
+// desenhar, overlay e trocar buffers).
+//
+// - CPU: SDL_GetPerformanceCounter() no início e no fim de cada etapa.
+// - GPU: um MyGpuTimer (gpu_timer.h) por etapa. Os resultados ficam prontos
+//   alguns quadros depois; para não esperar pela GPU, o perfilador guarda os
+//   tempos de CPU dos últimos MY_PROFILER_LATENCY quadros e só lê um quadro
+//   quando o resultado de todas as etapas estiver disponível. Apenas se os
+//   anéis de consultas estiverem cheios é que begin_frame() espera (contado
+//   em `stallCount`).
+//
+// Cada quadro completo (CPU + GPU) entra no histórico circular de
+// MY_PROFILER_HISTORY_SIZE quadros, usado pelo gráfico (graph.h), e, se
+// houver um arquivo aberto com open_csv(), é gravado como uma linha CSV.
+//
+// Uso, a cada quadro:
+//
+//   MyFrameProfiler_begin_frame(&profiler);
+//   MyFrameProfiler_begin_section(&profiler, MY_PROFILER_CLEAR);
+//   glClear(...);
+//   MyFrameProfiler_end_section(&profiler, MY_PROFILER_CLEAR);
+//   ... demais etapas ...
+//   MyFrameProfiler_end_frame(&profiler);
+//------------------------------------------------------------------------------
+#ifndef MY_PROFILER_H
+#define MY_PROFILER_H
+
+#include <stdbool.h>
+#include <GL/glew.h>
+#include <SDL3/SDL.h>
+#include "gpu_timer.h"
+
+typedef enum MyProfilerSection
+{
+  MY_PROFILER_CLEAR,
+  MY_PROFILER_DRAW,
+  MY_PROFILER_OVERLAY,
+  MY_PROFILER_SWAP,
+  MY_PROFILER_SECTION_COUNT,
+} MyProfilerSection;
+
+enum profiler_constants
+{
+  MY_PROFILER_LATENCY = MY_GPU_TIMER_QUERY_COUNT,
+  MY_PROFILER_HISTORY_SIZE = 240,
+};
+
+typedef struct MyFrameProfile MyFrameProfile;
+struct MyFrameProfile
+{
+  Uint64 frameIndex;
+  double cpuMS[MY_PROFILER_SECTION_COUNT];
+  double gpuMS[MY_PROFILER_SECTION_COUNT];
+  double cpuFrameMS;  // Do início de begin_frame() ao fim de end_frame().
+  double gpuFrameMS;  // Soma das etapas.
+};
+
+typedef struct MyFrameProfiler MyFrameProfiler;
+struct MyFrameProfiler
+{
+  // Tempos de CPU dos quadros ainda sem resultado da GPU. Cada etapa é
+  // medida uma vez por quadro, então o resultado mais antigo de cada
+  // temporizador é o do quadro pending[tail].
+  MyGpuTimer timers[MY_PROFILER_SECTION_COUNT];
+  MyFrameProfile pending[MY_PROFILER_LATENCY];
+  int head;
+  int pendingCount;
+
+  Uint64 frameStart;
+  Uint64 sectionStart;
+  double ticksToMS;
+  Uint64 frameCount;
+  Uint64 stallCount;
+
+  // Histórico circular: o quadro mais recente é history[(historyHead - 1) %
+  // MY_PROFILER_HISTORY_SIZE].
+  MyFrameProfile history[MY_PROFILER_HISTORY_SIZE];
+  int historyHead;
+  int historyCount;
+
+  // Soma de todos os quadros completos, para as médias.
+  MyFrameProfile sum;
+  Uint64 completedCount;
+
+  SDL_IOStream *csv;
+};
+
+bool MyFrameProfiler_initialize(MyFrameProfiler *profiler);
+void MyFrameProfiler_destroy(MyFrameProfiler *profiler);
+
+/**
+ * Grava cada quadro completo em `filename` (CSV, uma linha por quadro, tempos
+ * em ms). O arquivo é fechado em destroy().
+ */
+bool MyFrameProfiler_open_csv(MyFrameProfiler *profiler, const char *filename);
+
+void MyFrameProfiler_begin_frame(MyFrameProfiler *profiler);
+void MyFrameProfiler_begin_section(MyFrameProfiler *profiler, MyProfilerSection section);
+void MyFrameProfiler_end_section(MyFrameProfiler *profiler, MyProfilerSection section);
+
+/**
+ * Encerra o quadro e lê, sem esperar, os quadros anteriores já completos.
+ */
+void MyFrameProfiler_end_frame(MyFrameProfiler *profiler);
+
+/**
+ * Espera e lê todos os quadros pendentes (ex. antes de encerrar).
+ */
+void MyFrameProfiler_flush(MyFrameProfiler *profiler);
+
+/**
+ * `age` = 0 é o quadro completo mais recente. NULL se não houver.
+ */
+const MyFrameProfile *MyFrameProfiler_get_history(const MyFrameProfiler *profiler, int age);
+
+const char *MyFrameProfiler_get_section_name(MyProfilerSection section);
+
+#endif // MY_PROFILER_H
@@ -0,0 +1,206 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "program_cache.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+
+// "MYPB" em little-endian.
+static const Uint32 CACHE_MAGIC = 0x4250594Du;
+static const Uint32 CACHE_VERSION = 1;
+
+static const Uint64 FNV_OFFSET_BASIS = 0xCBF29CE484222325ull;
+static const Uint64 FNV_PRIME = 0x100000001B3ull;
+
+// Cabeçalho de cada arquivo, seguido de `length` bytes do binário.
+typedef struct CacheHeader CacheHeader;
+struct CacheHeader
+{
+  Uint32 magic;
+  Uint32 version;
+  Uint64 key;
+  Uint32 format;
+  Uint32 length;
+};
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static Uint64 hash_string(Uint64 hash, const char *text);
+static Uint64 program_key(const MyProgramCache *cache, const char *vertexCode, const char *fragmentCode);
+static void program_path(const MyProgramCache *cache, Uint64 key, const char *extension, char *path);
+
+//------------------------------------------------------------------------------
+// FNV-1a, incluindo o terminador (para que "ab" + "c" != "a" + "bc").
+//------------------------------------------------------------------------------
+Uint64 hash_string(Uint64 hash, const char *text)
+{
+  const Uint8 *bytes = (const Uint8 *)(text ? text : "");
+  do
+  {
+    hash ^= *bytes;
+    hash *= FNV_PRIME;
+  } while (*bytes++);
+
+  return hash;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+Uint64 program_key(const MyProgramCache *cache, const char *vertexCode, const char *fragmentCode)
+{
+  return hash_string(hash_string(cache->driverHash, vertexCode), fragmentCode);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void program_path(const MyProgramCache *cache, Uint64 key, const char *extension, char *path)
+{
+  SDL_snprintf(path, MY_PROGRAM_CACHE_PATH_MAX_LENGTH, "%s/%016llx.%s", cache->directory, (unsigned long long)key, extension);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyProgramCache_initialize(MyProgramCache *cache, const char *directory)
+{
+  MY_LOG_TRACE(">>> MyProgramCache_initialize(\"%s\")", directory ? directory : "(null)");
+
+  if (!cache || !directory)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyProgramCache_initialize()");
+    return false;
+  }
+
+  SDL_zerop(cache);
+
+  GLint formatCount = 0;
+  if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+
+  if (formatCount <= 0)
+  {
+    MY_LOG_INFO("\tDriver sem suporte a binários de programa; cache desativado.");
+    MY_LOG_TRACE("<<< MyProgramCache_initialize()");
+    return false;
+  }
+
+  SDL_strlcpy(cache->directory, directory, MY_PROGRAM_CACHE_PATH_MAX_LENGTH);
+  SDL_CreateDirectory(cache->directory);
+
+  cache->driverHash = FNV_OFFSET_BASIS;
+  cache->driverHash = hash_string(cache->driverHash, (const char *)glGetString(GL_VENDOR));
+  cache->driverHash = hash_string(cache->driverHash, (const char *)glGetString(GL_RENDERER));
+  cache->driverHash = hash_string(cache->driverHash, (const char *)glGetString(GL_VERSION));
+  cache->enabled = true;
+
+  MY_LOG_INFO("\t%d formato(s) de binário; driver %016llx.", formatCount, (unsigned long long)cache->driverHash);
+  MY_LOG_TRACE("<<< MyProgramCache_initialize()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+GLuint MyProgramCache_load(const MyProgramCache *cache, const char *vertexCode, const char *fragmentCode)
+{
+  if (!cache || !cache->enabled)
+    return 0;
+
+  const Uint64 key = program_key(cache, vertexCode, fragmentCode);
+  char path[MY_PROGRAM_CACHE_PATH_MAX_LENGTH];
+  program_path(cache, key, "bin", path);
+
+  size_t size = 0;
+  Uint8 *data = (Uint8 *)SDL_LoadFile(path, &size);
+  if (!data)
+    return 0;
+
+  CacheHeader header;
+  bool valid = size >= sizeof(header);
+  if (valid)
+  {
+    SDL_memcpy(&header, data, sizeof(header));
+    valid = header.magic == CACHE_MAGIC && header.version == CACHE_VERSION && header.key == key
+      && header.length == size - sizeof(header);
+  }
+
+  GLuint program = 0;
+  if (valid)
+  {
+    program = glCreateProgram();
+    glProgramBinary(program, (GLenum)header.format, data + sizeof(header), (GLsizei)header.length);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE)
+    {
+      MY_LOG_WARN("\t\tBinário recusado pelo driver: %s", path);
+      glDeleteProgram(program);
+      program = 0;
+    }
+  }
+  else
+  {
+    MY_LOG_WARN("\t\tArquivo de cache inválido: %s", path);
+  }
+
+  SDL_free(data);
+  return program;
+}
+
+//------------------------------------------------------------------------------
+// Grava em um arquivo temporário e renomeia, para que uma execução
+// interrompida não deixe um arquivo pela metade com o nome final.
+//------------------------------------------------------------------------------
+bool MyProgramCache_store(const MyProgramCache *cache, GLuint program, const char *vertexCode, const char *fragmentCode)
+{
+  if (!cache || !cache->enabled || !program)
+    return false;
+
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0)
+    return false;
+
+  const size_t size = sizeof(CacheHeader) + (size_t)length;
+  Uint8 *data = (Uint8 *)SDL_malloc(size);
+  if (!data)
+    return false;
+
+  GLenum format = 0;
+  GLsizei written = 0;
+  glGetProgramBinary(program, length, &written, &format, data + sizeof(CacheHeader));
+
+  const CacheHeader header = {
+    .magic = CACHE_MAGIC,
+    .version = CACHE_VERSION,
+    .key = program_key(cache, vertexCode, fragmentCode),
+    .format = (Uint32)format,
+    .length = (Uint32)written,
+  };
+  SDL_memcpy(data, &header, sizeof(header));
+
+  char path[MY_PROGRAM_CACHE_PATH_MAX_LENGTH];
+  char temporaryPath[MY_PROGRAM_CACHE_PATH_MAX_LENGTH];
+  program_path(cache, header.key, "bin", path);
+  program_path(cache, header.key, "tmp", temporaryPath);
+
+  const bool ok = written > 0
+    && SDL_SaveFile(temporaryPath, data, sizeof(header) + (size_t)written)
+    && SDL_RenamePath(temporaryPath, path);
+  if (!ok)
+    MY_LOG_ERROR("\t\t*** Erro ao gravar %s: %s", path, SDL_GetError());
+
+  SDL_free(data);
+  return ok;
+}
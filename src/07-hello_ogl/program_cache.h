@@ -0,0 +1,63 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Cache em disco de programas GLSL já linkados (glGetProgramBinary), para
+// evitar compilar os shaders a cada execução.
+//
+// Cada programa vira um arquivo `<diretório>/<chave>.bin`, em que a chave é
+// um hash (FNV-1a de 64 bits) do código dos dois shaders e das strings
+// GL_VENDOR, GL_RENDERER e GL_VERSION. Assim, mudar o código, a GPU ou o
+// driver gera outra chave, e o arquivo antigo simplesmente deixa de ser
+// usado. Mesmo com a chave certa, o driver pode recusar o binário (ex. após
+// uma atualização que não mudou GL_VERSION); nesse caso, load() retorna 0 e o
+// programa é compilado a partir do código, como se não houvesse cache.
+//
+// O binário de programa é do OpenGL 4.1 (ou da extensão
+// ARB_get_program_binary); sem ele, ou se o driver não oferece nenhum formato
+// de binário, o cache fica desativado (`enabled == false`) e nada muda.
+//
+// Observação: alguns drivers (ex. Mesa) têm seu próprio cache de shaders em
+// disco; para medir uma partida "fria" de verdade, desative-o (no Mesa,
+// MESA_SHADER_CACHE_DISABLE=true).
+//------------------------------------------------------------------------------
+#ifndef MY_PROGRAM_CACHE_H
+#define MY_PROGRAM_CACHE_H
+
+#include <stdbool.h>
+#include <GL/glew.h>
+#include <SDL3/SDL.h>
+
+enum program_cache_constants
+{
+  MY_PROGRAM_CACHE_PATH_MAX_LENGTH = 512,
+};
+
+typedef struct MyProgramCache MyProgramCache;
+struct MyProgramCache
+{
+  bool enabled;
+  char directory[MY_PROGRAM_CACHE_PATH_MAX_LENGTH];
+  // Hash das strings do driver, combinado com o código de cada programa.
+  Uint64 driverHash;
+};
+
+/**
+ * Prepara o cache em `directory` (criado se não existir). Retorna false, com
+ * o cache desativado, se o driver não suportar binários de programa.
+ */
+bool MyProgramCache_initialize(MyProgramCache *cache, const char *directory);
+
+/**
+ * Cria um programa a partir do binário guardado para esse par de shaders.
+ * Retorna 0 se não houver binário ou se ele for recusado.
+ */
+GLuint MyProgramCache_load(const MyProgramCache *cache, const char *vertexCode, const char *fragmentCode);
+
+/**
+ * Guarda o binário de `program`, que deve ter sido linkado com
+ * GL_PROGRAM_BINARY_RETRIEVABLE_HINT.
+ */
+bool MyProgramCache_store(const MyProgramCache *cache, GLuint program, const char *vertexCode, const char *fragmentCode);
+
+#endif // MY_PROGRAM_CACHE_H
@@ -0,0 +1,181 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "readback.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+
+// Espera máxima por uma cópia antes de desistir (1 segundo).
+static const GLuint64 FENCE_TIMEOUT_NS = 1000000000ull;
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static bool is_oldest_ready(MyReadback *readback, bool wait);
+static void deliver_oldest(MyReadback *readback);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyReadback_initialize(MyReadback *readback, int width, int height, MyReadbackFunction function, void *userdata)
+{
+  MY_LOG_TRACE(">>> MyReadback_initialize(%d, %d)", width, height);
+
+  if (!readback || width <= 0 || height <= 0 || !function)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyReadback_initialize()");
+    return false;
+  }
+
+  SDL_zerop(readback);
+  readback->width = width;
+  readback->height = height;
+  readback->function = function;
+  readback->userdata = userdata;
+
+  const GLsizeiptr frameSize = (GLsizeiptr)width * height * 4;
+  glGenBuffers(MY_READBACK_RING_SIZE, readback->pbos);
+  for (int i = 0; i < MY_READBACK_RING_SIZE; ++i)
+  {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pbos[i]);
+    glBufferData(GL_PIXEL_PACK_BUFFER, frameSize, NULL, GL_STREAM_READ);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  if (glGetError() != GL_NO_ERROR)
+  {
+    MY_LOG_ERROR("\t*** Erro ao criar %d PBOs de %lld bytes.", (int)MY_READBACK_RING_SIZE, (long long)frameSize);
+    MyReadback_destroy(readback);
+    MY_LOG_TRACE("<<< MyReadback_initialize()");
+    return false;
+  }
+
+  MY_LOG_TRACE("<<< MyReadback_initialize()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyReadback_destroy(MyReadback *readback)
+{
+  MY_LOG_TRACE(">>> MyReadback_destroy()");
+
+  if (!readback)
+  {
+    MY_LOG_ERROR("\t*** Erro: Leitor inválido (readback == NULL).");
+    MY_LOG_TRACE("<<< MyReadback_destroy()");
+    return;
+  }
+
+  for (int i = 0; i < MY_READBACK_RING_SIZE; ++i)
+  {
+    if (readback->fences[i])
+      glDeleteSync(readback->fences[i]);
+  }
+
+  glDeleteBuffers(MY_READBACK_RING_SIZE, readback->pbos);
+  SDL_zerop(readback);
+
+  MY_LOG_TRACE("<<< MyReadback_destroy()");
+}
+
+//------------------------------------------------------------------------------
+// A cópia mais antiga terminou? Com `wait`, espera por ela.
+//------------------------------------------------------------------------------
+bool is_oldest_ready(MyReadback *readback, bool wait)
+{
+  const int tail = (readback->head - readback->pendingCount + MY_READBACK_RING_SIZE) % MY_READBACK_RING_SIZE;
+  GLenum result = glClientWaitSync(readback->fences[tail], GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+  if (result == GL_TIMEOUT_EXPIRED && wait)
+    result = glClientWaitSync(readback->fences[tail], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+
+  return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+//------------------------------------------------------------------------------
+// Mapeia o PBO mais antigo, entrega o quadro e libera o PBO.
+//------------------------------------------------------------------------------
+void deliver_oldest(MyReadback *readback)
+{
+  const int tail = (readback->head - readback->pendingCount + MY_READBACK_RING_SIZE) % MY_READBACK_RING_SIZE;
+  const GLsizeiptr frameSize = (GLsizeiptr)readback->width * readback->height * 4;
+
+  const Uint64 t0 = SDL_GetTicksNS();
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pbos[tail]);
+  const Uint8 *pixels = (const Uint8 *)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameSize, GL_MAP_READ_BIT);
+  if (pixels)
+  {
+    readback->function(readback->userdata, pixels, readback->width, readback->height, readback->frameIndices[tail]);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    ++readback->stats.deliveredCount;
+  }
+  else
+  {
+    MY_LOG_ERROR("\t*** Erro ao mapear o PBO do quadro %llu.", (unsigned long long)readback->frameIndices[tail]);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  readback->stats.deliverNS += SDL_GetTicksNS() - t0;
+
+  glDeleteSync(readback->fences[tail]);
+  readback->fences[tail] = NULL;
+  --readback->pendingCount;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyReadback_capture(MyReadback *readback)
+{
+  if (readback->pendingCount == MY_READBACK_RING_SIZE)
+  {
+    // Anel cheio: espera pela cópia mais antiga, se ainda não terminou.
+    if (!is_oldest_ready(readback, false))
+    {
+      const Uint64 t0 = SDL_GetTicksNS();
+      is_oldest_ready(readback, true);
+      readback->stats.stallNS += SDL_GetTicksNS() - t0;
+      ++readback->stats.stallCount;
+    }
+    deliver_oldest(readback);
+  }
+
+  const int slot = readback->head;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->pbos[slot]);
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  glReadPixels(0, 0, readback->width, readback->height, GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid *)0);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  readback->fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  readback->frameIndices[slot] = readback->stats.capturedCount++;
+  readback->head = (slot + 1) % MY_READBACK_RING_SIZE;
+  ++readback->pendingCount;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyReadback_poll(MyReadback *readback)
+{
+  while (readback->pendingCount > 0 && is_oldest_ready(readback, false))
+    deliver_oldest(readback);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyReadback_flush(MyReadback *readback)
+{
+  while (readback->pendingCount > 0)
+  {
+    is_oldest_ready(readback, true);
+    deliver_oldest(readback);
+  }
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Leitura assíncrona de quadros (GPU -> CPU) com Pixel Buffer Objects (PBO).
+//
+// glReadPixels() para a memória da CPU espera a GPU terminar o quadro. Com um
+// PBO ligado em GL_PIXEL_PACK_BUFFER, a mesma chamada só agenda a cópia e
+// retorna. O leitor tem um anel de MY_READBACK_RING_SIZE PBOs: cada quadro
+// capturado vai para o próximo PBO, marcado com uma cerca (glFenceSync), e é
+// entregue (mapeado e passado para a função do usuário) só quando a cerca
+// indicar que a cópia terminou, alguns quadros depois.
+//
+// A CPU só espera se o anel inteiro estiver ocupado com cópias ainda não
+// terminadas; essas esperas são contadas em `stats`.
+//
+// Os quadros são entregues na ordem de captura, com as linhas de baixo para
+// cima (convenção do OpenGL).
+//------------------------------------------------------------------------------
+#ifndef MY_READBACK_H
+#define MY_READBACK_H
+
+#include <stdbool.h>
+#include <GL/glew.h>
+#include <SDL3/SDL.h>
+
+enum readback_constants
+{
+  MY_READBACK_RING_SIZE = 3,
+};
+
+/**
+ * Recebe um quadro RGBA8 (`width * 4` bytes por linha, de baixo para cima).
+ * `pixels` só é válido durante a chamada.
+ */
+typedef void (*MyReadbackFunction)(void *userdata, const Uint8 *pixels, int width, int height, Uint64 frameIndex);
+
+typedef struct MyReadbackStats MyReadbackStats;
+struct MyReadbackStats
+{
+  Uint64 capturedCount;
+  Uint64 deliveredCount;
+  Uint64 stallCount;  // Capturas que esperaram por um PBO livre.
+  Uint64 stallNS;
+  Uint64 deliverNS;   // Tempo em map + função do usuário + unmap.
+};
+
+typedef struct MyReadback MyReadback;
+struct MyReadback
+{
+  int width;
+  int height;
+
+  GLuint pbos[MY_READBACK_RING_SIZE];
+  GLsync fences[MY_READBACK_RING_SIZE];
+  Uint64 frameIndices[MY_READBACK_RING_SIZE];
+  int head;          // Próximo PBO a usar.
+  int pendingCount;  // Capturas ainda não entregues.
+
+  MyReadbackFunction function;
+  void *userdata;
+
+  MyReadbackStats stats;
+};
+
+bool MyReadback_initialize(MyReadback *readback, int width, int height, MyReadbackFunction function, void *userdata);
+
+/**
+ * Descarta capturas pendentes (use flush() antes para entregá-las).
+ */
+void MyReadback_destroy(MyReadback *readback);
+
+/**
+ * Agenda a cópia do framebuffer ligado em GL_READ_FRAMEBUFFER.
+ */
+void MyReadback_capture(MyReadback *readback);
+
+/**
+ * Entrega, sem esperar, as capturas cujas cópias já terminaram.
+ */
+void MyReadback_poll(MyReadback *readback);
+
+/**
+ * Espera e entrega todas as capturas pendentes.
+ */
+void MyReadback_flush(MyReadback *readback);
+
+#endif // MY_READBACK_H
@@ -0,0 +1,391 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "scene.h"
+#include "shader.h"
+#include "log.h"
+
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+// Vertex shader code.
+//------------------------------------------------------------------------------
+static const char *SCENE_VERTEX_SHADER_CODE =
+  "#version 330 core\n"
+  "layout(location = 0) in vec3 a_Pos;\n"
+  "layout(location = 1) in vec3 a_Color;\n"
+  "layout(location = 2) in mat4 a_MVPMatrix;\n"
+  "layout(location = 6) in vec4 a_InstanceColor;\n"
+  "out vec3 v_FragColor;\n"
+  "void main() {\n"
+  "  gl_Position = a_MVPMatrix * vec4(a_Pos, 1.0);\n"
+  "  v_FragColor = a_Color * a_InstanceColor.rgb;\n"
+  "}\0";
+
+//------------------------------------------------------------------------------
+// Fragment shader code.
+//------------------------------------------------------------------------------
+static const char *SCENE_FRAGMENT_SHADER_CODE =
+  "#version 330 core\n"
+  "in vec3 v_FragColor;\n"
+  "out vec4 f_Color;\n"
+  "void main() {\n"
+  "  f_Color = vec4(v_FragColor, 1.0);\n"
+  "}\0";
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+
+// Dados de um objeto visível no fluxo de instâncias.
+typedef struct SceneInstance SceneInstance;
+struct SceneInstance
+{
+  GLfloat mvp[16];
+  Uint32 color;
+};
+
+enum scene_internal_constants
+{
+  // Um mat4 ocupa 4 atributos consecutivos (um por coluna).
+  MVP_ATTRIBUTE = 2,
+  COLOR_ATTRIBUTE = 6,
+};
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static void mark_dirty(MyScene *scene, int index);
+static void compute_model(const MyScene *scene, int index, mat4 model);
+static void set_instance_attributes(GLintptr offset);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyScene_initialize(MyScene *scene, int capacity, GLuint vertexBuffer)
+{
+  MY_LOG_TRACE(">>> MyScene_initialize(%d)", capacity);
+
+  if (!scene || capacity <= 0)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyScene_initialize()");
+    return false;
+  }
+
+  SDL_zerop(scene);
+  scene->capacity = SDL_min(capacity, (int)MY_SCENE_MAX_COUNT);
+  glm_mat4_identity(scene->viewProjection);
+
+  const size_t n = (size_t)scene->capacity;
+  scene->positionX = (float *)SDL_malloc(n * sizeof(float));
+  scene->positionY = (float *)SDL_malloc(n * sizeof(float));
+  scene->positionZ = (float *)SDL_malloc(n * sizeof(float));
+  scene->scale = (float *)SDL_malloc(n * sizeof(float));
+  scene->angle = (float *)SDL_malloc(n * sizeof(float));
+  scene->radius = (float *)SDL_malloc(n * sizeof(float));
+  scene->color = (Uint32 *)SDL_malloc(n * sizeof(Uint32));
+  scene->model = (mat4 *)SDL_aligned_alloc(16, n * sizeof(mat4));
+  scene->mvp = (mat4 *)SDL_aligned_alloc(16, n * sizeof(mat4));
+  scene->dirty = (Uint8 *)SDL_calloc(n, sizeof(Uint8));
+  scene->dirtyList = (int *)SDL_malloc(n * sizeof(int));
+  scene->visibleList = (int *)SDL_malloc(n * sizeof(int));
+
+  if (!scene->positionX || !scene->positionY || !scene->positionZ || !scene->scale || !scene->angle
+    || !scene->radius || !scene->color || !scene->model || !scene->mvp || !scene->dirty
+    || !scene->dirtyList || !scene->visibleList)
+  {
+    MY_LOG_ERROR("\t*** Erro ao alocar memória para %d objetos.", scene->capacity);
+    MyScene_destroy(scene);
+    MY_LOG_TRACE("<<< MyScene_initialize()");
+    return false;
+  }
+
+  scene->program = MyShader_create_program("scene", SCENE_VERTEX_SHADER_CODE, SCENE_FRAGMENT_SHADER_CODE);
+  if (!scene->program
+    || !MyVertexStream_initialize(&scene->stream, (GLsizeiptr)n * sizeof(SceneInstance), MY_STREAM_MAP_UNSYNCHRONIZED))
+  {
+    MyScene_destroy(scene);
+    MY_LOG_TRACE("<<< MyScene_initialize()");
+    return false;
+  }
+
+  glGenVertexArrays(1, &scene->vao);
+  glBindVertexArray(scene->vao);
+  {
+    // Atributos por vértice, lidos do VBO do triângulo.
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid *)(3 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(1);
+
+    // Atributos por instância (divisor 1); os ponteiros são refeitos em
+    // draw(), a partir da posição dos dados do quadro no fluxo.
+    for (int column = 0; column < 4; ++column)
+    {
+      glEnableVertexAttribArray(MVP_ATTRIBUTE + column);
+      glVertexAttribDivisor(MVP_ATTRIBUTE + column, 1);
+    }
+    glEnableVertexAttribArray(COLOR_ATTRIBUTE);
+    glVertexAttribDivisor(COLOR_ATTRIBUTE, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+  glBindVertexArray(0);
+
+  MY_LOG_TRACE("<<< MyScene_initialize()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyScene_destroy(MyScene *scene)
+{
+  MY_LOG_TRACE(">>> MyScene_destroy()");
+
+  if (!scene)
+  {
+    MY_LOG_ERROR("\t*** Erro: Cena inválida (scene == NULL).");
+    MY_LOG_TRACE("<<< MyScene_destroy()");
+    return;
+  }
+
+  if (scene->stream.vbo)
+    MyVertexStream_destroy(&scene->stream);
+  glDeleteVertexArrays(1, &scene->vao);
+  glDeleteProgram(scene->program);
+
+  SDL_free(scene->positionX);
+  SDL_free(scene->positionY);
+  SDL_free(scene->positionZ);
+  SDL_free(scene->scale);
+  SDL_free(scene->angle);
+  SDL_free(scene->radius);
+  SDL_free(scene->color);
+  SDL_aligned_free(scene->model);
+  SDL_aligned_free(scene->mvp);
+  SDL_free(scene->dirty);
+  SDL_free(scene->dirtyList);
+  SDL_free(scene->visibleList);
+  SDL_zerop(scene);
+
+  MY_LOG_TRACE("<<< MyScene_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void mark_dirty(MyScene *scene, int index)
+{
+  if (scene->dirty[index])
+    return;
+
+  scene->dirty[index] = 1;
+  scene->dirtyList[scene->dirtyCount++] = index;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int MyScene_add(MyScene *scene, float x, float y, float z, float scale, float angle, float radius, Uint32 color)
+{
+  if (scene->count == scene->capacity)
+    return -1;
+
+  const int index = scene->count++;
+  scene->positionX[index] = x;
+  scene->positionY[index] = y;
+  scene->positionZ[index] = z;
+  scene->scale[index] = scale;
+  scene->angle[index] = angle;
+  scene->radius[index] = radius;
+  scene->color[index] = color;
+  scene->dirty[index] = 0;
+  mark_dirty(scene, index);
+
+  return index;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyScene_set_position(MyScene *scene, int index, float x, float y, float z)
+{
+  scene->positionX[index] = x;
+  scene->positionY[index] = y;
+  scene->positionZ[index] = z;
+  mark_dirty(scene, index);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyScene_set_angle(MyScene *scene, int index, float angle)
+{
+  scene->angle[index] = angle;
+  mark_dirty(scene, index);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyScene_set_view_projection(MyScene *scene, mat4 viewProjection)
+{
+  glm_mat4_copy(viewProjection, scene->viewProjection);
+  scene->viewProjectionChanged = true;
+}
+
+//------------------------------------------------------------------------------
+// Translação * rotação em Z * escala, montada direto (colunas), sem as três
+// multiplicações de glm_translate()/glm_rotate()/glm_scale().
+//------------------------------------------------------------------------------
+void compute_model(const MyScene *scene, int index, mat4 model)
+{
+  const float scale = scene->scale[index];
+  const float c = SDL_cosf(scene->angle[index]) * scale;
+  const float s = SDL_sinf(scene->angle[index]) * scale;
+
+  model[0][0] = c;    model[0][1] = s;    model[0][2] = 0.0f;  model[0][3] = 0.0f;
+  model[1][0] = -s;   model[1][1] = c;    model[1][2] = 0.0f;  model[1][3] = 0.0f;
+  model[2][0] = 0.0f; model[2][1] = 0.0f; model[2][2] = scale; model[2][3] = 0.0f;
+  model[3][0] = scene->positionX[index];
+  model[3][1] = scene->positionY[index];
+  model[3][2] = scene->positionZ[index];
+  model[3][3] = 1.0f;
+}
+
+//------------------------------------------------------------------------------
+// Os objetos alterados são processados em lotes: primeiro as matrizes do
+// modelo do lote (trigonometria, escalar), depois as MVPs (glm_mat4_mul(),
+// SIMD). As matrizes do lote (MY_SCENE_BATCH_SIZE * 64 bytes) ainda estão no
+// cache L1 quando o segundo laço as lê.
+//------------------------------------------------------------------------------
+void MyScene_update(MyScene *scene)
+{
+  const Uint64 t0 = SDL_GetTicksNS();
+
+  for (int begin = 0; begin < scene->dirtyCount; begin += MY_SCENE_BATCH_SIZE)
+  {
+    const int end = SDL_min(begin + (int)MY_SCENE_BATCH_SIZE, scene->dirtyCount);
+    for (int k = begin; k < end; ++k)
+      compute_model(scene, scene->dirtyList[k], scene->model[scene->dirtyList[k]]);
+
+    if (scene->viewProjectionChanged)
+      continue;
+
+    for (int k = begin; k < end; ++k)
+    {
+      const int index = scene->dirtyList[k];
+      glm_mat4_mul(scene->viewProjection, scene->model[index], scene->mvp[index]);
+    }
+  }
+
+  if (scene->viewProjectionChanged)
+  {
+    // Câmera nova: todas as MVPs, em ordem (acesso sequencial aos arrays).
+    for (int i = 0; i < scene->count; ++i)
+      glm_mat4_mul(scene->viewProjection, scene->model[i], scene->mvp[i]);
+    scene->stats.updatedCount = scene->count;
+  }
+  else
+  {
+    scene->stats.updatedCount = scene->dirtyCount;
+  }
+
+  for (int k = 0; k < scene->dirtyCount; ++k)
+    scene->dirty[scene->dirtyList[k]] = 0;
+  scene->dirtyCount = 0;
+  scene->viewProjectionChanged = false;
+
+  scene->stats.updateNS = SDL_GetTicksNS() - t0;
+}
+
+//------------------------------------------------------------------------------
+// Esfera contra os planos do frustum (normalizados, com a normal para dentro):
+// o objeto está fora se o centro estiver a mais de `r` atrás de algum plano.
+// O laço não tem desvios, e cada array é lido em sequência.
+//------------------------------------------------------------------------------
+int MyScene_cull(MyScene *scene)
+{
+  const Uint64 t0 = SDL_GetTicksNS();
+
+  vec4 planes[6];
+  glm_frustum_planes(scene->viewProjection, planes);
+
+  int visibleCount = 0;
+  for (int i = 0; i < scene->count; ++i)
+  {
+    const float x = scene->positionX[i];
+    const float y = scene->positionY[i];
+    const float z = scene->positionZ[i];
+    const float r = scene->radius[i] * scene->scale[i];
+    int inside = 1;
+    for (int p = 0; p < 6; ++p)
+      inside &= planes[p][0] * x + planes[p][1] * y + planes[p][2] * z + planes[p][3] >= -r;
+
+    scene->visibleList[visibleCount] = i;
+    visibleCount += inside;
+  }
+
+  scene->visibleCount = visibleCount;
+  scene->stats.drawnCount = visibleCount;
+  scene->stats.culledCount = scene->count - visibleCount;
+  scene->stats.cullNS = SDL_GetTicksNS() - t0;
+
+  return visibleCount;
+}
+
+//------------------------------------------------------------------------------
+// Aponta os atributos por instância para os dados do quadro no fluxo (não há
+// glDrawArraysInstancedBaseInstance() no OpenGL 3.3).
+//------------------------------------------------------------------------------
+void set_instance_attributes(GLintptr offset)
+{
+  for (int column = 0; column < 4; ++column)
+  {
+    glVertexAttribPointer(MVP_ATTRIBUTE + column, 4, GL_FLOAT, GL_FALSE, sizeof(SceneInstance),
+      (GLvoid *)(offset + column * 4 * sizeof(GLfloat)));
+  }
+  glVertexAttribPointer(COLOR_ATTRIBUTE, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SceneInstance),
+    (GLvoid *)(offset + offsetof(SceneInstance, color)));
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyScene_draw(MyScene *scene)
+{
+  if (scene->visibleCount == 0)
+    return;
+
+  GLintptr offset = 0;
+  SceneInstance *dst = (SceneInstance *)MyVertexStream_map(&scene->stream, (GLsizeiptr)scene->visibleCount * sizeof(SceneInstance), &offset);
+  if (!dst)
+  {
+    MyVertexStream_end_frame(&scene->stream);
+    return;
+  }
+
+  for (int k = 0; k < scene->visibleCount; ++k)
+  {
+    const int index = scene->visibleList[k];
+    SDL_memcpy(dst[k].mvp, scene->mvp[index], sizeof(dst[k].mvp));
+    dst[k].color = scene->color[index];
+  }
+  MyVertexStream_unmap(&scene->stream);
+
+  glUseProgram(scene->program);
+  glBindVertexArray(scene->vao);
+  glBindBuffer(GL_ARRAY_BUFFER, scene->stream.vbo);
+  set_instance_attributes(offset);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glDrawArraysInstanced(GL_TRIANGLES, 0, 3, scene->visibleCount);
+  glBindVertexArray(0);
+
+  MyVertexStream_end_frame(&scene->stream);
+}
@@ -0,0 +1,121 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Cena com dezenas de milhares de objetos (cópias do triângulo), guardada em
+// estrutura de arrays (SoA): posição, escala, ângulo, raio da esfera
+// envolvente e cor de cada objeto ficam em arrays separados, contínuos na
+// memória. Cada etapa percorre só os arrays de que precisa.
+//
+// A cada quadro:
+//
+// 1. update(): recalcula a matriz do modelo só dos objetos alterados (lista
+//    de "sujos") e, em lotes de MY_SCENE_BATCH_SIZE, a MVP com
+//    glm_mat4_mul() (SSE/AVX/NEON no cglm, quando disponível). Se a câmera
+//    mudou (set_view_projection()), todas as MVPs são recalculadas, mas as
+//    matrizes do modelo continuam as mesmas.
+// 2. cull(): testa a esfera envolvente de cada objeto contra os 6 planos do
+//    frustum e monta a lista de objetos visíveis.
+// 3. draw(): copia as MVPs e cores dos visíveis para um fluxo de vértices
+//    (stream.h) e desenha todos com uma chamada glDrawArraysInstanced(). Os
+//    objetos fora do frustum não são enviados para a GPU.
+//
+// O objeto é girado em torno do eixo Z e escalado uniformemente, então a
+// esfera envolvente no mundo tem centro na posição e raio `radius * scale`.
+//------------------------------------------------------------------------------
+#ifndef MY_SCENE_H
+#define MY_SCENE_H
+
+#include <stdbool.h>
+#include <GL/glew.h>
+#include <SDL3/SDL.h>
+#include <cglm/cglm.h>
+#include "stream.h"
+
+enum scene_constants
+{
+  MY_SCENE_MAX_COUNT = 1000000,
+  MY_SCENE_BATCH_SIZE = 64,
+};
+
+typedef struct MySceneStats MySceneStats;
+struct MySceneStats
+{
+  int updatedCount;  // Objetos com a MVP recalculada no último update().
+  int drawnCount;
+  int culledCount;
+  Uint64 updateNS;
+  Uint64 cullNS;
+};
+
+typedef struct MyScene MyScene;
+struct MyScene
+{
+  int count;
+  int capacity;
+
+  // Dados dos objetos (SoA).
+  float *positionX;
+  float *positionY;
+  float *positionZ;
+  float *scale;
+  float *angle;
+  float *radius;
+  Uint32 *color;  // RGBA8 (R no byte menos significativo).
+  mat4 *model;
+  mat4 *mvp;
+
+  // Objetos alterados desde o último update() (sem repetições).
+  Uint8 *dirty;
+  int *dirtyList;
+  int dirtyCount;
+
+  mat4 viewProjection;
+  bool viewProjectionChanged;
+
+  // Índices dos objetos visíveis, preenchidos por cull().
+  int *visibleList;
+  int visibleCount;
+
+  // Desenho.
+  GLuint program;
+  GLuint vao;
+  MyVertexStream stream;
+
+  MySceneStats stats;
+};
+
+/**
+ * Reserva espaço para `capacity` objetos e cria o programa e o fluxo de
+ * instâncias. `vertexBuffer` é o VBO do triângulo (X, Y, Z, R, G, B).
+ */
+bool MyScene_initialize(MyScene *scene, int capacity, GLuint vertexBuffer);
+void MyScene_destroy(MyScene *scene);
+
+/**
+ * Adiciona um objeto e retorna o seu índice, ou -1 se a cena estiver cheia.
+ * `radius` é o raio da esfera envolvente antes da escala.
+ */
+int MyScene_add(MyScene *scene, float x, float y, float z, float scale, float angle, float radius, Uint32 color);
+
+void MyScene_set_position(MyScene *scene, int index, float x, float y, float z);
+void MyScene_set_angle(MyScene *scene, int index, float angle);
+void MyScene_set_view_projection(MyScene *scene, mat4 viewProjection);
+
+/**
+ * Recalcula as matrizes dos objetos alterados (ou todas as MVPs, se a câmera
+ * mudou).
+ */
+void MyScene_update(MyScene *scene);
+
+/**
+ * Monta a lista de objetos visíveis e retorna quantos são.
+ */
+int MyScene_cull(MyScene *scene);
+
+/**
+ * Desenha os objetos visíveis (depois de cull()).
+ */
+void MyScene_draw(MyScene *scene);
+
+#endif // MY_SCENE_H
@@ -0,0 +1,132 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "shader.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+enum shader_constants
+{
+  INFO_LOG_MAX_LENGTH = 1024,
+};
+
+static const MyProgramCache *g_programCache = NULL;
+static MyShaderStats g_stats;
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static GLuint compile_shader(GLenum type, const char *code);
+static GLuint link_program(const char *name, const char *vertexCode, const char *fragmentCode);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+GLuint compile_shader(GLenum type, const char *code)
+{
+  GLuint shader = glCreateShader(type);
+  glShaderSource(shader, 1, &code, NULL);
+  glCompileShader(shader);
+
+  GLint status = GL_FALSE;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+  if (status != GL_TRUE)
+  {
+    char log[INFO_LOG_MAX_LENGTH] = { 0 };
+    glGetShaderInfoLog(shader, INFO_LOG_MAX_LENGTH, NULL, log);
+    MY_LOG_ERROR("\t\t*** Erro ao compilar %s shader:\n%s", type == GL_VERTEX_SHADER ? "vertex" : "fragment", log);
+    glDeleteShader(shader);
+    return 0;
+  }
+
+  return shader;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+GLuint link_program(const char *name, const char *vertexCode, const char *fragmentCode)
+{
+  GLuint vertexShader = compile_shader(GL_VERTEX_SHADER, vertexCode);
+  GLuint fragmentShader = compile_shader(GL_FRAGMENT_SHADER, fragmentCode);
+  if (!vertexShader || !fragmentShader)
+  {
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    return 0;
+  }
+
+  GLuint program = glCreateProgram();
+  glAttachShader(program, vertexShader);
+  glAttachShader(program, fragmentShader);
+  if (g_programCache && g_programCache->enabled)
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  glLinkProgram(program);
+
+  // Depois do link, os shaders não são mais necessários.
+  glDeleteShader(vertexShader);
+  glDeleteShader(fragmentShader);
+
+  GLint status = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &status);
+  if (status != GL_TRUE)
+  {
+    char log[INFO_LOG_MAX_LENGTH] = { 0 };
+    glGetProgramInfoLog(program, INFO_LOG_MAX_LENGTH, NULL, log);
+    MY_LOG_ERROR("\t\t*** Erro ao linkar o programa \"%s\":\n%s", name, log);
+    glDeleteProgram(program);
+    return 0;
+  }
+
+  return program;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+GLuint MyShader_create_program(const char *name, const char *vertexCode, const char *fragmentCode)
+{
+  MY_LOG_TRACE("\tMyShader_create_program(\"%s\")", name);
+
+  const Uint64 t0 = SDL_GetTicksNS();
+  GLuint program = MyProgramCache_load(g_programCache, vertexCode, fragmentCode);
+  if (program)
+  {
+    const Uint64 elapsedNS = SDL_GetTicksNS() - t0;
+    ++g_stats.cachedCount;
+    g_stats.cachedNS += elapsedNS;
+    MY_LOG_INFO("\t\tCarregado do cache em %.3f ms.", (double)elapsedNS / SDL_NS_PER_MS);
+    return program;
+  }
+
+  program = link_program(name, vertexCode, fragmentCode);
+  if (program)
+    MyProgramCache_store(g_programCache, program, vertexCode, fragmentCode);
+
+  const Uint64 elapsedNS = SDL_GetTicksNS() - t0;
+  ++g_stats.compiledCount;
+  g_stats.compiledNS += elapsedNS;
+  MY_LOG_INFO("\t\tCompilado em %.3f ms.", (double)elapsedNS / SDL_NS_PER_MS);
+  return program;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyShader_set_program_cache(const MyProgramCache *cache)
+{
+  g_programCache = cache;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const MyShaderStats *MyShader_get_stats(void)
+{
+  return &g_stats;
+}
@@ -0,0 +1,46 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Compilação e link de programas GLSL (vertex + fragment shader).
+//
+// Em caso de erro, o log do compilador/linker é registrado com MY_LOG_ERROR()
+// e a função retorna 0, para que o chamador possa encerrar o programa ao invés
+// de desenhar com um programa inválido.
+//
+// Com um cache de programas (program_cache.h) configurado, o programa é
+// carregado do binário guardado em disco quando possível; senão, é compilado
+// e o binário é guardado para a próxima execução. As estatísticas separam os
+// programas vindos do cache dos compilados, com o tempo gasto em cada grupo.
+//------------------------------------------------------------------------------
+#ifndef MY_SHADER_H
+#define MY_SHADER_H
+
+#include <GL/glew.h>
+#include <SDL3/SDL.h>
+#include "program_cache.h"
+
+typedef struct MyShaderStats MyShaderStats;
+struct MyShaderStats
+{
+  int cachedCount;
+  int compiledCount;
+  Uint64 cachedNS;
+  Uint64 compiledNS;
+};
+
+/**
+ * Compila os dois shaders e retorna o programa linkado, ou 0 em caso de erro.
+ * `name` só é usado nas mensagens de log.
+ */
+GLuint MyShader_create_program(const char *name, const char *vertexCode, const char *fragmentCode);
+
+/**
+ * Cache usado pelas próximas chamadas de MyShader_create_program() (NULL =
+ * sem cache). O cache deve continuar válido enquanto estiver configurado.
+ */
+void MyShader_set_program_cache(const MyProgramCache *cache);
+
+const MyShaderStats *MyShader_get_stats(void);
+
+#endif // MY_SHADER_H
@@ -0,0 +1,196 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "stream.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+
+// Espera máxima por uma cerca antes de desistir (1 segundo).
+static const GLuint64 FENCE_TIMEOUT_NS = 1000000000ull;
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static void begin_segment(MyVertexStream *stream);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyVertexStream_initialize(MyVertexStream *stream, GLsizeiptr frameCapacity, MyVertexStreamMode mode)
+{
+  MY_LOG_TRACE(">>> MyVertexStream_initialize(%lld, %s)", (long long)frameCapacity, MyVertexStream_get_mode_name(mode));
+
+  if (!stream || frameCapacity <= 0)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyVertexStream_initialize()");
+    return false;
+  }
+
+  SDL_zerop(stream);
+  stream->mode = mode;
+  stream->frameCapacity = frameCapacity;
+
+  const GLsizeiptr size = mode == MY_STREAM_ORPHAN ? frameCapacity : frameCapacity * MY_STREAM_SEGMENT_COUNT;
+
+  glGenBuffers(1, &stream->vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, stream->vbo);
+  glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  if (glGetError() != GL_NO_ERROR)
+  {
+    MY_LOG_ERROR("\t*** Erro ao criar o VBO de %lld bytes.", (long long)size);
+    MyVertexStream_destroy(stream);
+    MY_LOG_TRACE("<<< MyVertexStream_initialize()");
+    return false;
+  }
+
+  MY_LOG_TRACE("<<< MyVertexStream_initialize()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyVertexStream_destroy(MyVertexStream *stream)
+{
+  MY_LOG_TRACE(">>> MyVertexStream_destroy()");
+
+  if (!stream)
+  {
+    MY_LOG_ERROR("\t*** Erro: Fluxo inválido (stream == NULL).");
+    MY_LOG_TRACE("<<< MyVertexStream_destroy()");
+    return;
+  }
+
+  if (stream->mapped)
+    MyVertexStream_unmap(stream);
+
+  for (int i = 0; i < MY_STREAM_SEGMENT_COUNT; ++i)
+  {
+    if (stream->fences[i])
+      glDeleteSync(stream->fences[i]);
+  }
+
+  glDeleteBuffers(1, &stream->vbo);
+  SDL_zerop(stream);
+
+  MY_LOG_TRACE("<<< MyVertexStream_destroy()");
+}
+
+//------------------------------------------------------------------------------
+// Primeira escrita do quadro: garante que a GPU não lê mais o segmento.
+//------------------------------------------------------------------------------
+void begin_segment(MyVertexStream *stream)
+{
+  stream->frameStarted = true;
+  stream->head = 0;
+
+  if (stream->mode == MY_STREAM_ORPHAN)
+  {
+    glBufferData(GL_ARRAY_BUFFER, stream->frameCapacity, NULL, GL_STREAM_DRAW);
+    return;
+  }
+
+  GLsync fence = stream->fences[stream->segment];
+  if (!fence)
+    return;
+
+  // Consulta sem esperar; só mede (e conta) se a GPU ainda estiver atrasada.
+  GLenum result = glClientWaitSync(fence, 0, 0);
+  if (result == GL_TIMEOUT_EXPIRED)
+  {
+    const Uint64 t0 = SDL_GetTicksNS();
+    result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+    stream->stats.waitNS += SDL_GetTicksNS() - t0;
+    ++stream->stats.waitCount;
+  }
+
+  if (result == GL_WAIT_FAILED || result == GL_TIMEOUT_EXPIRED)
+    MY_LOG_ERROR("\t*** Erro ao esperar pela cerca do segmento %d.", stream->segment);
+
+  glDeleteSync(fence);
+  stream->fences[stream->segment] = NULL;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void *MyVertexStream_map(MyVertexStream *stream, GLsizeiptr size, GLintptr *offset)
+{
+  glBindBuffer(GL_ARRAY_BUFFER, stream->vbo);
+
+  if (!stream->frameStarted)
+    begin_segment(stream);
+
+  if (stream->mapped || size <= 0 || stream->head + size > stream->frameCapacity)
+    return NULL;
+
+  const GLintptr start = (GLintptr)stream->segment * stream->frameCapacity + stream->head;
+
+  // O segmento não está em uso pela GPU (cerca) ou é um armazenamento novo
+  // (órfão): não há o que sincronizar, e o conteúdo antigo pode ser descartado.
+  void *dst = glMapBufferRange(GL_ARRAY_BUFFER, start, size, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+  if (!dst)
+    return NULL;
+
+  stream->mapped = true;
+  stream->head += size;
+  stream->stats.totalBytes += (Uint64)size;
+
+  *offset = start;
+  return dst;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyVertexStream_unmap(MyVertexStream *stream)
+{
+  if (!stream->mapped)
+    return;
+
+  glBindBuffer(GL_ARRAY_BUFFER, stream->vbo);
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  stream->mapped = false;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyVertexStream_end_frame(MyVertexStream *stream)
+{
+  if (stream->mode == MY_STREAM_MAP_UNSYNCHRONIZED && stream->frameStarted)
+  {
+    stream->fences[stream->segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    stream->segment = (stream->segment + 1) % MY_STREAM_SEGMENT_COUNT;
+  }
+
+  stream->stats.frameBytes = (Uint64)stream->head;
+  stream->frameStarted = false;
+  stream->head = 0;
+  ++stream->stats.frameCount;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const char *MyVertexStream_get_mode_name(MyVertexStreamMode mode)
+{
+  switch (mode)
+  {
+    case MY_STREAM_MAP_UNSYNCHRONIZED:
+      return "anel + cercas";
+    case MY_STREAM_ORPHAN:
+      return "órfão";
+  }
+
+  return "?";
+}
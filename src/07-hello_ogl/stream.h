@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Fluxo de vértices dinâmico: geometria que muda a cada quadro, enviada para
+// a GPU sem esperar que ela termine de usar os dados do quadro anterior.
+//
+// Escrever em um VBO que a GPU ainda está lendo obrigaria o driver a esperar
+// (ou a copiar o buffer). Há duas estratégias, escolhidas em initialize():
+//
+// - MY_STREAM_MAP_UNSYNCHRONIZED (anel): o VBO tem MY_STREAM_SEGMENT_COUNT
+//   segmentos de `frameCapacity` bytes, um por quadro em uso. Cada quadro
+//   escreve no próximo segmento com glMapBufferRange(GL_MAP_UNSYNCHRONIZED_BIT
+//   | GL_MAP_INVALIDATE_RANGE_BIT), sem sincronização do driver; no fim do
+//   quadro, uma cerca (glFenceSync) marca os comandos que leem o segmento.
+//   Antes de reutilizá-lo, MY_STREAM_SEGMENT_COUNT quadros depois, a cerca é
+//   consultada e, só se a GPU ainda não passou por ela, a CPU espera.
+//
+// - MY_STREAM_ORPHAN (órfão): o VBO tem um único segmento e, no início de
+//   cada quadro, glBufferData(NULL) "abandona" o armazenamento antigo (que o
+//   driver libera quando a GPU terminar) e aloca outro. As esperas, se
+//   houver, ficam escondidas dentro do driver.
+//
+// As estatísticas contam os bytes enviados por quadro e, no modo anel, as
+// esperas por cercas e o tempo gasto nelas.
+//
+// Uso típico, a cada quadro:
+//
+//   GLintptr offset;
+//   float *dst = MyVertexStream_map(&stream, size, &offset);
+//   ... escreve `size` bytes em dst (só escrita, sem ler) ...
+//   MyVertexStream_unmap(&stream);
+//   ... desenha a partir de `offset` ...
+//   MyVertexStream_end_frame(&stream);
+//------------------------------------------------------------------------------
+#ifndef MY_STREAM_H
+#define MY_STREAM_H
+
+#include <stdbool.h>
+#include <GL/glew.h>
+#include <SDL3/SDL.h>
+
+enum stream_constants
+{
+  MY_STREAM_SEGMENT_COUNT = 3,
+};
+
+typedef enum MyVertexStreamMode
+{
+  MY_STREAM_MAP_UNSYNCHRONIZED,
+  MY_STREAM_ORPHAN,
+} MyVertexStreamMode;
+
+typedef struct MyVertexStreamStats MyVertexStreamStats;
+struct MyVertexStreamStats
+{
+  Uint64 frameBytes;  // Bytes escritos no último quadro encerrado.
+  Uint64 totalBytes;
+  Uint64 frameCount;
+  Uint64 waitCount;   // Quadros em que a CPU esperou por uma cerca.
+  Uint64 waitNS;
+};
+
+typedef struct MyVertexStream MyVertexStream;
+struct MyVertexStream
+{
+  MyVertexStreamMode mode;
+  GLuint vbo;
+  GLsizeiptr frameCapacity;
+
+  int segment;        // Segmento do quadro atual.
+  GLsizeiptr head;    // Bytes já usados no segmento atual.
+  bool frameStarted;  // Segmento atual já preparado (cerca ou órfão).
+  bool mapped;
+  GLsync fences[MY_STREAM_SEGMENT_COUNT];
+
+  MyVertexStreamStats stats;
+};
+
+/**
+ * Cria o VBO com `frameCapacity` bytes por quadro (vezes
+ * MY_STREAM_SEGMENT_COUNT no modo anel).
+ */
+bool MyVertexStream_initialize(MyVertexStream *stream, GLsizeiptr frameCapacity, MyVertexStreamMode mode);
+void MyVertexStream_destroy(MyVertexStream *stream);
+
+/**
+ * Reserva `size` bytes no quadro atual e retorna o ponteiro para escrita, ou
+ * NULL se não couber em `frameCapacity`. `offset` recebe a posição dos dados
+ * no VBO. Deixa o VBO ligado em GL_ARRAY_BUFFER.
+ */
+void *MyVertexStream_map(MyVertexStream *stream, GLsizeiptr size, GLintptr *offset);
+void MyVertexStream_unmap(MyVertexStream *stream);
+
+/**
+ * Encerra o quadro (depois dos desenhos que leem os dados) e passa para o
+ * próximo segmento.
+ */
+void MyVertexStream_end_frame(MyVertexStream *stream);
+
+const char *MyVertexStream_get_mode_name(MyVertexStreamMode mode);
+
+#endif // MY_STREAM_H
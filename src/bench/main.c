@@ -0,0 +1,826 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Ferramenta: bench
+// Mede, sem abrir janela, o tempo dos filtros da biblioteca comum
+// (common/filters.h) aplicados a uma imagem: negativo (invert) e filtro de
+// média com os tamanhos associados às teclas '1' a '9' do exemplo
+// 06-filter_image, e o filtro gaussiano (gauss<sigma>). Os filtros de
+// vizinhança também são medidos "in place" (<kernel>_inplace), sobre a
+// própria superfície de saída, e alguns filtros também com 16 bits
+// (<kernel>_u16, RGBA64) e float (<kernel>_f32, RGBA128_FLOAT) por canal.
+// Também mede as conversões de cor (common/color.h), de RGBA32 para imagens
+// planares (to_<espaço>) e de volta (from_<espaço>), e o redimensionamento
+// (common/resample.h) para metade do tamanho com cada filtro
+// (resample_<filtro>) e a detecção de bordas (common/edges.h) com os parâmetros
+// padrão (edges_<modo>).
+//
+// Uso: main [opções]
+//   --image <arquivo>     imagem de entrada (padrão: DEFAULT_IMAGE_FILENAME)
+//   --iterations <n>      execuções medidas de cada kernel (padrão: 10)
+//   --threads <n>         threads usadas pelos filtros (padrão: núcleos lógicos)
+//   --output <arquivo>    grava os resultados em CSV
+//   --compare <arquivo>   compara com um CSV gravado antes (--output) e mostra
+//                         o speedup de cada kernel
+//   --counters            mede também os contadores de desempenho do hardware
+//                         (common/perf_counters.h) de cada kernel
+//
+// Cada kernel é executado uma vez antes das medições (aquece caches e o pool de
+// threads). São registrados o menor tempo (menos sujeito a interferências do
+// sistema, usado no speedup) e a mediana.
+//
+// Também é medido o acréscimo ao pico de memória residente (Linux, VmHWM de
+// /proc/self/status, zerado antes de cada kernel): tudo o que o kernel aloca,
+// incluindo a superfície de saída, criada para cada kernel. Os filtros "in
+// place" trabalham sobre uma cópia da imagem criada no início, então só a
+// memória temporária entra na conta. Blocos das arenas das threads ficam
+// reservados depois do primeiro kernel que os usa e não voltam a ser contados.
+//
+// Com --counters, os contadores somam as execuções medidas de cada kernel (em
+// todas as threads) e são mostrados por execução: IPC (instruções por ciclo),
+// faltas na L1 de dados e na LLC e desvios mal previstos por pixel, bytes por
+// pixel trazidos da memória (faltas na LLC x linha de cache) e o tempo de CPU
+// somado entre as threads. Contadores indisponíveis aparecem como "n/d" (e
+// vazios no CSV); os tempos continuam sendo medidos normalmente.
+//
+// O programa também é a carga de treino da otimização guiada por perfil (PGO):
+// veja o alvo `pgo` no makefile. A variável de ambiente COMPVIS_CPU
+// (kernels.h) permite medir um conjunto de instruções específico.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include "kernels.h"
+#include "image.h"
+#include "parallel.h"
+#include "filters.h"
+#include "color.h"
+#include "resample.h"
+#include "edges.h"
+#include "perf_counters.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+static const char *DEFAULT_IMAGE_FILENAME = "../06-filter_image/kodim23.png";
+static const char *CSV_HEADER = "kernel,min_ms,median_ms,mpixels_per_s,ipc,l1d_misses_per_pixel,"
+  "llc_misses_per_pixel,branch_misses_per_pixel,bytes_per_pixel,cpu_ms,peak_rss_kib";
+
+// Valor das métricas dos contadores quando algum contador está indisponível.
+static const double METRIC_UNAVAILABLE = -1.0;
+
+static const char *PROC_STATUS_FILENAME = "/proc/self/status";
+static const char *PROC_CLEAR_REFS_FILENAME = "/proc/self/clear_refs";
+
+enum constants
+{
+  DEFAULT_ITERATIONS = 10,
+  MAX_ITERATIONS = 1000,
+  KERNEL_NAME_LENGTH = 32,
+  PROC_STATUS_SIZE = 4096,
+  MMAP_THRESHOLD = 128 * 1024,
+};
+
+// Tamanhos do filtro de média das teclas '1' a '9' do exemplo 06-filter_image.
+static const Uint32 FILTER_SIZES[] = { 3, 5, 7, 11, 15, 29, 41, 73, 101 };
+
+static const float GAUSSIAN_SIGMAS[] = { 1.0f, 3.0f };
+
+// Formatos com mais de 8 bits por canal medidos com o negativo, o filtro de
+// média 15x15 e o gaussiano com sigma 3.
+static const SDL_PixelFormat TYPED_FORMATS[] = { SDL_PIXELFORMAT_RGBA64, SDL_PIXELFORMAT_RGBA128_FLOAT };
+
+typedef struct MyBenchConversion MyBenchConversion;
+struct MyBenchConversion
+{
+  MyColorSpace space;
+  MyChromaSubsampling subsampling;
+};
+
+// Conversões de cor medidas (ida e volta de cada uma).
+static const MyBenchConversion COLOR_CONVERSIONS[] = {
+  { MY_COLOR_GRAY, MY_CHROMA_444 },
+  { MY_COLOR_YCBCR_601, MY_CHROMA_444 },
+  { MY_COLOR_YCBCR_601, MY_CHROMA_420 },
+  { MY_COLOR_YCBCR_709, MY_CHROMA_444 },
+  { MY_COLOR_HSV, MY_CHROMA_444 },
+  { MY_COLOR_LAB, MY_CHROMA_444 },
+};
+
+// Negativo + um filtro de média e um gaussiano por tamanho (com e sem "in
+// place") + as conversões de cor + os filtros de redimensionamento + os modos
+// de detecção de bordas + 3 filtros por formato de TYPED_FORMATS.
+#define KERNEL_COUNT (1 + 2 * SDL_arraysize(FILTER_SIZES) + 2 * SDL_arraysize(GAUSSIAN_SIGMAS) \
+  + 2 * SDL_arraysize(COLOR_CONVERSIONS) + MY_RESAMPLE_FILTER_COUNT + MY_EDGE_MODE_COUNT - 1 + 3 * SDL_arraysize(TYPED_FORMATS))
+
+typedef enum MyBenchKernelType
+{
+  MY_BENCH_INVERT,
+  MY_BENCH_BLUR,
+  MY_BENCH_GAUSSIAN,
+  MY_BENCH_TO_PLANAR,
+  MY_BENCH_FROM_PLANAR,
+  MY_BENCH_RESAMPLE,
+  MY_BENCH_EDGES,
+} MyBenchKernelType;
+
+typedef struct MyBenchKernel MyBenchKernel;
+struct MyBenchKernel
+{
+  MyBenchKernelType type;
+  Uint32 filterSize;                // MY_BENCH_BLUR.
+  float sigma;                      // MY_BENCH_GAUSSIAN.
+  bool inPlace;                     // MY_BENCH_BLUR e MY_BENCH_GAUSSIAN.
+  SDL_PixelFormat format;           // MY_BENCH_INVERT, MY_BENCH_BLUR e MY_BENCH_GAUSSIAN (0 = RGBA32).
+  MyBenchConversion conversion;     // MY_BENCH_TO_PLANAR e MY_BENCH_FROM_PLANAR.
+  MyResampleFilter resampleFilter;  // MY_BENCH_RESAMPLE.
+  MyEdgeMode edgeMode;              // MY_BENCH_EDGES.
+};
+
+typedef struct MyBenchOptions MyBenchOptions;
+struct MyBenchOptions
+{
+  const char *imageFilename;
+  const char *outputFilename;
+  const char *compareFilename;
+  int iterations;
+  int threads;
+  bool counters;
+};
+
+typedef struct MyBenchResult MyBenchResult;
+struct MyBenchResult
+{
+  char name[KERNEL_NAME_LENGTH];
+  double minMS;
+  double medianMS;
+  double megapixelsPerSecond;
+
+  // Métricas dos contadores, por execução (METRIC_UNAVAILABLE se indisponível).
+  double ipc;
+  double l1dMissesPerPixel;
+  double llcMissesPerPixel;
+  double branchMissesPerPixel;
+  double bytesPerPixel;
+  double cpuMS;
+
+  // Acréscimo ao pico de memória residente (METRIC_UNAVAILABLE se indisponível).
+  double peakKiB;
+};
+
+//------------------------------------------------------------------------------
+// Globals (argh!)
+//------------------------------------------------------------------------------
+static MyThreadPool g_threadPool;
+static SDL_Surface *g_source = NULL;
+static SDL_Surface *g_destination = NULL;
+static SDL_Surface *g_inPlaceImage = NULL;
+static MyPlanarImage g_planar;
+static SDL_Surface *g_resampled = NULL;
+static SDL_Surface *g_typedSource = NULL;
+static SDL_Surface *g_typedDestination = NULL;
+static MyPerfCounters g_counters;
+static bool g_useCounters = false;
+
+static MyBenchResult g_results[KERNEL_COUNT];
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static bool parse_options(int argc, char *argv[], MyBenchOptions *options);
+
+/**
+ * Ordem crescente de doubles (SDL_qsort()).
+ */
+static int compare_doubles(const void *a, const void *b);
+
+static bool run_kernel(const MyBenchKernel *kernel);
+
+/**
+ * Executa `kernel` uma vez para aquecer e depois `iterations` vezes, medindo
+ * cada execução.
+ */
+static bool measure_kernel(const MyBenchKernel *kernel, int iterations, MyBenchResult *result);
+
+/**
+ * Preenche as métricas de `result` a partir dos contadores somados em
+ * `iterations` execuções.
+ */
+static void compute_metrics(const MyPerfValues *values, int iterations, MyBenchResult *result);
+
+/**
+ * Grava `value` em `text` com `format`, ou `unavailableText` se o valor for
+ * METRIC_UNAVAILABLE.
+ */
+static void format_metric(char *text, size_t size, const char *format, double value, const char *unavailableText);
+
+/**
+ * Zera o pico de memória residente do processo (VmHWM) com o valor atual.
+ * Retorna false se o sistema não permitir (ou não for Linux).
+ */
+static bool reset_peak_memory(void);
+
+/**
+ * Valor, em KiB, do campo `field` (ex. "VmRSS:") de /proc/self/status, ou -1
+ * se indisponível.
+ */
+static Sint64 get_process_memory_kib(const char *field);
+
+static bool save_results(const char *filename, const MyBenchResult *results, int count);
+
+/**
+ * Lê um CSV gravado por save_results() e mostra, para cada kernel presente nos
+ * dois conjuntos, o speedup (tempo anterior / tempo atual) e a média
+ * geométrica dos speedups.
+ */
+static bool compare_results(const char *filename, const MyBenchResult *results, int count);
+
+static void shutdown(void);
+
+//------------------------------------------------------------------------------
+// Function implementation
+//------------------------------------------------------------------------------
+bool parse_options(int argc, char *argv[], MyBenchOptions *options)
+{
+  options->imageFilename = DEFAULT_IMAGE_FILENAME;
+  options->outputFilename = NULL;
+  options->compareFilename = NULL;
+  options->iterations = DEFAULT_ITERATIONS;
+  options->threads = 0;
+  options->counters = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const bool hasValue = (i + 1 < argc);
+
+    if (SDL_strcmp(argv[i], "--image") == 0 && hasValue)
+      options->imageFilename = argv[++i];
+    else if (SDL_strcmp(argv[i], "--output") == 0 && hasValue)
+      options->outputFilename = argv[++i];
+    else if (SDL_strcmp(argv[i], "--compare") == 0 && hasValue)
+      options->compareFilename = argv[++i];
+    else if (SDL_strcmp(argv[i], "--iterations") == 0 && hasValue)
+    {
+      const int iterations = SDL_atoi(argv[++i]);
+      options->iterations = SDL_clamp(iterations, 1, MAX_ITERATIONS);
+    }
+    else if (SDL_strcmp(argv[i], "--counters") == 0)
+      options->counters = true;
+    else if (SDL_strcmp(argv[i], "--threads") == 0 && hasValue)
+    {
+      const int threads = SDL_atoi(argv[++i]);
+      options->threads = SDL_max(threads, 0);
+    }
+    else
+    {
+      MY_LOG_ERROR("*** Erro: Opção inválida ou sem valor: %s", argv[i]);
+      MY_LOG_INFO("Uso: %s [--image <arquivo>] [--iterations <n>] [--threads <n>] [--output <csv>] [--compare <csv>] [--counters]", argv[0]);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int compare_doubles(const void *a, const void *b)
+{
+  const double x = *(const double *)a;
+  const double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool run_kernel(const MyBenchKernel *kernel)
+{
+  // Com `format`, os filtros usam as cópias da imagem nesse formato.
+  SDL_Surface *source = g_typedSource ? g_typedSource : g_source;
+  SDL_Surface *destination = g_typedDestination ? g_typedDestination : g_destination;
+
+  switch (kernel->type)
+  {
+  case MY_BENCH_INVERT:
+    return MyFilter_invert(source, destination, &g_threadPool);
+  case MY_BENCH_BLUR:
+    // "In place", a cópia da imagem é filtrada de novo a cada execução (o
+    // custo não depende do conteúdo).
+    if (kernel->inPlace)
+      return MyFilter_blur(g_inPlaceImage, g_inPlaceImage, kernel->filterSize, &g_threadPool);
+    return MyFilter_blur(source, destination, kernel->filterSize, &g_threadPool);
+  case MY_BENCH_GAUSSIAN:
+    if (kernel->inPlace)
+      return MyFilter_gaussian(g_inPlaceImage, g_inPlaceImage, kernel->sigma, &g_threadPool);
+    return MyFilter_gaussian(source, destination, kernel->sigma, &g_threadPool);
+  case MY_BENCH_TO_PLANAR:
+    return MyColor_from_rgba32(g_source, &g_planar, &g_threadPool);
+  case MY_BENCH_FROM_PLANAR:
+    return MyColor_to_rgba32(&g_planar, g_destination, &g_threadPool);
+  case MY_BENCH_RESAMPLE:
+    return MyResample_surface(g_source, g_resampled, kernel->resampleFilter, &g_threadPool);
+  case MY_BENCH_EDGES:
+  {
+    const MyEdgeParams params = MyEdges_get_default_params();
+    return MyEdges_apply(g_source, g_destination, kernel->edgeMode, &params, &g_threadPool);
+  }
+  }
+
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool measure_kernel(const MyBenchKernel *kernel, int iterations, MyBenchResult *result)
+{
+  static double times[MAX_ITERATIONS];
+
+  const MyBenchConversion *conversion = &kernel->conversion;
+  const char *subsampling = conversion->subsampling == MY_CHROMA_420 ? "_420"
+    : conversion->subsampling == MY_CHROMA_422 ? "_422" : "";
+
+  // O pico de memória conta tudo o que o kernel aloca a partir daqui.
+  const Sint64 baseKiB = reset_peak_memory() ? get_process_memory_kib("VmRSS:") : -1;
+
+  switch (kernel->type)
+  {
+  case MY_BENCH_INVERT:
+    SDL_snprintf(result->name, sizeof(result->name), "invert");
+    break;
+  case MY_BENCH_BLUR:
+    SDL_snprintf(result->name, sizeof(result->name), "blur%u%s", kernel->filterSize, kernel->inPlace ? "_inplace" : "");
+    break;
+  case MY_BENCH_GAUSSIAN:
+    SDL_snprintf(result->name, sizeof(result->name), "gauss%g%s", kernel->sigma, kernel->inPlace ? "_inplace" : "");
+    break;
+  case MY_BENCH_TO_PLANAR:
+  case MY_BENCH_FROM_PLANAR:
+    SDL_snprintf(result->name, sizeof(result->name), "%s_%s%s", kernel->type == MY_BENCH_TO_PLANAR ? "to" : "from",
+      MyColor_get_space_name(conversion->space), subsampling);
+
+    // A imagem planar é criada fora das medições; a volta parte de uma ida.
+    if (!MyPlanarImage_create(&g_planar, g_source->w, g_source->h, conversion->space, conversion->subsampling)
+      || !MyColor_from_rgba32(g_source, &g_planar, &g_threadPool))
+    {
+      MyPlanarImage_destroy(&g_planar);
+      MY_LOG_ERROR("\t*** Erro ao preparar o kernel %s.", result->name);
+      return false;
+    }
+    break;
+  case MY_BENCH_RESAMPLE:
+    SDL_snprintf(result->name, sizeof(result->name), "resample_%s", MyResample_get_filter_name(kernel->resampleFilter));
+
+    g_resampled = SDL_CreateSurface(SDL_max(1, g_source->w / 2), SDL_max(1, g_source->h / 2), SDL_PIXELFORMAT_RGBA32);
+    if (!g_resampled)
+    {
+      MY_LOG_ERROR("\t*** Erro ao preparar o kernel %s.", result->name);
+      return false;
+    }
+    break;
+  case MY_BENCH_EDGES:
+    SDL_snprintf(result->name, sizeof(result->name), "edges_%s", MyEdges_get_mode_name(kernel->edgeMode));
+    break;
+  }
+
+  // A saída RGBA32 é criada para cada kernel (e entra no pico de memória).
+  const bool hasDestination = kernel->format == SDL_PIXELFORMAT_UNKNOWN && !kernel->inPlace
+    && kernel->type != MY_BENCH_TO_PLANAR && kernel->type != MY_BENCH_RESAMPLE;
+  if (hasDestination)
+  {
+    g_destination = SDL_CreateSurface(g_source->w, g_source->h, SDL_PIXELFORMAT_RGBA32);
+    if (!g_destination)
+    {
+      MyPlanarImage_destroy(&g_planar);
+      MY_LOG_ERROR("\t*** Erro ao preparar o kernel %s: %s", result->name, SDL_GetError());
+      return false;
+    }
+  }
+
+  // As cópias da imagem em `format` são criadas fora das medições.
+  if (kernel->format != SDL_PIXELFORMAT_UNKNOWN)
+  {
+    const size_t length = SDL_strlen(result->name);
+    SDL_snprintf(result->name + length, sizeof(result->name) - length, "_%s",
+      kernel->format == SDL_PIXELFORMAT_RGBA64 ? "u16" : "f32");
+
+    g_typedSource = SDL_ConvertSurface(g_source, kernel->format);
+    g_typedDestination = SDL_CreateSurface(g_source->w, g_source->h, kernel->format);
+    if (!g_typedSource || !g_typedDestination)
+    {
+      SDL_DestroySurface(g_typedSource);
+      SDL_DestroySurface(g_typedDestination);
+      g_typedSource = g_typedDestination = NULL;
+      MY_LOG_ERROR("\t*** Erro ao preparar o kernel %s: %s", result->name, SDL_GetError());
+      return false;
+    }
+  }
+
+  bool ok = true;
+  for (int i = -1; ok && i < iterations; ++i)
+  {
+    // Os contadores começam depois do aquecimento.
+    if (i == 0 && g_useCounters)
+      MyPerfCounters_start(&g_counters);
+
+    const Uint64 start = SDL_GetTicksNS();
+    ok = run_kernel(kernel);
+    const Uint64 elapsed = SDL_GetTicksNS() - start;
+
+    // A execução i = -1 só aquece.
+    if (i >= 0)
+      times[i] = (double)elapsed / SDL_NS_PER_MS;
+  }
+
+  MyPerfValues values = { 0 };
+  if (g_useCounters)
+    MyPerfCounters_stop(&g_counters, &values);
+
+  const Sint64 peakKiB = (baseKiB >= 0) ? get_process_memory_kib("VmHWM:") : -1;
+  result->peakKiB = (peakKiB >= 0) ? (double)SDL_max(peakKiB - baseKiB, 0) : METRIC_UNAVAILABLE;
+
+  SDL_DestroySurface(g_destination);
+  g_destination = NULL;
+  MyPlanarImage_destroy(&g_planar);
+  SDL_DestroySurface(g_resampled);
+  g_resampled = NULL;
+  SDL_DestroySurface(g_typedSource);
+  SDL_DestroySurface(g_typedDestination);
+  g_typedSource = g_typedDestination = NULL;
+
+  if (!ok)
+  {
+    MY_LOG_ERROR("\t*** Erro ao executar o kernel %s.", result->name);
+    return false;
+  }
+
+  SDL_qsort(times, (size_t)iterations, sizeof(times[0]), compare_doubles);
+
+  const double megapixels = (double)g_source->w * g_source->h / 1.0e6;
+  result->minMS = times[0];
+  result->medianMS = times[iterations / 2];
+  result->megapixelsPerSecond = (result->minMS > 0.0) ? megapixels / (result->minMS / 1000.0) : 0.0;
+
+  char peak[16];
+  format_metric(peak, sizeof(peak), "+%.0f", result->peakKiB, "n/d");
+  MY_LOG_INFO("\t%-18s  min: %9.3f ms  mediana: %9.3f ms  %10.1f MP/s  memória: %8s KiB",
+    result->name, result->minMS, result->medianMS, result->megapixelsPerSecond, peak);
+
+  compute_metrics(&values, iterations, result);
+  if (g_useCounters)
+  {
+    char ipc[16];
+    char l1d[16];
+    char llc[16];
+    char branch[16];
+    char bytes[16];
+    char cpu[16];
+    format_metric(ipc, sizeof(ipc), "%5.2f", result->ipc, "n/d");
+    format_metric(l1d, sizeof(l1d), "%7.3f", result->l1dMissesPerPixel, "n/d");
+    format_metric(llc, sizeof(llc), "%7.4f", result->llcMissesPerPixel, "n/d");
+    format_metric(branch, sizeof(branch), "%7.4f", result->branchMissesPerPixel, "n/d");
+    format_metric(bytes, sizeof(bytes), "%6.2f", result->bytesPerPixel, "n/d");
+    format_metric(cpu, sizeof(cpu), "%9.3f", result->cpuMS, "n/d");
+    MY_LOG_INFO("\t%-18s  IPC: %s  por pixel: L1D %s  LLC %s  desvios %s  %s bytes  CPU: %s ms",
+      "", ipc, l1d, llc, branch, bytes, cpu);
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void compute_metrics(const MyPerfValues *values, int iterations, MyBenchResult *result)
+{
+  const double pixels = (double)g_source->w * g_source->h * iterations;
+  const bool *available = values->available;
+  const double *counts = values->values;
+
+  result->ipc = (available[MY_PERF_CYCLES] && available[MY_PERF_INSTRUCTIONS] && counts[MY_PERF_CYCLES] > 0.0)
+    ? counts[MY_PERF_INSTRUCTIONS] / counts[MY_PERF_CYCLES] : METRIC_UNAVAILABLE;
+  result->l1dMissesPerPixel = available[MY_PERF_L1D_MISSES] ? counts[MY_PERF_L1D_MISSES] / pixels : METRIC_UNAVAILABLE;
+  result->llcMissesPerPixel = available[MY_PERF_LLC_MISSES] ? counts[MY_PERF_LLC_MISSES] / pixels : METRIC_UNAVAILABLE;
+  result->branchMissesPerPixel = available[MY_PERF_BRANCH_MISSES] ? counts[MY_PERF_BRANCH_MISSES] / pixels : METRIC_UNAVAILABLE;
+  result->bytesPerPixel = available[MY_PERF_LLC_MISSES]
+    ? counts[MY_PERF_LLC_MISSES] * MY_PERF_CACHE_LINE_SIZE / pixels : METRIC_UNAVAILABLE;
+  result->cpuMS = available[MY_PERF_TASK_CLOCK]
+    ? counts[MY_PERF_TASK_CLOCK] / iterations / SDL_NS_PER_MS : METRIC_UNAVAILABLE;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void format_metric(char *text, size_t size, const char *format, double value, const char *unavailableText)
+{
+  if (value == METRIC_UNAVAILABLE)
+    SDL_snprintf(text, size, "%s", unavailableText);
+  else
+    SDL_snprintf(text, size, format, value);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool reset_peak_memory(void)
+{
+#if defined(__linux__)
+  // "5" em clear_refs iguala o pico (VmHWM) ao uso atual (Linux 4.0+).
+  SDL_IOStream *file = SDL_IOFromFile(PROC_CLEAR_REFS_FILENAME, "w");
+  if (!file)
+    return false;
+
+  const bool ok = SDL_IOprintf(file, "5") > 0;
+  return SDL_CloseIO(file) && ok;
+#else
+  return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+Sint64 get_process_memory_kib(const char *field)
+{
+  // O tamanho de arquivos em /proc é 0, então SDL_LoadFile() não serve.
+  SDL_IOStream *file = SDL_IOFromFile(PROC_STATUS_FILENAME, "r");
+  if (!file)
+    return -1;
+
+  char status[PROC_STATUS_SIZE];
+  size_t length = 0;
+  size_t chunk = 0;
+  while (length < sizeof(status) - 1 && (chunk = SDL_ReadIO(file, status + length, sizeof(status) - 1 - length)) > 0)
+    length += chunk;
+  status[length] = '\0';
+  SDL_CloseIO(file);
+
+  // Cada linha: "<campo>:\t<valor> kB".
+  const char *line = SDL_strstr(status, field);
+  if (!line)
+    return -1;
+
+  return (Sint64)SDL_strtoll(line + SDL_strlen(field), NULL, 10);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool save_results(const char *filename, const MyBenchResult *results, int count)
+{
+  MY_LOG_TRACE(">>> save_results(\"%s\")", filename);
+
+  SDL_IOStream *file = SDL_IOFromFile(filename, "w");
+  if (!file)
+  {
+    MY_LOG_ERROR("\t*** Erro ao criar arquivo: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< save_results(\"%s\")", filename);
+    return false;
+  }
+
+  bool ok = SDL_IOprintf(file, "%s\n", CSV_HEADER) > 0;
+  for (int i = 0; ok && i < count; ++i)
+  {
+    // Métricas indisponíveis ficam vazias.
+    const MyBenchResult *result = &results[i];
+    char metrics[7][32];
+    format_metric(metrics[0], sizeof(metrics[0]), "%.4f", result->ipc, "");
+    format_metric(metrics[1], sizeof(metrics[1]), "%.6f", result->l1dMissesPerPixel, "");
+    format_metric(metrics[2], sizeof(metrics[2]), "%.6f", result->llcMissesPerPixel, "");
+    format_metric(metrics[3], sizeof(metrics[3]), "%.6f", result->branchMissesPerPixel, "");
+    format_metric(metrics[4], sizeof(metrics[4]), "%.4f", result->bytesPerPixel, "");
+    format_metric(metrics[5], sizeof(metrics[5]), "%.6f", result->cpuMS, "");
+    format_metric(metrics[6], sizeof(metrics[6]), "%.0f", result->peakKiB, "");
+
+    ok = SDL_IOprintf(file, "%s,%.6f,%.6f,%.3f,%s,%s,%s,%s,%s,%s,%s\n",
+      result->name, result->minMS, result->medianMS, result->megapixelsPerSecond,
+      metrics[0], metrics[1], metrics[2], metrics[3], metrics[4], metrics[5], metrics[6]) > 0;
+  }
+
+  if (!SDL_CloseIO(file) || !ok)
+  {
+    MY_LOG_ERROR("\t*** Erro ao gravar arquivo: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< save_results(\"%s\")", filename);
+    return false;
+  }
+
+  MY_LOG_TRACE("<<< save_results(\"%s\")", filename);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool compare_results(const char *filename, const MyBenchResult *results, int count)
+{
+  MY_LOG_TRACE(">>> compare_results(\"%s\")", filename);
+
+  char *data = (char *)SDL_LoadFile(filename, NULL);
+  if (!data)
+  {
+    MY_LOG_ERROR("\t*** Erro ao ler arquivo: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< compare_results(\"%s\")", filename);
+    return false;
+  }
+
+  MY_LOG_INFO("\t%-18s  %12s  %12s  %8s", "kernel", "antes (ms)", "depois (ms)", "speedup");
+
+  double logSum = 0.0;
+  int compared = 0;
+
+  // Cada linha: nome,min_ms,... (a primeira é o cabeçalho); só min_ms é usado.
+  char *state = NULL;
+  for (char *line = SDL_strtok_r(data, "\r\n", &state); line; line = SDL_strtok_r(NULL, "\r\n", &state))
+  {
+    char *comma = SDL_strchr(line, ',');
+    if (!comma || SDL_strncmp(line, CSV_HEADER, (size_t)(comma - line)) == 0)
+      continue;
+
+    *comma = '\0';
+    const double baselineMS = SDL_strtod(comma + 1, NULL);
+
+    for (int i = 0; i < count; ++i)
+    {
+      if (SDL_strcmp(line, results[i].name) != 0 || baselineMS <= 0.0 || results[i].minMS <= 0.0)
+        continue;
+
+      const double speedup = baselineMS / results[i].minMS;
+      MY_LOG_INFO("\t%-18s  %12.3f  %12.3f  %7.2fx", line, baselineMS, results[i].minMS, speedup);
+
+      logSum += SDL_log(speedup);
+      ++compared;
+      break;
+    }
+  }
+
+  SDL_free(data);
+
+  if (compared == 0)
+  {
+    MY_LOG_WARN("\t*** Aviso: Nenhum kernel em comum com \"%s\".", filename);
+    MY_LOG_TRACE("<<< compare_results(\"%s\")", filename);
+    return false;
+  }
+
+  MY_LOG_INFO("\tSpeedup (média geométrica de %d kernels): %.2fx", compared, SDL_exp(logSum / compared));
+
+  MY_LOG_TRACE("<<< compare_results(\"%s\")", filename);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void shutdown(void)
+{
+  MY_LOG_TRACE(">>> shutdown()");
+
+  SDL_DestroySurface(g_destination);
+  g_destination = NULL;
+
+  SDL_DestroySurface(g_inPlaceImage);
+  g_inPlaceImage = NULL;
+
+  SDL_DestroySurface(g_source);
+  g_source = NULL;
+
+  MyThreadPool_destroy(&g_threadPool);
+
+  // Sem --counters, `g_counters` nunca foi aberto (fds zerados, não -1).
+  if (g_useCounters)
+    MyPerfCounters_close(&g_counters);
+
+  MyLog_shutdown();
+
+  MY_LOG_TRACE("<<< shutdown()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  atexit(shutdown);
+  MyLog_initialize();
+
+#if defined(__GLIBC__)
+  // Com o limite fixo, blocos grandes (ex. superfícies) sempre voltam ao
+  // sistema ao serem liberados; com o limite dinâmico (padrão), a glibc os
+  // guardaria para os próximos kernels, que não teriam o pico medido.
+  mallopt(M_MMAP_THRESHOLD, MMAP_THRESHOLD);
+#endif
+
+  MyBenchOptions options;
+  if (!parse_options(argc, argv, &options))
+    return EXIT_FAILURE;
+
+  MY_LOG_INFO("Selecionando kernels...");
+  MyKernels_get();
+
+  // Os contadores são abertos antes do pool, para contarem também as threads
+  // do pool. Sem contadores, só os tempos são medidos.
+  if (options.counters)
+  {
+    MY_LOG_INFO("Abrindo contadores de desempenho...");
+    MyPerfCounters_open(&g_counters);
+    g_useCounters = true;
+  }
+
+  MY_LOG_INFO("Criando pool de threads...");
+  if (!MyThreadPool_initialize(&g_threadPool, options.threads))
+    return EXIT_FAILURE;
+
+  g_source = load_surface(options.imageFilename, SDL_PIXELFORMAT_RGBA32);
+  if (!g_source)
+    return EXIT_FAILURE;
+
+  // Imagem filtrada pelos kernels "in place" (criada antes das medições).
+  g_inPlaceImage = SDL_DuplicateSurface(g_source);
+  if (!g_inPlaceImage)
+  {
+    MY_LOG_ERROR("*** Erro ao copiar a imagem: %s", SDL_GetError());
+    return EXIT_FAILURE;
+  }
+
+  MY_LOG_INFO("Medindo %s (%dx%d), %d execuções por kernel, %d thread(s)...",
+    options.imageFilename, g_source->w, g_source->h, options.iterations,
+    MyThreadPool_get_thread_count(&g_threadPool));
+
+  int resultCount = 0;
+  const MyBenchKernel invert = { .type = MY_BENCH_INVERT };
+  if (!measure_kernel(&invert, options.iterations, &g_results[resultCount++]))
+    return EXIT_FAILURE;
+
+  for (int i = 0; i < (int)SDL_arraysize(FILTER_SIZES); ++i)
+  {
+    const MyBenchKernel blur = { .type = MY_BENCH_BLUR, .filterSize = FILTER_SIZES[i] };
+    const MyBenchKernel blurInPlace = { .type = MY_BENCH_BLUR, .filterSize = FILTER_SIZES[i], .inPlace = true };
+    if (!measure_kernel(&blur, options.iterations, &g_results[resultCount++])
+      || !measure_kernel(&blurInPlace, options.iterations, &g_results[resultCount++]))
+      return EXIT_FAILURE;
+  }
+
+  for (int i = 0; i < (int)SDL_arraysize(GAUSSIAN_SIGMAS); ++i)
+  {
+    const MyBenchKernel gaussian = { .type = MY_BENCH_GAUSSIAN, .sigma = GAUSSIAN_SIGMAS[i] };
+    const MyBenchKernel gaussianInPlace = { .type = MY_BENCH_GAUSSIAN, .sigma = GAUSSIAN_SIGMAS[i], .inPlace = true };
+    if (!measure_kernel(&gaussian, options.iterations, &g_results[resultCount++])
+      || !measure_kernel(&gaussianInPlace, options.iterations, &g_results[resultCount++]))
+      return EXIT_FAILURE;
+  }
+
+  for (int i = 0; i < (int)SDL_arraysize(TYPED_FORMATS); ++i)
+  {
+    const MyBenchKernel invert = { .type = MY_BENCH_INVERT, .format = TYPED_FORMATS[i] };
+    const MyBenchKernel blur = { .type = MY_BENCH_BLUR, .filterSize = 15, .format = TYPED_FORMATS[i] };
+    const MyBenchKernel gaussian = { .type = MY_BENCH_GAUSSIAN, .sigma = 3.0f, .format = TYPED_FORMATS[i] };
+    if (!measure_kernel(&invert, options.iterations, &g_results[resultCount++])
+      || !measure_kernel(&blur, options.iterations, &g_results[resultCount++])
+      || !measure_kernel(&gaussian, options.iterations, &g_results[resultCount++]))
+      return EXIT_FAILURE;
+  }
+
+  for (int i = 0; i < (int)SDL_arraysize(COLOR_CONVERSIONS); ++i)
+  {
+    const MyBenchKernel to = { .type = MY_BENCH_TO_PLANAR, .conversion = COLOR_CONVERSIONS[i] };
+    const MyBenchKernel from = { .type = MY_BENCH_FROM_PLANAR, .conversion = COLOR_CONVERSIONS[i] };
+    if (!measure_kernel(&to, options.iterations, &g_results[resultCount++])
+      || !measure_kernel(&from, options.iterations, &g_results[resultCount++]))
+      return EXIT_FAILURE;
+  }
+
+  for (int i = 0; i < MY_RESAMPLE_FILTER_COUNT; ++i)
+  {
+    const MyBenchKernel resample = { .type = MY_BENCH_RESAMPLE, .resampleFilter = (MyResampleFilter)i };
+    if (!measure_kernel(&resample, options.iterations, &g_results[resultCount++]))
+      return EXIT_FAILURE;
+  }
+
+  for (int i = MY_EDGES_NONE + 1; i < MY_EDGE_MODE_COUNT; ++i)
+  {
+    const MyBenchKernel edges = { .type = MY_BENCH_EDGES, .edgeMode = (MyEdgeMode)i };
+    if (!measure_kernel(&edges, options.iterations, &g_results[resultCount++]))
+      return EXIT_FAILURE;
+  }
+
+  if (options.outputFilename && !save_results(options.outputFilename, g_results, KERNEL_COUNT))
+    return EXIT_FAILURE;
+
+  if (options.compareFilename && !compare_results(options.compareFilename, g_results, KERNEL_COUNT))
+    return EXIT_FAILURE;
+
+  return 0;
+}
@@ -0,0 +1,553 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include <SDL3_image/SDL_image.h>
+#include "atlas.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+enum
+{
+  SKYLINE_INITIAL_CAPACITY = 64,
+};
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static int load_thread(void *data);
+static void decode_images(void *userdata, int begin, int end, int threadIndex);
+static void copy_images(void *userdata, int begin, int end, int threadIndex);
+static bool pack_images(MyAtlas *atlas);
+
+static MyAtlasPage *add_page(MyAtlas *atlas, int width, int maxHeight);
+
+/**
+ * Procura na página a posição para um retângulo `width x height` cujo topo
+ * fique mais baixo (empate: segmento mais estreito). Retorna false se não
+ * couber.
+ */
+static bool skyline_find(const MyAtlasPage *page, int width, int height, int *nodeIndex, SDL_Point *position);
+static int skyline_fit(const MyAtlasPage *page, int nodeIndex, int width, int height);
+static bool skyline_insert(MyAtlasPage *page, int nodeIndex, const SDL_Rect *rect);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyAtlas_begin_load(MyAtlas *atlas, const char *const *filenames, int count, int pageSize, MyThreadPool *threadPool)
+{
+  MY_LOG_TRACE(">>> MyAtlas_begin_load(count: %d)", count);
+
+  if (!atlas || !filenames || count <= 0 || !threadPool)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyAtlas_begin_load(count: %d)", count);
+    return false;
+  }
+
+  SDL_zerop(atlas);
+  atlas->count = count;
+  atlas->pageSize = (pageSize > 0) ? pageSize : MY_ATLAS_DEFAULT_PAGE_SIZE;
+  atlas->threadPool = threadPool;
+
+  atlas->filenames = (char **)SDL_calloc((size_t)count, sizeof(char *));
+  atlas->entries = (MyAtlasEntry *)SDL_calloc((size_t)count, sizeof(MyAtlasEntry));
+  atlas->decoded = (SDL_Surface **)SDL_calloc((size_t)count, sizeof(SDL_Surface *));
+  if (!atlas->filenames || !atlas->entries || !atlas->decoded)
+  {
+    MY_LOG_ERROR("\t*** Erro ao alocar memória para %d imagens.", count);
+    MyAtlas_destroy(atlas);
+    MY_LOG_TRACE("<<< MyAtlas_begin_load(count: %d)", count);
+    return false;
+  }
+
+  for (int i = 0; i < count; ++i)
+  {
+    atlas->filenames[i] = SDL_strdup(filenames[i]);
+    atlas->entries[i].page = -1;
+  }
+
+  atlas->thread = SDL_CreateThread(load_thread, "atlas", atlas);
+  if (!atlas->thread)
+  {
+    MY_LOG_ERROR("\t*** Erro ao criar thread de carregamento: %s", SDL_GetError());
+    MyAtlas_destroy(atlas);
+    MY_LOG_TRACE("<<< MyAtlas_begin_load(count: %d)", count);
+    return false;
+  }
+
+  MY_LOG_TRACE("<<< MyAtlas_begin_load(count: %d)", count);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyAtlas_is_loaded(MyAtlas *atlas)
+{
+  return atlas && SDL_GetAtomicInt(&atlas->loaded) != 0;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyAtlas_finish_load(MyAtlas *atlas, SDL_Renderer *renderer)
+{
+  MY_LOG_TRACE(">>> MyAtlas_finish_load()");
+
+  if (!atlas || !atlas->thread || !renderer)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos.");
+    MY_LOG_TRACE("<<< MyAtlas_finish_load()");
+    return false;
+  }
+
+  SDL_WaitThread(atlas->thread, NULL);
+  atlas->thread = NULL;
+
+  if (atlas->failed)
+  {
+    MY_LOG_TRACE("<<< MyAtlas_finish_load()");
+    return false;
+  }
+
+  const Uint64 startNS = SDL_GetTicksNS();
+
+  for (int i = 0; i < atlas->pageCount; ++i)
+  {
+    MyAtlasPage *page = &atlas->pages[i];
+
+    page->texture = SDL_CreateTextureFromSurface(renderer, page->surface);
+    if (!page->texture)
+    {
+      MY_LOG_ERROR("\t*** Erro ao criar textura da página %d (%dx%d): %s", i, page->width, page->usedHeight, SDL_GetError());
+      MY_LOG_TRACE("<<< MyAtlas_finish_load()");
+      return false;
+    }
+
+    SDL_DestroySurface(page->surface);
+    page->surface = NULL;
+  }
+
+  atlas->stats.uploadMS = (double)(SDL_GetTicksNS() - startNS) / SDL_NS_PER_MS;
+
+  MY_LOG_INFO("\t%d de %d imagens em %d página(s) (%.1f MiB decodificados).",
+    atlas->stats.loadedCount, atlas->count, atlas->pageCount, atlas->stats.decodedBytes / (1024.0 * 1024.0));
+  MY_LOG_INFO("\tDecodificação: %.1f ms (%d threads), empacotamento: %.1f ms, cópia: %.1f ms, envio: %.1f ms.",
+    atlas->stats.decodeMS, MyThreadPool_get_thread_count(atlas->threadPool),
+    atlas->stats.packMS, atlas->stats.copyMS, atlas->stats.uploadMS);
+
+  MY_LOG_TRACE("<<< MyAtlas_finish_load()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyAtlas_destroy(MyAtlas *atlas)
+{
+  MY_LOG_TRACE(">>> MyAtlas_destroy()");
+
+  if (!atlas)
+  {
+    MY_LOG_ERROR("\t*** Erro: Atlas inválido (atlas == NULL).");
+    MY_LOG_TRACE("<<< MyAtlas_destroy()");
+    return;
+  }
+
+  if (atlas->thread)
+    SDL_WaitThread(atlas->thread, NULL);
+
+  for (int i = 0; i < atlas->pageCount; ++i)
+  {
+    SDL_DestroySurface(atlas->pages[i].surface);
+    SDL_DestroyTexture(atlas->pages[i].texture);
+    SDL_free(atlas->pages[i].skyline);
+  }
+  SDL_free(atlas->pages);
+
+  for (int i = 0; i < atlas->count; ++i)
+  {
+    if (atlas->decoded)
+      SDL_DestroySurface(atlas->decoded[i]);
+    if (atlas->filenames)
+      SDL_free(atlas->filenames[i]);
+  }
+  SDL_free(atlas->decoded);
+  SDL_free(atlas->filenames);
+  SDL_free(atlas->entries);
+
+  SDL_zerop(atlas);
+
+  MY_LOG_TRACE("<<< MyAtlas_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyAtlas_get(const MyAtlas *atlas, int index, SDL_Texture **texture, SDL_FRect *srcrect)
+{
+  if (!atlas || index < 0 || index >= atlas->count || atlas->entries[index].page < 0)
+    return false;
+
+  const MyAtlasEntry *entry = &atlas->entries[index];
+  *texture = atlas->pages[entry->page].texture;
+  SDL_RectToFRect(&entry->rect, srcrect);
+  return *texture != NULL;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int load_thread(void *data)
+{
+  MyAtlas *atlas = (MyAtlas *)data;
+
+  // Cada arquivo é um bloco de trabalho: os tamanhos variam muito, então
+  // blocos pequenos equilibram melhor a carga entre as threads.
+  Uint64 startNS = SDL_GetTicksNS();
+  MyThreadPool_parallel_for(atlas->threadPool, atlas->count, 1, decode_images, atlas);
+  atlas->stats.decodeMS = (double)(SDL_GetTicksNS() - startNS) / SDL_NS_PER_MS;
+
+  startNS = SDL_GetTicksNS();
+  atlas->failed = !pack_images(atlas);
+  atlas->stats.packMS = (double)(SDL_GetTicksNS() - startNS) / SDL_NS_PER_MS;
+
+  if (!atlas->failed)
+  {
+    startNS = SDL_GetTicksNS();
+    MyThreadPool_parallel_for(atlas->threadPool, atlas->count, 1, copy_images, atlas);
+    atlas->stats.copyMS = (double)(SDL_GetTicksNS() - startNS) / SDL_NS_PER_MS;
+  }
+
+  for (int i = 0; i < atlas->count; ++i)
+  {
+    SDL_DestroySurface(atlas->decoded[i]);
+    atlas->decoded[i] = NULL;
+  }
+
+  SDL_SetAtomicInt(&atlas->loaded, 1);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void decode_images(void *userdata, int begin, int end, int threadIndex)
+{
+  MyAtlas *atlas = (MyAtlas *)userdata;
+  (void)threadIndex;
+
+  for (int i = begin; i < end; ++i)
+  {
+    SDL_Surface *surface = IMG_Load(atlas->filenames[i]);
+    if (!surface)
+    {
+      MY_LOG_ERROR("\t*** Erro ao carregar a imagem '%s': %s", atlas->filenames[i], SDL_GetError());
+      continue;
+    }
+
+    if (surface->format != SDL_PIXELFORMAT_RGBA32)
+    {
+      SDL_Surface *converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+      SDL_DestroySurface(surface);
+      surface = converted;
+
+      if (!surface)
+      {
+        MY_LOG_ERROR("\t*** Erro ao converter '%s' para RGBA32: %s", atlas->filenames[i], SDL_GetError());
+        continue;
+      }
+    }
+
+    atlas->decoded[i] = surface;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void copy_images(void *userdata, int begin, int end, int threadIndex)
+{
+  MyAtlas *atlas = (MyAtlas *)userdata;
+  (void)threadIndex;
+
+  // As regiões das imagens não se sobrepõem, então as threads podem escrever
+  // na mesma página sem sincronização.
+  for (int i = begin; i < end; ++i)
+  {
+    const MyAtlasEntry *entry = &atlas->entries[i];
+    const SDL_Surface *src = atlas->decoded[i];
+    if (entry->page < 0 || !src)
+      continue;
+
+    SDL_Surface *dst = atlas->pages[entry->page].surface;
+    const size_t rowSize = (size_t)entry->rect.w * 4;
+    for (int y = 0; y < entry->rect.h; ++y)
+    {
+      const Uint8 *srcRow = (const Uint8 *)src->pixels + (size_t)y * src->pitch;
+      Uint8 *dstRow = (Uint8 *)dst->pixels + (size_t)(entry->rect.y + y) * dst->pitch + (size_t)entry->rect.x * 4;
+      SDL_memcpy(dstRow, srcRow, rowSize);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Ordena por altura (maior primeiro) e, em caso de empate, por largura.
+//------------------------------------------------------------------------------
+static int compare_heights(void *userdata, const void *a, const void *b)
+{
+  SDL_Surface **decoded = (SDL_Surface **)userdata;
+  const SDL_Surface *sa = decoded[*(const int *)a];
+  const SDL_Surface *sb = decoded[*(const int *)b];
+
+  if (sa->h != sb->h)
+    return sb->h - sa->h;
+
+  return sb->w - sa->w;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool pack_images(MyAtlas *atlas)
+{
+  int *order = (int *)SDL_malloc((size_t)atlas->count * sizeof(int));
+  if (!order)
+  {
+    MY_LOG_ERROR("\t*** Erro ao alocar memória para o empacotamento.");
+    return false;
+  }
+
+  int loaded = 0;
+  for (int i = 0; i < atlas->count; ++i)
+  {
+    if (atlas->decoded[i])
+    {
+      order[loaded++] = i;
+      atlas->stats.decodedBytes += (size_t)atlas->decoded[i]->w * atlas->decoded[i]->h * 4;
+    }
+  }
+  atlas->stats.loadedCount = loaded;
+
+  // Imagens mais altas primeiro deixam a linha do horizonte mais plana.
+  SDL_qsort_r(order, (size_t)loaded, sizeof(int), compare_heights, atlas->decoded);
+
+  bool ok = true;
+  for (int k = 0; k < loaded; ++k)
+  {
+    const int i = order[k];
+    const int width = atlas->decoded[i]->w + MY_ATLAS_PADDING;
+    const int height = atlas->decoded[i]->h + MY_ATLAS_PADDING;
+
+    MyAtlasPage *page = NULL;
+    int nodeIndex = 0;
+    SDL_Point position = { 0, 0 };
+
+    // Primeira página com espaço; se nenhuma tiver, uma página nova (ou uma
+    // página exclusiva, do tamanho da imagem, se ela for maior do que a
+    // página).
+    const bool oversized = (width > atlas->pageSize || height > atlas->pageSize);
+    for (int p = 0; p < atlas->pageCount && !page && !oversized; ++p)
+    {
+      if (skyline_find(&atlas->pages[p], width, height, &nodeIndex, &position))
+        page = &atlas->pages[p];
+    }
+
+    if (!page)
+    {
+      page = oversized ? add_page(atlas, width, height) : add_page(atlas, atlas->pageSize, atlas->pageSize);
+      if (!page || !skyline_find(page, width, height, &nodeIndex, &position))
+      {
+        ok = false;
+        break;
+      }
+    }
+
+    const SDL_Rect rect = { position.x, position.y, width, height };
+    if (!skyline_insert(page, nodeIndex, &rect))
+    {
+      ok = false;
+      break;
+    }
+
+    page->usedHeight = SDL_max(page->usedHeight, rect.y + rect.h);
+    atlas->entries[i].page = (int)(page - atlas->pages);
+    atlas->entries[i].rect = (SDL_Rect){ rect.x, rect.y, atlas->decoded[i]->w, atlas->decoded[i]->h };
+  }
+
+  SDL_free(order);
+
+  if (!ok)
+  {
+    MY_LOG_ERROR("\t*** Erro ao alocar memória para as páginas do atlas.");
+    return false;
+  }
+
+  // Cada página só precisa da altura efetivamente ocupada.
+  for (int p = 0; p < atlas->pageCount; ++p)
+  {
+    MyAtlasPage *page = &atlas->pages[p];
+    page->surface = SDL_CreateSurface(page->width, page->usedHeight, SDL_PIXELFORMAT_RGBA32);
+    if (!page->surface)
+    {
+      MY_LOG_ERROR("\t*** Erro ao criar superfície da página %d (%dx%d): %s", p, page->width, page->usedHeight, SDL_GetError());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+MyAtlasPage *add_page(MyAtlas *atlas, int width, int maxHeight)
+{
+  if (atlas->pageCount == atlas->pageCapacity)
+  {
+    const int capacity = SDL_max(4, atlas->pageCapacity * 2);
+    MyAtlasPage *pages = (MyAtlasPage *)SDL_realloc(atlas->pages, (size_t)capacity * sizeof(MyAtlasPage));
+    if (!pages)
+      return NULL;
+
+    atlas->pages = pages;
+    atlas->pageCapacity = capacity;
+  }
+
+  MySkylineNode *skyline = (MySkylineNode *)SDL_malloc(SKYLINE_INITIAL_CAPACITY * sizeof(MySkylineNode));
+  if (!skyline)
+    return NULL;
+
+  // Página vazia: um único segmento, no chão, com a largura toda.
+  skyline[0] = (MySkylineNode){ .x = 0, .y = 0, .width = width };
+
+  MyAtlasPage *page = &atlas->pages[atlas->pageCount++];
+  *page = (MyAtlasPage){
+    .surface = NULL,
+    .texture = NULL,
+    .width = width,
+    .maxHeight = maxHeight,
+    .usedHeight = 0,
+    .skyline = skyline,
+    .nodeCount = 1,
+    .nodeCapacity = SKYLINE_INITIAL_CAPACITY,
+  };
+
+  return page;
+}
+
+//------------------------------------------------------------------------------
+// Altura (y) em que o retângulo fica apoiado se começar no segmento
+// `nodeIndex`, ou -1 se não couber.
+//------------------------------------------------------------------------------
+int skyline_fit(const MyAtlasPage *page, int nodeIndex, int width, int height)
+{
+  const int x = page->skyline[nodeIndex].x;
+  if (x + width > page->width)
+    return -1;
+
+  // O retângulo se apoia no segmento mais alto entre os que ele cobre.
+  int y = 0;
+  int remaining = width;
+  for (int i = nodeIndex; remaining > 0; ++i)
+  {
+    y = SDL_max(y, page->skyline[i].y);
+    if (y + height > page->maxHeight)
+      return -1;
+
+    remaining -= page->skyline[i].width;
+  }
+
+  return y;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool skyline_find(const MyAtlasPage *page, int width, int height, int *nodeIndex, SDL_Point *position)
+{
+  int bestIndex = -1;
+  int bestTop = SDL_MAX_SINT32;
+  int bestWidth = SDL_MAX_SINT32;
+
+  for (int i = 0; i < page->nodeCount; ++i)
+  {
+    const int y = skyline_fit(page, i, width, height);
+    if (y < 0)
+      continue;
+
+    const int top = y + height;
+    if (top < bestTop || (top == bestTop && page->skyline[i].width < bestWidth))
+    {
+      bestIndex = i;
+      bestTop = top;
+      bestWidth = page->skyline[i].width;
+      position->x = page->skyline[i].x;
+      position->y = y;
+    }
+  }
+
+  *nodeIndex = bestIndex;
+  return bestIndex >= 0;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool skyline_insert(MyAtlasPage *page, int nodeIndex, const SDL_Rect *rect)
+{
+  if (page->nodeCount == page->nodeCapacity)
+  {
+    const int capacity = page->nodeCapacity * 2;
+    MySkylineNode *skyline = (MySkylineNode *)SDL_realloc(page->skyline, (size_t)capacity * sizeof(MySkylineNode));
+    if (!skyline)
+      return false;
+
+    page->skyline = skyline;
+    page->nodeCapacity = capacity;
+  }
+
+  // Novo segmento no topo do retângulo.
+  MySkylineNode *nodes = page->skyline;
+  SDL_memmove(&nodes[nodeIndex + 1], &nodes[nodeIndex], (size_t)(page->nodeCount - nodeIndex) * sizeof(MySkylineNode));
+  nodes[nodeIndex] = (MySkylineNode){ .x = rect->x, .y = rect->y + rect->h, .width = rect->w };
+  ++page->nodeCount;
+
+  // Os segmentos seguintes cobertos pelo retângulo encolhem ou desaparecem.
+  for (int i = nodeIndex + 1; i < page->nodeCount;)
+  {
+    const int previousEnd = nodes[i - 1].x + nodes[i - 1].width;
+    if (nodes[i].x >= previousEnd)
+      break;
+
+    const int shrink = previousEnd - nodes[i].x;
+    nodes[i].x += shrink;
+    nodes[i].width -= shrink;
+    if (nodes[i].width > 0)
+      break;
+
+    SDL_memmove(&nodes[i], &nodes[i + 1], (size_t)(page->nodeCount - i - 1) * sizeof(MySkylineNode));
+    --page->nodeCount;
+  }
+
+  // Segmentos vizinhos na mesma altura viram um só.
+  for (int i = 0; i + 1 < page->nodeCount;)
+  {
+    if (nodes[i].y != nodes[i + 1].y)
+    {
+      ++i;
+      continue;
+    }
+
+    nodes[i].width += nodes[i + 1].width;
+    SDL_memmove(&nodes[i + 1], &nodes[i + 2], (size_t)(page->nodeCount - i - 2) * sizeof(MySkylineNode));
+    --page->nodeCount;
+  }
+
+  return true;
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Atlas de texturas: carrega várias imagens em paralelo e as agrupa em poucas
+// texturas grandes (páginas), para que o renderizador desenhe todas elas sem
+// trocar de textura a cada imagem.
+//
+// MyAtlas_begin_load() inicia uma thread de carregamento e retorna
+// imediatamente (ex. enquanto a janela é criada). A thread:
+// 1. decodifica os arquivos com IMG_Load(), distribuindo-os entre as threads
+//    do MyThreadPool;
+// 2. posiciona as imagens nas páginas com um empacotador skyline (bottom-left):
+//    a "linha do horizonte" de cada página é uma lista de segmentos
+//    horizontais e cada imagem, da mais alta para a mais baixa, vai para a
+//    posição em que o seu topo fica mais baixo;
+// 3. copia os pixels para as superfícies das páginas, também em paralelo.
+//
+// MyAtlas_finish_load() espera a thread e cria as texturas no renderizador
+// (o que precisa acontecer na thread principal).
+//------------------------------------------------------------------------------
+#ifndef MY_ATLAS_H
+#define MY_ATLAS_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+#include "parallel.h"
+
+enum atlas_constants
+{
+  MY_ATLAS_DEFAULT_PAGE_SIZE = 4096,
+  // Espaço vazio à direita e abaixo de cada imagem, para que a filtragem
+  // linear da textura não misture pixels de imagens vizinhas.
+  MY_ATLAS_PADDING = 1,
+};
+
+typedef struct MyAtlasEntry MyAtlasEntry;
+struct MyAtlasEntry
+{
+  int page;       // -1 se a imagem não pôde ser carregada.
+  SDL_Rect rect;  // Posição da imagem na página.
+};
+
+typedef struct MySkylineNode MySkylineNode;
+struct MySkylineNode
+{
+  int x;
+  int y;
+  int width;
+};
+
+typedef struct MyAtlasPage MyAtlasPage;
+struct MyAtlasPage
+{
+  SDL_Surface *surface;
+  SDL_Texture *texture;
+  int width;
+  int maxHeight;
+  int usedHeight;
+
+  MySkylineNode *skyline;
+  int nodeCount;
+  int nodeCapacity;
+};
+
+typedef struct MyAtlasStats MyAtlasStats;
+struct MyAtlasStats
+{
+  double decodeMS;
+  double packMS;
+  double copyMS;
+  double uploadMS;
+  size_t decodedBytes;
+  int loadedCount;
+};
+
+typedef struct MyAtlas MyAtlas;
+struct MyAtlas
+{
+  // Entrada.
+  char **filenames;
+  int count;
+  int pageSize;
+  MyThreadPool *threadPool;
+
+  // Resultado, na mesma ordem de `filenames`.
+  MyAtlasEntry *entries;
+  MyAtlasPage *pages;
+  int pageCount;
+  int pageCapacity;
+
+  // Carregamento em segundo plano.
+  SDL_Thread *thread;
+  SDL_AtomicInt loaded;
+  SDL_Surface **decoded;
+  bool failed;
+
+  MyAtlasStats stats;
+};
+
+/**
+ * Copia a lista `filenames` e inicia o carregamento das `count` imagens em
+ * páginas de até `pageSize x pageSize` pixels (0 = MY_ATLAS_DEFAULT_PAGE_SIZE).
+ * Uma imagem maior do que a página recebe uma página só para ela.
+ *
+ * `threadPool` não deve ser usado por outra thread até MyAtlas_finish_load().
+ */
+bool MyAtlas_begin_load(MyAtlas *atlas, const char *const *filenames, int count, int pageSize, MyThreadPool *threadPool);
+
+/**
+ * Retorna true quando a thread de carregamento terminou (sem bloquear).
+ */
+bool MyAtlas_is_loaded(MyAtlas *atlas);
+
+/**
+ * Espera o fim do carregamento e envia as páginas para `renderer`. As
+ * superfícies das páginas são liberadas depois do envio.
+ */
+bool MyAtlas_finish_load(MyAtlas *atlas, SDL_Renderer *renderer);
+
+void MyAtlas_destroy(MyAtlas *atlas);
+
+/**
+ * Textura e região da imagem `index` (na ordem de `filenames`). Retorna false
+ * se a imagem não foi carregada.
+ */
+bool MyAtlas_get(const MyAtlas *atlas, int index, SDL_Texture **texture, SDL_FRect *srcrect);
+
+#endif // MY_ATLAS_H
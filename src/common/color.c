@@ -0,0 +1,637 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "color.h"
+#include "image_pool.h"
+#include "kernels.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+enum
+{
+  COLOR_PIXELS_PER_BLOCK = 1 << 16,
+
+  // Entradas das tabelas de Lab (mais uma, para a interpolação no fim).
+  LAB_F_TABLE_SIZE = 1024,
+  SRGB_ENCODE_TABLE_SIZE = 4096,
+
+  TABLES_UNINITIALIZED = 0,
+  TABLES_INITIALIZING = 1,
+  TABLES_READY = 2,
+};
+
+typedef struct ColorJob ColorJob;
+struct ColorJob
+{
+  Uint8 *pixels;  // Superfície RGBA32.
+  int pitch;
+  const MyPlanarImage *image;
+  int chromaShiftX;
+  int chromaShiftY;
+  const MyKernels *kernels;
+  float matrix[12];  // Veja rgba32_to_planes() em kernels.h.
+  SDL_AtomicInt failed;
+};
+
+static const char *COLOR_SPACE_NAMES[MY_COLOR_SPACE_COUNT] = { "gray", "ycbcr601", "ycbcr709", "hsv", "lab" };
+
+// Pesos de R e B na luminância (o de G é 1 - Kr - Kb).
+static const float BT601_KR = 0.299f;
+static const float BT601_KB = 0.114f;
+static const float BT709_KR = 0.2126f;
+static const float BT709_KB = 0.0722f;
+
+// sRGB linear -> XYZ (D65), com cada linha já dividida pelo branco de
+// referência, e a inversa (XYZ normalizado -> sRGB linear).
+static const float RGB_TO_XYZ[3][3] = {
+  { 0.4124564f / 0.95047f, 0.3575761f / 0.95047f, 0.1804375f / 0.95047f },
+  { 0.2126729f, 0.7151522f, 0.0721750f },
+  { 0.0193339f / 1.08883f, 0.1191920f / 1.08883f, 0.9503041f / 1.08883f },
+};
+static const float XYZ_TO_RGB[3][3] = {
+  { 3.2404542f * 0.95047f, -1.5371385f, -0.4985314f * 1.08883f },
+  { -0.9692660f * 0.95047f, 1.8760108f, 0.0415560f * 1.08883f },
+  { 0.0556434f * 0.95047f, -0.2040259f, 1.0572252f * 1.08883f },
+};
+
+// Limite entre o trecho linear e a raiz cúbica da função f() do Lab.
+static const float LAB_DELTA = 6.0f / 29.0f;
+
+//------------------------------------------------------------------------------
+// Globals (argh!)
+//------------------------------------------------------------------------------
+static float g_srgbToLinear[256];
+static float g_labF[LAB_F_TABLE_SIZE + 1];
+static float g_linearToSrgb[SRGB_ENCODE_TABLE_SIZE + 1];
+static SDL_AtomicInt g_tablesState;
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static void initialize_tables(void);
+static float lookup(const float *table, int size, float t);
+static void rgba32_to_lab_row(const Uint8 *src, Uint8 *const dst[3], int width);
+static void lab_to_rgba32_row(const Uint8 *const src[3], Uint8 *dst, int width);
+static void build_forward_matrix(MyColorSpace space, float matrix[12]);
+static void build_inverse_matrix(MyColorSpace space, float matrix[12]);
+static void get_chroma_shift(const MyPlanarImage *image, int *shiftX, int *shiftY);
+static void downsample_chroma_row(Uint8 *const rows[2], int rowCount, int width, Uint8 *dst, int dstWidth);
+static void from_rgba32_rows(void *userdata, int begin, int end, int threadIndex);
+static void to_rgba32_rows(void *userdata, int begin, int end, int threadIndex);
+
+//------------------------------------------------------------------------------
+// Tabelas do Lab, montadas na primeira conversão (como em MyKernels_get()).
+//------------------------------------------------------------------------------
+void initialize_tables(void)
+{
+  if (SDL_GetAtomicInt(&g_tablesState) == TABLES_READY)
+    return;
+
+  if (!SDL_CompareAndSwapAtomicInt(&g_tablesState, TABLES_UNINITIALIZED, TABLES_INITIALIZING))
+  {
+    while (SDL_GetAtomicInt(&g_tablesState) != TABLES_READY)
+      SDL_CPUPauseInstruction();
+    return;
+  }
+
+  for (int i = 0; i < 256; ++i)
+  {
+    const float c = i / 255.0f;
+    g_srgbToLinear[i] = c <= 0.04045f ? c / 12.92f : SDL_powf((c + 0.055f) / 1.055f, 2.4f);
+  }
+
+  // f(t) = t^(1/3) acima de delta^3; abaixo, uma reta que evita a
+  // inclinação infinita da raiz cúbica em zero.
+  const float epsilon = LAB_DELTA * LAB_DELTA * LAB_DELTA;
+  for (int i = 0; i <= LAB_F_TABLE_SIZE; ++i)
+  {
+    const float t = (float)i / LAB_F_TABLE_SIZE;
+    g_labF[i] = t > epsilon ? SDL_powf(t, 1.0f / 3.0f) : t / (3.0f * LAB_DELTA * LAB_DELTA) + 4.0f / 29.0f;
+  }
+
+  for (int i = 0; i <= SRGB_ENCODE_TABLE_SIZE; ++i)
+  {
+    const float c = (float)i / SRGB_ENCODE_TABLE_SIZE;
+    const float encoded = c <= 0.0031308f ? c * 12.92f : 1.055f * SDL_powf(c, 1.0f / 2.4f) - 0.055f;
+    g_linearToSrgb[i] = encoded * 255.0f;
+  }
+
+  SDL_SetAtomicInt(&g_tablesState, TABLES_READY);
+}
+
+//------------------------------------------------------------------------------
+// Interpolação linear em `table` (size + 1 entradas cobrindo [0, 1]).
+//------------------------------------------------------------------------------
+float lookup(const float *table, int size, float t)
+{
+  const float position = SDL_clamp(t, 0.0f, 1.0f) * size;
+  const int i = SDL_min((int)position, size - 1);
+  const float fraction = position - (float)i;
+  return table[i] + (table[i + 1] - table[i]) * fraction;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void rgba32_to_lab_row(const Uint8 *src, Uint8 *const dst[3], int width)
+{
+  for (int x = 0; x < width; ++x, src += 4)
+  {
+    const float r = g_srgbToLinear[src[0]];
+    const float g = g_srgbToLinear[src[1]];
+    const float b = g_srgbToLinear[src[2]];
+
+    float f[3];
+    for (int k = 0; k < 3; ++k)
+    {
+      const float t = RGB_TO_XYZ[k][0] * r + RGB_TO_XYZ[k][1] * g + RGB_TO_XYZ[k][2] * b;
+      f[k] = lookup(g_labF, LAB_F_TABLE_SIZE, t);
+    }
+
+    const float lightness = 116.0f * f[1] - 16.0f;
+    const float a = 500.0f * (f[0] - f[1]);
+    const float bb = 200.0f * (f[1] - f[2]);
+
+    dst[0][x] = (Uint8)SDL_clamp(lightness * (255.0f / 100.0f) + 0.5f, 0.0f, 255.0f);
+    dst[1][x] = (Uint8)SDL_clamp(a + 128.5f, 0.0f, 255.0f);
+    dst[2][x] = (Uint8)SDL_clamp(bb + 128.5f, 0.0f, 255.0f);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void lab_to_rgba32_row(const Uint8 *const src[3], Uint8 *dst, int width)
+{
+  for (int x = 0; x < width; ++x, dst += 4)
+  {
+    const float fy = (src[0][x] * (100.0f / 255.0f) + 16.0f) / 116.0f;
+    const float f[3] = {
+      fy + (src[1][x] - 128.0f) / 500.0f,
+      fy,
+      fy - (src[2][x] - 128.0f) / 200.0f,
+    };
+
+    float xyz[3];
+    for (int k = 0; k < 3; ++k)
+    {
+      xyz[k] = f[k] > LAB_DELTA
+        ? f[k] * f[k] * f[k]
+        : 3.0f * LAB_DELTA * LAB_DELTA * (f[k] - 4.0f / 29.0f);
+    }
+
+    for (int c = 0; c < 3; ++c)
+    {
+      const float linear = XYZ_TO_RGB[c][0] * xyz[0] + XYZ_TO_RGB[c][1] * xyz[1] + XYZ_TO_RGB[c][2] * xyz[2];
+      dst[c] = (Uint8)(lookup(g_linearToSrgb, SRGB_ENCODE_TABLE_SIZE, linear) + 0.5f);
+    }
+    dst[3] = 255;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Matrizes de rgba32_to_planes(), com o 0.5 do arredondamento na constante.
+//------------------------------------------------------------------------------
+void build_forward_matrix(MyColorSpace space, float matrix[12])
+{
+  SDL_memset(matrix, 0, 12 * sizeof(float));
+
+  const float kr = space == MY_COLOR_YCBCR_709 ? BT709_KR : BT601_KR;
+  const float kb = space == MY_COLOR_YCBCR_709 ? BT709_KB : BT601_KB;
+  const float kg = 1.0f - kr - kb;
+
+  // Y
+  matrix[0] = kr;
+  matrix[1] = kg;
+  matrix[2] = kb;
+  matrix[3] = 0.5f;
+
+  if (space == MY_COLOR_GRAY)
+    return;
+
+  // Cb = 128 + (B - Y) / (2 (1 - Kb))
+  matrix[4] = -0.5f * kr / (1.0f - kb);
+  matrix[5] = -0.5f * kg / (1.0f - kb);
+  matrix[6] = 0.5f;
+  matrix[7] = 128.5f;
+
+  // Cr = 128 + (R - Y) / (2 (1 - Kr))
+  matrix[8] = 0.5f;
+  matrix[9] = -0.5f * kg / (1.0f - kr);
+  matrix[10] = -0.5f * kb / (1.0f - kr);
+  matrix[11] = 128.5f;
+}
+
+//------------------------------------------------------------------------------
+// Matrizes de planes_to_rgba32(). Em cinza, os três planos de entrada são o
+// mesmo plano Y.
+//------------------------------------------------------------------------------
+void build_inverse_matrix(MyColorSpace space, float matrix[12])
+{
+  SDL_memset(matrix, 0, 12 * sizeof(float));
+
+  if (space == MY_COLOR_GRAY)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      matrix[c * 4 + 0] = 1.0f;
+      matrix[c * 4 + 3] = 0.5f;
+    }
+    return;
+  }
+
+  const float kr = space == MY_COLOR_YCBCR_709 ? BT709_KR : BT601_KR;
+  const float kb = space == MY_COLOR_YCBCR_709 ? BT709_KB : BT601_KB;
+  const float kg = 1.0f - kr - kb;
+  const float crToR = 2.0f * (1.0f - kr);
+  const float cbToB = 2.0f * (1.0f - kb);
+  const float cbToG = cbToB * kb / kg;
+  const float crToG = crToR * kr / kg;
+
+  // R = Y + 2 (1 - Kr) (Cr - 128)
+  matrix[0] = 1.0f;
+  matrix[2] = crToR;
+  matrix[3] = -128.0f * crToR + 0.5f;
+
+  // G = (Y - Kr R - Kb B) / Kg
+  matrix[4] = 1.0f;
+  matrix[5] = -cbToG;
+  matrix[6] = -crToG;
+  matrix[7] = 128.0f * (cbToG + crToG) + 0.5f;
+
+  // B = Y + 2 (1 - Kb) (Cb - 128)
+  matrix[8] = 1.0f;
+  matrix[9] = cbToB;
+  matrix[11] = -128.0f * cbToB + 0.5f;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void get_chroma_shift(const MyPlanarImage *image, int *shiftX, int *shiftY)
+{
+  *shiftX = image->subsampling != MY_CHROMA_444 ? 1 : 0;
+  *shiftY = image->subsampling == MY_CHROMA_420 ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+// Média de cada par (4:2:2) ou bloco 2x2 (4:2:0) de amostras de `rows`, com
+// arredondamento. Com largura ímpar, o último par repete o último pixel.
+//------------------------------------------------------------------------------
+void downsample_chroma_row(Uint8 *const rows[2], int rowCount, int width, Uint8 *dst, int dstWidth)
+{
+  const Uint8 *row0 = rows[0];
+  const Uint8 *row1 = rows[rowCount - 1];
+
+  if (rowCount == 1)
+  {
+    for (int x = 0; x < dstWidth; ++x)
+    {
+      const int x1 = SDL_min(2 * x + 1, width - 1);
+      dst[x] = (Uint8)((row0[2 * x] + row0[x1] + 1) >> 1);
+    }
+    return;
+  }
+
+  for (int x = 0; x < dstWidth; ++x)
+  {
+    const int x1 = SDL_min(2 * x + 1, width - 1);
+    dst[x] = (Uint8)((row0[2 * x] + row0[x1] + row1[2 * x] + row1[x1] + 2) >> 2);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Cada item é uma linha dos planos de crominância (uma ou duas linhas da
+// imagem). Com subamostragem, a crominância de cada linha é convertida em
+// resolução completa para a arena da thread e reduzida em seguida.
+//------------------------------------------------------------------------------
+void from_rgba32_rows(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+  ColorJob *job = (ColorJob *)userdata;
+  const MyPlanarImage *image = job->image;
+  const int width = image->width;
+  const bool subsampled = job->chromaShiftX > 0;
+  const int rowsPerItem = 1 << job->chromaShiftY;
+
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker arenaMarker = MyArena_get_marker(arena);
+  Uint8 *chroma[2][2] = { { NULL, NULL }, { NULL, NULL } };  // [plano][linha]
+  if (subsampled)
+  {
+    for (int k = 0; k < 2; ++k)
+    {
+      for (int r = 0; r < rowsPerItem; ++r)
+      {
+        chroma[k][r] = MyArena_push(arena, (size_t)width, MY_IMAGE_POOL_ALIGNMENT);
+        if (!chroma[k][r])
+        {
+          SDL_SetAtomicInt(&job->failed, 1);
+          MyArena_reset_to_marker(arena, arenaMarker);
+          return;
+        }
+      }
+    }
+  }
+
+  for (int item = begin; item < end; ++item)
+  {
+    int rowCount = 0;
+    for (int r = 0; r < rowsPerItem; ++r)
+    {
+      // Com altura ímpar (4:2:0), a última linha de crominância só cobre
+      // uma linha da imagem.
+      const int y = item * rowsPerItem + r;
+      if (y >= image->height)
+        break;
+
+      Uint8 *dst[3] = { image->planes[0] + (size_t)y * image->pitches[0], NULL, NULL };
+      for (int k = 1; k < image->planeCount; ++k)
+        dst[k] = subsampled ? chroma[k - 1][r] : image->planes[k] + (size_t)y * image->pitches[k];
+
+      const Uint8 *src = job->pixels + (size_t)y * job->pitch;
+      switch (image->space)
+      {
+      case MY_COLOR_HSV:
+        job->kernels->rgba32_to_hsv(src, dst, width);
+        break;
+      case MY_COLOR_LAB:
+        rgba32_to_lab_row(src, dst, width);
+        break;
+      default:
+        job->kernels->rgba32_to_planes(src, dst, image->planeCount, width, job->matrix);
+        break;
+      }
+      ++rowCount;
+    }
+
+    if (subsampled)
+    {
+      for (int k = 1; k < image->planeCount; ++k)
+      {
+        Uint8 *dst = image->planes[k] + (size_t)item * image->pitches[k];
+        downsample_chroma_row(chroma[k - 1], rowCount, width, dst, image->planeWidths[k]);
+      }
+    }
+  }
+
+  MyArena_reset_to_marker(arena, arenaMarker);
+}
+
+//------------------------------------------------------------------------------
+// Cada item é uma linha da imagem. Com subamostragem, a linha de crominância
+// é expandida (repetindo as amostras) para a arena da thread.
+//------------------------------------------------------------------------------
+void to_rgba32_rows(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+  ColorJob *job = (ColorJob *)userdata;
+  const MyPlanarImage *image = job->image;
+  const int width = image->width;
+  const bool subsampled = job->chromaShiftX > 0;
+
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker arenaMarker = MyArena_get_marker(arena);
+  Uint8 *chroma[2] = { NULL, NULL };
+  if (subsampled)
+  {
+    chroma[0] = MyArena_push(arena, (size_t)width, MY_IMAGE_POOL_ALIGNMENT);
+    chroma[1] = MyArena_push(arena, (size_t)width, MY_IMAGE_POOL_ALIGNMENT);
+    if (!chroma[0] || !chroma[1])
+    {
+      SDL_SetAtomicInt(&job->failed, 1);
+      MyArena_reset_to_marker(arena, arenaMarker);
+      return;
+    }
+  }
+
+  int expandedRow = -1;
+  for (int y = begin; y < end; ++y)
+  {
+    const Uint8 *src[3];
+    src[0] = image->planes[0] + (size_t)y * image->pitches[0];
+    if (image->planeCount == 1)
+    {
+      src[1] = src[0];
+      src[2] = src[0];
+    }
+    else if (subsampled)
+    {
+      // Em 4:2:0, duas linhas seguidas usam a mesma linha de crominância.
+      const int chromaRow = y >> job->chromaShiftY;
+      if (chromaRow != expandedRow)
+      {
+        for (int k = 0; k < 2; ++k)
+        {
+          const Uint8 *row = image->planes[k + 1] + (size_t)chromaRow * image->pitches[k + 1];
+          for (int x = 0; x < width; ++x)
+            chroma[k][x] = row[x >> job->chromaShiftX];
+        }
+        expandedRow = chromaRow;
+      }
+      src[1] = chroma[0];
+      src[2] = chroma[1];
+    }
+    else
+    {
+      src[1] = image->planes[1] + (size_t)y * image->pitches[1];
+      src[2] = image->planes[2] + (size_t)y * image->pitches[2];
+    }
+
+    Uint8 *dst = job->pixels + (size_t)y * job->pitch;
+    switch (image->space)
+    {
+    case MY_COLOR_HSV:
+      job->kernels->hsv_to_rgba32(src, dst, width);
+      break;
+    case MY_COLOR_LAB:
+      lab_to_rgba32_row(src, dst, width);
+      break;
+    default:
+      job->kernels->planes_to_rgba32(src, dst, width, job->matrix);
+      break;
+    }
+  }
+
+  MyArena_reset_to_marker(arena, arenaMarker);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyPlanarImage_create(MyPlanarImage *image, int width, int height, MyColorSpace space, MyChromaSubsampling subsampling)
+{
+  if (!image || width <= 0 || height <= 0 || space < 0 || space >= MY_COLOR_SPACE_COUNT)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos para a imagem planar.");
+    return false;
+  }
+
+  if (space == MY_COLOR_GRAY)
+    subsampling = MY_CHROMA_444;
+  else if (space == MY_COLOR_HSV && subsampling != MY_CHROMA_444)
+  {
+    MY_LOG_ERROR("\t*** Erro: HSV não aceita crominância subamostrada.");
+    return false;
+  }
+
+  SDL_zerop(image);
+  image->space = space;
+  image->subsampling = subsampling;
+  image->width = width;
+  image->height = height;
+  image->planeCount = space == MY_COLOR_GRAY ? 1 : 3;
+
+  int shiftX, shiftY;
+  get_chroma_shift(image, &shiftX, &shiftY);
+
+  size_t offsets[MY_PLANAR_IMAGE_MAX_PLANES];
+  size_t size = 0;
+  for (int k = 0; k < image->planeCount; ++k)
+  {
+    const int w = k == 0 ? width : (width + (1 << shiftX) - 1) >> shiftX;
+    const int h = k == 0 ? height : (height + (1 << shiftY) - 1) >> shiftY;
+    image->planeWidths[k] = w;
+    image->planeHeights[k] = h;
+    image->pitches[k] = (w + MY_IMAGE_POOL_ALIGNMENT - 1) & ~(MY_IMAGE_POOL_ALIGNMENT - 1);
+    offsets[k] = size;
+    size += (size_t)image->pitches[k] * h;
+  }
+
+  image->memory = SDL_aligned_alloc(MY_IMAGE_POOL_ALIGNMENT, size);
+  if (!image->memory)
+  {
+    MY_LOG_ERROR("\t*** Erro: Não foi possível alocar a imagem planar (%zu bytes).", size);
+    SDL_zerop(image);
+    return false;
+  }
+
+  for (int k = 0; k < image->planeCount; ++k)
+    image->planes[k] = (Uint8 *)image->memory + offsets[k];
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPlanarImage_destroy(MyPlanarImage *image)
+{
+  if (!image)
+    return;
+
+  SDL_aligned_free(image->memory);
+  SDL_zerop(image);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyColor_from_rgba32(SDL_Surface *src, MyPlanarImage *dst, MyThreadPool *pool)
+{
+  if (!src || !dst || !dst->memory || src->w != dst->width || src->h != dst->height)
+  {
+    MY_LOG_ERROR("\t*** Erro: Superfície ou imagem planar inválida para a conversão de cor.");
+    return false;
+  }
+
+  if (src->format != SDL_PIXELFORMAT_RGBA32)
+  {
+    MY_LOG_ERROR("\t*** Erro: Conversão de cor espera superfícies RGBA32 (recebeu %s).", SDL_GetPixelFormatName(src->format));
+    return false;
+  }
+
+  if (dst->space == MY_COLOR_LAB)
+    initialize_tables();
+
+  SDL_LockSurface(src);
+
+  ColorJob job = {
+    .pixels = (Uint8 *)src->pixels,
+    .pitch = src->pitch,
+    .image = dst,
+    .kernels = MyKernels_get(),
+    .failed = { 0 },
+  };
+  get_chroma_shift(dst, &job.chromaShiftX, &job.chromaShiftY);
+  build_forward_matrix(dst->space, job.matrix);
+
+  // Os itens são linhas de crominância (duas linhas da imagem em 4:2:0).
+  const int itemCount = dst->planeCount > 1 ? dst->planeHeights[1] : dst->height;
+  const int grain = SDL_max(1, (COLOR_PIXELS_PER_BLOCK >> job.chromaShiftY) / dst->width);
+  MyThreadPool_parallel_for(pool, itemCount, grain, from_rgba32_rows, &job);
+
+  SDL_UnlockSurface(src);
+
+  if (SDL_GetAtomicInt(&job.failed))
+  {
+    MY_LOG_ERROR("\t*** Erro: Memória temporária da conversão de cor indisponível.");
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyColor_to_rgba32(const MyPlanarImage *src, SDL_Surface *dst, MyThreadPool *pool)
+{
+  if (!src || !dst || !src->memory || dst->w != src->width || dst->h != src->height)
+  {
+    MY_LOG_ERROR("\t*** Erro: Superfície ou imagem planar inválida para a conversão de cor.");
+    return false;
+  }
+
+  if (dst->format != SDL_PIXELFORMAT_RGBA32)
+  {
+    MY_LOG_ERROR("\t*** Erro: Conversão de cor espera superfícies RGBA32 (recebeu %s).", SDL_GetPixelFormatName(dst->format));
+    return false;
+  }
+
+  if (src->space == MY_COLOR_LAB)
+    initialize_tables();
+
+  SDL_LockSurface(dst);
+
+  ColorJob job = {
+    .pixels = (Uint8 *)dst->pixels,
+    .pitch = dst->pitch,
+    .image = src,
+    .kernels = MyKernels_get(),
+    .failed = { 0 },
+  };
+  get_chroma_shift(src, &job.chromaShiftX, &job.chromaShiftY);
+  build_inverse_matrix(src->space, job.matrix);
+
+  // Blocos com número par de linhas, para que as duas linhas de um par 4:2:0
+  // fiquem no mesmo bloco e a crominância seja expandida uma só vez.
+  const int grain = SDL_max(2, (COLOR_PIXELS_PER_BLOCK / src->width) & ~1);
+  MyThreadPool_parallel_for(pool, src->height, grain, to_rgba32_rows, &job);
+
+  SDL_UnlockSurface(dst);
+
+  if (SDL_GetAtomicInt(&job.failed))
+  {
+    MY_LOG_ERROR("\t*** Erro: Memória temporária da conversão de cor indisponível.");
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const char *MyColor_get_space_name(MyColorSpace space)
+{
+  if (space < 0 || space >= MY_COLOR_SPACE_COUNT)
+    return "?";
+
+  return COLOR_SPACE_NAMES[space];
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Conversão de superfícies RGBA32 (ex. as produzidas por load_rgba32()) para
+// imagens planares de 8 bits (um plano por componente) e de volta para RGBA32.
+//
+// Espaços suportados (todos com componentes de 8 bits):
+//
+// - Cinza: Y = 0.299 R + 0.587 G + 0.114 B (pesos do BT.601), um plano.
+// - YCbCr BT.601 e BT.709, faixa completa (como no JPEG): Y em [0, 255] e Cb
+//   e Cr centrados em 128.
+// - HSV: H em [0, 256) cobrindo o círculo inteiro, S e V em [0, 255].
+// - Lab (CIE L*a*b*, sRGB com branco D65): L * 255 / 100, a + 128 e b + 128.
+//
+// Nos espaços com luminância e crominância (YCbCr e Lab), os planos 1 e 2
+// podem ter resolução reduzida (4:2:2 ou 4:2:0). Na ida, cada amostra de
+// crominância é a média dos pixels que ela cobre; na volta, a amostra é
+// repetida (vizinho mais próximo).
+//
+// Cinza, YCbCr e HSV usam os kernels com despacho em tempo de execução
+// (kernels.h); Lab usa tabelas (linearização do sRGB e raiz cúbica) em C
+// puro. As linhas são divididas entre as threads de `pool` (pode ser NULL).
+// O alpha é ignorado na ida e vale 255 na volta.
+//------------------------------------------------------------------------------
+#ifndef MY_COLOR_H
+#define MY_COLOR_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+#include "parallel.h"
+
+enum color_constants
+{
+  MY_PLANAR_IMAGE_MAX_PLANES = 3,
+};
+
+typedef enum MyColorSpace
+{
+  MY_COLOR_GRAY,
+  MY_COLOR_YCBCR_601,
+  MY_COLOR_YCBCR_709,
+  MY_COLOR_HSV,
+  MY_COLOR_LAB,
+  MY_COLOR_SPACE_COUNT
+} MyColorSpace;
+
+typedef enum MyChromaSubsampling
+{
+  MY_CHROMA_444,  // Resolução completa.
+  MY_CHROMA_422,  // Metade da largura.
+  MY_CHROMA_420,  // Metade da largura e da altura.
+} MyChromaSubsampling;
+
+typedef struct MyPlanarImage MyPlanarImage;
+struct MyPlanarImage
+{
+  MyColorSpace space;
+  MyChromaSubsampling subsampling;
+  int width;
+  int height;
+  int planeCount;
+
+  // Dimensões e pitch (alinhado em MY_IMAGE_POOL_ALIGNMENT bytes) de cada
+  // plano. Todos os planos ficam em um único bloco de memória.
+  Uint8 *planes[MY_PLANAR_IMAGE_MAX_PLANES];
+  int planeWidths[MY_PLANAR_IMAGE_MAX_PLANES];
+  int planeHeights[MY_PLANAR_IMAGE_MAX_PLANES];
+  int pitches[MY_PLANAR_IMAGE_MAX_PLANES];
+  void *memory;
+};
+
+/**
+ * Cria uma imagem planar `width x height` no espaço `space`. A subamostragem
+ * só é aceita em YCbCr e Lab (o matiz do HSV não pode ser promediado) e é
+ * ignorada em cinza.
+ */
+bool MyPlanarImage_create(MyPlanarImage *image, int width, int height, MyColorSpace space, MyChromaSubsampling subsampling);
+void MyPlanarImage_destroy(MyPlanarImage *image);
+
+/**
+ * Converte `src` (RGBA32) para `dst`, já criada com as mesmas dimensões.
+ */
+bool MyColor_from_rgba32(SDL_Surface *src, MyPlanarImage *dst, MyThreadPool *pool);
+
+/**
+ * Converte `src` de volta para `dst` (RGBA32, mesmas dimensões).
+ */
+bool MyColor_to_rgba32(const MyPlanarImage *src, SDL_Surface *dst, MyThreadPool *pool);
+
+const char *MyColor_get_space_name(MyColorSpace space);
+
+#endif // MY_COLOR_H
@@ -0,0 +1,590 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "edges.h"
+#include "image_pool.h"
+#include "kernels.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+enum
+{
+  EDGES_MIN_ROWS_PER_BAND = 32,
+  EDGES_MAX_RADIUS = 16,
+  EDGES_OUTPUT_PIXELS_PER_BLOCK = 1 << 16,
+};
+
+// Classes do mapa do Canny.
+enum
+{
+  EDGE_CLASS_NONE,
+  EDGE_CLASS_WEAK,
+  EDGE_CLASS_STRONG,
+};
+
+typedef struct EdgesJob EdgesJob;
+struct EdgesJob
+{
+  const Uint8 *srcPixels;
+  Uint8 *dstPixels;
+  Uint8 *classes;
+  int width;
+  int height;
+  int srcPitch;
+  int dstPitch;
+  int rowsPerBand;
+  int radius;
+  const float *gaussian;
+  float center;
+  float lowThreshold;
+  float highThreshold;
+  bool canny;
+  bool orientation;
+  const MyKernels *kernels;
+  SDL_AtomicInt weakCount;
+  SDL_AtomicInt failed;
+};
+
+// Estado de uma faixa: anéis de linhas na arena da thread.
+typedef struct EdgesBand EdgesBand;
+struct EdgesBand
+{
+  int begin;
+  int end;
+  int taps;
+  int lumaBegin;
+  Uint8 *luma;
+  float *verticalWeights;
+  float *blurred;
+  float *smoothed[3];
+  int smoothedRows[3];
+  float *magnitudes[3];
+  Uint8 *directions[3];
+  float *zeros;
+};
+
+static const char *MODE_NAMES[MY_EDGE_MODE_COUNT] = { "none", "gradient", "orientation", "canny" };
+
+// Luminância BT.601 (veja rgba32_to_planes() em kernels.h).
+static const float GRAY_MATRIX[12] = { 0.299f, 0.587f, 0.114f, 0.5f };
+
+// Peso central da suavização de cada operador (os laterais valem 1).
+static const float OPERATOR_CENTER[MY_GRADIENT_OPERATOR_COUNT] = { 2.0f, 10.0f / 3.0f };
+
+// Cor de cada MyGradientDirection no modo orientação.
+static const Uint8 DIRECTION_COLORS[4][3] = {
+  { 255, 0, 0 },
+  { 255, 255, 0 },
+  { 0, 255, 0 },
+  { 0, 128, 255 },
+};
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static int vertical_first(const EdgesJob *job, int taps, int row);
+static const float *get_smoothed_row(const EdgesJob *job, EdgesBand *band, int row);
+static void suppress_non_maxima(const EdgesJob *job, EdgesBand *band, int row);
+static void write_gradient_row(const EdgesJob *job, const float *magnitude, const Uint8 *direction, int row);
+static int flood(Uint8 *classes, int width, int rowBegin, int rowEnd, int *queue, int tail);
+static bool process_band(EdgesJob *job, int begin, int end);
+static void edges_bands(void *userdata, int begin, int end, int threadIndex);
+static void canny_output_rows(void *userdata, int begin, int end, int threadIndex);
+static bool edges_run(SDL_Surface *src, SDL_Surface *dst, const MyEdgeParams *params, bool canny, bool orientation,
+  MyThreadPool *pool);
+
+//------------------------------------------------------------------------------
+// Primeira linha de entrada da janela vertical da gaussiana na linha `row`
+// (a janela é deslocada para dentro da imagem perto das bordas).
+//------------------------------------------------------------------------------
+int vertical_first(const EdgesJob *job, int taps, int row)
+{
+  return SDL_clamp(row - job->radius, 0, job->height - taps);
+}
+
+//------------------------------------------------------------------------------
+// Linha suavizada `row` (com um valor replicado em [-1] e em [width]), vinda
+// do anel de 3 linhas ou calculada a partir das linhas de cinza da faixa.
+//------------------------------------------------------------------------------
+const float *get_smoothed_row(const EdgesJob *job, EdgesBand *band, int row)
+{
+  const int slot = row % 3;
+  float *smoothed = band->smoothed[slot];
+  if (band->smoothedRows[slot] == row)
+    return smoothed + 1;
+
+  const int width = job->width;
+  const int radius = job->radius;
+  const int first = vertical_first(job, band->taps, row);
+
+  // Perto das bordas, os pesos das linhas de fora (que repetem a borda) são
+  // somados aos pesos das linhas da borda.
+  const float *weights = job->gaussian;
+  if (row - radius < 0 || row + radius >= job->height)
+  {
+    SDL_memset(band->verticalWeights, 0, (size_t)band->taps * sizeof(float));
+    for (int k = 0; k <= 2 * radius; ++k)
+      band->verticalWeights[SDL_clamp(row - radius + k, 0, job->height - 1) - first] += job->gaussian[k];
+    weights = band->verticalWeights;
+  }
+
+  float *blurred = band->blurred;
+  job->kernels->resample_vertical_u8(band->luma + (size_t)(first - band->lumaBegin) * width, (size_t)width,
+    weights, band->taps, blurred + radius, (size_t)width);
+
+  for (int k = 1; k <= radius; ++k)
+  {
+    blurred[radius - k] = blurred[radius];
+    blurred[radius + width - 1 + k] = blurred[radius + width - 1];
+  }
+
+  job->kernels->convolve_row_f32(blurred, smoothed + 1, width, job->gaussian, 2 * radius + 1);
+  smoothed[0] = smoothed[1];
+  smoothed[width + 1] = smoothed[width];
+
+  band->smoothedRows[slot] = row;
+  return smoothed + 1;
+}
+
+//------------------------------------------------------------------------------
+// Supressão de não-máximos e limiares da linha `row` (as magnitudes das linhas
+// row - 1, row e row + 1 estão no anel; fora da imagem, zero).
+//------------------------------------------------------------------------------
+void suppress_non_maxima(const EdgesJob *job, EdgesBand *band, int row)
+{
+  const float *above = (row > 0) ? band->magnitudes[(row - 1) % 3] + 1 : band->zeros + 1;
+  const float *current = band->magnitudes[row % 3] + 1;
+  const float *below = (row + 1 < job->height) ? band->magnitudes[(row + 1) % 3] + 1 : band->zeros + 1;
+  const Uint8 *direction = band->directions[row % 3];
+  Uint8 *classes = job->classes + (size_t)row * job->width;
+
+  for (int x = 0; x < job->width; ++x)
+  {
+    // Vizinhos ao longo do gradiente (y para baixo).
+    float p;
+    float q;
+    switch (direction[x])
+    {
+    case MY_GRADIENT_HORIZONTAL:
+      p = current[x - 1];
+      q = current[x + 1];
+      break;
+    case MY_GRADIENT_VERTICAL:
+      p = above[x];
+      q = below[x];
+      break;
+    case MY_GRADIENT_DIAGONAL:
+      p = above[x - 1];
+      q = below[x + 1];
+      break;
+    default:
+      p = above[x + 1];
+      q = below[x - 1];
+      break;
+    }
+
+    // Em um platô, só o primeiro pixel (p < m <= q) é mantido.
+    const float m = current[x];
+    Uint8 c = EDGE_CLASS_NONE;
+    if (m >= job->lowThreshold && m > p && m >= q)
+      c = (m >= job->highThreshold) ? EDGE_CLASS_STRONG : EDGE_CLASS_WEAK;
+    classes[x] = c;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void write_gradient_row(const EdgesJob *job, const float *magnitude, const Uint8 *direction, int row)
+{
+  Uint8 *dst = job->dstPixels + (size_t)row * job->dstPitch;
+  for (int x = 0; x < job->width; ++x, dst += 4)
+  {
+    const Uint8 v = (Uint8)(SDL_min(magnitude[x], 255.0f) + 0.5f);
+    if (job->orientation)
+    {
+      const Uint8 *color = DIRECTION_COLORS[direction[x]];
+      dst[0] = (Uint8)(color[0] * v / 255);
+      dst[1] = (Uint8)(color[1] * v / 255);
+      dst[2] = (Uint8)(color[2] * v / 255);
+    }
+    else
+    {
+      dst[0] = dst[1] = dst[2] = v;
+    }
+    dst[3] = 255;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Histerese: a partir dos pixels em queue[0, tail), marca como fortes os
+// pixels fracos 8-conectados, sem sair das linhas [rowBegin, rowEnd). Cada
+// pixel entra na fila no máximo uma vez. Retorna o número de pixels marcados.
+//------------------------------------------------------------------------------
+int flood(Uint8 *classes, int width, int rowBegin, int rowEnd, int *queue, int tail)
+{
+  int marked = 0;
+  for (int head = 0; head < tail; ++head)
+  {
+    const int y = queue[head] / width;
+    const int x = queue[head] % width;
+    const int yBegin = SDL_max(rowBegin, y - 1);
+    const int yEnd = SDL_min(rowEnd - 1, y + 1);
+    const int xBegin = SDL_max(0, x - 1);
+    const int xEnd = SDL_min(width - 1, x + 1);
+
+    for (int ny = yBegin; ny <= yEnd; ++ny)
+    {
+      for (int nx = xBegin; nx <= xEnd; ++nx)
+      {
+        const int i = ny * width + nx;
+        if (classes[i] == EDGE_CLASS_WEAK)
+        {
+          classes[i] = EDGE_CLASS_STRONG;
+          queue[tail++] = i;
+          ++marked;
+        }
+      }
+    }
+  }
+
+  return marked;
+}
+
+//------------------------------------------------------------------------------
+// Processa as linhas [begin, end): cinza, gaussiana e gradiente fundidos e,
+// no Canny, supressão de não-máximos e histerese dentro da faixa.
+//------------------------------------------------------------------------------
+bool process_band(EdgesJob *job, int begin, int end)
+{
+  const int width = job->width;
+  const int height = job->height;
+  const int radius = job->radius;
+
+  // O Canny precisa da magnitude de uma linha a mais de cada lado; o
+  // gradiente, de uma linha suavizada a mais de cada lado.
+  const int halo = job->canny ? 1 : 0;
+  const int magnitudeBegin = SDL_max(0, begin - halo);
+  const int magnitudeEnd = SDL_min(height, end + halo);
+  const int smoothedBegin = SDL_max(0, magnitudeBegin - 1);
+  const int smoothedEnd = SDL_min(height, magnitudeEnd + 1);
+
+  EdgesBand band = {
+    .begin = begin,
+    .end = end,
+    .taps = SDL_min(2 * radius + 1, height),
+    .smoothedRows = { -1, -1, -1 },
+  };
+  band.lumaBegin = vertical_first(job, band.taps, smoothedBegin);
+  const int lumaEnd = vertical_first(job, band.taps, smoothedEnd - 1) + band.taps;
+
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker arenaMarker = MyArena_get_marker(arena);
+
+  band.luma = MyArena_push(arena, (size_t)(lumaEnd - band.lumaBegin) * width, MY_IMAGE_POOL_ALIGNMENT);
+  band.verticalWeights = MyArena_push(arena, (size_t)band.taps * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+  band.blurred = MyArena_push(arena, (size_t)(width + 2 * radius) * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+  band.zeros = MyArena_push(arena, (size_t)(width + 2) * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+  bool ok = band.luma && band.verticalWeights && band.blurred && band.zeros;
+  for (int i = 0; i < 3 && ok; ++i)
+  {
+    band.smoothed[i] = MyArena_push(arena, (size_t)(width + 2) * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+    band.magnitudes[i] = MyArena_push(arena, (size_t)(width + 2) * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+    band.directions[i] = MyArena_push(arena, (size_t)width, MY_IMAGE_POOL_ALIGNMENT);
+    ok = band.smoothed[i] && band.magnitudes[i] && band.directions[i];
+  }
+
+  if (!ok)
+  {
+    MyArena_reset_to_marker(arena, arenaMarker);
+    return false;
+  }
+
+  // Cinza de todas as linhas de entrada da faixa (com o halo).
+  for (int row = band.lumaBegin; row < lumaEnd; ++row)
+  {
+    Uint8 *const luma[3] = { band.luma + (size_t)(row - band.lumaBegin) * width, NULL, NULL };
+    job->kernels->rgba32_to_planes(job->srcPixels + (size_t)row * job->srcPitch, luma, 1, (size_t)width, GRAY_MATRIX);
+  }
+
+  // Magnitudes com zero nas colunas -1 e width (supressão de não-máximos).
+  SDL_memset(band.zeros, 0, (size_t)(width + 2) * sizeof(float));
+  for (int i = 0; i < 3; ++i)
+    band.magnitudes[i][0] = band.magnitudes[i][width + 1] = 0.0f;
+
+  // A linha `row - 1` é finalizada assim que a magnitude de `row` fica pronta.
+  for (int row = magnitudeBegin; row <= magnitudeEnd; ++row)
+  {
+    if (row < magnitudeEnd)
+    {
+      const float *const rows[3] = {
+        get_smoothed_row(job, &band, SDL_max(0, row - 1)),
+        get_smoothed_row(job, &band, row),
+        get_smoothed_row(job, &band, SDL_min(height - 1, row + 1)),
+      };
+      float *magnitude = band.magnitudes[row % 3] + 1;
+      Uint8 *direction = band.directions[row % 3];
+      job->kernels->gradient_3x3_f32(rows, magnitude, direction, width, job->center);
+
+      if (!job->canny)
+        write_gradient_row(job, magnitude, direction, row);
+    }
+
+    if (job->canny && row - 1 >= begin && row - 1 < end)
+      suppress_non_maxima(job, &band, row - 1);
+  }
+
+  MyArena_reset_to_marker(arena, arenaMarker);
+  if (!job->canny)
+    return true;
+
+  // Histerese dentro da faixa, a partir dos pixels fortes.
+  int *queue = MyArena_push(arena, (size_t)(end - begin) * width * sizeof(int), MY_IMAGE_POOL_ALIGNMENT);
+  if (!queue)
+  {
+    MyArena_reset_to_marker(arena, arenaMarker);
+    return false;
+  }
+
+  int tail = 0;
+  int weak = 0;
+  for (int i = begin * width; i < end * width; ++i)
+  {
+    if (job->classes[i] == EDGE_CLASS_STRONG)
+      queue[tail++] = i;
+    else if (job->classes[i] == EDGE_CLASS_WEAK)
+      ++weak;
+  }
+
+  weak -= flood(job->classes, width, begin, end, queue, tail);
+  SDL_AddAtomicInt(&job->weakCount, weak);
+
+  MyArena_reset_to_marker(arena, arenaMarker);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void edges_bands(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+  EdgesJob *job = (EdgesJob *)userdata;
+
+  for (int band = begin; band < end; ++band)
+  {
+    const int rowBegin = band * job->rowsPerBand;
+    const int rowEnd = SDL_min(job->height, rowBegin + job->rowsPerBand);
+    if (!process_band(job, rowBegin, rowEnd))
+    {
+      SDL_SetAtomicInt(&job->failed, 1);
+      return;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void canny_output_rows(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+  EdgesJob *job = (EdgesJob *)userdata;
+
+  for (int row = begin; row < end; ++row)
+  {
+    const Uint8 *classes = job->classes + (size_t)row * job->width;
+    Uint8 *dst = job->dstPixels + (size_t)row * job->dstPitch;
+    for (int x = 0; x < job->width; ++x, dst += 4)
+    {
+      dst[0] = dst[1] = dst[2] = (classes[x] == EDGE_CLASS_STRONG) ? 255 : 0;
+      dst[3] = 255;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool edges_run(SDL_Surface *src, SDL_Surface *dst, const MyEdgeParams *params, bool canny, bool orientation,
+  MyThreadPool *pool)
+{
+  if (!src || !dst || !params || src->w != dst->w || src->h != dst->h || (!canny && src == dst))
+  {
+    MY_LOG_ERROR("\t*** Erro: Superfícies inválidas para a detecção de bordas.");
+    return false;
+  }
+
+  if (src->format != SDL_PIXELFORMAT_RGBA32 || dst->format != SDL_PIXELFORMAT_RGBA32)
+  {
+    MY_LOG_ERROR("\t*** Erro: Detecção de bordas espera superfícies RGBA32.");
+    return false;
+  }
+
+  if (params->op < 0 || params->op >= MY_GRADIENT_OPERATOR_COUNT || params->sigma < 0.0f
+    || params->lowThreshold > params->highThreshold)
+  {
+    MY_LOG_ERROR("\t*** Erro: Parâmetros inválidos para a detecção de bordas.");
+    return false;
+  }
+
+  const int width = src->w;
+  const int height = src->h;
+  const int radius = SDL_min((int)SDL_ceilf(3.0f * params->sigma), EDGES_MAX_RADIUS);
+
+  // Gaussiana e mapa de classes na arena da thread que chamou a função.
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker arenaMarker = MyArena_get_marker(arena);
+  float *gaussian = MyArena_push(arena, (size_t)(2 * radius + 1) * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+  Uint8 *classes = canny ? MyArena_push(arena, (size_t)width * height, MY_IMAGE_POOL_ALIGNMENT) : NULL;
+  if (!gaussian || (canny && !classes))
+  {
+    MyArena_reset_to_marker(arena, arenaMarker);
+    MY_LOG_ERROR("\t*** Erro: Memória temporária da detecção de bordas indisponível.");
+    return false;
+  }
+
+  float sum = 0.0f;
+  for (int k = -radius; k <= radius; ++k)
+  {
+    gaussian[k + radius] = (radius > 0) ? SDL_expf(-(float)(k * k) / (2.0f * params->sigma * params->sigma)) : 1.0f;
+    sum += gaussian[k + radius];
+  }
+  for (int k = 0; k <= 2 * radius; ++k)
+    gaussian[k] /= sum;
+
+  SDL_LockSurface(src);
+  if (dst != src)
+    SDL_LockSurface(dst);
+
+  // Faixas altas o bastante para que o halo (2 * (radius + 2) linhas de
+  // cinza) seja uma fração pequena do trabalho.
+  EdgesJob job = {
+    .srcPixels = (const Uint8 *)src->pixels,
+    .dstPixels = (Uint8 *)dst->pixels,
+    .classes = classes,
+    .width = width,
+    .height = height,
+    .srcPitch = src->pitch,
+    .dstPitch = dst->pitch,
+    .rowsPerBand = SDL_max(EDGES_MIN_ROWS_PER_BAND, 4 * (radius + 2)),
+    .radius = radius,
+    .gaussian = gaussian,
+    .center = OPERATOR_CENTER[params->op],
+    .lowThreshold = params->lowThreshold,
+    .highThreshold = params->highThreshold,
+    .canny = canny,
+    .orientation = orientation,
+    .kernels = MyKernels_get(),
+    .weakCount = { 0 },
+    .failed = { 0 },
+  };
+
+  const int bandCount = (height + job.rowsPerBand - 1) / job.rowsPerBand;
+  MyThreadPool_parallel_for(pool, bandCount, 1, edges_bands, &job);
+  bool ok = !SDL_GetAtomicInt(&job.failed);
+
+  // Costuras: os caminhos de pixels fracos que atravessam faixas continuam a
+  // partir dos pixels fortes das linhas vizinhas a cada costura. A fila cabe
+  // as sementes e todos os pixels fracos que sobraram.
+  if (ok && canny && bandCount > 1)
+  {
+    const size_t capacity = (size_t)(bandCount - 1) * 2 * width + (size_t)SDL_GetAtomicInt(&job.weakCount);
+    int *queue = MyArena_push(arena, capacity * sizeof(int), MY_IMAGE_POOL_ALIGNMENT);
+    ok = queue != NULL;
+
+    int tail = 0;
+    for (int band = 1; ok && band < bandCount; ++band)
+    {
+      const int seam = band * job.rowsPerBand;
+      for (int i = (seam - 1) * width; i < (seam + 1) * width; ++i)
+      {
+        if (classes[i] == EDGE_CLASS_STRONG)
+          queue[tail++] = i;
+      }
+    }
+
+    if (ok)
+      flood(classes, width, 0, height, queue, tail);
+  }
+
+  if (ok && canny)
+    MyThreadPool_parallel_for(pool, height, SDL_max(1, EDGES_OUTPUT_PIXELS_PER_BLOCK / width), canny_output_rows, &job);
+
+  if (dst != src)
+    SDL_UnlockSurface(dst);
+  SDL_UnlockSurface(src);
+  MyArena_reset_to_marker(arena, arenaMarker);
+
+  if (!ok)
+  {
+    MY_LOG_ERROR("\t*** Erro: Memória temporária da detecção de bordas indisponível.");
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+MyEdgeParams MyEdges_get_default_params(void)
+{
+  return (MyEdgeParams){
+    .op = MY_GRADIENT_SOBEL,
+    .sigma = 1.4f,
+    .lowThreshold = 10.0f,
+    .highThreshold = 30.0f,
+  };
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyEdges_gradient(SDL_Surface *src, SDL_Surface *dst, const MyEdgeParams *params, bool orientation, MyThreadPool *pool)
+{
+  return edges_run(src, dst, params, false, orientation, pool);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyEdges_canny(SDL_Surface *src, SDL_Surface *dst, const MyEdgeParams *params, MyThreadPool *pool)
+{
+  return edges_run(src, dst, params, true, false, pool);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyEdges_apply(SDL_Surface *src, SDL_Surface *dst, MyEdgeMode mode, const MyEdgeParams *params, MyThreadPool *pool)
+{
+  switch (mode)
+  {
+  case MY_EDGES_GRADIENT:
+    return MyEdges_gradient(src, dst, params, false, pool);
+  case MY_EDGES_ORIENTATION:
+    return MyEdges_gradient(src, dst, params, true, pool);
+  case MY_EDGES_CANNY:
+    return MyEdges_canny(src, dst, params, pool);
+  default:
+    MY_LOG_ERROR("\t*** Erro: Modo de detecção de bordas inválido (%d).", (int)mode);
+    return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const char *MyEdges_get_mode_name(MyEdgeMode mode)
+{
+  if (mode < 0 || mode >= MY_EDGE_MODE_COUNT)
+    return "?";
+
+  return MODE_NAMES[mode];
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Detecção de bordas em superfícies RGBA32: magnitude/orientação do gradiente
+// (Sobel ou Scharr) e detector de Canny.
+//
+// As etapas iniciais são fundidas em uma única passada por faixa de linhas:
+// cada linha de entrada é convertida para cinza (luminância BT.601), suavizada
+// por uma gaussiana separável (vertical e depois horizontal) e entra em um
+// anel de 3 linhas suavizadas, de onde sai o gradiente 3x3 (magnitude e
+// direção). No Canny, a supressão de não-máximos usa um anel de 3 linhas de
+// magnitude e grava um mapa de classes (fraco/forte) de 1 byte por pixel.
+// Nenhuma imagem intermediária completa (cinza, suavizada ou gradiente) é
+// criada: só linhas na arena da thread.
+//
+// A imagem é dividida em faixas de linhas (tiles com a largura da imagem),
+// processadas em paralelo pelas threads de `pool` (pode ser NULL). Cada faixa
+// recalcula as poucas linhas vizinhas de que precisa (o "halo" da gaussiana e
+// do gradiente), então o resultado é idêntico ao de uma única faixa.
+//
+// A histerese é uma inundação (flood fill) com fila a partir dos pixels
+// fortes, 8-conectada: primeiro cada faixa, em paralelo, sem sair da faixa;
+// depois uma única inundação que parte das bordas (costuras) entre faixas
+// continua os caminhos que atravessam faixas.
+//------------------------------------------------------------------------------
+#ifndef MY_EDGES_H
+#define MY_EDGES_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+#include "parallel.h"
+
+typedef enum MyGradientOperator
+{
+  MY_GRADIENT_SOBEL,    // [1 2 1] x [-1 0 1].
+  MY_GRADIENT_SCHARR,   // [3 10 3] x [-1 0 1], mais isotrópico.
+  MY_GRADIENT_OPERATOR_COUNT
+} MyGradientOperator;
+
+typedef enum MyEdgeMode
+{
+  MY_EDGES_NONE,
+  MY_EDGES_GRADIENT,      // Magnitude do gradiente, em cinza.
+  MY_EDGES_ORIENTATION,   // Magnitude com a cor da direção do gradiente.
+  MY_EDGES_CANNY,         // Bordas (branco) do detector de Canny.
+  MY_EDGE_MODE_COUNT
+} MyEdgeMode;
+
+/**
+ * A magnitude do gradiente é normalizada (divisão pela soma dos pesos da
+ * suavização do operador), então fica na escala da diferença de intensidade
+ * entre vizinhos: um degrau de 0 para 100 sem suavização tem magnitude 100.
+ */
+typedef struct MyEdgeParams MyEdgeParams;
+struct MyEdgeParams
+{
+  MyGradientOperator op;
+  float sigma;           // Desvio padrão da gaussiana (0 = sem suavização).
+  float lowThreshold;    // Canny: magnitude mínima de um pixel fraco.
+  float highThreshold;   // Canny: magnitude mínima de um pixel forte.
+};
+
+/**
+ * Parâmetros padrão: Sobel, sigma 1.4 e limiares 10 e 30.
+ */
+MyEdgeParams MyEdges_get_default_params(void);
+
+/**
+ * Magnitude do gradiente de `src` em `dst` (RGBA32, mesmas dimensões,
+ * superfícies diferentes), limitada a 255. Com `orientation`, a magnitude
+ * colore o pixel com a cor da direção do gradiente (vermelho = horizontal,
+ * amarelo e azul = diagonais, verde = vertical).
+ */
+bool MyEdges_gradient(SDL_Surface *src, SDL_Surface *dst, const MyEdgeParams *params, bool orientation, MyThreadPool *pool);
+
+/**
+ * Detector de Canny: bordas em branco sobre preto em `dst` (RGBA32, mesmas
+ * dimensões). `src` e `dst` podem ser a mesma superfície.
+ */
+bool MyEdges_canny(SDL_Surface *src, SDL_Surface *dst, const MyEdgeParams *params, MyThreadPool *pool);
+
+/**
+ * Chama MyEdges_gradient() ou MyEdges_canny() conforme `mode` (diferente de
+ * MY_EDGES_NONE).
+ */
+bool MyEdges_apply(SDL_Surface *src, SDL_Surface *dst, MyEdgeMode mode, const MyEdgeParams *params, MyThreadPool *pool);
+
+const char *MyEdges_get_mode_name(MyEdgeMode mode);
+
+#endif // MY_EDGES_H
@@ -0,0 +1,513 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "filters.h"
+#include "histogram.h"
+#include "image_pool.h"
+#include "kernels.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+enum
+{
+  BLUR_MIN_ROWS_PER_BLOCK = 16,
+  INVERT_PIXELS_PER_BLOCK = 1 << 16,
+  GAUSSIAN_MAX_RADIUS = 128,
+};
+
+// Faixas de linhas dos filtros de vizinhança com anel de linhas originais.
+// Cada faixa grava só as suas linhas, mas lê até `radius` linhas acima e
+// abaixo dela. No modo "in place" (src == dst), essas linhas podem já ter sido
+// sobrescritas pela faixa vizinha, então as 2 * radius linhas em torno de cada
+// costura entre faixas são copiadas para `seams` antes do processamento.
+typedef struct RowBands RowBands;
+struct RowBands
+{
+  const Uint8 *srcPixels;
+  int srcPitch;
+  int height;
+  int radius;
+  int rowsPerBand;
+  int count;
+  bool inPlace;
+  size_t rowBytes;
+  Uint8 *seams;
+};
+
+typedef struct BlurJob BlurJob;
+struct BlurJob
+{
+  const Uint8 *srcPixels;
+  Uint8 *dstPixels;
+  int width;
+  int height;
+  int srcPitch;
+  int dstPitch;
+  int radius;
+  float average;          // RGBA32 (kernels SIMD).
+  double inverseArea;     // RGBA64 e RGBA128_FLOAT.
+  RowBands bands;
+  const MyKernels *kernels;
+  SDL_AtomicInt failed;
+};
+
+// Gaussiana separável: o passo vertical combina as linhas do anel em uma linha
+// de floats e o passo horizontal combina as colunas dessa linha (os mesmos
+// kernels do redimensionamento, com escala 1).
+typedef struct GaussianJob GaussianJob;
+struct GaussianJob
+{
+  Uint8 *dstPixels;
+  int width;
+  int dstPitch;
+  int taps;
+  const float *verticalWeights;
+  const int *horizontalFirst;
+  const float *horizontalWeights;
+  int horizontalTaps;
+  RowBands bands;
+  const MyKernels *kernels;
+  SDL_AtomicInt failed;
+};
+
+typedef struct InvertJob InvertJob;
+struct InvertJob
+{
+  const Uint8 *srcPixels;
+  Uint8 *dstPixels;
+  int width;
+  int srcPitch;
+  int dstPitch;
+  const MyKernels *kernels;
+};
+
+// Funções de cada formato de superfície aceito pelos filtros, geradas a partir
+// do mesmo código (filters_typed.h).
+typedef struct PixelFunctions PixelFunctions;
+struct PixelFunctions
+{
+  SDL_PixelFormat format;
+  MyParallelForFunction blurRows;
+  MyParallelForFunction blurInPlaceBands;
+  MyParallelForFunction gaussianBands;
+  MyParallelForFunction invertRows;
+};
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static bool RowBands_init(RowBands *bands, MyArena *arena, SDL_Surface *src, SDL_Surface *dst, int radius, int minRowsPerBand, MyThreadPool *pool);
+static const Uint8 *RowBands_get_source_row(const RowBands *bands, int band, int row);
+static int ring_slot(int row, int size);
+static bool build_gaussian_weights(MyArena *arena, float sigma, int width, GaussianJob *job);
+static const PixelFunctions *get_pixel_functions(SDL_PixelFormat format);
+static void copy_surface(SDL_Surface *src, SDL_Surface *dst);
+
+//------------------------------------------------------------------------------
+// Filtros por tipo de canal. O acumulador do filtro de média cabe a soma da
+// janela inteira: 32 bits para 8 bits por canal (até 4104 x 4104), 64 bits
+// para 16 bits e double para float (as somas deslizantes em float acumulariam
+// erro de arredondamento).
+//------------------------------------------------------------------------------
+#define MY_PIXEL_SUFFIX u8
+#define MY_PIXEL_TYPE Uint8
+#define MY_PIXEL_SUM Uint32
+#define MY_PIXEL_MAX 255
+#define MY_PIXEL_KERNELS 1
+#include "filters_typed.h"
+
+// 16 bits: a média é arredondada (a soma em double é exata).
+#define MY_PIXEL_SUFFIX u16
+#define MY_PIXEL_TYPE Uint16
+#define MY_PIXEL_SUM Uint64
+#define MY_PIXEL_MAX 65535
+#define MY_PIXEL_KERNELS 0
+#define MY_PIXEL_FROM_FLOAT(x) ((Uint16)(SDL_clamp((x), 0.0f, 65535.0f) + 0.5f))
+#define MY_PIXEL_FROM_DOUBLE(x) ((Uint16)((x) + 0.5))
+#include "filters_typed.h"
+
+// Float: sem limites (ex. HDR), então nada é limitado a [0, 1].
+#define MY_PIXEL_SUFFIX f32
+#define MY_PIXEL_TYPE float
+#define MY_PIXEL_SUM double
+#define MY_PIXEL_MAX 1.0f
+#define MY_PIXEL_KERNELS 0
+#define MY_PIXEL_FROM_FLOAT(x) (x)
+#define MY_PIXEL_FROM_DOUBLE(x) ((float)(x))
+#include "filters_typed.h"
+#include "log.h"
+
+static const PixelFunctions PIXEL_FUNCTIONS[] = {
+  { SDL_PIXELFORMAT_RGBA32, blur_rows_u8, blur_in_place_bands_u8, gaussian_bands_u8, invert_rows_u8 },
+  { SDL_PIXELFORMAT_RGBA64, blur_rows_u16, blur_in_place_bands_u16, gaussian_bands_u16, invert_rows_u16 },
+  { SDL_PIXELFORMAT_RGBA128_FLOAT, blur_rows_f32, blur_in_place_bands_f32, gaussian_bands_f32, invert_rows_f32 },
+};
+
+//------------------------------------------------------------------------------
+// Divide as linhas em faixas e, no modo "in place", copia as linhas em torno
+// das costuras (na arena de quem chamou, antes de qualquer faixa gravar). As
+// faixas "in place" são uma por thread, o que limita a memória extra a
+// O(threads x largura x tamanho do filtro).
+//------------------------------------------------------------------------------
+bool RowBands_init(RowBands *bands, MyArena *arena, SDL_Surface *src, SDL_Surface *dst, int radius, int minRowsPerBand, MyThreadPool *pool)
+{
+  const int height = src->h;
+  const int threadCount = MyThreadPool_get_thread_count(pool);
+
+  *bands = (RowBands){
+    .srcPixels = (const Uint8 *)src->pixels,
+    .srcPitch = src->pitch,
+    .height = height,
+    .radius = radius,
+    .inPlace = src == dst,
+    .rowBytes = (size_t)src->w * SDL_BYTESPERPIXEL(src->format),
+    .seams = NULL,
+  };
+
+  bands->rowsPerBand = bands->inPlace ? SDL_max(minRowsPerBand, (height + threadCount - 1) / threadCount) : minRowsPerBand;
+  bands->count = (height + bands->rowsPerBand - 1) / bands->rowsPerBand;
+  if (!bands->inPlace || bands->count <= 1 || radius == 0)
+    return true;
+
+  const size_t seamRows = (size_t)2 * radius;
+  bands->seams = MyArena_push(arena, (size_t)(bands->count - 1) * seamRows * bands->rowBytes, MY_IMAGE_POOL_ALIGNMENT);
+  if (!bands->seams)
+    return false;
+
+  for (int seam = 1; seam < bands->count; ++seam)
+  {
+    Uint8 *rows = bands->seams + (size_t)(seam - 1) * seamRows * bands->rowBytes;
+    const int first = seam * bands->rowsPerBand - radius;
+    for (int i = 0; i < (int)seamRows; ++i)
+    {
+      const int row = first + i;
+      if (row >= 0 && row < height)
+        SDL_memcpy(rows + (size_t)i * bands->rowBytes, bands->srcPixels + (size_t)row * bands->srcPitch, bands->rowBytes);
+    }
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Linha original `row` (dentro da imagem) lida pela faixa `band`.
+//------------------------------------------------------------------------------
+const Uint8 *RowBands_get_source_row(const RowBands *bands, int band, int row)
+{
+  if (bands->inPlace)
+  {
+    const size_t seamRows = (size_t)2 * bands->radius;
+    const int begin = band * bands->rowsPerBand;
+    const int end = SDL_min(bands->height, begin + bands->rowsPerBand);
+
+    if (row < begin)
+      return bands->seams + ((size_t)(band - 1) * seamRows + (size_t)(row - (begin - bands->radius))) * bands->rowBytes;
+    if (row >= end)
+      return bands->seams + ((size_t)band * seamRows + (size_t)(row - (end - bands->radius))) * bands->rowBytes;
+  }
+
+  return bands->srcPixels + (size_t)row * bands->srcPitch;
+}
+
+//------------------------------------------------------------------------------
+// Posição da linha `row` (pode ser negativa) em um anel de `size` linhas.
+//------------------------------------------------------------------------------
+int ring_slot(int row, int size)
+{
+  return (row % size + size) % size;
+}
+
+//------------------------------------------------------------------------------
+// Pesos da gaussiana (raio ceil(3 * sigma), soma 1) nos dois eixos. No eixo
+// vertical, o anel guarda a linha y na posição y % taps, então há uma tabela
+// de pesos por posição inicial da janela no anel. No horizontal, as colunas
+// fora da imagem repetem a borda e seus pesos são somados aos da borda.
+//------------------------------------------------------------------------------
+bool build_gaussian_weights(MyArena *arena, float sigma, int width, GaussianJob *job)
+{
+  const int radius = job->bands.radius;
+  const int taps = 2 * radius + 1;
+  const int horizontalTaps = SDL_min(taps, width);
+
+  float *kernel = MyArena_push(arena, (size_t)taps * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+  float *vertical = MyArena_push(arena, (size_t)taps * taps * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+  int *first = MyArena_push(arena, (size_t)width * sizeof(int), MY_IMAGE_POOL_ALIGNMENT);
+  float *horizontal = MyArena_push(arena, (size_t)width * horizontalTaps * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+  if (!kernel || !vertical || !first || !horizontal)
+    return false;
+
+  float sum = 0.0f;
+  for (int k = 0; k < taps; ++k)
+  {
+    const float x = (float)(k - radius);
+    kernel[k] = SDL_expf(-x * x / (2.0f * sigma * sigma));
+    sum += kernel[k];
+  }
+  for (int k = 0; k < taps; ++k)
+    kernel[k] /= sum;
+
+  for (int start = 0; start < taps; ++start)
+  {
+    for (int slot = 0; slot < taps; ++slot)
+      vertical[start * taps + slot] = kernel[(slot - start + taps) % taps];
+  }
+
+  for (int x = 0; x < width; ++x)
+  {
+    const int left = SDL_clamp(x - radius, 0, width - horizontalTaps);
+    float *weights = horizontal + (size_t)x * horizontalTaps;
+    SDL_memset(weights, 0, (size_t)horizontalTaps * sizeof(float));
+    for (int k = 0; k < taps; ++k)
+      weights[SDL_clamp(x - radius + k, 0, width - 1) - left] += kernel[k];
+
+    first[x] = left;
+  }
+
+  job->taps = taps;
+  job->verticalWeights = vertical;
+  job->horizontalFirst = first;
+  job->horizontalWeights = horizontal;
+  job->horizontalTaps = horizontalTaps;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Funções dos filtros para o formato `format`, ou NULL se ele não for aceito.
+//------------------------------------------------------------------------------
+const PixelFunctions *get_pixel_functions(SDL_PixelFormat format)
+{
+  for (int i = 0; i < (int)SDL_arraysize(PIXEL_FUNCTIONS); ++i)
+  {
+    if (PIXEL_FUNCTIONS[i].format == format)
+      return &PIXEL_FUNCTIONS[i];
+  }
+
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+// Copia os pixels de `src` para `dst` (mesmas dimensões e formato).
+//------------------------------------------------------------------------------
+void copy_surface(SDL_Surface *src, SDL_Surface *dst)
+{
+  SDL_LockSurface(src);
+  SDL_LockSurface(dst);
+  for (int row = 0; row < src->h; ++row)
+  {
+    SDL_memcpy((Uint8 *)dst->pixels + (size_t)row * dst->pitch,
+      (const Uint8 *)src->pixels + (size_t)row * src->pitch, (size_t)src->w * SDL_BYTESPERPIXEL(src->format));
+  }
+  SDL_UnlockSurface(dst);
+  SDL_UnlockSurface(src);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyFilter_blur(SDL_Surface *src, SDL_Surface *dst, Uint32 filter_size, MyThreadPool *pool)
+{
+  if (!src || !dst || src->w != dst->w || src->h != dst->h || src->format != dst->format)
+  {
+    MY_LOG_ERROR("\t*** Erro: Superfícies inválidas para o blur.");
+    return false;
+  }
+
+  const PixelFunctions *functions = get_pixel_functions(src->format);
+  if (!functions)
+  {
+    MY_LOG_ERROR("\t*** Erro: Blur espera superfícies RGBA32, RGBA64 ou RGBA128_FLOAT (recebeu %s).",
+      SDL_GetPixelFormatName(src->format));
+    return false;
+  }
+
+  if (filter_size == 0)
+  {
+    MY_LOG_ERROR("\t*** Erro: Tamanho do filtro inválido (filter_size == 0).");
+    return false;
+  }
+
+  SDL_LockSurface(src);
+  if (dst != src)
+    SDL_LockSurface(dst);
+
+  BlurJob job = {
+    .srcPixels = (const Uint8 *)src->pixels,
+    .dstPixels = (Uint8 *)dst->pixels,
+    .width = src->w,
+    .height = src->h,
+    .srcPitch = src->pitch,
+    .dstPitch = dst->pitch,
+    .radius = (int)(filter_size >> 1),
+    .average = 1.0f / (filter_size * filter_size),
+    .inverseArea = 1.0 / ((double)filter_size * filter_size),
+    .kernels = MyKernels_get(),
+    .failed = { 0 },
+  };
+
+  // Cada bloco precisa somar as linhas da janela antes da primeira linha do
+  // bloco, então blocos muito pequenos desperdiçariam trabalho.
+  const int grain = SDL_max(BLUR_MIN_ROWS_PER_BLOCK, (int)filter_size);
+
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker arenaMarker = MyArena_get_marker(arena);
+  bool ok = true;
+
+  if (src != dst)
+    MyThreadPool_parallel_for(pool, src->h, grain, functions->blurRows, &job);
+  else if ((ok = RowBands_init(&job.bands, arena, src, dst, job.radius, grain, pool)))
+    MyThreadPool_parallel_for(pool, job.bands.count, 1, functions->blurInPlaceBands, &job);
+
+  if (dst != src)
+    SDL_UnlockSurface(dst);
+  SDL_UnlockSurface(src);
+  MyArena_reset_to_marker(arena, arenaMarker);
+
+  if (!ok || SDL_GetAtomicInt(&job.failed))
+  {
+    MY_LOG_ERROR("\t*** Erro: Memória temporária do filtro indisponível.");
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyFilter_gaussian(SDL_Surface *src, SDL_Surface *dst, float sigma, MyThreadPool *pool)
+{
+  if (!src || !dst || src->w != dst->w || src->h != dst->h || src->format != dst->format || src->w <= 0 || src->h <= 0)
+  {
+    MY_LOG_ERROR("\t*** Erro: Superfícies inválidas para o filtro gaussiano.");
+    return false;
+  }
+
+  const PixelFunctions *functions = get_pixel_functions(src->format);
+  if (!functions)
+  {
+    MY_LOG_ERROR("\t*** Erro: Filtro gaussiano espera superfícies RGBA32, RGBA64 ou RGBA128_FLOAT (recebeu %s).",
+      SDL_GetPixelFormatName(src->format));
+    return false;
+  }
+
+  const int radius = (int)SDL_ceilf(3.0f * sigma);
+  if (!(sigma > 0.0f) || radius > GAUSSIAN_MAX_RADIUS)
+  {
+    MY_LOG_ERROR("\t*** Erro: Sigma do filtro gaussiano inválido (%.2f).", sigma);
+    return false;
+  }
+
+  // Pesos e linhas das costuras ficam na arena da thread que chamou a função.
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker arenaMarker = MyArena_get_marker(arena);
+
+  SDL_LockSurface(src);
+  if (dst != src)
+    SDL_LockSurface(dst);
+
+  GaussianJob job = {
+    .dstPixels = (Uint8 *)dst->pixels,
+    .width = src->w,
+    .dstPitch = dst->pitch,
+    .kernels = MyKernels_get(),
+    .failed = { 0 },
+  };
+
+  // Cada faixa lê 2 * radius linhas além das suas, como os blocos do blur.
+  const int minRowsPerBand = SDL_max(BLUR_MIN_ROWS_PER_BLOCK, 4 * radius);
+  const bool ok = RowBands_init(&job.bands, arena, src, dst, radius, minRowsPerBand, pool)
+    && build_gaussian_weights(arena, sigma, src->w, &job);
+  if (ok)
+    MyThreadPool_parallel_for(pool, job.bands.count, 1, functions->gaussianBands, &job);
+
+  if (dst != src)
+    SDL_UnlockSurface(dst);
+  SDL_UnlockSurface(src);
+  MyArena_reset_to_marker(arena, arenaMarker);
+
+  if (!ok || SDL_GetAtomicInt(&job.failed))
+  {
+    MY_LOG_ERROR("\t*** Erro: Memória temporária do filtro gaussiano indisponível.");
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyFilter_invert(SDL_Surface *src, SDL_Surface *dst, MyThreadPool *pool)
+{
+  if (!src || !dst || src->w != dst->w || src->h != dst->h || src->format != dst->format)
+  {
+    MY_LOG_ERROR("\t*** Erro: Superfícies inválidas para o negativo.");
+    return false;
+  }
+
+  const PixelFunctions *functions = get_pixel_functions(src->format);
+  if (!functions)
+  {
+    MY_LOG_ERROR("\t*** Erro: Negativo espera superfícies RGBA32, RGBA64 ou RGBA128_FLOAT.");
+    return false;
+  }
+
+  SDL_LockSurface(src);
+  if (dst != src)
+    SDL_LockSurface(dst);
+
+  InvertJob job = {
+    .srcPixels = (const Uint8 *)src->pixels,
+    .dstPixels = (Uint8 *)dst->pixels,
+    .width = src->w,
+    .srcPitch = src->pitch,
+    .dstPitch = dst->pitch,
+    .kernels = MyKernels_get(),
+  };
+  MyThreadPool_parallel_for(pool, src->h, SDL_max(1, INVERT_PIXELS_PER_BLOCK / SDL_max(1, src->w)), functions->invertRows, &job);
+
+  if (dst != src)
+    SDL_UnlockSurface(dst);
+  SDL_UnlockSurface(src);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyFilterChain_apply(const MyFilterChain *chain, SDL_Surface *src, SDL_Surface *dst, MyThreadPool *pool)
+{
+  if (!src || !dst)
+    return false;
+
+  if (MyFilterChain_is_empty(chain))
+  {
+    copy_surface(src, dst);
+    return true;
+  }
+
+  if (chain->equalize)
+  {
+    // Sozinha, a equalização grava direto na saída; seguida de blur ou de
+    // bordas, trabalha "in place" em src, que vira a entrada da próxima etapa.
+    SDL_Surface *equalizeOutput = (chain->blurSize > 0 || chain->edges != MY_EDGES_NONE) ? src : dst;
+    MyHistogram histogram;
+    if (!MyHistogram_compute(&histogram, src, pool) || !MyHistogram_equalize(&histogram, src, equalizeOutput, pool))
+      return false;
+  }
+
+  if (chain->edges == MY_EDGES_NONE)
+    return chain->blurSize == 0 || MyFilter_blur(src, dst, chain->blurSize, pool);
+
+  // Com bordas, o blur é feito "in place" em src, que vira a entrada das
+  // bordas.
+  if (chain->blurSize > 0 && !MyFilter_blur(src, src, chain->blurSize, pool))
+    return false;
+
+  const MyEdgeParams params = MyEdges_get_default_params();
+  return MyEdges_apply(src, dst, chain->edges, &params, pool);
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Filtros que operam diretamente em superfícies (sem renderer/textura), para
+// que possam ser executados fora da thread principal (ex. pelo decodificador
+// do modo sequência).
+//
+// O negativo, o filtro de média e o gaussiano aceitam superfícies RGBA32 (8
+// bits por canal), RGBA64 (16 bits) e RGBA128_FLOAT (float), com `src` e `dst`
+// no mesmo formato. Cada formato tem sua própria versão, gerada a partir do
+// mesmo código (filters_typed.h), com somas largas o bastante para o tipo do
+// canal; em RGBA32, as operações de linha são os kernels escolhidos em tempo
+// de execução (kernels.h). A equalização e a detecção de bordas continuam só
+// em RGBA32. Quando `pool` não é NULL, as linhas da imagem são divididas entre
+// as threads do pool.
+//
+// Os filtros de vizinhança (média e gaussiano) também funcionam "in place"
+// (src == dst), sem uma segunda superfície do tamanho da imagem: a imagem é
+// dividida em uma faixa de linhas por thread e cada faixa guarda, em um anel,
+// as linhas originais da janela vertical antes de sobrescrevê-las. As poucas
+// linhas em torno das costuras entre faixas são copiadas antes, então a
+// memória extra é O(threads x largura x tamanho do filtro) e o resultado é
+// idêntico ao do filtro com duas superfícies.
+//------------------------------------------------------------------------------
+#ifndef MY_FILTERS_H
+#define MY_FILTERS_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+#include "parallel.h"
+#include "edges.h"
+
+/**
+ * Operações aplicadas, em ordem, a cada imagem: equalização de histograma
+ * (se `equalize`), filtro de média `blurSize x blurSize` (se `blurSize > 0`)
+ * e detecção de bordas com os parâmetros padrão (se `edges` não for
+ * MY_EDGES_NONE; veja edges.h).
+ */
+typedef struct MyFilterChain MyFilterChain;
+struct MyFilterChain
+{
+  Uint32 blurSize;
+  bool equalize;
+  MyEdgeMode edges;
+};
+
+/**
+ * Filtro de média `filter_size x filter_size` de `src` para `dst` (mesmas
+ * dimensões e formato). Posições fora da imagem contam como intensidade zero e
+ * o alpha da saída é opaco. Em RGBA32 a média é truncada; em RGBA64,
+ * arredondada.
+ *
+ * As somas da janela são mantidas de forma incremental (por coluna, ao descer
+ * uma linha, e por pixel, ao andar uma coluna), então o custo por pixel não
+ * depende de `filter_size`. O resultado é idêntico ao da soma direta de todos
+ * os pixels da janela. `src` e `dst` podem ser a mesma superfície.
+ */
+bool MyFilter_blur(SDL_Surface *src, SDL_Surface *dst, Uint32 filter_size, MyThreadPool *pool);
+
+/**
+ * Filtro gaussiano separável com desvio padrão `sigma` (raio ceil(3 * sigma),
+ * até 128) de `src` para `dst` (mesmas dimensões e formato). Os 4 canais são
+ * filtrados e as posições fora da imagem repetem a borda. `src` e `dst` podem
+ * ser a mesma superfície.
+ */
+bool MyFilter_gaussian(SDL_Surface *src, SDL_Surface *dst, float sigma, MyThreadPool *pool);
+
+/**
+ * Negativo da imagem (R, G e B invertidos em relação ao máximo do canal, 1.0
+ * em float; alpha copiado). `src` e `dst` podem ser a mesma superfície.
+ */
+bool MyFilter_invert(SDL_Surface *src, SDL_Surface *dst, MyThreadPool *pool);
+
+static inline bool MyFilterChain_is_empty(const MyFilterChain *chain)
+{
+  return !chain || (chain->blurSize == 0 && !chain->equalize && chain->edges == MY_EDGES_NONE);
+}
+
+/**
+ * Aplica `chain` em `src` e grava o resultado em `dst`. `src` é usada como
+ * área intermediária e pode ter seu conteúdo alterado.
+ */
+bool MyFilterChain_apply(const MyFilterChain *chain, SDL_Surface *src, SDL_Surface *dst, MyThreadPool *pool);
+
+#endif // MY_FILTERS_H
@@ -0,0 +1,370 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Modelo (template) dos filtros de filters.c para um tipo de canal. Este
+// arquivo não tem include guard: filters.c o inclui uma vez por tipo, depois
+// de definir
+//
+//   MY_PIXEL_SUFFIX    sufixo dos nomes gerados (ex. u16 -> blur_rows_u16)
+//   MY_PIXEL_TYPE      tipo de cada canal (Uint8, Uint16 ou float)
+//   MY_PIXEL_SUM       acumulador das somas do filtro de média, largo o
+//                      bastante para a soma da janela inteira
+//   MY_PIXEL_MAX       valor máximo de um canal (alpha opaco, negativo)
+//   MY_PIXEL_KERNELS   1 para usar os kernels SIMD de kernels.h (só RGBA32)
+//   MY_PIXEL_FROM_FLOAT(x)    converte um resultado em float para um canal
+//   MY_PIXEL_FROM_DOUBLE(x)   idem, para a média (em double)
+//
+// e o próprio arquivo remove essas definições no final. As operações de linha
+// (somas, média, negativo e os dois passos da gaussiana) são as únicas partes
+// que mudam de um tipo para outro; as funções de linhas e de faixas que as
+// usam são as mesmas para todos os tipos.
+//------------------------------------------------------------------------------
+#define MY_PIXEL_CONCAT_(name, suffix) name##_##suffix
+#define MY_PIXEL_CONCAT(name, suffix) MY_PIXEL_CONCAT_(name, suffix)
+#define MY_PIXEL_NAME(name) MY_PIXEL_CONCAT(name, MY_PIXEL_SUFFIX)
+
+//------------------------------------------------------------------------------
+// Operações de linha
+//------------------------------------------------------------------------------
+#if MY_PIXEL_KERNELS
+
+static inline void MY_PIXEL_NAME(add_row)(const MyKernels *kernels, MY_PIXEL_SUM *sums, const MY_PIXEL_TYPE *src, size_t count)
+{
+  kernels->add_u8_to_u32(sums, src, count);
+}
+
+static inline void MY_PIXEL_NAME(sub_row)(const MyKernels *kernels, MY_PIXEL_SUM *sums, const MY_PIXEL_TYPE *src, size_t count)
+{
+  kernels->sub_u8_from_u32(sums, src, count);
+}
+
+static inline void MY_PIXEL_NAME(box_sum)(const MyKernels *kernels, const MY_PIXEL_SUM *src, MY_PIXEL_SUM *dst, int width, int radius)
+{
+  kernels->box_sum_rgba_u32(src, dst, width, radius);
+}
+
+static inline void MY_PIXEL_NAME(average)(const MyKernels *kernels, const MY_PIXEL_SUM *sums, MY_PIXEL_TYPE *dst, int width,
+  const BlurJob *job)
+{
+  kernels->average_to_rgba32(sums, dst, (size_t)width, job->average);
+}
+
+static inline void MY_PIXEL_NAME(invert)(const MyKernels *kernels, const MY_PIXEL_TYPE *src, MY_PIXEL_TYPE *dst, int width)
+{
+  kernels->invert_rgba32(src, dst, (size_t)width);
+}
+
+static inline void MY_PIXEL_NAME(vertical)(const MyKernels *kernels, const Uint8 *src, size_t pitch, const float *weights, int taps,
+  float *dst, size_t count)
+{
+  kernels->resample_vertical_u8(src, pitch, weights, taps, dst, count);
+}
+
+static inline void MY_PIXEL_NAME(horizontal)(const MyKernels *kernels, const float *src, MY_PIXEL_TYPE *dst, int width,
+  const int *first, const float *weights, int taps)
+{
+  kernels->resample_horizontal_rgba32(src, dst, width, first, weights, taps);
+}
+
+#else
+
+static inline void MY_PIXEL_NAME(add_row)(const MyKernels *kernels, MY_PIXEL_SUM *sums, const MY_PIXEL_TYPE *src, size_t count)
+{
+  (void)kernels;
+  for (size_t i = 0; i < count; ++i)
+    sums[i] += src[i];
+}
+
+static inline void MY_PIXEL_NAME(sub_row)(const MyKernels *kernels, MY_PIXEL_SUM *sums, const MY_PIXEL_TYPE *src, size_t count)
+{
+  (void)kernels;
+  for (size_t i = 0; i < count; ++i)
+    sums[i] -= src[i];
+}
+
+// Mesma janela deslizante de MyKernels_box_sum_rgba_u32_scalar().
+static inline void MY_PIXEL_NAME(box_sum)(const MyKernels *kernels, const MY_PIXEL_SUM *src, MY_PIXEL_SUM *dst, int width, int radius)
+{
+  (void)kernels;
+  MY_PIXEL_SUM sum[4] = { 0, 0, 0, 0 };
+  for (int x = 0; x <= radius && x < width; ++x)
+  {
+    for (int c = 0; c < 4; ++c)
+      sum[c] += src[x * 4 + c];
+  }
+
+  for (int x = 0; x < width; ++x)
+  {
+    const int in = x + radius + 1;
+    const int out = x - radius;
+    for (int c = 0; c < 4; ++c)
+    {
+      dst[x * 4 + c] = sum[c];
+      if (in < width)
+        sum[c] += src[in * 4 + c];
+      if (out >= 0)
+        sum[c] -= src[out * 4 + c];
+    }
+  }
+}
+
+static inline void MY_PIXEL_NAME(average)(const MyKernels *kernels, const MY_PIXEL_SUM *sums, MY_PIXEL_TYPE *dst, int width,
+  const BlurJob *job)
+{
+  (void)kernels;
+  for (int x = 0; x < width; ++x, sums += 4, dst += 4)
+  {
+    for (int c = 0; c < 3; ++c)
+      dst[c] = MY_PIXEL_FROM_DOUBLE(sums[c] * job->inverseArea);
+    dst[3] = MY_PIXEL_MAX;
+  }
+}
+
+static inline void MY_PIXEL_NAME(invert)(const MyKernels *kernels, const MY_PIXEL_TYPE *src, MY_PIXEL_TYPE *dst, int width)
+{
+  (void)kernels;
+  for (int x = 0; x < width; ++x, src += 4, dst += 4)
+  {
+    dst[0] = MY_PIXEL_MAX - src[0];
+    dst[1] = MY_PIXEL_MAX - src[1];
+    dst[2] = MY_PIXEL_MAX - src[2];
+    dst[3] = src[3];
+  }
+}
+
+// Mesmas operações de MyKernels_resample_vertical_u8_scalar(); `count` é o
+// número de canais da linha.
+static inline void MY_PIXEL_NAME(vertical)(const MyKernels *kernels, const Uint8 *src, size_t pitch, const float *weights, int taps,
+  float *dst, size_t count)
+{
+  (void)kernels;
+  for (size_t i = 0; i < count; ++i)
+    dst[i] = 0.0f;
+
+  for (int k = 0; k < taps; ++k, src += pitch)
+  {
+    const MY_PIXEL_TYPE *row = (const MY_PIXEL_TYPE *)src;
+    const float w = weights[k];
+    for (size_t i = 0; i < count; ++i)
+      dst[i] = dst[i] + w * row[i];
+  }
+}
+
+static inline void MY_PIXEL_NAME(horizontal)(const MyKernels *kernels, const float *src, MY_PIXEL_TYPE *dst, int width,
+  const int *first, const float *weights, int taps)
+{
+  (void)kernels;
+  for (int x = 0; x < width; ++x, dst += 4, weights += taps)
+  {
+    const float *s = src + (size_t)first[x] * 4;
+    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int k = 0; k < taps; ++k, s += 4)
+    {
+      for (int c = 0; c < 4; ++c)
+        sum[c] = sum[c] + weights[k] * s[c];
+    }
+
+    for (int c = 0; c < 4; ++c)
+      dst[c] = MY_PIXEL_FROM_FLOAT(sum[c]);
+  }
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+// Filtro de média com duas superfícies: as somas da janela vertical de cada
+// bloco de linhas descem pela imagem (veja MyFilter_blur()).
+//------------------------------------------------------------------------------
+static void MY_PIXEL_NAME(blur_rows)(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+  BlurJob *job = (BlurJob *)userdata;
+  const MyKernels *kernels = job->kernels;
+  const size_t rowValues = (size_t)job->width * 4;
+
+  // Somas por coluna (janela vertical) e por pixel (janela completa), na
+  // arena da thread que executa o bloco.
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker arenaMarker = MyArena_get_marker(arena);
+  MY_PIXEL_SUM *columnSums = MyArena_push(arena, rowValues * sizeof(MY_PIXEL_SUM), MY_IMAGE_POOL_ALIGNMENT);
+  MY_PIXEL_SUM *windowSums = MyArena_push(arena, rowValues * sizeof(MY_PIXEL_SUM), MY_IMAGE_POOL_ALIGNMENT);
+  if (!columnSums || !windowSums)
+  {
+    SDL_SetAtomicInt(&job->failed, 1);
+    MyArena_reset_to_marker(arena, arenaMarker);
+    return;
+  }
+
+  // Janela vertical da primeira linha do bloco. Linhas fora da imagem contam
+  // como zero, então simplesmente não entram na soma.
+  SDL_memset(columnSums, 0, rowValues * sizeof(MY_PIXEL_SUM));
+  const int first = SDL_max(0, begin - job->radius);
+  const int last = SDL_min(job->height - 1, begin + job->radius);
+  for (int row = first; row <= last; ++row)
+    MY_PIXEL_NAME(add_row)(kernels, columnSums, (const MY_PIXEL_TYPE *)(job->srcPixels + (size_t)row * job->srcPitch), rowValues);
+
+  for (int row = begin; row < end; ++row)
+  {
+    MY_PIXEL_NAME(box_sum)(kernels, columnSums, windowSums, job->width, job->radius);
+    MY_PIXEL_NAME(average)(kernels, windowSums, (MY_PIXEL_TYPE *)(job->dstPixels + (size_t)row * job->dstPitch), job->width, job);
+
+    // Desce a janela vertical uma linha: sai a linha de cima, entra a de baixo.
+    const int rowOut = row - job->radius;
+    const int rowIn = row + job->radius + 1;
+    if (rowOut >= 0)
+      MY_PIXEL_NAME(sub_row)(kernels, columnSums, (const MY_PIXEL_TYPE *)(job->srcPixels + (size_t)rowOut * job->srcPitch), rowValues);
+    if (rowIn < job->height)
+      MY_PIXEL_NAME(add_row)(kernels, columnSums, (const MY_PIXEL_TYPE *)(job->srcPixels + (size_t)rowIn * job->srcPitch), rowValues);
+  }
+
+  MyArena_reset_to_marker(arena, arenaMarker);
+}
+
+//------------------------------------------------------------------------------
+// Mesmas somas de blur_rows(), mas a faixa grava sobre as próprias linhas de
+// entrada: as linhas da janela vertical são copiadas para um anel de
+// 2 * radius + 1 linhas originais antes de serem sobrescritas.
+//------------------------------------------------------------------------------
+static void MY_PIXEL_NAME(blur_in_place_bands)(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+  BlurJob *job = (BlurJob *)userdata;
+  const MyKernels *kernels = job->kernels;
+  const RowBands *bands = &job->bands;
+  const size_t rowValues = (size_t)job->width * 4;
+  const int ringRows = 2 * job->radius + 1;
+
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker arenaMarker = MyArena_get_marker(arena);
+  MY_PIXEL_SUM *columnSums = MyArena_push(arena, rowValues * sizeof(MY_PIXEL_SUM), MY_IMAGE_POOL_ALIGNMENT);
+  MY_PIXEL_SUM *windowSums = MyArena_push(arena, rowValues * sizeof(MY_PIXEL_SUM), MY_IMAGE_POOL_ALIGNMENT);
+  MY_PIXEL_TYPE *ring = MyArena_push(arena, (size_t)ringRows * rowValues * sizeof(MY_PIXEL_TYPE), MY_IMAGE_POOL_ALIGNMENT);
+  if (!columnSums || !windowSums || !ring)
+  {
+    SDL_SetAtomicInt(&job->failed, 1);
+    MyArena_reset_to_marker(arena, arenaMarker);
+    return;
+  }
+
+  for (int band = begin; band < end; ++band)
+  {
+    const int rowBegin = band * bands->rowsPerBand;
+    const int rowEnd = SDL_min(job->height, rowBegin + bands->rowsPerBand);
+
+    SDL_memset(columnSums, 0, rowValues * sizeof(MY_PIXEL_SUM));
+    const int first = SDL_max(0, rowBegin - job->radius);
+    const int last = SDL_min(job->height - 1, rowBegin + job->radius);
+    for (int row = first; row <= last; ++row)
+    {
+      MY_PIXEL_TYPE *slot = ring + (size_t)ring_slot(row, ringRows) * rowValues;
+      SDL_memcpy(slot, RowBands_get_source_row(bands, band, row), bands->rowBytes);
+      MY_PIXEL_NAME(add_row)(kernels, columnSums, slot, rowValues);
+    }
+
+    for (int row = rowBegin; row < rowEnd; ++row)
+    {
+      MY_PIXEL_NAME(box_sum)(kernels, columnSums, windowSums, job->width, job->radius);
+      MY_PIXEL_NAME(average)(kernels, windowSums, (MY_PIXEL_TYPE *)(job->dstPixels + (size_t)row * job->dstPitch), job->width, job);
+
+      // A linha que sai e a que entra ocupam a mesma posição do anel. Depois
+      // da última linha da faixa, a janela não precisa mais descer.
+      const int rowOut = row - job->radius;
+      const int rowIn = row + job->radius + 1;
+      if (row + 1 == rowEnd)
+        break;
+      if (rowOut >= 0)
+        MY_PIXEL_NAME(sub_row)(kernels, columnSums, ring + (size_t)ring_slot(rowOut, ringRows) * rowValues, rowValues);
+      if (rowIn < job->height)
+      {
+        MY_PIXEL_TYPE *slot = ring + (size_t)ring_slot(rowIn, ringRows) * rowValues;
+        SDL_memcpy(slot, RowBands_get_source_row(bands, band, rowIn), bands->rowBytes);
+        MY_PIXEL_NAME(add_row)(kernels, columnSums, slot, rowValues);
+      }
+    }
+  }
+
+  MyArena_reset_to_marker(arena, arenaMarker);
+}
+
+//------------------------------------------------------------------------------
+// Cada faixa mantém um anel com as `taps` linhas originais da janela vertical
+// (as linhas fora da imagem repetem a borda), então pode gravar sobre as
+// próprias linhas de entrada.
+//------------------------------------------------------------------------------
+static void MY_PIXEL_NAME(gaussian_bands)(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+  GaussianJob *job = (GaussianJob *)userdata;
+  const MyKernels *kernels = job->kernels;
+  const RowBands *bands = &job->bands;
+  const int radius = bands->radius;
+  const int taps = job->taps;
+  const size_t rowValues = (size_t)job->width * 4;
+  const size_t rowBytes = bands->rowBytes;
+
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker arenaMarker = MyArena_get_marker(arena);
+  Uint8 *ring = MyArena_push(arena, (size_t)taps * rowBytes, MY_IMAGE_POOL_ALIGNMENT);
+  float *row = MyArena_push(arena, rowValues * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+  if (!ring || !row)
+  {
+    SDL_SetAtomicInt(&job->failed, 1);
+    MyArena_reset_to_marker(arena, arenaMarker);
+    return;
+  }
+
+  for (int band = begin; band < end; ++band)
+  {
+    const int rowBegin = band * bands->rowsPerBand;
+    const int rowEnd = SDL_min(bands->height, rowBegin + bands->rowsPerBand);
+
+    // A janela inicial tem as linhas [rowBegin - radius, rowBegin + radius);
+    // a cada linha de saída y, entra a linha y + radius, na posição do anel
+    // da linha que saiu.
+    for (int y = rowBegin - radius; y < rowBegin + radius; ++y)
+    {
+      SDL_memcpy(ring + (size_t)ring_slot(y, taps) * rowBytes,
+        RowBands_get_source_row(bands, band, SDL_clamp(y, 0, bands->height - 1)), rowBytes);
+    }
+
+    for (int y = rowBegin; y < rowEnd; ++y)
+    {
+      SDL_memcpy(ring + (size_t)ring_slot(y + radius, taps) * rowBytes,
+        RowBands_get_source_row(bands, band, SDL_min(y + radius, bands->height - 1)), rowBytes);
+
+      const float *weights = job->verticalWeights + (size_t)ring_slot(y - radius, taps) * taps;
+      MY_PIXEL_NAME(vertical)(kernels, ring, rowBytes, weights, taps, row, rowValues);
+      MY_PIXEL_NAME(horizontal)(kernels, row, (MY_PIXEL_TYPE *)(job->dstPixels + (size_t)y * job->dstPitch), job->width,
+        job->horizontalFirst, job->horizontalWeights, job->horizontalTaps);
+    }
+  }
+
+  MyArena_reset_to_marker(arena, arenaMarker);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void MY_PIXEL_NAME(invert_rows)(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+  InvertJob *job = (InvertJob *)userdata;
+
+  for (int row = begin; row < end; ++row)
+  {
+    MY_PIXEL_NAME(invert)(job->kernels, (const MY_PIXEL_TYPE *)(job->srcPixels + (size_t)row * job->srcPitch),
+      (MY_PIXEL_TYPE *)(job->dstPixels + (size_t)row * job->dstPitch), job->width);
+  }
+}
+
+#undef MY_PIXEL_NAME
+#undef MY_PIXEL_CONCAT
+#undef MY_PIXEL_CONCAT_
+#undef MY_PIXEL_SUFFIX
+#undef MY_PIXEL_TYPE
+#undef MY_PIXEL_SUM
+#undef MY_PIXEL_MAX
+#undef MY_PIXEL_KERNELS
+#undef MY_PIXEL_FROM_FLOAT
+#undef MY_PIXEL_FROM_DOUBLE
@@ -0,0 +1,308 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "frame_scheduler.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static bool is_input_event(Uint32 type);
+static bool is_tick_due(const MyFrameScheduler *scheduler, Uint64 nowNS);
+static bool has_pending_frame(const MyFrameScheduler *scheduler, Uint64 nowNS);
+
+/**
+ * Retorna o próximo prazo (SDL_GetTicksNS()) ou 0 se não há prazo.
+ */
+static Uint64 get_next_deadline(const MyFrameScheduler *scheduler);
+
+static void update_measurement_window(MyFrameScheduler *scheduler, Uint64 nowNS);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool is_input_event(Uint32 type)
+{
+  switch (type)
+  {
+  case SDL_EVENT_KEY_DOWN:
+  case SDL_EVENT_KEY_UP:
+  case SDL_EVENT_MOUSE_MOTION:
+  case SDL_EVENT_MOUSE_BUTTON_DOWN:
+  case SDL_EVENT_MOUSE_BUTTON_UP:
+  case SDL_EVENT_MOUSE_WHEEL:
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool is_tick_due(const MyFrameScheduler *scheduler, Uint64 nowNS)
+{
+  if (!scheduler->animating)
+    return false;
+
+  // Com vsync (ou sem intervalo definido), a própria apresentação do quadro
+  // dita o ritmo: sempre há um quadro a desenhar.
+  if (scheduler->vsync || scheduler->frameTimeNS == 0)
+    return true;
+
+  return nowNS >= scheduler->nextTickNS;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool has_pending_frame(const MyFrameScheduler *scheduler, Uint64 nowNS)
+{
+  return scheduler->dirty
+    || is_tick_due(scheduler, nowNS)
+    || (scheduler->wakeupNS != 0 && nowNS >= scheduler->wakeupNS);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+Uint64 get_next_deadline(const MyFrameScheduler *scheduler)
+{
+  Uint64 deadlineNS = 0;
+
+  if (scheduler->animating && !scheduler->vsync && scheduler->frameTimeNS > 0)
+    deadlineNS = scheduler->nextTickNS;
+
+  if (scheduler->wakeupNS != 0 && (deadlineNS == 0 || scheduler->wakeupNS < deadlineNS))
+    deadlineNS = scheduler->wakeupNS;
+
+  return deadlineNS;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void update_measurement_window(MyFrameScheduler *scheduler, Uint64 nowNS)
+{
+  const Uint64 elapsedNS = nowNS - scheduler->windowStartNS;
+  if (elapsedNS < SDL_NS_PER_SECOND)
+    return;
+
+  const double waitRatio = (double)scheduler->windowWaitNS / (double)elapsedNS;
+  scheduler->stats.busyPercent = waitRatio >= 1.0 ? 0.0 : 100.0 * (1.0 - waitRatio);
+  scheduler->stats.framesPerSecond = (double)scheduler->windowFrames * (double)SDL_NS_PER_SECOND / (double)elapsedNS;
+
+  scheduler->windowStartNS = nowNS;
+  scheduler->windowWaitNS = 0;
+  scheduler->windowFrames = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameScheduler_initialize(MyFrameScheduler *scheduler, Uint64 frameTimeNS, bool vsync)
+{
+  if (!scheduler)
+    return;
+
+  SDL_zerop(scheduler);
+  scheduler->frameTimeNS = frameTimeNS;
+  scheduler->vsync = vsync;
+  scheduler->animating = frameTimeNS > 0 || vsync;
+  scheduler->dirty = true;
+
+  const Uint64 nowNS = SDL_GetTicksNS();
+  scheduler->nextTickNS = nowNS;
+  scheduler->windowStartNS = nowNS;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameScheduler_set_animating(MyFrameScheduler *scheduler, bool animating)
+{
+  if (!scheduler || scheduler->animating == animating)
+    return;
+
+  scheduler->animating = animating;
+  scheduler->nextTickNS = SDL_GetTicksNS();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameScheduler_invalidate(MyFrameScheduler *scheduler)
+{
+  if (!scheduler)
+    return;
+
+  scheduler->dirty = true;
+
+  // Mede a latência a partir da entrada mais antiga que alterou o conteúdo
+  // e que ainda não foi exibida.
+  if (scheduler->currentInputNS != 0 && scheduler->pendingInputNS == 0)
+    scheduler->pendingInputNS = scheduler->currentInputNS;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameScheduler_request_wakeup(MyFrameScheduler *scheduler, Uint64 deadlineNS)
+{
+  if (!scheduler)
+    return;
+
+  if (scheduler->wakeupNS == 0 || deadlineNS < scheduler->wakeupNS)
+    scheduler->wakeupNS = deadlineNS;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyFrameScheduler_wait_event(MyFrameScheduler *scheduler, SDL_Event *event)
+{
+  if (!scheduler || !event)
+    return false;
+
+  const Uint64 nowNS = SDL_GetTicksNS();
+  bool hasEvent = false;
+
+  if (has_pending_frame(scheduler, nowNS))
+  {
+    // Há um quadro a desenhar: apenas esvaziamos a fila de eventos.
+    hasEvent = SDL_PollEvent(event);
+  }
+  else
+  {
+    // Nada a fazer até o próximo prazo (ou, sem prazo, até o próximo evento).
+    Sint32 timeoutMS = -1;
+    const Uint64 deadlineNS = get_next_deadline(scheduler);
+    if (deadlineNS != 0)
+    {
+      // Arredonda para cima, para não acordar antes do prazo.
+      const Uint64 remainingMS = (deadlineNS - nowNS + SDL_NS_PER_MS - 1) / SDL_NS_PER_MS;
+      timeoutMS = remainingMS > SDL_MAX_SINT32 ? SDL_MAX_SINT32 : (Sint32)remainingMS;
+    }
+
+    hasEvent = SDL_WaitEventTimeout(event, timeoutMS);
+
+    const Uint64 wokeNS = SDL_GetTicksNS();
+    scheduler->windowWaitNS += wokeNS - nowNS;
+    ++scheduler->stats.wakeupCount;
+    update_measurement_window(scheduler, wokeNS);
+  }
+
+  if (!hasEvent)
+  {
+    scheduler->currentInputNS = 0;
+    return false;
+  }
+
+  if (is_input_event(event->type))
+    scheduler->currentInputNS = event->common.timestamp != 0 ? event->common.timestamp : SDL_GetTicksNS();
+  else
+    scheduler->currentInputNS = 0;
+
+  // Eventos que exigem redesenhar a janela, independente do programa.
+  switch (event->type)
+  {
+  case SDL_EVENT_WINDOW_EXPOSED:
+  case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+  case SDL_EVENT_WINDOW_RESTORED:
+    scheduler->dirty = true;
+    break;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+Uint32 MyFrameScheduler_begin_frame(MyFrameScheduler *scheduler)
+{
+  if (!scheduler)
+    return MY_FRAME_NONE;
+
+  const Uint64 nowNS = SDL_GetTicksNS();
+  Uint32 reasons = MY_FRAME_NONE;
+
+  if (scheduler->dirty)
+  {
+    reasons |= MY_FRAME_DIRTY;
+    scheduler->dirty = false;
+  }
+
+  if (is_tick_due(scheduler, nowNS))
+  {
+    reasons |= MY_FRAME_TICK;
+
+    // Próximo quadro em um múltiplo do intervalo (sem acumular atraso); se o
+    // programa ficou para trás, recomeça a partir de agora ao invés de tentar
+    // recuperar os quadros perdidos.
+    scheduler->nextTickNS += scheduler->frameTimeNS;
+    if (scheduler->nextTickNS <= nowNS)
+      scheduler->nextTickNS = nowNS + scheduler->frameTimeNS;
+  }
+
+  if (scheduler->wakeupNS != 0 && nowNS >= scheduler->wakeupNS)
+  {
+    reasons |= MY_FRAME_WAKEUP;
+    scheduler->wakeupNS = 0;
+  }
+
+  return reasons;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameScheduler_end_frame(MyFrameScheduler *scheduler)
+{
+  if (!scheduler)
+    return;
+
+  const Uint64 nowNS = SDL_GetTicksNS();
+  MyFrameSchedulerStats *stats = &scheduler->stats;
+
+  ++stats->frameCount;
+  ++scheduler->windowFrames;
+
+  if (scheduler->pendingInputNS != 0 && nowNS >= scheduler->pendingInputNS)
+  {
+    const double latencyMS = (double)(nowNS - scheduler->pendingInputNS) / (double)SDL_NS_PER_MS;
+
+    stats->inputLatencyMS = latencyMS;
+    if (latencyMS > stats->maxInputLatencyMS)
+      stats->maxInputLatencyMS = latencyMS;
+
+    ++stats->inputLatencySamples;
+    stats->averageInputLatencyMS += (latencyMS - stats->averageInputLatencyMS) / (double)stats->inputLatencySamples;
+  }
+  scheduler->pendingInputNS = 0;
+
+  update_measurement_window(scheduler, nowNS);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyFrameScheduler_log_stats(const MyFrameScheduler *scheduler)
+{
+  if (!scheduler)
+    return;
+
+  const MyFrameSchedulerStats *stats = &scheduler->stats;
+
+  MY_LOG_INFO("\tMyFrameScheduler: %llu quadros, %llu despertares | %.1f fps | thread principal ocupada %.1f%% (ociosa %.1f%%)",
+    (unsigned long long)stats->frameCount, (unsigned long long)stats->wakeupCount,
+    stats->framesPerSecond, stats->busyPercent, 100.0 - stats->busyPercent);
+
+  MY_LOG_INFO("\tLatência entrada -> apresentação: última %.2f ms | média %.2f ms | máx. %.2f ms (%llu amostras)",
+    stats->inputLatencyMS, stats->averageInputLatencyMS, stats->maxInputLatencyMS,
+    (unsigned long long)stats->inputLatencySamples);
+}
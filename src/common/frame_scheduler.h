@@ -0,0 +1,131 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Agendador de quadros orientado a eventos, compartilhado pelos exemplos.
+//
+// Ao invés de consultar eventos sem parar (SDL_PollEvent() em um laço, que
+// mantém um núcleo da CPU em 100%) ou dormir um tempo fixo (SDL_Delay(), que
+// atrasa a resposta à entrada), o programa bloqueia em SDL_WaitEventTimeout()
+// até que:
+// - chegue um evento; ou
+// - chegue a hora do próximo quadro de uma animação; ou
+// - chegue a hora pedida com MyFrameScheduler_request_wakeup().
+//
+// Se nada estiver "sujo" (invalidado) e não houver animação, a espera não
+// tem prazo e o programa não consome CPU enquanto está parado.
+//
+// Uso típico:
+//
+//   while (isRunning)
+//   {
+//     while (isRunning && MyFrameScheduler_wait_event(&scheduler, &event))
+//     {
+//       ... trata o evento, chamando MyFrameScheduler_invalidate() se algo
+//       mudou na tela ...
+//     }
+//
+//     Uint32 reasons = MyFrameScheduler_begin_frame(&scheduler);
+//     if (reasons & MY_FRAME_TICK) ... avança a animação ...
+//     if (reasons) { render(); MyFrameScheduler_end_frame(&scheduler); }
+//   }
+//
+// Métricas: latência entre o primeiro evento de entrada (teclado/mouse) ainda
+// não exibido e a apresentação do quadro seguinte, quadros por segundo e
+// fração do tempo em que a thread principal ficou ocupada (o restante é
+// tempo ocioso, bloqueado à espera de eventos).
+//------------------------------------------------------------------------------
+#ifndef MY_FRAME_SCHEDULER_H
+#define MY_FRAME_SCHEDULER_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+
+typedef enum MyFrameReason
+{
+  MY_FRAME_NONE = 0,
+  MY_FRAME_DIRTY = 1 << 0,   // Conteúdo invalidado (ex. tecla, exposição).
+  MY_FRAME_TICK = 1 << 1,    // Hora do próximo quadro da animação.
+  MY_FRAME_WAKEUP = 1 << 2,  // Hora pedida com request_wakeup().
+} MyFrameReason;
+
+typedef struct MyFrameSchedulerStats MyFrameSchedulerStats;
+struct MyFrameSchedulerStats
+{
+  Uint64 frameCount;
+  Uint64 wakeupCount;
+  double framesPerSecond;
+  double busyPercent;
+  double inputLatencyMS;
+  double maxInputLatencyMS;
+  double averageInputLatencyMS;
+  Uint64 inputLatencySamples;
+};
+
+typedef struct MyFrameScheduler MyFrameScheduler;
+struct MyFrameScheduler
+{
+  Uint64 frameTimeNS;
+  bool vsync;
+  bool animating;
+  bool dirty;
+  Uint64 nextTickNS;
+  Uint64 wakeupNS;
+
+  // Instante do evento de entrada sendo tratado (0 se não for entrada) e da
+  // entrada mais antiga que invalidou o conteúdo ainda não apresentado.
+  Uint64 currentInputNS;
+  Uint64 pendingInputNS;
+
+  // Janela de medição (atualizada a cada segundo).
+  Uint64 windowStartNS;
+  Uint64 windowWaitNS;
+  Uint64 windowFrames;
+
+  MyFrameSchedulerStats stats;
+};
+
+/**
+ * `frameTimeNS`: intervalo entre quadros de conteúdo animado (ex.
+ * SDL_NS_PER_SECOND / 60). Use 0 para conteúdo estático, que só é redesenhado
+ * quando invalidado.
+ * `vsync`: indica que SDL_RenderPresent()/SDL_GL_SwapWindow() já bloqueiam
+ * até o vsync; nesse caso, um conteúdo animado é redesenhado a cada volta do
+ * laço e o ritmo é dado pelo vsync.
+ */
+void MyFrameScheduler_initialize(MyFrameScheduler *scheduler, Uint64 frameTimeNS, bool vsync);
+
+void MyFrameScheduler_set_animating(MyFrameScheduler *scheduler, bool animating);
+
+/**
+ * Marca o conteúdo como "sujo": o próximo begin_frame() pedirá um quadro.
+ */
+void MyFrameScheduler_invalidate(MyFrameScheduler *scheduler);
+
+/**
+ * Pede para acordar (no máximo) no instante `deadlineNS` (SDL_GetTicksNS()).
+ */
+void MyFrameScheduler_request_wakeup(MyFrameScheduler *scheduler, Uint64 deadlineNS);
+
+/**
+ * Retorna true e preenche `event` enquanto houver eventos. Se não houver
+ * quadro pendente, bloqueia até o próximo evento ou prazo; retorna false
+ * quando é hora de chamar begin_frame().
+ */
+bool MyFrameScheduler_wait_event(MyFrameScheduler *scheduler, SDL_Event *event);
+
+/**
+ * Retorna os motivos (MyFrameReason) para desenhar um quadro agora, ou
+ * MY_FRAME_NONE se não há nada a fazer.
+ */
+Uint32 MyFrameScheduler_begin_frame(MyFrameScheduler *scheduler);
+
+/**
+ * Deve ser chamada logo após apresentar o quadro (SDL_RenderPresent() ou
+ * SDL_GL_SwapWindow()). Atualiza as métricas e agenda o próximo quadro.
+ */
+void MyFrameScheduler_end_frame(MyFrameScheduler *scheduler);
+
+void MyFrameScheduler_log_stats(const MyFrameScheduler *scheduler);
+
+#endif // MY_FRAME_SCHEDULER_H
@@ -0,0 +1,256 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "histogram.h"
+#include "image_pool.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+enum
+{
+  // Quantidade aproximada de pixels por bloco de trabalho do parallel_for.
+  PIXELS_PER_BLOCK = 1 << 16,
+  GAIN_SHIFT = 16,
+};
+
+typedef struct HistogramJob HistogramJob;
+struct HistogramJob
+{
+  const Uint8 *pixels;
+  int width;
+  int pitch;
+  MyHistogram *partials;
+};
+
+typedef struct EqualizeJob EqualizeJob;
+struct EqualizeJob
+{
+  const Uint8 *srcPixels;
+  Uint8 *dstPixels;
+  int width;
+  int srcPitch;
+  int dstPitch;
+  const Uint8 *lut;
+  const Uint32 *gain;       // lut[y] / y em ponto fixo (GAIN_SHIFT bits).
+};
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static int rows_per_block(int width);
+static void histogram_rows(void *userdata, int begin, int end, int threadIndex);
+static void equalize_rows(void *userdata, int begin, int end, int threadIndex);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int rows_per_block(int width)
+{
+  return SDL_max(1, PIXELS_PER_BLOCK / SDL_max(1, width));
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void histogram_rows(void *userdata, int begin, int end, int threadIndex)
+{
+  HistogramJob *job = (HistogramJob *)userdata;
+
+  // Dois conjuntos de bins locais (pixels pares e ímpares).
+  Uint32 local[2][MY_HISTOGRAM_CHANNEL_COUNT][MY_HISTOGRAM_BINS];
+  SDL_memset(local, 0, sizeof(local));
+
+  for (int row = begin; row < end; ++row)
+  {
+    const Uint8 *px = job->pixels + (size_t)row * job->pitch;
+    int col = 0;
+    for (; col + 1 < job->width; col += 2, px += 8)
+    {
+      ++local[0][MY_HISTOGRAM_RED][px[0]];
+      ++local[0][MY_HISTOGRAM_GREEN][px[1]];
+      ++local[0][MY_HISTOGRAM_BLUE][px[2]];
+      ++local[0][MY_HISTOGRAM_LUMA][my_luma(px[0], px[1], px[2])];
+
+      ++local[1][MY_HISTOGRAM_RED][px[4]];
+      ++local[1][MY_HISTOGRAM_GREEN][px[5]];
+      ++local[1][MY_HISTOGRAM_BLUE][px[6]];
+      ++local[1][MY_HISTOGRAM_LUMA][my_luma(px[4], px[5], px[6])];
+    }
+
+    if (col < job->width)
+    {
+      ++local[0][MY_HISTOGRAM_RED][px[0]];
+      ++local[0][MY_HISTOGRAM_GREEN][px[1]];
+      ++local[0][MY_HISTOGRAM_BLUE][px[2]];
+      ++local[0][MY_HISTOGRAM_LUMA][my_luma(px[0], px[1], px[2])];
+    }
+  }
+
+  // Cada thread só escreve no seu próprio parcial.
+  MyHistogram *partial = &job->partials[threadIndex];
+  for (int c = 0; c < MY_HISTOGRAM_CHANNEL_COUNT; ++c)
+  {
+    for (int i = 0; i < MY_HISTOGRAM_BINS; ++i)
+      partial->bins[c][i] += local[0][c][i] + local[1][c][i];
+  }
+  partial->pixelCount += (Uint64)(end - begin) * job->width;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyHistogram_compute(MyHistogram *histogram, SDL_Surface *surface, MyThreadPool *pool)
+{
+  if (!histogram || !surface || !surface->pixels)
+  {
+    MY_LOG_ERROR("\t*** Erro: Histograma/superfície inválidos.");
+    return false;
+  }
+
+  if (surface->format != SDL_PIXELFORMAT_RGBA32)
+  {
+    MY_LOG_ERROR("\t*** Erro: Histograma espera superfície RGBA32 (recebeu %s).", SDL_GetPixelFormatName(surface->format));
+    return false;
+  }
+
+  // Parciais por thread, na arena da thread atual (sem alocação após o
+  // primeiro uso).
+  const int threadCount = MyThreadPool_get_thread_count(pool);
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker marker = MyArena_get_marker(arena);
+  MyHistogram *partials = MyArena_push(arena, threadCount * sizeof(MyHistogram), MY_IMAGE_POOL_ALIGNMENT);
+  if (!partials)
+  {
+    MY_LOG_ERROR("\t*** Erro: Memória temporária do histograma indisponível.");
+    return false;
+  }
+  SDL_memset(partials, 0, threadCount * sizeof(MyHistogram));
+
+  SDL_LockSurface(surface);
+
+  HistogramJob job = {
+    .pixels = (const Uint8 *)surface->pixels,
+    .width = surface->w,
+    .pitch = surface->pitch,
+    .partials = partials,
+  };
+  MyThreadPool_parallel_for(pool, surface->h, rows_per_block(surface->w), histogram_rows, &job);
+
+  SDL_UnlockSurface(surface);
+
+  // Redução dos parciais.
+  SDL_zerop(histogram);
+  for (int t = 0; t < threadCount; ++t)
+  {
+    for (int c = 0; c < MY_HISTOGRAM_CHANNEL_COUNT; ++c)
+    {
+      for (int i = 0; i < MY_HISTOGRAM_BINS; ++i)
+        histogram->bins[c][i] += partials[t].bins[c][i];
+    }
+    histogram->pixelCount += partials[t].pixelCount;
+  }
+
+  MyArena_reset_to_marker(arena, marker);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void equalize_rows(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+  EqualizeJob *job = (EqualizeJob *)userdata;
+
+  for (int row = begin; row < end; ++row)
+  {
+    const Uint8 *src = job->srcPixels + (size_t)row * job->srcPitch;
+    Uint8 *dst = job->dstPixels + (size_t)row * job->dstPitch;
+    for (int col = 0; col < job->width; ++col, src += 4, dst += 4)
+    {
+      // R, G e B são multiplicados por Y'/Y (mesma matiz e saturação).
+      // Pixels pretos (Y = 0) vão para o novo nível de preto.
+      const Uint8 y = my_luma(src[0], src[1], src[2]);
+      if (y == 0)
+      {
+        dst[0] = dst[1] = dst[2] = job->lut[0];
+      }
+      else
+      {
+        const Uint32 gain = job->gain[y];
+        const Uint32 half = 1u << (GAIN_SHIFT - 1);
+        dst[0] = (Uint8)SDL_min((src[0] * gain + half) >> GAIN_SHIFT, 255u);
+        dst[1] = (Uint8)SDL_min((src[1] * gain + half) >> GAIN_SHIFT, 255u);
+        dst[2] = (Uint8)SDL_min((src[2] * gain + half) >> GAIN_SHIFT, 255u);
+      }
+      dst[3] = src[3];
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyHistogram_equalize(const MyHistogram *histogram, SDL_Surface *src, SDL_Surface *dst, MyThreadPool *pool)
+{
+  if (!histogram || !src || !dst || src->w != dst->w || src->h != dst->h)
+  {
+    MY_LOG_ERROR("\t*** Erro: Histograma/superfícies inválidos para equalização.");
+    return false;
+  }
+
+  if (src->format != SDL_PIXELFORMAT_RGBA32 || dst->format != SDL_PIXELFORMAT_RGBA32)
+  {
+    MY_LOG_ERROR("\t*** Erro: Equalização espera superfícies RGBA32.");
+    return false;
+  }
+
+  // LUT a partir da distribuição acumulada (CDF) da luminância:
+  // lut[v] = (cdf[v] - cdfMin) * 255 / (N - cdfMin).
+  const Uint32 *luma = histogram->bins[MY_HISTOGRAM_LUMA];
+  Uint64 cdfMin = 0;
+  for (int i = 0; i < MY_HISTOGRAM_BINS && cdfMin == 0; ++i)
+    cdfMin = luma[i];
+
+  Uint8 lut[MY_HISTOGRAM_BINS];
+  const Uint64 range = histogram->pixelCount - cdfMin;
+  Uint64 cdf = 0;
+  for (int i = 0; i < MY_HISTOGRAM_BINS; ++i)
+  {
+    cdf += luma[i];
+    if (range == 0)
+      lut[i] = (Uint8)i; // Imagem com uma única intensidade: nada a equalizar.
+    else
+      lut[i] = (Uint8)(((cdf > cdfMin ? cdf - cdfMin : 0) * 255 + range / 2) / range);
+  }
+
+  Uint32 gain[MY_HISTOGRAM_BINS] = { 0 };
+  for (int i = 1; i < MY_HISTOGRAM_BINS; ++i)
+    gain[i] = ((Uint32)lut[i] << GAIN_SHIFT) / (Uint32)i;
+
+  SDL_LockSurface(src);
+  if (dst != src)
+    SDL_LockSurface(dst);
+
+  EqualizeJob job = {
+    .srcPixels = (const Uint8 *)src->pixels,
+    .dstPixels = (Uint8 *)dst->pixels,
+    .width = src->w,
+    .srcPitch = src->pitch,
+    .dstPitch = dst->pitch,
+    .lut = lut,
+    .gain = gain,
+  };
+  MyThreadPool_parallel_for(pool, src->h, rows_per_block(src->w), equalize_rows, &job);
+
+  if (dst != src)
+    SDL_UnlockSurface(dst);
+  SDL_UnlockSurface(src);
+
+  return true;
+}
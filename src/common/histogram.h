@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Histogramas (R, G, B e luminância) e equalização global de histograma.
+//
+// O cálculo é paralelo por faixas de linhas: cada thread acumula em bins
+// privados (sem atomics nem false sharing) e a thread principal soma os
+// parciais no final (redução). Dentro de cada thread, os pixels alternam
+// entre dois conjuntos de bins, o que evita que incrementos consecutivos no
+// mesmo bin fiquem esperando um pelo outro (comum em regiões uniformes).
+//
+// As funções assumem superfícies no formato SDL_PIXELFORMAT_RGBA32 (bytes na
+// ordem R, G, B, A), como as produzidas por load_rgba32().
+//------------------------------------------------------------------------------
+#ifndef MY_HISTOGRAM_H
+#define MY_HISTOGRAM_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+#include "parallel.h"
+
+enum histogram_constants
+{
+  MY_HISTOGRAM_BINS = 256,
+};
+
+typedef enum MyHistogramChannel
+{
+  MY_HISTOGRAM_RED,
+  MY_HISTOGRAM_GREEN,
+  MY_HISTOGRAM_BLUE,
+  MY_HISTOGRAM_LUMA,
+  MY_HISTOGRAM_CHANNEL_COUNT
+} MyHistogramChannel;
+
+typedef struct MyHistogram MyHistogram;
+struct MyHistogram
+{
+  Uint32 bins[MY_HISTOGRAM_CHANNEL_COUNT][MY_HISTOGRAM_BINS];
+  Uint64 pixelCount;
+};
+
+/**
+ * Luminância aproximada (BT.601) em ponto fixo: (77R + 150G + 29B) / 256.
+ */
+static inline Uint8 my_luma(Uint8 r, Uint8 g, Uint8 b)
+{
+  return (Uint8)((77u * r + 150u * g + 29u * b) >> 8);
+}
+
+/**
+ * Calcula os histogramas de `surface` em paralelo, usando `pool` (pode ser
+ * NULL para executar apenas na thread atual).
+ */
+bool MyHistogram_compute(MyHistogram *histogram, SDL_Surface *surface, MyThreadPool *pool);
+
+/**
+ * Equalização global da luminância: monta uma tabela (LUT) a partir da
+ * distribuição acumulada da luminância de `histogram` e, em cada pixel de
+ * `src`, multiplica R, G e B por Y'/Y (Y = luminância do pixel, Y' = LUT[Y]),
+ * gravando em `dst` (mesmas dimensões; pode ser a própria `src`). A matiz e a
+ * saturação são mantidas, exceto onde um canal passa de 255 (saturado). O
+ * canal alpha é preservado.
+ */
+bool MyHistogram_equalize(const MyHistogram *histogram, SDL_Surface *src, SDL_Surface *dst, MyThreadPool *pool);
+
+#endif // MY_HISTOGRAM_H
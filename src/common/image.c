@@ -0,0 +1,218 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include <SDL3_image/SDL_image.h>
+#include "image.h"
+#include "resample.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyImage_destroy(MyImage *image)
+{
+  MY_LOG_TRACE(">>> MyImage_destroy()");
+
+  if (!image)
+  {
+    MY_LOG_ERROR("\t*** Erro: Imagem inválida (image == NULL).");
+    MY_LOG_TRACE("<<< MyImage_destroy()");
+    return;
+  }
+
+  if (image->texture)
+  {
+    MY_LOG_DEBUG("\tDestruindo MyImage->texture...");
+    SDL_DestroyTexture(image->texture);
+    image->texture = NULL;
+  }
+
+  if (image->surface)
+  {
+    MY_LOG_DEBUG("\tDestruindo MyImage->surface...");
+    SDL_DestroySurface(image->surface);
+    image->surface = NULL;
+  }
+
+  MY_LOG_DEBUG("\tRedefinindo MyImage->rect...");
+  image->rect.x = image->rect.y = image->rect.w = image->rect.h = 0.0f;
+
+  MY_LOG_TRACE("<<< MyImage_destroy()");
+}
+
+//------------------------------------------------------------------------------
+// 
+//------------------------------------------------------------------------------
+bool MyImage_update_texture_with_surface(MyImage* image, SDL_Renderer *renderer, SDL_Surface *surface)
+{
+  MY_LOG_TRACE(">>> MyImage_update_texture_with_surface()");
+
+  if (!image)
+  {
+    MY_LOG_ERROR("\t*** Erro: Imagem inválida (image == NULL).");
+    MY_LOG_TRACE("<<< MyImage_update_texture_with_surface()");
+    return false;
+  }
+
+  if (!renderer)
+  {
+    MY_LOG_ERROR("\t*** Erro: Renderer inválido (renderer == NULL).");
+    MY_LOG_TRACE("<<< MyImage_update_texture_with_surface()");
+    return false;
+  }
+
+  if (!surface)
+  {
+    MY_LOG_ERROR("\t*** Erro: Superfície inválida (surface == NULL).");
+    MY_LOG_TRACE("<<< MyImage_update_texture_with_surface()");
+    return false;
+  }
+
+  SDL_DestroyTexture(image->texture);
+
+  image->texture = SDL_CreateTextureFromSurface(renderer, surface);
+  if (!image->texture)
+  {
+    MY_LOG_ERROR("\t*** Erro ao criar textura: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< MyImage_update_texture_with_surface()");
+    return false;
+  }
+
+  MY_LOG_DEBUG("\tObtendo dimensões da textura...");
+  SDL_GetTextureSize(image->texture, &image->rect.w, &image->rect.h);
+
+  MY_LOG_TRACE("<<< MyImage_update_texture_with_surface()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyImage_restore_texture(MyImage* image, SDL_Renderer *renderer)
+{
+  MY_LOG_TRACE(">>> MyImage_restore_texture()");
+  
+  if (!MyImage_update_texture_with_surface(image, renderer, image->surface))
+  {
+    MY_LOG_ERROR("\t*** Erro ao restaurar a textura da imagem.");
+    return false;
+  }
+
+  MY_LOG_TRACE("<<< MyImage_restore_texture()");
+  return true;  
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+SDL_Surface *load_surface(const char *filename, SDL_PixelFormat format)
+{
+  MY_LOG_TRACE(">>> load_surface(\"%s\", %s)", filename, SDL_GetPixelFormatName(format));
+
+  if (!filename)
+  {
+    MY_LOG_ERROR("\t*** Erro: Nome do arquivo inválido (filename == NULL).");
+    MY_LOG_TRACE("<<< load_surface(\"%s\", %s)", filename, SDL_GetPixelFormatName(format));
+    return NULL;
+  }
+
+  SDL_Surface *surface = IMG_Load(filename);
+  if (!surface)
+  {
+    MY_LOG_ERROR("\t*** Erro ao carregar a imagem: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< load_surface(\"%s\", %s)", filename, SDL_GetPixelFormatName(format));
+    return NULL;
+  }
+
+  MY_LOG_DEBUG("\tConvertendo superfície de %s para %s...", SDL_GetPixelFormatName(surface->format), SDL_GetPixelFormatName(format));
+  SDL_Surface *converted = SDL_ConvertSurface(surface, format);
+  SDL_DestroySurface(surface);
+  if (!converted)
+    MY_LOG_ERROR("\t*** Erro ao converter superfície: %s", SDL_GetError());
+
+  MY_LOG_TRACE("<<< load_surface(\"%s\", %s)", filename, SDL_GetPixelFormatName(format));
+  return converted;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool load_rgba32(const char *filename, SDL_Renderer *renderer, MyImage *output_image)
+{
+  return load_rgba32_fit(filename, renderer, SDL_MAX_SINT32, SDL_MAX_SINT32, NULL, output_image);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool load_rgba32_fit(const char *filename, SDL_Renderer *renderer, int maxWidth, int maxHeight, MyThreadPool *pool,
+  MyImage *output_image)
+{
+  MY_LOG_TRACE(">>> load_rgba32_fit(\"%s\")", filename);
+
+  if (!filename)
+  {
+    MY_LOG_ERROR("\t*** Erro: Nome do arquivo inválido (filename == NULL).");
+    MY_LOG_TRACE("<<< load_rgba32_fit(\"%s\")", filename);
+    return false;
+  }
+
+  if (!renderer)
+  {
+    MY_LOG_ERROR("\t*** Erro: Renderer inválido (renderer == NULL).");
+    MY_LOG_TRACE("<<< load_rgba32_fit(\"%s\")", filename);
+    return false;
+  }
+
+  if (!output_image)
+  {
+    MY_LOG_ERROR("\t*** Erro: Imagem de saída inválida (output_image == NULL).");
+    MY_LOG_TRACE("<<< load_rgba32_fit(\"%s\")", filename);
+    return false;
+  }
+
+  MyImage_destroy(output_image);
+
+  MY_LOG_DEBUG("\tCarregando imagem \"%s\" em uma superfície RGBA32...", filename);
+  output_image->surface = load_surface(filename, SDL_PIXELFORMAT_RGBA32);
+  if (!output_image->surface)
+  {
+    MY_LOG_TRACE("<<< load_rgba32_fit(\"%s\")", filename);
+    return false;
+  }
+
+  int fitWidth = 0;
+  int fitHeight = 0;
+  MyResample_fit_size(output_image->surface->w, output_image->surface->h, maxWidth, maxHeight, &fitWidth, &fitHeight);
+  if (fitWidth != output_image->surface->w || fitHeight != output_image->surface->h)
+  {
+    MY_LOG_DEBUG("\tReduzindo imagem de (%d, %d) para (%d, %d) (%s)...", output_image->surface->w, output_image->surface->h,
+      fitWidth, fitHeight, MyResample_get_filter_name(MY_RESAMPLE_LANCZOS3));
+
+    SDL_Surface *fitted = SDL_CreateSurface(fitWidth, fitHeight, SDL_PIXELFORMAT_RGBA32);
+    if (!fitted || !MyResample_surface(output_image->surface, fitted, MY_RESAMPLE_LANCZOS3, pool))
+    {
+      MY_LOG_ERROR("\t*** Erro ao reduzir a imagem: %s", SDL_GetError());
+      SDL_DestroySurface(fitted);
+      MY_LOG_TRACE("<<< load_rgba32_fit(\"%s\")", filename);
+      return false;
+    }
+
+    SDL_DestroySurface(output_image->surface);
+    output_image->surface = fitted;
+  }
+
+  MY_LOG_DEBUG("\tCriando textura a partir da superfície...");
+  if (!MyImage_update_texture_with_surface(output_image, renderer, output_image->surface))
+  {
+    MY_LOG_ERROR("\t*** Erro ao criar textura.");
+    MY_LOG_TRACE("<<< load_rgba32_fit(\"%s\")", filename);
+    return false;
+  }
+
+  MY_LOG_TRACE("<<< load_rgba32_fit(\"%s\")", filename);
+  return true;
+}
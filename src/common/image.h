@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Imagem exibida pelos exemplos: superfície (pixels em RGBA32, acessíveis pela
+// CPU) + textura (cópia na GPU, usada pelo renderizador).
+//------------------------------------------------------------------------------
+#ifndef MY_IMAGE_H
+#define MY_IMAGE_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+#include "parallel.h"
+
+typedef struct MyImage MyImage;
+struct MyImage
+{
+  SDL_Surface *surface;
+  SDL_Texture *texture;
+  SDL_FRect rect;
+};
+
+void MyImage_destroy(MyImage *image);
+
+/**
+ * Recria a textura da imagem a partir de `surface` (que pode ser diferente de
+ * MyImage->surface, ex. o resultado de um filtro) e atualiza MyImage->rect.
+ */
+bool MyImage_update_texture_with_surface(MyImage* image, SDL_Renderer *renderer, SDL_Surface *surface);
+
+/**
+ * Recria a textura a partir da superfície original (MyImage->surface).
+ */
+bool MyImage_restore_texture(MyImage* image, SDL_Renderer *renderer);
+
+/**
+ * Carrega a imagem `filename` em uma nova superfície no formato `format`. Com
+ * SDL_PIXELFORMAT_RGBA64 ou SDL_PIXELFORMAT_RGBA128_FLOAT (aceitos pelos
+ * filtros de filters.h), imagens com mais de 8 bits por canal (ex. PNG de 16
+ * bits) mantêm a precisão que o decodificador do SDL_image entregar. Retorna
+ * NULL em caso de erro.
+ */
+SDL_Surface *load_surface(const char *filename, SDL_PixelFormat format);
+
+/**
+ * Carrega a imagem indicada no parâmetro `filename` e a converte para o formato
+ * RGBA32, eliminando dependência do formato original da imagem. A imagem
+ * carregada é armazenada em output_image.
+ * Caso ocorra algum erro no processo, a função retorna false.
+ */
+bool load_rgba32(const char *filename, SDL_Renderer *renderer, MyImage *output_image);
+
+/**
+ * Igual a load_rgba32(), mas imagens maiores do que `maxWidth x maxHeight`
+ * são reduzidas (Lanczos-3, mantendo a proporção; veja resample.h) antes de
+ * criar a textura. MyImage->surface passa a ser a imagem reduzida, ou seja,
+ * filtros e histograma trabalham no tamanho exibido. `pool` pode ser NULL.
+ */
+bool load_rgba32_fit(const char *filename, SDL_Renderer *renderer, int maxWidth, int maxHeight, MyThreadPool *pool,
+  MyImage *output_image);
+
+#endif // MY_IMAGE_H
@@ -0,0 +1,431 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "image_pool.h"
+#include "log.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+//------------------------------------------------------------------------------
+// Globals (argh!)
+//------------------------------------------------------------------------------
+static SDL_TLSID g_arenaTLS;
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static size_t align_up(size_t value, size_t alignment);
+static MyArenaBlock *MyArenaBlock_create(size_t capacity);
+static void MyArena_destroy_thread_local(void *arena);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t align_up(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyImagePool_initialize(MyImagePool *pool)
+{
+  MY_LOG_TRACE(">>> MyImagePool_initialize()");
+
+  if (!pool)
+  {
+    MY_LOG_ERROR("\t*** Erro: Pool inválido (pool == NULL).");
+    MY_LOG_TRACE("<<< MyImagePool_initialize()");
+    return false;
+  }
+
+  SDL_zerop(pool);
+
+  pool->mutex = SDL_CreateMutex();
+  if (!pool->mutex)
+  {
+    MY_LOG_ERROR("\t*** Erro ao criar mutex do pool: %s", SDL_GetError());
+    MY_LOG_TRACE("<<< MyImagePool_initialize()");
+    return false;
+  }
+
+  MY_LOG_TRACE("<<< MyImagePool_initialize()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyImagePool_destroy(MyImagePool *pool)
+{
+  MY_LOG_TRACE(">>> MyImagePool_destroy()");
+
+  if (!pool)
+  {
+    MY_LOG_ERROR("\t*** Erro: Pool inválido (pool == NULL).");
+    MY_LOG_TRACE("<<< MyImagePool_destroy()");
+    return;
+  }
+
+  for (int i = 0; i < pool->bufferCount; ++i)
+  {
+    if (pool->buffers[i].inUse)
+      MY_LOG_WARN("\t*** Aviso: Buffer %d ainda está em uso.", i);
+
+    SDL_aligned_free(pool->buffers[i].pixels);
+  }
+
+  SDL_DestroyMutex(pool->mutex);
+  SDL_zerop(pool);
+
+  MY_LOG_TRACE("<<< MyImagePool_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void *MyImagePool_acquire(MyImagePool *pool, size_t size)
+{
+  if (!pool || size == 0)
+    return NULL;
+
+  size = align_up(size, MY_IMAGE_POOL_ALIGNMENT);
+
+  SDL_LockMutex(pool->mutex);
+  ++pool->stats.acquireCount;
+
+  // Procura o menor buffer livre que comporte o tamanho pedido (best fit).
+  MyPoolBuffer *best = NULL;
+  MyPoolBuffer *smallestFree = NULL;
+  for (int i = 0; i < pool->bufferCount; ++i)
+  {
+    MyPoolBuffer *buffer = &pool->buffers[i];
+    if (buffer->inUse)
+      continue;
+
+    if (buffer->size >= size && (!best || buffer->size < best->size))
+      best = buffer;
+
+    if (!smallestFree || buffer->size < smallestFree->size)
+      smallestFree = buffer;
+  }
+
+  if (best)
+  {
+    best->inUse = true;
+    ++pool->stats.reuseCount;
+    SDL_UnlockMutex(pool->mutex);
+    return best->pixels;
+  }
+
+  // Nenhum buffer livre comporta o pedido. Usamos um novo slot ou, se o pool
+  // estiver cheio, substituímos o menor buffer livre.
+  MyPoolBuffer *slot = NULL;
+  if (pool->bufferCount < MY_IMAGE_POOL_MAX_BUFFERS)
+  {
+    slot = &pool->buffers[pool->bufferCount++];
+  }
+  else if (smallestFree)
+  {
+    slot = smallestFree;
+    pool->stats.bytesReserved -= slot->size;
+    SDL_aligned_free(slot->pixels);
+  }
+  else
+  {
+    SDL_UnlockMutex(pool->mutex);
+    SDL_SetError("Todos os %d buffers do pool estão em uso", MY_IMAGE_POOL_MAX_BUFFERS);
+    return NULL;
+  }
+
+  MY_LOG_DEBUG("\tMyImagePool: alocando novo buffer de %zu bytes...", size);
+  slot->pixels = SDL_aligned_alloc(MY_IMAGE_POOL_ALIGNMENT, size);
+  if (!slot->pixels)
+  {
+    // Slot fica vazio (size == 0) e será reaproveitado na próxima alocação.
+    slot->size = 0;
+    slot->inUse = false;
+    SDL_UnlockMutex(pool->mutex);
+    return NULL;
+  }
+
+  // Toca todas as páginas agora, para que os page faults aconteçam aqui e não
+  // dentro do laço de processamento da imagem.
+  SDL_memset(slot->pixels, 0, size);
+
+  slot->size = size;
+  slot->inUse = true;
+  ++pool->stats.allocationCount;
+  pool->stats.bytesReserved += size;
+
+  SDL_UnlockMutex(pool->mutex);
+  return slot->pixels;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyImagePool_release(MyImagePool *pool, void *pixels)
+{
+  if (!pool || !pixels)
+    return;
+
+  SDL_LockMutex(pool->mutex);
+
+  for (int i = 0; i < pool->bufferCount; ++i)
+  {
+    if (pool->buffers[i].pixels == pixels)
+    {
+      pool->buffers[i].inUse = false;
+      SDL_UnlockMutex(pool->mutex);
+      return;
+    }
+  }
+
+  SDL_UnlockMutex(pool->mutex);
+  MY_LOG_ERROR("\t*** Erro: Buffer %p não pertence ao pool.", pixels);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+SDL_Surface *MyImagePool_acquire_surface(MyImagePool *pool, int width, int height, SDL_PixelFormat format)
+{
+  if (width <= 0 || height <= 0)
+  {
+    SDL_SetError("Dimensões inválidas (%d, %d)", width, height);
+    return NULL;
+  }
+
+  const size_t pitch = align_up((size_t)width * SDL_BYTESPERPIXEL(format), MY_IMAGE_POOL_ALIGNMENT);
+  void *pixels = MyImagePool_acquire(pool, pitch * height);
+  if (!pixels)
+    return NULL;
+
+  SDL_Surface *surface = SDL_CreateSurfaceFrom(width, height, format, pixels, (int)pitch);
+  if (!surface)
+    MyImagePool_release(pool, pixels);
+
+  return surface;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyImagePool_release_surface(MyImagePool *pool, SDL_Surface *surface)
+{
+  if (!surface)
+    return;
+
+  // SDL_DestroySurface() não libera pixels de superfícies criadas com
+  // SDL_CreateSurfaceFrom(), então o buffer volta intacto para o pool.
+  void *pixels = surface->pixels;
+  SDL_DestroySurface(surface);
+  MyImagePool_release(pool, pixels);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyImagePool_log_stats(const MyImagePool *pool)
+{
+  if (!pool)
+    return;
+
+  MY_LOG_INFO("\tMyImagePool: %llu pedidos, %llu reaproveitados, %llu alocações, %zu bytes reservados.",
+    (unsigned long long)pool->stats.acquireCount, (unsigned long long)pool->stats.reuseCount,
+    (unsigned long long)pool->stats.allocationCount, pool->stats.bytesReserved);
+
+#if defined(__linux__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    MY_LOG_INFO("\tProcesso: %ld page faults (minor), %ld page faults (major).",
+      usage.ru_minflt, usage.ru_majflt);
+  }
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+MyArenaBlock *MyArenaBlock_create(size_t capacity)
+{
+  MyArenaBlock *block = SDL_malloc(sizeof(MyArenaBlock));
+  if (!block)
+    return NULL;
+
+  block->data = SDL_aligned_alloc(MY_IMAGE_POOL_ALIGNMENT, capacity);
+  if (!block->data)
+  {
+    SDL_free(block);
+    return NULL;
+  }
+
+  block->previous = NULL;
+  block->capacity = capacity;
+  block->offset = 0;
+  return block;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyArena_initialize(MyArena *arena, size_t capacity)
+{
+  if (!arena)
+    return false;
+
+  capacity = align_up(capacity ? capacity : MY_ARENA_DEFAULT_CAPACITY, MY_IMAGE_POOL_ALIGNMENT);
+
+  arena->current = MyArenaBlock_create(capacity);
+  arena->peakSize = capacity;
+  arena->allocationCount = arena->current ? 1 : 0;
+  return arena->current != NULL;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyArena_destroy(MyArena *arena)
+{
+  if (!arena)
+    return;
+
+  while (arena->current)
+  {
+    MyArenaBlock *previous = arena->current->previous;
+    SDL_aligned_free(arena->current->data);
+    SDL_free(arena->current);
+    arena->current = previous;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void *MyArena_push(MyArena *arena, size_t size, size_t alignment)
+{
+  if (!arena || !arena->current)
+    return NULL;
+
+  if (alignment == 0)
+    alignment = sizeof(void *);
+
+  MyArenaBlock *block = arena->current;
+  size_t offset = align_up(block->offset, alignment);
+  if (offset + size > block->capacity)
+  {
+    // Bloco atual cheio: encadeia um novo bloco (pelo menos o dobro do atual).
+    size_t capacity = align_up(SDL_max(block->capacity * 2, size + alignment), MY_IMAGE_POOL_ALIGNMENT);
+    MyArenaBlock *newBlock = MyArenaBlock_create(capacity);
+    if (!newBlock)
+      return NULL;
+
+    ++arena->allocationCount;
+    newBlock->previous = block;
+    arena->current = block = newBlock;
+    offset = align_up(block->offset, alignment);
+
+    size_t chainSize = 0;
+    for (MyArenaBlock *b = block; b; b = b->previous)
+      chainSize += b->capacity;
+    arena->peakSize = SDL_max(arena->peakSize, chainSize);
+  }
+
+  block->offset = offset + size;
+  return block->data + offset;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+MyArenaMarker MyArena_get_marker(const MyArena *arena)
+{
+  MyArenaMarker marker = { .block = NULL, .offset = 0 };
+  if (arena && arena->current)
+  {
+    marker.block = arena->current;
+    marker.offset = arena->current->offset;
+  }
+  return marker;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyArena_reset_to_marker(MyArena *arena, MyArenaMarker marker)
+{
+  if (!arena || !arena->current || !marker.block)
+    return;
+
+  // Descarta os blocos criados depois do marcador.
+  while (arena->current != marker.block && arena->current->previous)
+  {
+    MyArenaBlock *previous = arena->current->previous;
+    SDL_aligned_free(arena->current->data);
+    SDL_free(arena->current);
+    arena->current = previous;
+  }
+
+  arena->current->offset = marker.offset;
+
+  // Arena voltou a ficar vazia e o primeiro bloco é menor do que o pico
+  // registrado: substitui por um único bloco do tamanho do pico, para que as
+  // próximas execuções não precisem encadear blocos.
+  MyArenaBlock *block = arena->current;
+  if (!block->previous && block->offset == 0 && block->capacity < arena->peakSize)
+  {
+    MyArenaBlock *newBlock = MyArenaBlock_create(arena->peakSize);
+    if (newBlock)
+    {
+      ++arena->allocationCount;
+      SDL_aligned_free(block->data);
+      SDL_free(block);
+      arena->current = newBlock;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyArena_destroy_thread_local(void *arena)
+{
+  MyArena_destroy((MyArena *)arena);
+  SDL_free(arena);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+MyArena *MyArena_get_thread_local(void)
+{
+  MyArena *arena = (MyArena *)SDL_GetTLS(&g_arenaTLS);
+  if (arena)
+    return arena;
+
+  arena = SDL_malloc(sizeof(MyArena));
+  if (!arena)
+    return NULL;
+
+  if (!MyArena_initialize(arena, MY_ARENA_DEFAULT_CAPACITY))
+  {
+    SDL_free(arena);
+    return NULL;
+  }
+
+  if (!SDL_SetTLS(&g_arenaTLS, arena, MyArena_destroy_thread_local))
+  {
+    MyArena_destroy_thread_local(arena);
+    return NULL;
+  }
+
+  return arena;
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Pool de buffers de imagem e arenas de rascunho (scratch).
+//
+// MyImagePool mantém buffers alinhados que são reaproveitados entre operações
+// e imagens: ao invés de criar uma nova superfície (e pagar pela alocação e
+// pelos page faults) a cada filtro, o programa "pega emprestado" um buffer do
+// pool e o devolve assim que termina de usá-lo.
+//
+// MyArena é um alocador linear (bump allocator) para memória temporária de
+// curta duração (ex. janela de vizinhança de um filtro). Cada thread possui a
+// sua própria arena (MyArena_get_thread_local()), então não há disputa entre
+// threads e nenhuma alocação acontece depois que a arena atinge o tamanho
+// necessário.
+//------------------------------------------------------------------------------
+#ifndef MY_IMAGE_POOL_H
+#define MY_IMAGE_POOL_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+
+enum image_pool_constants
+{
+  MY_IMAGE_POOL_MAX_BUFFERS = 32,
+  MY_IMAGE_POOL_ALIGNMENT = 64,
+  MY_ARENA_DEFAULT_CAPACITY = 1 << 20,
+};
+
+typedef struct MyPoolBuffer MyPoolBuffer;
+struct MyPoolBuffer
+{
+  void *pixels;
+  size_t size;
+  bool inUse;
+};
+
+typedef struct MyImagePoolStats MyImagePoolStats;
+struct MyImagePoolStats
+{
+  Uint64 acquireCount;
+  Uint64 allocationCount;
+  Uint64 reuseCount;
+  size_t bytesReserved;
+};
+
+typedef struct MyImagePool MyImagePool;
+struct MyImagePool
+{
+  SDL_Mutex *mutex;
+  MyPoolBuffer buffers[MY_IMAGE_POOL_MAX_BUFFERS];
+  int bufferCount;
+  MyImagePoolStats stats;
+};
+
+typedef struct MyArenaBlock MyArenaBlock;
+struct MyArenaBlock
+{
+  MyArenaBlock *previous;
+  size_t capacity;
+  size_t offset;
+  Uint8 *data;
+};
+
+typedef struct MyArenaMarker MyArenaMarker;
+struct MyArenaMarker
+{
+  MyArenaBlock *block;
+  size_t offset;
+};
+
+typedef struct MyArena MyArena;
+struct MyArena
+{
+  MyArenaBlock *current;
+  size_t peakSize;
+  Uint64 allocationCount;
+};
+
+bool MyImagePool_initialize(MyImagePool *pool);
+void MyImagePool_destroy(MyImagePool *pool);
+
+/**
+ * Obtém um buffer com pelo menos `size` bytes, alinhado em
+ * MY_IMAGE_POOL_ALIGNMENT bytes. Um buffer livre é reaproveitado sempre que
+ * possível; caso contrário, um novo buffer é alocado e suas páginas são
+ * tocadas imediatamente, para que os page faults não aconteçam durante o
+ * processamento da imagem.
+ * Retorna NULL caso não seja possível obter o buffer.
+ */
+void *MyImagePool_acquire(MyImagePool *pool, size_t size);
+
+/**
+ * Devolve ao pool um buffer obtido com MyImagePool_acquire().
+ */
+void MyImagePool_release(MyImagePool *pool, void *pixels);
+
+/**
+ * Cria uma superfície cujos pixels pertencem ao pool. O pitch de cada linha é
+ * alinhado em MY_IMAGE_POOL_ALIGNMENT bytes e pode ser maior do que
+ * `width * bytes_per_pixel` (use sempre `surface->pitch` para percorrer as
+ * linhas). A superfície deve ser liberada com MyImagePool_release_surface().
+ */
+SDL_Surface *MyImagePool_acquire_surface(MyImagePool *pool, int width, int height, SDL_PixelFormat format);
+void MyImagePool_release_surface(MyImagePool *pool, SDL_Surface *surface);
+
+void MyImagePool_log_stats(const MyImagePool *pool);
+
+bool MyArena_initialize(MyArena *arena, size_t capacity);
+void MyArena_destroy(MyArena *arena);
+
+/**
+ * Reserva `size` bytes na arena, com o alinhamento indicado (potência de 2).
+ * Se o bloco atual não tiver espaço, um novo bloco é encadeado; ao voltar
+ * para o início da arena, os blocos são consolidados em um único bloco com o
+ * tamanho de pico, então as próximas execuções não alocam mais memória.
+ */
+void *MyArena_push(MyArena *arena, size_t size, size_t alignment);
+MyArenaMarker MyArena_get_marker(const MyArena *arena);
+void MyArena_reset_to_marker(MyArena *arena, MyArenaMarker marker);
+
+/**
+ * Retorna a arena da thread atual, criando-a no primeiro uso. A arena é
+ * destruída automaticamente quando a thread termina (ou em SDL_Quit(), no
+ * caso da thread principal).
+ */
+MyArena *MyArena_get_thread_local(void);
+
+#endif // MY_IMAGE_POOL_H
@@ -0,0 +1,419 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "kernels_internal.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+enum
+{
+  KERNELS_UNINITIALIZED = 0,
+  KERNELS_INITIALIZING = 1,
+  KERNELS_READY = 2,
+};
+
+static const char *CPU_LEVEL_NAMES[MY_CPU_LEVEL_COUNT] = { "scalar", "sse2", "avx2", "avx512" };
+
+//------------------------------------------------------------------------------
+// Globals (argh!)
+//------------------------------------------------------------------------------
+static MyKernels g_kernels;
+static SDL_AtomicInt g_kernelsState;
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static MyCpuLevel get_requested_level(void);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_invert_rgba32_scalar(const Uint8 *src, Uint8 *dst, size_t pixelCount)
+{
+  for (size_t i = 0; i < pixelCount; ++i, src += 4, dst += 4)
+  {
+    dst[0] = 255 - src[0];
+    dst[1] = 255 - src[1];
+    dst[2] = 255 - src[2];
+    dst[3] = src[3];
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_add_u8_to_u32_scalar(Uint32 *sums, const Uint8 *src, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+    sums[i] += src[i];
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_sub_u8_from_u32_scalar(Uint32 *sums, const Uint8 *src, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+    sums[i] -= src[i];
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_box_sum_rgba_u32_scalar(const Uint32 *src, Uint32 *dst, int width, int radius)
+{
+  // Janela do primeiro pixel: [-radius, radius], com zero fora da linha.
+  Uint32 sum[4] = { 0, 0, 0, 0 };
+  for (int x = 0; x <= radius && x < width; ++x)
+  {
+    for (int c = 0; c < 4; ++c)
+      sum[c] += src[x * 4 + c];
+  }
+
+  // Desliza a janela: entra o pixel x + radius + 1, sai o pixel x - radius.
+  for (int x = 0; x < width; ++x)
+  {
+    const int in = x + radius + 1;
+    const int out = x - radius;
+    for (int c = 0; c < 4; ++c)
+    {
+      dst[x * 4 + c] = sum[c];
+      if (in < width)
+        sum[c] += src[in * 4 + c];
+      if (out >= 0)
+        sum[c] -= src[out * 4 + c];
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_average_to_rgba32_scalar(const Uint32 *sums, Uint8 *dst, size_t pixelCount, float scale)
+{
+  for (size_t i = 0; i < pixelCount; ++i, sums += 4, dst += 4)
+  {
+    dst[0] = (Uint8)(sums[0] * scale);
+    dst[1] = (Uint8)(sums[1] * scale);
+    dst[2] = (Uint8)(sums[2] * scale);
+    dst[3] = 255;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_fill_u32_scalar(Uint32 *dst, Uint32 value, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+    dst[i] = value;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_rgba32_to_planes_scalar(const Uint8 *src, Uint8 *const dst[3], int planeCount, size_t pixelCount, const float *matrix)
+{
+  for (size_t i = 0; i < pixelCount; ++i, src += 4)
+  {
+    const float r = src[0];
+    const float g = src[1];
+    const float b = src[2];
+    for (int k = 0; k < planeCount; ++k)
+    {
+      const float *m = matrix + k * 4;
+      const float v = m[0] * r + m[1] * g + m[2] * b + m[3];
+      dst[k][i] = (Uint8)SDL_clamp(v, 0.0f, 255.0f);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_planes_to_rgba32_scalar(const Uint8 *const src[3], Uint8 *dst, size_t pixelCount, const float *matrix)
+{
+  for (size_t i = 0; i < pixelCount; ++i, dst += 4)
+  {
+    const float x = src[0][i];
+    const float y = src[1][i];
+    const float z = src[2][i];
+    for (int c = 0; c < 3; ++c)
+    {
+      const float *m = matrix + c * 4;
+      const float v = m[0] * x + m[1] * y + m[2] * z + m[3];
+      dst[c] = (Uint8)SDL_clamp(v, 0.0f, 255.0f);
+    }
+    dst[3] = 255;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_rgba32_to_hsv_scalar(const Uint8 *src, Uint8 *const dst[3], size_t pixelCount)
+{
+  for (size_t i = 0; i < pixelCount; ++i, src += 4)
+  {
+    const float r = src[0];
+    const float g = src[1];
+    const float b = src[2];
+    const float max = SDL_max(r, SDL_max(g, b));
+    const float min = SDL_min(r, SDL_min(g, b));
+    const float delta = max - min;
+
+    // Com delta == 0 (cinza), R == G == B e o matiz calculado já é zero; o
+    // divisor mínimo 1 só evita a divisão por zero.
+    const float divisor = SDL_max(delta, 1.0f);
+    float h;
+    if (max == r)
+      h = (g - b) / divisor;
+    else if (max == g)
+      h = (b - r) / divisor + 2.0f;
+    else
+      h = (r - g) / divisor + 4.0f;
+    h = h * MY_KERNELS_HSV_HUE_SCALE;
+    if (h < 0.0f)
+      h = h + 256.0f;
+
+    const float s = (255.0f * delta) / SDL_max(max, 1.0f);
+
+    // 255.5 arredonda para 256, que volta a ser 0 (o matiz é circular).
+    dst[0][i] = (Uint8)((int)(h + 0.5f) & 0xFF);
+    dst[1][i] = (Uint8)(s + 0.5f);
+    dst[2][i] = (Uint8)max;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_hsv_to_rgba32_scalar(const Uint8 *const src[3], Uint8 *dst, size_t pixelCount)
+{
+  for (size_t i = 0; i < pixelCount; ++i, dst += 4)
+  {
+    const float h = src[0][i] * (6.0f / 256.0f);
+    const int sector = (int)h;
+    const float f = h - (float)sector;
+    const float s = src[1][i] * (1.0f / 255.0f);
+    const float v = src[2][i];
+    const float p = v * (1.0f - s);
+    const float q = v * (1.0f - s * f);
+    const float t = v * (1.0f - s * (1.0f - f));
+
+    float r, g, b;
+    switch (sector)
+    {
+    case 0: r = v; g = t; b = p; break;
+    case 1: r = q; g = v; b = p; break;
+    case 2: r = p; g = v; b = t; break;
+    case 3: r = p; g = q; b = v; break;
+    case 4: r = t; g = p; b = v; break;
+    default: r = v; g = p; b = q; break;
+    }
+
+    dst[0] = (Uint8)(r + 0.5f);
+    dst[1] = (Uint8)(g + 0.5f);
+    dst[2] = (Uint8)(b + 0.5f);
+    dst[3] = 255;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_resample_vertical_u8_scalar(const Uint8 *src, size_t pitch, const float *weights, int taps, float *dst, size_t count)
+{
+  // Linha a linha (acesso sequencial), somando na mesma ordem das versões
+  // SIMD, que percorrem as linhas para cada bloco de colunas.
+  for (size_t i = 0; i < count; ++i)
+    dst[i] = 0.0f;
+
+  for (int k = 0; k < taps; ++k, src += pitch)
+  {
+    const float w = weights[k];
+    for (size_t i = 0; i < count; ++i)
+      dst[i] = dst[i] + w * src[i];
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_resample_horizontal_rgba32_scalar(const float *src, Uint8 *dst, int dstWidth, const int *first, const float *weights, int taps)
+{
+  for (int x = 0; x < dstWidth; ++x, dst += 4, weights += taps)
+  {
+    const float *s = src + (size_t)first[x] * 4;
+    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int k = 0; k < taps; ++k, s += 4)
+    {
+      for (int c = 0; c < 4; ++c)
+        sum[c] = sum[c] + weights[k] * s[c];
+    }
+
+    for (int c = 0; c < 4; ++c)
+      dst[c] = (Uint8)(SDL_clamp(sum[c], 0.0f, 255.0f) + 0.5f);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_convolve_row_f32_scalar(const float *src, float *dst, int width, const float *weights, int taps)
+{
+  for (int x = 0; x < width; ++x)
+  {
+    float sum = 0.0f;
+    for (int k = 0; k < taps; ++k)
+      sum = sum + weights[k] * src[x + k];
+    dst[x] = sum;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_gradient_3x3_f32_scalar(const float *const rows[3], float *magnitude, Uint8 *direction, int width, float center)
+{
+  const float *a = rows[0];
+  const float *r = rows[1];
+  const float *b = rows[2];
+  const float scale = 1.0f / (2.0f + center);
+
+  for (int x = 0; x < width; ++x)
+  {
+    const float gx = ((a[x + 1] - a[x - 1]) + center * (r[x + 1] - r[x - 1]) + (b[x + 1] - b[x - 1])) * scale;
+    const float gy = ((b[x - 1] - a[x - 1]) + center * (b[x] - a[x]) + (b[x + 1] - a[x + 1])) * scale;
+    magnitude[x] = SDL_sqrtf(gx * gx + gy * gy);
+
+    const float ax = SDL_fabsf(gx);
+    const float ay = SDL_fabsf(gy);
+    if (ay <= MY_KERNELS_TAN_22_5 * ax)
+      direction[x] = MY_GRADIENT_HORIZONTAL;
+    else if (ay >= MY_KERNELS_TAN_67_5 * ax)
+      direction[x] = MY_GRADIENT_VERTICAL;
+    else
+      direction[x] = ((gx < 0.0f) != (gy < 0.0f)) ? MY_GRADIENT_ANTIDIAGONAL : MY_GRADIENT_DIAGONAL;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+MyCpuLevel MyKernels_detect_cpu_level(void)
+{
+#if MY_KERNELS_X86
+  // SDL verifica tanto a CPU quanto o suporte do sistema operacional (ex.
+  // registradores AVX salvos na troca de contexto).
+  if (SDL_HasAVX512F())
+    return MY_CPU_AVX512;
+  if (SDL_HasAVX2())
+    return MY_CPU_AVX2;
+  if (SDL_HasSSE2())
+    return MY_CPU_SSE2;
+#endif
+
+  return MY_CPU_SCALAR;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const char *MyKernels_get_level_name(MyCpuLevel level)
+{
+  if (level < 0 || level >= MY_CPU_LEVEL_COUNT)
+    return "?";
+
+  return CPU_LEVEL_NAMES[level];
+}
+
+//------------------------------------------------------------------------------
+// Nível pedido em COMPVIS_CPU, ou MY_CPU_LEVEL_COUNT se não houver pedido.
+//------------------------------------------------------------------------------
+MyCpuLevel get_requested_level(void)
+{
+  const char *requested = SDL_getenv("COMPVIS_CPU");
+  if (!requested || !*requested)
+    return MY_CPU_LEVEL_COUNT;
+
+  for (int level = 0; level < MY_CPU_LEVEL_COUNT; ++level)
+  {
+    if (SDL_strcasecmp(requested, CPU_LEVEL_NAMES[level]) == 0)
+      return (MyCpuLevel)level;
+  }
+
+  MY_LOG_WARN("\t*** Aviso: COMPVIS_CPU=\"%s\" desconhecido (use scalar, sse2, avx2 ou avx512).", requested);
+  return MY_CPU_LEVEL_COUNT;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyKernels_get_for_level(MyCpuLevel level, MyKernels *kernels)
+{
+  if (!kernels || level < 0 || level >= MY_CPU_LEVEL_COUNT || level > MyKernels_detect_cpu_level())
+    return false;
+
+  kernels->level = level;
+  kernels->invert_rgba32 = MyKernels_invert_rgba32_scalar;
+  kernels->add_u8_to_u32 = MyKernels_add_u8_to_u32_scalar;
+  kernels->sub_u8_from_u32 = MyKernels_sub_u8_from_u32_scalar;
+  kernels->box_sum_rgba_u32 = MyKernels_box_sum_rgba_u32_scalar;
+  kernels->average_to_rgba32 = MyKernels_average_to_rgba32_scalar;
+  kernels->fill_u32 = MyKernels_fill_u32_scalar;
+  kernels->rgba32_to_planes = MyKernels_rgba32_to_planes_scalar;
+  kernels->planes_to_rgba32 = MyKernels_planes_to_rgba32_scalar;
+  kernels->rgba32_to_hsv = MyKernels_rgba32_to_hsv_scalar;
+  kernels->hsv_to_rgba32 = MyKernels_hsv_to_rgba32_scalar;
+  kernels->resample_vertical_u8 = MyKernels_resample_vertical_u8_scalar;
+  kernels->resample_horizontal_rgba32 = MyKernels_resample_horizontal_rgba32_scalar;
+  kernels->convolve_row_f32 = MyKernels_convolve_row_f32_scalar;
+  kernels->gradient_3x3_f32 = MyKernels_gradient_3x3_f32_scalar;
+
+#if MY_KERNELS_X86
+  if (level >= MY_CPU_SSE2)
+    MyKernels_install_sse2(kernels);
+  if (level >= MY_CPU_AVX2)
+    MyKernels_install_avx2(kernels);
+  if (level >= MY_CPU_AVX512)
+    MyKernels_install_avx512(kernels);
+#endif
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const MyKernels *MyKernels_get(void)
+{
+  if (SDL_GetAtomicInt(&g_kernelsState) == KERNELS_READY)
+    return &g_kernels;
+
+  // Apenas uma thread monta a tabela; as demais esperam (só acontece se
+  // várias threads chamarem a função ao mesmo tempo na inicialização).
+  if (SDL_CompareAndSwapAtomicInt(&g_kernelsState, KERNELS_UNINITIALIZED, KERNELS_INITIALIZING))
+  {
+    const MyCpuLevel detected = MyKernels_detect_cpu_level();
+    const MyCpuLevel requested = get_requested_level();
+    const MyCpuLevel level = requested < detected ? requested : detected;
+
+    MyKernels_get_for_level(level, &g_kernels);
+    MY_LOG_INFO("\tKernels: %s (CPU suporta: %s).", MyKernels_get_level_name(level), MyKernels_get_level_name(detected));
+
+    SDL_SetAtomicInt(&g_kernelsState, KERNELS_READY);
+  }
+  else
+  {
+    while (SDL_GetAtomicInt(&g_kernelsState) != KERNELS_READY)
+      SDL_CPUPauseInstruction();
+  }
+
+  return &g_kernels;
+}
@@ -0,0 +1,157 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Kernels de processamento de imagem com despacho em tempo de execução.
+//
+// Cada kernel tem uma versão escalar (C puro) e, em CPUs x86, versões SSE2,
+// AVX2 e/ou AVX-512 (arquivos kernels_sse2.c, kernels_avx2.c e
+// kernels_avx512.c, compilados com as flags de cada conjunto de instruções).
+// A primeira chamada de MyKernels_get() detecta o que a CPU suporta e monta
+// uma tabela (MyKernels) com a versão mais rápida de cada kernel; as chamadas
+// seguintes apenas retornam essa tabela.
+//
+// A variável de ambiente COMPVIS_CPU (scalar, sse2, avx2 ou avx512) limita o
+// nível escolhido, útil para comparar as versões na mesma máquina. Ela nunca
+// escolhe um nível acima do suportado pela CPU.
+//
+// Os kernels operam em linhas de pixels RGBA32 (bytes R, G, B, A na memória);
+// os filtros em filters.h os usam linha a linha, respeitando o pitch de cada
+// superfície.
+//------------------------------------------------------------------------------
+#ifndef MY_KERNELS_H
+#define MY_KERNELS_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+
+typedef enum MyCpuLevel
+{
+  MY_CPU_SCALAR,
+  MY_CPU_SSE2,
+  MY_CPU_AVX2,
+  MY_CPU_AVX512,
+  MY_CPU_LEVEL_COUNT,
+} MyCpuLevel;
+
+// Direção do gradiente (y para baixo), em setores de 45 graus centrados em
+// 0, 45, 90 e 135 graus.
+typedef enum MyGradientDirection
+{
+  MY_GRADIENT_HORIZONTAL,     // |gy| <= tan(22.5) |gx|.
+  MY_GRADIENT_DIAGONAL,       // gx e gy com o mesmo sinal.
+  MY_GRADIENT_VERTICAL,       // |gy| >= tan(67.5) |gx|.
+  MY_GRADIENT_ANTIDIAGONAL,   // gx e gy com sinais opostos.
+} MyGradientDirection;
+
+typedef struct MyKernels MyKernels;
+struct MyKernels
+{
+  MyCpuLevel level;
+
+  /**
+   * dst = 255 - src nos canais R, G e B de `pixelCount` pixels RGBA32; o
+   * canal alpha é copiado. `src` e `dst` podem ser a mesma linha.
+   */
+  void (*invert_rgba32)(const Uint8 *src, Uint8 *dst, size_t pixelCount);
+
+  /**
+   * sums[i] += src[i] (ou -=), para `count` bytes. Usados para manter as
+   * somas por coluna de uma janela vertical que desliza pela imagem.
+   */
+  void (*add_u8_to_u32)(Uint32 *sums, const Uint8 *src, size_t count);
+  void (*sub_u8_from_u32)(Uint32 *sums, const Uint8 *src, size_t count);
+
+  /**
+   * Soma horizontal, por canal, da janela [x - radius, x + radius] de cada
+   * pixel de `src` (4 somas por pixel), com zero fora da linha.
+   */
+  void (*box_sum_rgba_u32)(const Uint32 *src, Uint32 *dst, int width, int radius);
+
+  /**
+   * dst = (Uint8)(sums * scale) nos canais R, G e B e alpha = 255, para
+   * `pixelCount` pixels. A conversão trunca, como um cast de float para
+   * Uint8 em C.
+   */
+  void (*average_to_rgba32)(const Uint32 *sums, Uint8 *dst, size_t pixelCount, float scale);
+
+  /**
+   * Preenche `count` valores de 32 bits (ex. pixels RGBA32) com `value`.
+   * Usado nos spans horizontais do rasterizador por software.
+   */
+  void (*fill_u32)(Uint32 *dst, Uint32 value, size_t count);
+
+  /**
+   * Transformação afim de R, G e B (o alpha é ignorado) para `planeCount`
+   * planos de 8 bits (1 ou 3):
+   *
+   *   dst[k][i] = m[k][0] * R + m[k][1] * G + m[k][2] * B + m[k][3]
+   *
+   * com o resultado limitado a [0, 255] e truncado (some 0.5 em m[k][3] para
+   * arredondar). `matrix` tem 4 floats por plano. Usado em cinza e YCbCr.
+   */
+  void (*rgba32_to_planes)(const Uint8 *src, Uint8 *const dst[3], int planeCount, size_t pixelCount, const float *matrix);
+
+  /**
+   * Inverso de rgba32_to_planes(): R, G e B são transformações afins de
+   * (src[0], src[1], src[2]) com a mesma convenção (12 floats) e alpha = 255.
+   */
+  void (*planes_to_rgba32)(const Uint8 *const src[3], Uint8 *dst, size_t pixelCount, const float *matrix);
+
+  /**
+   * RGB <-> HSV de 8 bits: H em [0, 256) cobrindo o círculo inteiro (256
+   * equivale a 360 graus), S e V em [0, 255].
+   */
+  void (*rgba32_to_hsv)(const Uint8 *src, Uint8 *const dst[3], size_t pixelCount);
+  void (*hsv_to_rgba32)(const Uint8 *const src[3], Uint8 *dst, size_t pixelCount);
+
+  /**
+   * Passo vertical do redimensionamento (resample.h): para `count` bytes,
+   * dst[i] = soma de weights[k] * src[k * pitch + i], com k em [0, taps).
+   */
+  void (*resample_vertical_u8)(const Uint8 *src, size_t pitch, const float *weights, int taps, float *dst, size_t count);
+
+  /**
+   * Passo horizontal: cada canal do pixel x de `dst` (RGBA32) é a soma de
+   * weights[x * taps + k] * src[(first[x] + k) * 4 + canal], com k em
+   * [0, taps), limitada a [0, 255] e arredondada.
+   */
+  void (*resample_horizontal_rgba32)(const float *src, Uint8 *dst, int dstWidth, const int *first, const float *weights, int taps);
+
+  /**
+   * Convolução de uma linha: dst[x] = soma de weights[k] * src[x + k], com k
+   * em [0, taps) e x em [0, width). `src` tem width + taps - 1 valores (a
+   * borda já replicada). Usado na suavização gaussiana (edges.h).
+   */
+  void (*convolve_row_f32)(const float *src, float *dst, int width, const float *weights, int taps);
+
+  /**
+   * Gradiente 3x3 (Sobel com `center` = 2, Scharr com `center` = 10/3) do
+   * pixel x da linha rows[1], com rows[0] e rows[2] as linhas de cima e de
+   * baixo (cada linha com um valor extra em [-1] e em [width]):
+   *
+   *   gx = ((a[x+1] - a[x-1]) + center * (r[x+1] - r[x-1]) + (b[x+1] - b[x-1])) / (2 + center)
+   *   gy = ((b[x-1] - a[x-1]) + center * (b[x] - a[x]) + (b[x+1] - a[x+1])) / (2 + center)
+   *
+   * magnitude[x] = sqrt(gx^2 + gy^2) e direction[x] é a direção do gradiente
+   * em 4 setores de 45 graus (MyGradientDirection).
+   */
+  void (*gradient_3x3_f32)(const float *const rows[3], float *magnitude, Uint8 *direction, int width, float center);
+};
+
+/**
+ * Tabela com as versões mais rápidas suportadas pela CPU (detectada uma única
+ * vez). Pode ser chamada de qualquer thread.
+ */
+const MyKernels *MyKernels_get(void);
+
+/**
+ * Preenche `kernels` com as versões de um nível específico (ex. para comparar
+ * desempenho). Retorna false se a CPU (ou a build) não suporta o nível.
+ */
+bool MyKernels_get_for_level(MyCpuLevel level, MyKernels *kernels);
+
+MyCpuLevel MyKernels_detect_cpu_level(void);
+const char *MyKernels_get_level_name(MyCpuLevel level);
+
+#endif // MY_KERNELS_H
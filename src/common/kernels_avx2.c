@@ -0,0 +1,459 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Kernels AVX2 (compilado com -mavx2). 32 bytes = 8 pixels RGBA32 por vez.
+// box_sum_rgba_u32 continua com a versão SSE2: cada passo depende do anterior
+// e as 4 somas de um pixel já ocupam um registrador de 128 bits. Pelo mesmo
+// motivo, resample_horizontal_rgba32 também continua com a versão SSE2.
+//------------------------------------------------------------------------------
+#include "kernels_internal.h"
+
+#if MY_KERNELS_X86
+#include <immintrin.h>
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void invert_rgba32_avx2(const Uint8 *src, Uint8 *dst, size_t pixelCount)
+{
+  const __m256i mask = _mm256_set1_epi32(0x00FFFFFF);
+
+  size_t i = 0;
+  for (; i + 8 <= pixelCount; i += 8)
+  {
+    const __m256i v = _mm256_loadu_si256((const __m256i *)(src + i * 4));
+    _mm256_storeu_si256((__m256i *)(dst + i * 4), _mm256_xor_si256(v, mask));
+  }
+
+  MyKernels_invert_rgba32_scalar(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void add_u8_to_u32_avx2(Uint32 *sums, const Uint8 *src, size_t count)
+{
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+    const __m256i lo = _mm256_cvtepu8_epi32(v);
+    const __m256i hi = _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8));
+
+    __m256i *s = (__m256i *)(sums + i);
+    _mm256_storeu_si256(s + 0, _mm256_add_epi32(_mm256_loadu_si256(s + 0), lo));
+    _mm256_storeu_si256(s + 1, _mm256_add_epi32(_mm256_loadu_si256(s + 1), hi));
+  }
+
+  MyKernels_add_u8_to_u32_scalar(sums + i, src + i, count - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void sub_u8_from_u32_avx2(Uint32 *sums, const Uint8 *src, size_t count)
+{
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+    const __m256i lo = _mm256_cvtepu8_epi32(v);
+    const __m256i hi = _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8));
+
+    __m256i *s = (__m256i *)(sums + i);
+    _mm256_storeu_si256(s + 0, _mm256_sub_epi32(_mm256_loadu_si256(s + 0), lo));
+    _mm256_storeu_si256(s + 1, _mm256_sub_epi32(_mm256_loadu_si256(s + 1), hi));
+  }
+
+  MyKernels_sub_u8_from_u32_scalar(sums + i, src + i, count - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void average_to_rgba32_avx2(const Uint32 *sums, Uint8 *dst, size_t pixelCount, float scale)
+{
+  const __m256 factor = _mm256_set1_ps(scale);
+  const __m256i alpha = _mm256_set1_epi32((int)0xFF000000);
+  const __m256i lowByte = _mm256_set1_epi32(0xFF);
+
+  // packs/packus operam em cada metade de 128 bits separadamente; esta
+  // permutação devolve os pixels à ordem original.
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+  size_t i = 0;
+  for (; i + 8 <= pixelCount; i += 8)
+  {
+    const __m256i *s = (const __m256i *)(sums + i * 4);
+
+    const __m256i p0 = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(s + 0)), factor)), lowByte);
+    const __m256i p1 = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(s + 1)), factor)), lowByte);
+    const __m256i p2 = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(s + 2)), factor)), lowByte);
+    const __m256i p3 = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(s + 3)), factor)), lowByte);
+
+    const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(p0, p1), _mm256_packs_epi32(p2, p3));
+    const __m256i ordered = _mm256_permutevar8x32_epi32(packed, order);
+    _mm256_storeu_si256((__m256i *)(dst + i * 4), _mm256_or_si256(ordered, alpha));
+  }
+
+  MyKernels_average_to_rgba32_scalar(sums + i * 4, dst + i * 4, pixelCount - i, scale);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void fill_u32_avx2(Uint32 *dst, Uint32 value, size_t count)
+{
+  if (count < 8)
+  {
+    MyKernels_fill_u32_scalar(dst, value, count);
+    return;
+  }
+
+  const __m256i v = _mm256_set1_epi32((int)value);
+
+  // As sobras são cobertas por uma última escrita que se sobrepõe à anterior.
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_si256((__m256i *)(dst + i), v);
+  if (i < count)
+    _mm256_storeu_si256((__m256i *)(dst + count - 8), v);
+}
+
+//------------------------------------------------------------------------------
+// R, G e B de 8 pixels RGBA32 como floats.
+//------------------------------------------------------------------------------
+static inline void load_rgb_avx2(const Uint8 *src, __m256 *r, __m256 *g, __m256 *b)
+{
+  const __m256i lowByte = _mm256_set1_epi32(0xFF);
+  const __m256i v = _mm256_loadu_si256((const __m256i *)src);
+  *r = _mm256_cvtepi32_ps(_mm256_and_si256(v, lowByte));
+  *g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, 8), lowByte));
+  *b = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, 16), lowByte));
+}
+
+//------------------------------------------------------------------------------
+// 8 bytes de um plano como floats.
+//------------------------------------------------------------------------------
+static inline __m256 load_plane_avx2(const Uint8 *src)
+{
+  return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src)));
+}
+
+//------------------------------------------------------------------------------
+// 32 valores em [0, 255] (8 por vetor) como bytes de um plano.
+//------------------------------------------------------------------------------
+static inline void store_plane_avx2(Uint8 *dst, const __m256i values[4])
+{
+  // Mesma permutação de average_to_rgba32_avx2().
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(values[0], values[1]), _mm256_packs_epi32(values[2], values[3]));
+  _mm256_storeu_si256((__m256i *)dst, _mm256_permutevar8x32_epi32(packed, order));
+}
+
+//------------------------------------------------------------------------------
+// Limita a [0, 255] e trunca, como SDL_clamp() seguido de um cast.
+//------------------------------------------------------------------------------
+static inline __m256i clamp_to_u8_avx2(__m256 v)
+{
+  return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(255.0f)));
+}
+
+//------------------------------------------------------------------------------
+// Pixels RGBA32 (alpha = 255) a partir de R, G e B em [0, 255].
+//------------------------------------------------------------------------------
+static inline __m256i pack_rgba32_avx2(__m256i r, __m256i g, __m256i b)
+{
+  const __m256i alpha = _mm256_set1_epi32((int)0xFF000000);
+  return _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)), _mm256_or_si256(_mm256_slli_epi32(b, 16), alpha));
+}
+
+//------------------------------------------------------------------------------
+// m[0] * x + m[1] * y + m[2] * z + m[3], na ordem da versão escalar (sem FMA).
+//------------------------------------------------------------------------------
+static inline __m256 affine_avx2(const __m256 m[4], __m256 x, __m256 y, __m256 z)
+{
+  const __m256 xy = _mm256_add_ps(_mm256_mul_ps(m[0], x), _mm256_mul_ps(m[1], y));
+  return _mm256_add_ps(_mm256_add_ps(xy, _mm256_mul_ps(m[2], z)), m[3]);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void rgba32_to_planes_avx2(const Uint8 *src, Uint8 *const dst[3], int planeCount, size_t pixelCount, const float *matrix)
+{
+  __m256 m[3][4];
+  for (int k = 0; k < 3; ++k)
+  {
+    for (int c = 0; c < 4; ++c)
+      m[k][c] = _mm256_set1_ps(k < planeCount ? matrix[k * 4 + c] : 0.0f);
+  }
+
+  // 32 pixels por vez, para gravar 32 bytes em cada plano.
+  size_t i = 0;
+  for (; i + 32 <= pixelCount; i += 32)
+  {
+    __m256 r[4], g[4], b[4];
+    for (int j = 0; j < 4; ++j)
+      load_rgb_avx2(src + (i + j * 8) * 4, &r[j], &g[j], &b[j]);
+
+    for (int k = 0; k < planeCount; ++k)
+    {
+      __m256i values[4];
+      for (int j = 0; j < 4; ++j)
+        values[j] = clamp_to_u8_avx2(affine_avx2(m[k], r[j], g[j], b[j]));
+      store_plane_avx2(dst[k] + i, values);
+    }
+  }
+
+  Uint8 *const tail[3] = { dst[0] + i, planeCount > 1 ? dst[1] + i : NULL, planeCount > 2 ? dst[2] + i : NULL };
+  MyKernels_rgba32_to_planes_scalar(src + i * 4, tail, planeCount, pixelCount - i, matrix);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void planes_to_rgba32_avx2(const Uint8 *const src[3], Uint8 *dst, size_t pixelCount, const float *matrix)
+{
+  __m256 m[3][4];
+  for (int c = 0; c < 3; ++c)
+  {
+    for (int k = 0; k < 4; ++k)
+      m[c][k] = _mm256_set1_ps(matrix[c * 4 + k]);
+  }
+
+  size_t i = 0;
+  for (; i + 8 <= pixelCount; i += 8)
+  {
+    const __m256 x = load_plane_avx2(src[0] + i);
+    const __m256 y = load_plane_avx2(src[1] + i);
+    const __m256 z = load_plane_avx2(src[2] + i);
+
+    const __m256i r = clamp_to_u8_avx2(affine_avx2(m[0], x, y, z));
+    const __m256i g = clamp_to_u8_avx2(affine_avx2(m[1], x, y, z));
+    const __m256i b = clamp_to_u8_avx2(affine_avx2(m[2], x, y, z));
+    _mm256_storeu_si256((__m256i *)(dst + i * 4), pack_rgba32_avx2(r, g, b));
+  }
+
+  const Uint8 *const tail[3] = { src[0] + i, src[1] + i, src[2] + i };
+  MyKernels_planes_to_rgba32_scalar(tail, dst + i * 4, pixelCount - i, matrix);
+}
+
+//------------------------------------------------------------------------------
+// Mesmas operações de MyKernels_rgba32_to_hsv_scalar() (veja a versão SSE2).
+//------------------------------------------------------------------------------
+static inline void rgb_to_hsv_avx2(__m256 r, __m256 g, __m256 b, __m256i *h, __m256i *s, __m256i *v)
+{
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 max = _mm256_max_ps(r, _mm256_max_ps(g, b));
+  const __m256 min = _mm256_min_ps(r, _mm256_min_ps(g, b));
+  const __m256 delta = _mm256_sub_ps(max, min);
+  const __m256 divisor = _mm256_max_ps(delta, one);
+
+  const __m256 hueR = _mm256_div_ps(_mm256_sub_ps(g, b), divisor);
+  const __m256 hueG = _mm256_add_ps(_mm256_div_ps(_mm256_sub_ps(b, r), divisor), _mm256_set1_ps(2.0f));
+  const __m256 hueB = _mm256_add_ps(_mm256_div_ps(_mm256_sub_ps(r, g), divisor), _mm256_set1_ps(4.0f));
+  const __m256 isMaxR = _mm256_cmp_ps(max, r, _CMP_EQ_OQ);
+  const __m256 isMaxG = _mm256_cmp_ps(max, g, _CMP_EQ_OQ);
+  __m256 hue = _mm256_blendv_ps(_mm256_blendv_ps(hueB, hueG, isMaxG), hueR, isMaxR);
+  hue = _mm256_mul_ps(hue, _mm256_set1_ps(MY_KERNELS_HSV_HUE_SCALE));
+  hue = _mm256_add_ps(hue, _mm256_and_ps(_mm256_cmp_ps(hue, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(256.0f)));
+
+  const __m256 saturation = _mm256_div_ps(_mm256_mul_ps(_mm256_set1_ps(255.0f), delta), _mm256_max_ps(max, one));
+
+  *h = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_add_ps(hue, half)), _mm256_set1_epi32(0xFF));
+  *s = _mm256_cvttps_epi32(_mm256_add_ps(saturation, half));
+  *v = _mm256_cvttps_epi32(max);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void rgba32_to_hsv_avx2(const Uint8 *src, Uint8 *const dst[3], size_t pixelCount)
+{
+  size_t i = 0;
+  for (; i + 32 <= pixelCount; i += 32)
+  {
+    __m256i h[4], s[4], v[4];
+    for (int j = 0; j < 4; ++j)
+    {
+      __m256 r, g, b;
+      load_rgb_avx2(src + (i + j * 8) * 4, &r, &g, &b);
+      rgb_to_hsv_avx2(r, g, b, &h[j], &s[j], &v[j]);
+    }
+
+    store_plane_avx2(dst[0] + i, h);
+    store_plane_avx2(dst[1] + i, s);
+    store_plane_avx2(dst[2] + i, v);
+  }
+
+  Uint8 *const tail[3] = { dst[0] + i, dst[1] + i, dst[2] + i };
+  MyKernels_rgba32_to_hsv_scalar(src + i * 4, tail, pixelCount - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void hsv_to_rgba32_avx2(const Uint8 *const src[3], Uint8 *dst, size_t pixelCount)
+{
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 half = _mm256_set1_ps(0.5f);
+
+  size_t i = 0;
+  for (; i + 8 <= pixelCount; i += 8)
+  {
+    const __m256 h = _mm256_mul_ps(load_plane_avx2(src[0] + i), _mm256_set1_ps(6.0f / 256.0f));
+    const __m256i sector = _mm256_cvttps_epi32(h);
+    const __m256 f = _mm256_sub_ps(h, _mm256_cvtepi32_ps(sector));
+    const __m256 s = _mm256_mul_ps(load_plane_avx2(src[1] + i), _mm256_set1_ps(1.0f / 255.0f));
+    const __m256 v = load_plane_avx2(src[2] + i);
+    const __m256 p = _mm256_mul_ps(v, _mm256_sub_ps(one, s));
+    const __m256 q = _mm256_mul_ps(v, _mm256_sub_ps(one, _mm256_mul_ps(s, f)));
+    const __m256 t = _mm256_mul_ps(v, _mm256_sub_ps(one, _mm256_mul_ps(s, _mm256_sub_ps(one, f))));
+
+    __m256 is[6];
+    for (int k = 0; k < 6; ++k)
+      is[k] = _mm256_castsi256_ps(_mm256_cmpeq_epi32(sector, _mm256_set1_epi32(k)));
+
+    const __m256 r = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(v, t, is[4]), p, _mm256_or_ps(is[2], is[3])), q, is[1]);
+    const __m256 g = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(p, q, is[3]), v, _mm256_or_ps(is[1], is[2])), t, is[0]);
+    const __m256 b = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(v, q, is[5]), t, is[2]), p, _mm256_or_ps(is[0], is[1]));
+
+    const __m256i pixels = pack_rgba32_avx2(_mm256_cvttps_epi32(_mm256_add_ps(r, half)),
+      _mm256_cvttps_epi32(_mm256_add_ps(g, half)), _mm256_cvttps_epi32(_mm256_add_ps(b, half)));
+    _mm256_storeu_si256((__m256i *)(dst + i * 4), pixels);
+  }
+
+  const Uint8 *const tail[3] = { src[0] + i, src[1] + i, src[2] + i };
+  MyKernels_hsv_to_rgba32_scalar(tail, dst + i * 4, pixelCount - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void resample_vertical_u8_avx2(const Uint8 *src, size_t pitch, const float *weights, int taps, float *dst, size_t count)
+{
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32)
+  {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+
+    const Uint8 *row = src + i;
+    for (int k = 0; k < taps; ++k, row += pitch)
+    {
+      const __m256 w = _mm256_set1_ps(weights[k]);
+      const __m128i lo = _mm_loadu_si128((const __m128i *)row);
+      const __m128i hi = _mm_loadu_si128((const __m128i *)(row + 16));
+      sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(w, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(lo))));
+      sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(w, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)))));
+      sum2 = _mm256_add_ps(sum2, _mm256_mul_ps(w, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(hi))));
+      sum3 = _mm256_add_ps(sum3, _mm256_mul_ps(w, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)))));
+    }
+
+    _mm256_storeu_ps(dst + i + 0, sum0);
+    _mm256_storeu_ps(dst + i + 8, sum1);
+    _mm256_storeu_ps(dst + i + 16, sum2);
+    _mm256_storeu_ps(dst + i + 24, sum3);
+  }
+
+  MyKernels_resample_vertical_u8_scalar(src + i, pitch, weights, taps, dst + i, count - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void convolve_row_f32_avx2(const float *src, float *dst, int width, const float *weights, int taps)
+{
+  int x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    for (int k = 0; k < taps; ++k)
+    {
+      const __m256 w = _mm256_set1_ps(weights[k]);
+      sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(w, _mm256_loadu_ps(src + x + k)));
+      sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(w, _mm256_loadu_ps(src + x + k + 8)));
+    }
+
+    _mm256_storeu_ps(dst + x, sum0);
+    _mm256_storeu_ps(dst + x + 8, sum1);
+  }
+
+  MyKernels_convolve_row_f32_scalar(src + x, dst + x, width - x, weights, taps);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void gradient_3x3_f32_avx2(const float *const rows[3], float *magnitude, Uint8 *direction, int width, float center)
+{
+  const __m256 c = _mm256_set1_ps(center);
+  const __m256 scale = _mm256_set1_ps(1.0f / (2.0f + center));
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+  const __m256 tan22 = _mm256_set1_ps(MY_KERNELS_TAN_22_5);
+  const __m256 tan67 = _mm256_set1_ps(MY_KERNELS_TAN_67_5);
+
+  int x = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    const float *a = rows[0] + x;
+    const float *r = rows[1] + x;
+    const float *b = rows[2] + x;
+    const __m256 aLeft = _mm256_loadu_ps(a - 1);
+    const __m256 aRight = _mm256_loadu_ps(a + 1);
+    const __m256 bLeft = _mm256_loadu_ps(b - 1);
+    const __m256 bRight = _mm256_loadu_ps(b + 1);
+
+    const __m256 dx = _mm256_add_ps(_mm256_add_ps(_mm256_sub_ps(aRight, aLeft),
+      _mm256_mul_ps(c, _mm256_sub_ps(_mm256_loadu_ps(r + 1), _mm256_loadu_ps(r - 1)))), _mm256_sub_ps(bRight, bLeft));
+    const __m256 dy = _mm256_add_ps(_mm256_add_ps(_mm256_sub_ps(bLeft, aLeft),
+      _mm256_mul_ps(c, _mm256_sub_ps(_mm256_loadu_ps(b), _mm256_loadu_ps(a)))), _mm256_sub_ps(bRight, aRight));
+    const __m256 gx = _mm256_mul_ps(dx, scale);
+    const __m256 gy = _mm256_mul_ps(dy, scale);
+    _mm256_storeu_ps(magnitude + x, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(gx, gx), _mm256_mul_ps(gy, gy))));
+
+    const __m256 ax = _mm256_and_ps(gx, absMask);
+    const __m256 ay = _mm256_and_ps(gy, absMask);
+    const __m256i horizontal = _mm256_castps_si256(_mm256_cmp_ps(ay, _mm256_mul_ps(tan22, ax), _CMP_LE_OQ));
+    const __m256i vertical = _mm256_castps_si256(_mm256_cmp_ps(ay, _mm256_mul_ps(tan67, ax), _CMP_GE_OQ));
+    const __m256i opposite = _mm256_srai_epi32(_mm256_castps_si256(_mm256_xor_ps(gx, gy)), 31);
+    const __m256i diagonal = _mm256_or_si256(_mm256_set1_epi32(MY_GRADIENT_DIAGONAL),
+      _mm256_and_si256(opposite, _mm256_set1_epi32(MY_GRADIENT_ANTIDIAGONAL - MY_GRADIENT_DIAGONAL)));
+    const __m256i sector = _mm256_andnot_si256(horizontal, _mm256_or_si256(_mm256_andnot_si256(vertical, diagonal),
+      _mm256_and_si256(vertical, _mm256_set1_epi32(MY_GRADIENT_VERTICAL))));
+
+    // 8 setores de 32 bits -> 8 bytes (as duas metades de 128 bits).
+    const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(sector), _mm256_extracti128_si256(sector, 1));
+    _mm_storel_epi64((__m128i *)(direction + x), _mm_packus_epi16(packed, _mm_setzero_si128()));
+  }
+
+  const float *const tail[3] = { rows[0] + x, rows[1] + x, rows[2] + x };
+  MyKernels_gradient_3x3_f32_scalar(tail, magnitude + x, direction + x, width - x, center);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_install_avx2(MyKernels *kernels)
+{
+  kernels->invert_rgba32 = invert_rgba32_avx2;
+  kernels->add_u8_to_u32 = add_u8_to_u32_avx2;
+  kernels->sub_u8_from_u32 = sub_u8_from_u32_avx2;
+  kernels->average_to_rgba32 = average_to_rgba32_avx2;
+  kernels->fill_u32 = fill_u32_avx2;
+  kernels->rgba32_to_planes = rgba32_to_planes_avx2;
+  kernels->planes_to_rgba32 = planes_to_rgba32_avx2;
+  kernels->rgba32_to_hsv = rgba32_to_hsv_avx2;
+  kernels->hsv_to_rgba32 = hsv_to_rgba32_avx2;
+  kernels->resample_vertical_u8 = resample_vertical_u8_avx2;
+  kernels->convolve_row_f32 = convolve_row_f32_avx2;
+  kernels->gradient_3x3_f32 = gradient_3x3_f32_avx2;
+}
+
+#endif // MY_KERNELS_X86
@@ -0,0 +1,116 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Kernels AVX-512 (compilado com -mavx512f). 64 bytes = 16 pixels RGBA32 por
+// vez. Só usa instruções AVX512F (presentes em todas as CPUs com AVX-512),
+// então a detecção com SDL_HasAVX512F() é suficiente.
+//------------------------------------------------------------------------------
+#include "kernels_internal.h"
+
+#if MY_KERNELS_X86
+#include <immintrin.h>
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void invert_rgba32_avx512(const Uint8 *src, Uint8 *dst, size_t pixelCount)
+{
+  const __m512i mask = _mm512_set1_epi32(0x00FFFFFF);
+
+  size_t i = 0;
+  for (; i + 16 <= pixelCount; i += 16)
+  {
+    const __m512i v = _mm512_loadu_si512((const void *)(src + i * 4));
+    _mm512_storeu_si512((void *)(dst + i * 4), _mm512_xor_si512(v, mask));
+  }
+
+  MyKernels_invert_rgba32_scalar(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void add_u8_to_u32_avx512(Uint32 *sums, const Uint8 *src, size_t count)
+{
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    const __m512i v = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+    _mm512_storeu_si512((void *)(sums + i), _mm512_add_epi32(_mm512_loadu_si512((const void *)(sums + i)), v));
+  }
+
+  MyKernels_add_u8_to_u32_scalar(sums + i, src + i, count - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void sub_u8_from_u32_avx512(Uint32 *sums, const Uint8 *src, size_t count)
+{
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    const __m512i v = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+    _mm512_storeu_si512((void *)(sums + i), _mm512_sub_epi32(_mm512_loadu_si512((const void *)(sums + i)), v));
+  }
+
+  MyKernels_sub_u8_from_u32_scalar(sums + i, src + i, count - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void average_to_rgba32_avx512(const Uint32 *sums, Uint8 *dst, size_t pixelCount, float scale)
+{
+  const __m512 factor = _mm512_set1_ps(scale);
+  const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+
+  // Cada iteração converte 16 somas (4 pixels); vpmovdb (_mm512_cvtepi32_epi8)
+  // reduz cada valor de 32 bits para o seu byte menos significativo, mantendo
+  // a ordem (mesmo resultado do cast para Uint8 da versão escalar).
+  size_t i = 0;
+  for (; i + 4 <= pixelCount; i += 4)
+  {
+    const __m512i s = _mm512_loadu_si512((const void *)(sums + i * 4));
+    const __m512i p = _mm512_cvttps_epi32(_mm512_mul_ps(_mm512_cvtepi32_ps(s), factor));
+    _mm_storeu_si128((__m128i *)(dst + i * 4), _mm_or_si128(_mm512_cvtepi32_epi8(p), alpha));
+  }
+
+  MyKernels_average_to_rgba32_scalar(sums + i * 4, dst + i * 4, pixelCount - i, scale);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void fill_u32_avx512(Uint32 *dst, Uint32 value, size_t count)
+{
+  if (count < 16)
+  {
+    MyKernels_fill_u32_scalar(dst, value, count);
+    return;
+  }
+
+  const __m512i v = _mm512_set1_epi32((int)value);
+
+  // As sobras são cobertas por uma última escrita que se sobrepõe à anterior.
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+    _mm512_storeu_si512((void *)(dst + i), v);
+  if (i < count)
+    _mm512_storeu_si512((void *)(dst + count - 16), v);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_install_avx512(MyKernels *kernels)
+{
+  kernels->invert_rgba32 = invert_rgba32_avx512;
+  kernels->add_u8_to_u32 = add_u8_to_u32_avx512;
+  kernels->sub_u8_from_u32 = sub_u8_from_u32_avx512;
+  kernels->average_to_rgba32 = average_to_rgba32_avx512;
+  kernels->fill_u32 = fill_u32_avx512;
+}
+
+#endif // MY_KERNELS_X86
@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Declarações compartilhadas entre kernels.c e as versões de cada conjunto de
+// instruções. Não faz parte da interface da biblioteca.
+//
+// Cada arquivo kernels_<isa>.c é compilado com as flags do seu conjunto de
+// instruções (veja o makefile) e só pode ser executado depois que o despacho
+// confirmou o suporte da CPU. Por isso, esses arquivos não devem definir nada
+// além das funções de instalação e dos kernels.
+//------------------------------------------------------------------------------
+#ifndef MY_KERNELS_INTERNAL_H
+#define MY_KERNELS_INTERNAL_H
+
+#include "kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MY_KERNELS_X86 1
+#else
+#define MY_KERNELS_X86 0
+#endif
+
+// Versões escalares (também usadas pelas versões SIMD nas sobras de cada
+// linha).
+void MyKernels_invert_rgba32_scalar(const Uint8 *src, Uint8 *dst, size_t pixelCount);
+void MyKernels_add_u8_to_u32_scalar(Uint32 *sums, const Uint8 *src, size_t count);
+void MyKernels_sub_u8_from_u32_scalar(Uint32 *sums, const Uint8 *src, size_t count);
+void MyKernels_box_sum_rgba_u32_scalar(const Uint32 *src, Uint32 *dst, int width, int radius);
+void MyKernels_average_to_rgba32_scalar(const Uint32 *sums, Uint8 *dst, size_t pixelCount, float scale);
+void MyKernels_fill_u32_scalar(Uint32 *dst, Uint32 value, size_t count);
+void MyKernels_rgba32_to_planes_scalar(const Uint8 *src, Uint8 *const dst[3], int planeCount, size_t pixelCount, const float *matrix);
+void MyKernels_planes_to_rgba32_scalar(const Uint8 *const src[3], Uint8 *dst, size_t pixelCount, const float *matrix);
+void MyKernels_rgba32_to_hsv_scalar(const Uint8 *src, Uint8 *const dst[3], size_t pixelCount);
+void MyKernels_hsv_to_rgba32_scalar(const Uint8 *const src[3], Uint8 *dst, size_t pixelCount);
+void MyKernels_resample_vertical_u8_scalar(const Uint8 *src, size_t pitch, const float *weights, int taps, float *dst, size_t count);
+void MyKernels_resample_horizontal_rgba32_scalar(const float *src, Uint8 *dst, int dstWidth, const int *first, const float *weights, int taps);
+void MyKernels_convolve_row_f32_scalar(const float *src, float *dst, int width, const float *weights, int taps);
+void MyKernels_gradient_3x3_f32_scalar(const float *const rows[3], float *magnitude, Uint8 *direction, int width, float center);
+
+// As versões SIMD das conversões de cor, do redimensionamento e do gradiente
+// fazem as mesmas operações em float, na mesma ordem (sem FMA), então o
+// resultado é idêntico ao da versão escalar.
+// MY_KERNELS_HSV_HUE_SCALE converte o setor do matiz ([0, 6)) para [0, 256).
+#define MY_KERNELS_HSV_HUE_SCALE (256.0f / 6.0f)
+
+// Limites dos setores de MyGradientDirection.
+#define MY_KERNELS_TAN_22_5 0.41421356f
+#define MY_KERNELS_TAN_67_5 2.41421356f
+
+// Substituem, em `kernels`, as entradas que têm versão no conjunto de
+// instruções. São chamadas em ordem (SSE2, AVX2, AVX-512), então cada nível
+// herda as versões do nível anterior que ele não reimplementa.
+#if MY_KERNELS_X86
+void MyKernels_install_sse2(MyKernels *kernels);
+void MyKernels_install_avx2(MyKernels *kernels);
+void MyKernels_install_avx512(MyKernels *kernels);
+#endif
+
+#endif // MY_KERNELS_INTERNAL_H
@@ -0,0 +1,573 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Kernels SSE2 (compilado com -msse2). 16 bytes = 4 pixels RGBA32 por vez.
+//------------------------------------------------------------------------------
+#include "kernels_internal.h"
+
+#if MY_KERNELS_X86
+#include <emmintrin.h>
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void invert_rgba32_sse2(const Uint8 *src, Uint8 *dst, size_t pixelCount)
+{
+  // XOR com 0xFF inverte R, G e B; o byte do alpha (o mais significativo de
+  // cada pixel em little-endian) fica intacto.
+  const __m128i mask = _mm_set1_epi32(0x00FFFFFF);
+
+  size_t i = 0;
+  for (; i + 4 <= pixelCount; i += 4)
+  {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(src + i * 4));
+    _mm_storeu_si128((__m128i *)(dst + i * 4), _mm_xor_si128(v, mask));
+  }
+
+  MyKernels_invert_rgba32_scalar(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void add_u8_to_u32_sse2(Uint32 *sums, const Uint8 *src, size_t count)
+{
+  const __m128i zero = _mm_setzero_si128();
+
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+    __m128i *s = (__m128i *)(sums + i);
+    _mm_storeu_si128(s + 0, _mm_add_epi32(_mm_loadu_si128(s + 0), _mm_unpacklo_epi16(lo, zero)));
+    _mm_storeu_si128(s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1), _mm_unpackhi_epi16(lo, zero)));
+    _mm_storeu_si128(s + 2, _mm_add_epi32(_mm_loadu_si128(s + 2), _mm_unpacklo_epi16(hi, zero)));
+    _mm_storeu_si128(s + 3, _mm_add_epi32(_mm_loadu_si128(s + 3), _mm_unpackhi_epi16(hi, zero)));
+  }
+
+  MyKernels_add_u8_to_u32_scalar(sums + i, src + i, count - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void sub_u8_from_u32_sse2(Uint32 *sums, const Uint8 *src, size_t count)
+{
+  const __m128i zero = _mm_setzero_si128();
+
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+    __m128i *s = (__m128i *)(sums + i);
+    _mm_storeu_si128(s + 0, _mm_sub_epi32(_mm_loadu_si128(s + 0), _mm_unpacklo_epi16(lo, zero)));
+    _mm_storeu_si128(s + 1, _mm_sub_epi32(_mm_loadu_si128(s + 1), _mm_unpackhi_epi16(lo, zero)));
+    _mm_storeu_si128(s + 2, _mm_sub_epi32(_mm_loadu_si128(s + 2), _mm_unpacklo_epi16(hi, zero)));
+    _mm_storeu_si128(s + 3, _mm_sub_epi32(_mm_loadu_si128(s + 3), _mm_unpackhi_epi16(hi, zero)));
+  }
+
+  MyKernels_sub_u8_from_u32_scalar(sums + i, src + i, count - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void box_sum_rgba_u32_sse2(const Uint32 *src, Uint32 *dst, int width, int radius)
+{
+  // As 4 somas (R, G, B, A) de um pixel cabem em um registrador: a janela
+  // desliza um pixel por vez, com uma soma e uma subtração vetoriais.
+  const __m128i *in = (const __m128i *)src;
+  __m128i *out = (__m128i *)dst;
+
+  __m128i sum = _mm_setzero_si128();
+  for (int x = 0; x <= radius && x < width; ++x)
+    sum = _mm_add_epi32(sum, _mm_loadu_si128(in + x));
+
+  // Trecho em que a janela ainda não perdeu pixels pela esquerda.
+  int x = 0;
+  const int head = SDL_min(radius, width);
+  for (; x < head; ++x)
+  {
+    _mm_storeu_si128(out + x, sum);
+    if (x + radius + 1 < width)
+      sum = _mm_add_epi32(sum, _mm_loadu_si128(in + x + radius + 1));
+  }
+
+  // Trecho central: sempre entra e sai um pixel.
+  for (; x + radius + 1 < width; ++x)
+  {
+    _mm_storeu_si128(out + x, sum);
+    sum = _mm_add_epi32(sum, _mm_loadu_si128(in + x + radius + 1));
+    sum = _mm_sub_epi32(sum, _mm_loadu_si128(in + x - radius));
+  }
+
+  // Trecho final: nada mais entra pela direita.
+  for (; x < width; ++x)
+  {
+    _mm_storeu_si128(out + x, sum);
+    if (x - radius >= 0)
+      sum = _mm_sub_epi32(sum, _mm_loadu_si128(in + x - radius));
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void average_to_rgba32_sse2(const Uint32 *sums, Uint8 *dst, size_t pixelCount, float scale)
+{
+  const __m128 factor = _mm_set1_ps(scale);
+  const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+  const __m128i lowByte = _mm_set1_epi32(0xFF);
+
+  size_t i = 0;
+  for (; i + 4 <= pixelCount; i += 4)
+  {
+    const __m128i *s = (const __m128i *)(sums + i * 4);
+
+    // Somas < 2^24 são exatas em float; _mm_cvttps_epi32 trunca e o AND
+    // mantém só o byte menos significativo, como o cast (Uint8)(sum * scale)
+    // da versão escalar (relevante só para filtros de tamanho par, em que a
+    // média pode passar de 255).
+    const __m128i p0 = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(s + 0)), factor)), lowByte);
+    const __m128i p1 = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(s + 1)), factor)), lowByte);
+    const __m128i p2 = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(s + 2)), factor)), lowByte);
+    const __m128i p3 = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(s + 3)), factor)), lowByte);
+
+    const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+    _mm_storeu_si128((__m128i *)(dst + i * 4), _mm_or_si128(packed, alpha));
+  }
+
+  MyKernels_average_to_rgba32_scalar(sums + i * 4, dst + i * 4, pixelCount - i, scale);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void fill_u32_sse2(Uint32 *dst, Uint32 value, size_t count)
+{
+  if (count < 4)
+  {
+    MyKernels_fill_u32_scalar(dst, value, count);
+    return;
+  }
+
+  const __m128i v = _mm_set1_epi32((int)value);
+
+  // As sobras são cobertas por uma última escrita que se sobrepõe à anterior.
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_si128((__m128i *)(dst + i), v);
+  if (i < count)
+    _mm_storeu_si128((__m128i *)(dst + count - 4), v);
+}
+
+//------------------------------------------------------------------------------
+// R, G e B de 4 pixels RGBA32 como floats.
+//------------------------------------------------------------------------------
+static inline void load_rgb_sse2(const Uint8 *src, __m128 *r, __m128 *g, __m128 *b)
+{
+  const __m128i lowByte = _mm_set1_epi32(0xFF);
+  const __m128i v = _mm_loadu_si128((const __m128i *)src);
+  *r = _mm_cvtepi32_ps(_mm_and_si128(v, lowByte));
+  *g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 8), lowByte));
+  *b = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 16), lowByte));
+}
+
+//------------------------------------------------------------------------------
+// 16 bytes de um plano como floats (4 por vetor).
+//------------------------------------------------------------------------------
+static inline void load_plane_sse2(const Uint8 *src, __m128 values[4])
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i v = _mm_loadu_si128((const __m128i *)src);
+  const __m128i lo = _mm_unpacklo_epi8(v, zero);
+  const __m128i hi = _mm_unpackhi_epi8(v, zero);
+  values[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero));
+  values[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero));
+  values[2] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero));
+  values[3] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero));
+}
+
+//------------------------------------------------------------------------------
+// 16 valores em [0, 255] (4 por vetor) como bytes de um plano.
+//------------------------------------------------------------------------------
+static inline void store_plane_sse2(Uint8 *dst, const __m128i values[4])
+{
+  const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(values[0], values[1]), _mm_packs_epi32(values[2], values[3]));
+  _mm_storeu_si128((__m128i *)dst, packed);
+}
+
+//------------------------------------------------------------------------------
+// Limita a [0, 255] e trunca, como SDL_clamp() seguido de um cast.
+//------------------------------------------------------------------------------
+static inline __m128i clamp_to_u8_sse2(__m128 v)
+{
+  return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(255.0f)));
+}
+
+//------------------------------------------------------------------------------
+// Pixels RGBA32 (alpha = 255) a partir de R, G e B em [0, 255].
+//------------------------------------------------------------------------------
+static inline __m128i pack_rgba32_sse2(__m128i r, __m128i g, __m128i b)
+{
+  const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+  return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_or_si128(_mm_slli_epi32(b, 16), alpha));
+}
+
+//------------------------------------------------------------------------------
+// mask ? a : b (SSE2 não tem blendv).
+//------------------------------------------------------------------------------
+static inline __m128 select_sse2(__m128 mask, __m128 a, __m128 b)
+{
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+//------------------------------------------------------------------------------
+// m[0] * x + m[1] * y + m[2] * z + m[3], na ordem da versão escalar.
+//------------------------------------------------------------------------------
+static inline __m128 affine_sse2(const __m128 m[4], __m128 x, __m128 y, __m128 z)
+{
+  const __m128 xy = _mm_add_ps(_mm_mul_ps(m[0], x), _mm_mul_ps(m[1], y));
+  return _mm_add_ps(_mm_add_ps(xy, _mm_mul_ps(m[2], z)), m[3]);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void rgba32_to_planes_sse2(const Uint8 *src, Uint8 *const dst[3], int planeCount, size_t pixelCount, const float *matrix)
+{
+  __m128 m[3][4];
+  for (int k = 0; k < 3; ++k)
+  {
+    for (int c = 0; c < 4; ++c)
+      m[k][c] = _mm_set1_ps(k < planeCount ? matrix[k * 4 + c] : 0.0f);
+  }
+
+  // 16 pixels por vez, para gravar 16 bytes em cada plano.
+  size_t i = 0;
+  for (; i + 16 <= pixelCount; i += 16)
+  {
+    __m128 r[4], g[4], b[4];
+    for (int j = 0; j < 4; ++j)
+      load_rgb_sse2(src + (i + j * 4) * 4, &r[j], &g[j], &b[j]);
+
+    for (int k = 0; k < planeCount; ++k)
+    {
+      __m128i values[4];
+      for (int j = 0; j < 4; ++j)
+        values[j] = clamp_to_u8_sse2(affine_sse2(m[k], r[j], g[j], b[j]));
+      store_plane_sse2(dst[k] + i, values);
+    }
+  }
+
+  Uint8 *const tail[3] = { dst[0] + i, planeCount > 1 ? dst[1] + i : NULL, planeCount > 2 ? dst[2] + i : NULL };
+  MyKernels_rgba32_to_planes_scalar(src + i * 4, tail, planeCount, pixelCount - i, matrix);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void planes_to_rgba32_sse2(const Uint8 *const src[3], Uint8 *dst, size_t pixelCount, const float *matrix)
+{
+  __m128 m[3][4];
+  for (int c = 0; c < 3; ++c)
+  {
+    for (int k = 0; k < 4; ++k)
+      m[c][k] = _mm_set1_ps(matrix[c * 4 + k]);
+  }
+
+  size_t i = 0;
+  for (; i + 16 <= pixelCount; i += 16)
+  {
+    __m128 x[4], y[4], z[4];
+    load_plane_sse2(src[0] + i, x);
+    load_plane_sse2(src[1] + i, y);
+    load_plane_sse2(src[2] + i, z);
+
+    for (int j = 0; j < 4; ++j)
+    {
+      const __m128i r = clamp_to_u8_sse2(affine_sse2(m[0], x[j], y[j], z[j]));
+      const __m128i g = clamp_to_u8_sse2(affine_sse2(m[1], x[j], y[j], z[j]));
+      const __m128i b = clamp_to_u8_sse2(affine_sse2(m[2], x[j], y[j], z[j]));
+      _mm_storeu_si128((__m128i *)(dst + (i + j * 4) * 4), pack_rgba32_sse2(r, g, b));
+    }
+  }
+
+  const Uint8 *const tail[3] = { src[0] + i, src[1] + i, src[2] + i };
+  MyKernels_planes_to_rgba32_scalar(tail, dst + i * 4, pixelCount - i, matrix);
+}
+
+//------------------------------------------------------------------------------
+// Mesmas operações de MyKernels_rgba32_to_hsv_scalar(); os três casos do
+// matiz são calculados e o correto é escolhido por máscaras.
+//------------------------------------------------------------------------------
+static inline void rgb_to_hsv_sse2(__m128 r, __m128 g, __m128 b, __m128i *h, __m128i *s, __m128i *v)
+{
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 max = _mm_max_ps(r, _mm_max_ps(g, b));
+  const __m128 min = _mm_min_ps(r, _mm_min_ps(g, b));
+  const __m128 delta = _mm_sub_ps(max, min);
+  const __m128 divisor = _mm_max_ps(delta, one);
+
+  const __m128 hueR = _mm_div_ps(_mm_sub_ps(g, b), divisor);
+  const __m128 hueG = _mm_add_ps(_mm_div_ps(_mm_sub_ps(b, r), divisor), _mm_set1_ps(2.0f));
+  const __m128 hueB = _mm_add_ps(_mm_div_ps(_mm_sub_ps(r, g), divisor), _mm_set1_ps(4.0f));
+  __m128 hue = select_sse2(_mm_cmpeq_ps(max, r), hueR, select_sse2(_mm_cmpeq_ps(max, g), hueG, hueB));
+  hue = _mm_mul_ps(hue, _mm_set1_ps(MY_KERNELS_HSV_HUE_SCALE));
+  hue = _mm_add_ps(hue, _mm_and_ps(_mm_cmplt_ps(hue, _mm_setzero_ps()), _mm_set1_ps(256.0f)));
+
+  const __m128 saturation = _mm_div_ps(_mm_mul_ps(_mm_set1_ps(255.0f), delta), _mm_max_ps(max, one));
+
+  *h = _mm_and_si128(_mm_cvttps_epi32(_mm_add_ps(hue, half)), _mm_set1_epi32(0xFF));
+  *s = _mm_cvttps_epi32(_mm_add_ps(saturation, half));
+  *v = _mm_cvttps_epi32(max);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void rgba32_to_hsv_sse2(const Uint8 *src, Uint8 *const dst[3], size_t pixelCount)
+{
+  size_t i = 0;
+  for (; i + 16 <= pixelCount; i += 16)
+  {
+    __m128i h[4], s[4], v[4];
+    for (int j = 0; j < 4; ++j)
+    {
+      __m128 r, g, b;
+      load_rgb_sse2(src + (i + j * 4) * 4, &r, &g, &b);
+      rgb_to_hsv_sse2(r, g, b, &h[j], &s[j], &v[j]);
+    }
+
+    store_plane_sse2(dst[0] + i, h);
+    store_plane_sse2(dst[1] + i, s);
+    store_plane_sse2(dst[2] + i, v);
+  }
+
+  Uint8 *const tail[3] = { dst[0] + i, dst[1] + i, dst[2] + i };
+  MyKernels_rgba32_to_hsv_scalar(src + i * 4, tail, pixelCount - i);
+}
+
+//------------------------------------------------------------------------------
+// Mesmas operações de MyKernels_hsv_to_rgba32_scalar(); o switch pelo setor
+// do matiz vira uma seleção por máscaras.
+//------------------------------------------------------------------------------
+static inline __m128i hsv_to_pixels_sse2(__m128 hue, __m128 saturation, __m128 value)
+{
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 h = _mm_mul_ps(hue, _mm_set1_ps(6.0f / 256.0f));
+  const __m128i sector = _mm_cvttps_epi32(h);
+  const __m128 f = _mm_sub_ps(h, _mm_cvtepi32_ps(sector));
+  const __m128 s = _mm_mul_ps(saturation, _mm_set1_ps(1.0f / 255.0f));
+  const __m128 v = value;
+  const __m128 p = _mm_mul_ps(v, _mm_sub_ps(one, s));
+  const __m128 q = _mm_mul_ps(v, _mm_sub_ps(one, _mm_mul_ps(s, f)));
+  const __m128 t = _mm_mul_ps(v, _mm_sub_ps(one, _mm_mul_ps(s, _mm_sub_ps(one, f))));
+
+  __m128 is[6];
+  for (int k = 0; k < 6; ++k)
+    is[k] = _mm_castsi128_ps(_mm_cmpeq_epi32(sector, _mm_set1_epi32(k)));
+
+  const __m128 r = select_sse2(is[1], q, select_sse2(_mm_or_ps(is[2], is[3]), p, select_sse2(is[4], t, v)));
+  const __m128 g = select_sse2(is[0], t, select_sse2(_mm_or_ps(is[1], is[2]), v, select_sse2(is[3], q, p)));
+  const __m128 b = select_sse2(_mm_or_ps(is[0], is[1]), p, select_sse2(is[2], t, select_sse2(is[5], q, v)));
+
+  return pack_rgba32_sse2(_mm_cvttps_epi32(_mm_add_ps(r, half)), _mm_cvttps_epi32(_mm_add_ps(g, half)),
+    _mm_cvttps_epi32(_mm_add_ps(b, half)));
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void hsv_to_rgba32_sse2(const Uint8 *const src[3], Uint8 *dst, size_t pixelCount)
+{
+  size_t i = 0;
+  for (; i + 16 <= pixelCount; i += 16)
+  {
+    __m128 h[4], s[4], v[4];
+    load_plane_sse2(src[0] + i, h);
+    load_plane_sse2(src[1] + i, s);
+    load_plane_sse2(src[2] + i, v);
+
+    for (int j = 0; j < 4; ++j)
+      _mm_storeu_si128((__m128i *)(dst + (i + j * 4) * 4), hsv_to_pixels_sse2(h[j], s[j], v[j]));
+  }
+
+  const Uint8 *const tail[3] = { src[0] + i, src[1] + i, src[2] + i };
+  MyKernels_hsv_to_rgba32_scalar(tail, dst + i * 4, pixelCount - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void resample_vertical_u8_sse2(const Uint8 *src, size_t pitch, const float *weights, int taps, float *dst, size_t count)
+{
+  const __m128i zero = _mm_setzero_si128();
+
+  // Para cada bloco de 16 colunas, as somas ficam em registradores enquanto
+  // as `taps` linhas são percorridas.
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+    __m128 sum2 = _mm_setzero_ps();
+    __m128 sum3 = _mm_setzero_ps();
+
+    const Uint8 *row = src + i;
+    for (int k = 0; k < taps; ++k, row += pitch)
+    {
+      const __m128 w = _mm_set1_ps(weights[k]);
+      const __m128i v = _mm_loadu_si128((const __m128i *)row);
+      const __m128i lo = _mm_unpacklo_epi8(v, zero);
+      const __m128i hi = _mm_unpackhi_epi8(v, zero);
+      sum0 = _mm_add_ps(sum0, _mm_mul_ps(w, _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero))));
+      sum1 = _mm_add_ps(sum1, _mm_mul_ps(w, _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero))));
+      sum2 = _mm_add_ps(sum2, _mm_mul_ps(w, _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero))));
+      sum3 = _mm_add_ps(sum3, _mm_mul_ps(w, _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero))));
+    }
+
+    _mm_storeu_ps(dst + i + 0, sum0);
+    _mm_storeu_ps(dst + i + 4, sum1);
+    _mm_storeu_ps(dst + i + 8, sum2);
+    _mm_storeu_ps(dst + i + 12, sum3);
+  }
+
+  MyKernels_resample_vertical_u8_scalar(src + i, pitch, weights, taps, dst + i, count - i);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void resample_horizontal_rgba32_sse2(const float *src, Uint8 *dst, int dstWidth, const int *first, const float *weights, int taps)
+{
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 max = _mm_set1_ps(255.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+
+  // Os 4 canais de um pixel ocupam um registrador; cada tap é uma
+  // multiplicação e uma soma.
+  for (int x = 0; x < dstWidth; ++x, weights += taps)
+  {
+    const float *s = src + (size_t)first[x] * 4;
+    __m128 sum = _mm_setzero_ps();
+    for (int k = 0; k < taps; ++k, s += 4)
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(s)));
+
+    const __m128i v = _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(sum, zero), max), half));
+    const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(v, v), _mm_setzero_si128());
+    const Uint32 pixel = (Uint32)_mm_cvtsi128_si32(packed);
+    SDL_memcpy(dst + (size_t)x * 4, &pixel, sizeof(pixel));
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void convolve_row_f32_sse2(const float *src, float *dst, int width, const float *weights, int taps)
+{
+  int x = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+    for (int k = 0; k < taps; ++k)
+    {
+      const __m128 w = _mm_set1_ps(weights[k]);
+      sum0 = _mm_add_ps(sum0, _mm_mul_ps(w, _mm_loadu_ps(src + x + k)));
+      sum1 = _mm_add_ps(sum1, _mm_mul_ps(w, _mm_loadu_ps(src + x + k + 4)));
+    }
+
+    _mm_storeu_ps(dst + x, sum0);
+    _mm_storeu_ps(dst + x + 4, sum1);
+  }
+
+  MyKernels_convolve_row_f32_scalar(src + x, dst + x, width - x, weights, taps);
+}
+
+//------------------------------------------------------------------------------
+// Gradiente e setor de 4 pixels (direções em 32 bits).
+//------------------------------------------------------------------------------
+static inline __m128i gradient_4_sse2(const float *a, const float *r, const float *b, float *magnitude, __m128 center,
+  __m128 scale)
+{
+  const __m128 aLeft = _mm_loadu_ps(a - 1);
+  const __m128 aRight = _mm_loadu_ps(a + 1);
+  const __m128 bLeft = _mm_loadu_ps(b - 1);
+  const __m128 bRight = _mm_loadu_ps(b + 1);
+
+  const __m128 dx = _mm_add_ps(_mm_add_ps(_mm_sub_ps(aRight, aLeft),
+    _mm_mul_ps(center, _mm_sub_ps(_mm_loadu_ps(r + 1), _mm_loadu_ps(r - 1)))), _mm_sub_ps(bRight, bLeft));
+  const __m128 dy = _mm_add_ps(_mm_add_ps(_mm_sub_ps(bLeft, aLeft),
+    _mm_mul_ps(center, _mm_sub_ps(_mm_loadu_ps(b), _mm_loadu_ps(a)))), _mm_sub_ps(bRight, aRight));
+  const __m128 gx = _mm_mul_ps(dx, scale);
+  const __m128 gy = _mm_mul_ps(dy, scale);
+  _mm_storeu_ps(magnitude, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(gx, gx), _mm_mul_ps(gy, gy))));
+
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+  const __m128 ax = _mm_and_ps(gx, absMask);
+  const __m128 ay = _mm_and_ps(gy, absMask);
+  const __m128i horizontal = _mm_castps_si128(_mm_cmple_ps(ay, _mm_mul_ps(_mm_set1_ps(MY_KERNELS_TAN_22_5), ax)));
+  const __m128i vertical = _mm_castps_si128(_mm_cmpge_ps(ay, _mm_mul_ps(_mm_set1_ps(MY_KERNELS_TAN_67_5), ax)));
+
+  // Diagonal: 1 ou 3, conforme os sinais de gx e gy (bit de sinal do xor).
+  const __m128i opposite = _mm_srai_epi32(_mm_castps_si128(_mm_xor_ps(gx, gy)), 31);
+  const __m128i diagonal = _mm_or_si128(_mm_set1_epi32(MY_GRADIENT_DIAGONAL),
+    _mm_and_si128(opposite, _mm_set1_epi32(MY_GRADIENT_ANTIDIAGONAL - MY_GRADIENT_DIAGONAL)));
+  const __m128i sector = _mm_or_si128(_mm_andnot_si128(vertical, diagonal),
+    _mm_and_si128(vertical, _mm_set1_epi32(MY_GRADIENT_VERTICAL)));
+  return _mm_andnot_si128(horizontal, sector);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void gradient_3x3_f32_sse2(const float *const rows[3], float *magnitude, Uint8 *direction, int width, float center)
+{
+  const __m128 c = _mm_set1_ps(center);
+  const __m128 scale = _mm_set1_ps(1.0f / (2.0f + center));
+
+  int x = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    const __m128i lo = gradient_4_sse2(rows[0] + x, rows[1] + x, rows[2] + x, magnitude + x, c, scale);
+    const __m128i hi = gradient_4_sse2(rows[0] + x + 4, rows[1] + x + 4, rows[2] + x + 4, magnitude + x + 4, c, scale);
+    const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128());
+    _mm_storel_epi64((__m128i *)(direction + x), packed);
+  }
+
+  const float *const tail[3] = { rows[0] + x, rows[1] + x, rows[2] + x };
+  MyKernels_gradient_3x3_f32_scalar(tail, magnitude + x, direction + x, width - x, center);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyKernels_install_sse2(MyKernels *kernels)
+{
+  kernels->invert_rgba32 = invert_rgba32_sse2;
+  kernels->add_u8_to_u32 = add_u8_to_u32_sse2;
+  kernels->sub_u8_from_u32 = sub_u8_from_u32_sse2;
+  kernels->box_sum_rgba_u32 = box_sum_rgba_u32_sse2;
+  kernels->average_to_rgba32 = average_to_rgba32_sse2;
+  kernels->fill_u32 = fill_u32_sse2;
+  kernels->rgba32_to_planes = rgba32_to_planes_sse2;
+  kernels->planes_to_rgba32 = planes_to_rgba32_sse2;
+  kernels->rgba32_to_hsv = rgba32_to_hsv_sse2;
+  kernels->hsv_to_rgba32 = hsv_to_rgba32_sse2;
+  kernels->resample_vertical_u8 = resample_vertical_u8_sse2;
+  kernels->resample_horizontal_rgba32 = resample_horizontal_rgba32_sse2;
+  kernels->convolve_row_f32 = convolve_row_f32_sse2;
+  kernels->gradient_3x3_f32 = gradient_3x3_f32_sse2;
+}
+
+#endif // MY_KERNELS_X86
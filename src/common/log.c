@@ -0,0 +1,305 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include <stdarg.h>
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+typedef struct MyLogMessage MyLogMessage;
+struct MyLogMessage
+{
+  int level;
+  char text[MY_LOG_MESSAGE_SIZE];
+};
+
+/**
+ * Buffer circular de uma thread (um produtor, um consumidor). `head` e `tail`
+ * só crescem (a diferença funciona mesmo quando dão a volta): a thread dona
+ * grava no slot `head` e então avança `head`; a thread de log lê os slots de
+ * `tail` até `head` e então avança `tail`.
+ */
+typedef struct MyLogRing MyLogRing;
+struct MyLogRing
+{
+  SDL_AtomicInt head;
+  SDL_AtomicInt tail;
+  SDL_AtomicInt dropped;
+  int index;
+  MyLogMessage messages[MY_LOG_RING_SIZE];
+};
+
+/**
+ * Um buffer é alocado na primeira mensagem da thread que o ocupa e nunca é
+ * liberado: quando a thread termina, ele fica livre para outra thread.
+ */
+typedef struct MyLogEntry MyLogEntry;
+struct MyLogEntry
+{
+  SDL_AtomicInt claimed;
+  void *ring;               // MyLogRing *, lido/gravado com SDL_*AtomicPointer().
+};
+
+typedef struct MyLogger MyLogger;
+struct MyLogger
+{
+  SDL_AtomicInt running;
+  SDL_Thread *thread;
+  SDL_Semaphore *wakeup;
+  SDL_Mutex *flushMutex;    // Só entre consumidores (thread de log e MyLog_flush()).
+  MyLogEntry entries[MY_LOG_MAX_THREADS];
+};
+
+//------------------------------------------------------------------------------
+// Globals (argh!)
+//------------------------------------------------------------------------------
+static MyLogger g_log;
+static SDL_TLSID g_ringTLS;
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static SDL_LogPriority get_priority(int level);
+static MyLogRing *get_thread_ring(void);
+static void release_thread_ring(void *ring);
+static void flush_ring(MyLogRing *ring);
+static int MyLog_thread_main(void *data);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+SDL_LogPriority get_priority(int level)
+{
+  // TRACE e DEBUG saem como INFO, que a SDL exibe por padrão (como SDL_Log()).
+  switch (level)
+  {
+  case MY_LOG_LEVEL_WARN:
+    return SDL_LOG_PRIORITY_WARN;
+
+  case MY_LOG_LEVEL_ERROR:
+    return SDL_LOG_PRIORITY_ERROR;
+
+  default:
+    return SDL_LOG_PRIORITY_INFO;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+MyLogRing *get_thread_ring(void)
+{
+  MyLogRing *ring = (MyLogRing *)SDL_GetTLS(&g_ringTLS);
+  if (ring)
+    return ring;
+
+  for (int i = 0; i < MY_LOG_MAX_THREADS; ++i)
+  {
+    MyLogEntry *entry = &g_log.entries[i];
+    if (!SDL_CompareAndSwapAtomicInt(&entry->claimed, 0, 1))
+      continue;
+
+    ring = (MyLogRing *)SDL_GetAtomicPointer(&entry->ring);
+    if (!ring)
+    {
+      ring = (MyLogRing *)SDL_calloc(1, sizeof(MyLogRing));
+      if (!ring)
+      {
+        SDL_SetAtomicInt(&entry->claimed, 0);
+        return NULL;
+      }
+
+      ring->index = i;
+      SDL_SetAtomicPointer(&entry->ring, ring);
+    }
+    else if (SDL_GetAtomicInt(&ring->head) != SDL_GetAtomicInt(&ring->tail))
+    {
+      // Ainda com mensagens da thread anterior: procura outro buffer.
+      SDL_SetAtomicInt(&entry->claimed, 0);
+      continue;
+    }
+
+    if (!SDL_SetTLS(&g_ringTLS, ring, release_thread_ring))
+    {
+      SDL_SetAtomicInt(&entry->claimed, 0);
+      return NULL;
+    }
+
+    return ring;
+  }
+
+  // Todos os buffers ocupados: esta mensagem vai para o log síncrono e a
+  // próxima tenta de novo.
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void release_thread_ring(void *ring)
+{
+  // As mensagens pendentes continuam no buffer até o próximo esvaziamento;
+  // outra thread só ocupa o buffer depois disso.
+  SDL_SetAtomicInt(&g_log.entries[((MyLogRing *)ring)->index].claimed, 0);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void flush_ring(MyLogRing *ring)
+{
+  const Uint32 head = (Uint32)SDL_GetAtomicInt(&ring->head);
+  Uint32 tail = (Uint32)SDL_GetAtomicInt(&ring->tail);
+
+  for (; tail != head; ++tail)
+  {
+    const MyLogMessage *message = &ring->messages[tail & (MY_LOG_RING_SIZE - 1)];
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, get_priority(message->level), "%s", message->text);
+
+    // Libera o slot para a thread dona.
+    SDL_SetAtomicInt(&ring->tail, (int)(tail + 1));
+  }
+
+  const int dropped = SDL_SetAtomicInt(&ring->dropped, 0);
+  if (dropped > 0)
+  {
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN,
+      "\t*** Aviso: %d mensagem(ns) de log descartada(s) (buffer da thread cheio).", dropped);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int MyLog_thread_main(void *data)
+{
+  (void)data;
+
+  while (SDL_GetAtomicInt(&g_log.running))
+  {
+    SDL_WaitSemaphoreTimeout(g_log.wakeup, MY_LOG_FLUSH_INTERVAL_MS);
+    MyLog_flush();
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyLog_initialize(void)
+{
+  if (g_log.thread)
+    return true;
+
+  g_log.wakeup = SDL_CreateSemaphore(0);
+  g_log.flushMutex = SDL_CreateMutex();
+  if (!g_log.wakeup || !g_log.flushMutex)
+  {
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR,
+      "\t*** Erro ao criar primitivas de sincronização do log: %s", SDL_GetError());
+    MyLog_shutdown();
+    return false;
+  }
+
+  SDL_SetAtomicInt(&g_log.running, 1);
+  g_log.thread = SDL_CreateThread(MyLog_thread_main, "MyLog", NULL);
+  if (!g_log.thread)
+  {
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR,
+      "\t*** Erro ao criar thread de log: %s", SDL_GetError());
+    MyLog_shutdown();
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyLog_shutdown(void)
+{
+  SDL_SetAtomicInt(&g_log.running, 0);
+
+  if (g_log.thread)
+  {
+    SDL_SignalSemaphore(g_log.wakeup);
+    SDL_WaitThread(g_log.thread, NULL);
+    g_log.thread = NULL;
+  }
+
+  MyLog_flush();
+
+  SDL_DestroyMutex(g_log.flushMutex);
+  SDL_DestroySemaphore(g_log.wakeup);
+  g_log.flushMutex = NULL;
+  g_log.wakeup = NULL;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyLog_flush(void)
+{
+  SDL_LockMutex(g_log.flushMutex);
+
+  for (int i = 0; i < MY_LOG_MAX_THREADS; ++i)
+  {
+    MyLogRing *ring = (MyLogRing *)SDL_GetAtomicPointer(&g_log.entries[i].ring);
+    if (ring)
+      flush_ring(ring);
+  }
+
+  SDL_UnlockMutex(g_log.flushMutex);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyLog_write(int level, const char *fmt, ...)
+{
+  va_list args;
+  va_start(args, fmt);
+
+  // Erros são gravados na hora (e inteiros, sem o limite do slot), depois das
+  // mensagens pendentes, para não se perderem se o programa terminar em
+  // seguida.
+  MyLogRing *ring = NULL;
+  if (level >= MY_LOG_LEVEL_ERROR)
+    MyLog_flush();
+  else if (SDL_GetAtomicInt(&g_log.running))
+    ring = get_thread_ring();
+
+  if (!ring)
+  {
+    SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, get_priority(level), fmt, args);
+    va_end(args);
+    return;
+  }
+
+  const Uint32 head = (Uint32)SDL_GetAtomicInt(&ring->head);
+  const Uint32 pending = head - (Uint32)SDL_GetAtomicInt(&ring->tail);
+  if (pending >= MY_LOG_RING_SIZE)
+  {
+    SDL_AddAtomicInt(&ring->dropped, 1);
+    va_end(args);
+    return;
+  }
+
+  MyLogMessage *message = &ring->messages[head & (MY_LOG_RING_SIZE - 1)];
+  message->level = level;
+  SDL_vsnprintf(message->text, sizeof(message->text), fmt, args);
+  va_end(args);
+
+  // Publica a mensagem: a thread de log só lê os slots antes de `head`.
+  SDL_SetAtomicInt(&ring->head, (int)(head + 1));
+
+  // Acorda a thread de log antes do intervalo se o buffer chegou à metade.
+  if (pending + 1 == MY_LOG_RING_SIZE / 2)
+    SDL_SignalSemaphore(g_log.wakeup);
+}
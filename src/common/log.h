@@ -0,0 +1,113 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Log com níveis eliminados em tempo de compilação e gravação assíncrona.
+//
+// Cada mensagem tem um nível, de MY_LOG_LEVEL_TRACE (entrada e saída de
+// funções, ">>>"/"<<<") a MY_LOG_LEVEL_ERROR. As macros de nível abaixo de
+// MY_LOG_LEVEL (definido na compilação; padrão MY_LOG_LEVEL_TRACE) não geram
+// código: os argumentos nem são avaliados, mas o formato continua verificado
+// pelo compilador. Os makefiles usam MY_LOG_LEVEL=MY_LOG_LEVEL_INFO em
+// BUILD=release (ou LOG_LEVEL=TRACE|DEBUG|INFO|WARN|ERROR|NONE).
+//
+// Entre MyLog_initialize() e MyLog_shutdown(), a mensagem é formatada pela
+// própria thread em um buffer circular dessa thread (um slot de tamanho fixo
+// por mensagem, sem locks: só a thread dona grava e só a thread de log lê).
+// A thread de log esvazia os buffers a cada MY_LOG_FLUSH_INTERVAL_MS (ou
+// antes, quando um buffer chega à metade) e chama SDL_LogMessage(), então a
+// E/S do console sai do caminho de quem gerou a mensagem. A ordem é mantida
+// entre as mensagens de uma mesma thread, mas não entre threads diferentes.
+// Com o buffer cheio, a mensagem é descartada e contada; o total de
+// descartes aparece no próximo esvaziamento. Mensagens de erro não passam
+// pelo buffer: os buffers são esvaziados e o erro é gravado na hora.
+//
+// Fora desse intervalo (ou se a thread não conseguir um buffer), a mensagem
+// vai direto para SDL_LogMessage(), como SDL_Log().
+//------------------------------------------------------------------------------
+#ifndef MY_LOG_H
+#define MY_LOG_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+
+#define MY_LOG_LEVEL_TRACE 0
+#define MY_LOG_LEVEL_DEBUG 1
+#define MY_LOG_LEVEL_INFO 2
+#define MY_LOG_LEVEL_WARN 3
+#define MY_LOG_LEVEL_ERROR 4
+#define MY_LOG_LEVEL_NONE 5
+
+#ifndef MY_LOG_LEVEL
+#define MY_LOG_LEVEL MY_LOG_LEVEL_TRACE
+#endif
+
+enum log_constants
+{
+  MY_LOG_MAX_THREADS = 64,         // Buffers disponíveis (um por thread).
+  MY_LOG_RING_SIZE = 256,          // Mensagens por buffer (potência de 2).
+  MY_LOG_MESSAGE_SIZE = 256,       // Bytes por mensagem (incluindo o '\0').
+  MY_LOG_FLUSH_INTERVAL_MS = 10,
+};
+
+// Mantém a verificação de formato e o uso das variáveis sem gerar código.
+#define MY_LOG_DISCARD(...) do { if (0) MyLog_write(MY_LOG_LEVEL_NONE, __VA_ARGS__); } while (0)
+
+#if MY_LOG_LEVEL <= MY_LOG_LEVEL_TRACE
+#define MY_LOG_TRACE(...) MyLog_write(MY_LOG_LEVEL_TRACE, __VA_ARGS__)
+#else
+#define MY_LOG_TRACE(...) MY_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if MY_LOG_LEVEL <= MY_LOG_LEVEL_DEBUG
+#define MY_LOG_DEBUG(...) MyLog_write(MY_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define MY_LOG_DEBUG(...) MY_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if MY_LOG_LEVEL <= MY_LOG_LEVEL_INFO
+#define MY_LOG_INFO(...) MyLog_write(MY_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define MY_LOG_INFO(...) MY_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if MY_LOG_LEVEL <= MY_LOG_LEVEL_WARN
+#define MY_LOG_WARN(...) MyLog_write(MY_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define MY_LOG_WARN(...) MY_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if MY_LOG_LEVEL <= MY_LOG_LEVEL_ERROR
+#define MY_LOG_ERROR(...) MyLog_write(MY_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define MY_LOG_ERROR(...) MY_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+/**
+ * Cria a thread de log. A partir daqui, as mensagens são gravadas de forma
+ * assíncrona. Em caso de erro, o log continua síncrono e a função retorna
+ * false.
+ */
+bool MyLog_initialize(void);
+
+/**
+ * Esvazia os buffers e encerra a thread de log; as mensagens seguintes são
+ * síncronas. Deve ser chamada depois que as demais threads pararam de gravar
+ * mensagens (ex. depois de destruir os pools de threads). Pode ser chamada
+ * mesmo sem MyLog_initialize().
+ */
+void MyLog_shutdown(void);
+
+/**
+ * Grava imediatamente, na thread que chama, as mensagens pendentes de todas
+ * as threads.
+ */
+void MyLog_flush(void);
+
+/**
+ * Grava uma mensagem no nível `level`. Use as macros MY_LOG_TRACE() ...
+ * MY_LOG_ERROR(), que eliminam os níveis desativados na compilação.
+ */
+void MyLog_write(int level, SDL_PRINTF_FORMAT_STRING const char *fmt, ...) SDL_PRINTF_VARARG_FUNC(2);
+
+#endif // MY_LOG_H
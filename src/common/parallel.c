@@ -0,0 +1,197 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "parallel.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static int MyThreadPool_worker_main(void *data);
+static void MyThreadPool_run_blocks(MyThreadPool *pool, int threadIndex);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyThreadPool_initialize(MyThreadPool *pool, int threadCount)
+{
+  MY_LOG_TRACE(">>> MyThreadPool_initialize(%d)", threadCount);
+
+  if (!pool)
+  {
+    MY_LOG_ERROR("\t*** Erro: Pool de threads inválido (pool == NULL).");
+    MY_LOG_TRACE("<<< MyThreadPool_initialize(%d)", threadCount);
+    return false;
+  }
+
+  SDL_zerop(pool);
+
+  if (threadCount <= 0)
+    threadCount = SDL_GetNumLogicalCPUCores();
+  pool->threadCount = SDL_clamp(threadCount, 1, MY_THREAD_POOL_MAX_THREADS);
+
+  pool->submitMutex = SDL_CreateMutex();
+  pool->mutex = SDL_CreateMutex();
+  pool->workAvailable = SDL_CreateCondition();
+  pool->workDone = SDL_CreateCondition();
+  if (!pool->submitMutex || !pool->mutex || !pool->workAvailable || !pool->workDone)
+  {
+    MY_LOG_ERROR("\t*** Erro ao criar primitivas de sincronização: %s", SDL_GetError());
+    MyThreadPool_destroy(pool);
+    MY_LOG_TRACE("<<< MyThreadPool_initialize(%d)", threadCount);
+    return false;
+  }
+
+  // O índice 0 é reservado para a thread que chama parallel_for().
+  for (int i = 1; i < pool->threadCount; ++i)
+  {
+    MyThreadPoolWorker *worker = &pool->workers[i];
+    worker->pool = pool;
+    worker->index = i;
+    worker->thread = SDL_CreateThread(MyThreadPool_worker_main, "MyThreadPool", worker);
+    if (!worker->thread)
+    {
+      MY_LOG_ERROR("\t*** Erro ao criar thread %d: %s", i, SDL_GetError());
+      pool->threadCount = i;
+      break;
+    }
+  }
+
+  MY_LOG_INFO("\tPool de threads com %d thread(s).", pool->threadCount);
+  MY_LOG_TRACE("<<< MyThreadPool_initialize(%d)", threadCount);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyThreadPool_destroy(MyThreadPool *pool)
+{
+  MY_LOG_TRACE(">>> MyThreadPool_destroy()");
+
+  if (!pool)
+  {
+    MY_LOG_ERROR("\t*** Erro: Pool de threads inválido (pool == NULL).");
+    MY_LOG_TRACE("<<< MyThreadPool_destroy()");
+    return;
+  }
+
+  SDL_LockMutex(pool->mutex);
+  pool->quit = true;
+  if (pool->workAvailable)
+    SDL_BroadcastCondition(pool->workAvailable);
+  SDL_UnlockMutex(pool->mutex);
+
+  for (int i = 1; i < pool->threadCount; ++i)
+  {
+    SDL_WaitThread(pool->workers[i].thread, NULL);
+  }
+
+  SDL_DestroyCondition(pool->workDone);
+  SDL_DestroyCondition(pool->workAvailable);
+  SDL_DestroyMutex(pool->mutex);
+  SDL_DestroyMutex(pool->submitMutex);
+  SDL_zerop(pool);
+
+  MY_LOG_TRACE("<<< MyThreadPool_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int MyThreadPool_get_thread_count(const MyThreadPool *pool)
+{
+  return (pool && pool->threadCount > 0) ? pool->threadCount : 1;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyThreadPool_run_blocks(MyThreadPool *pool, int threadIndex)
+{
+  for (;;)
+  {
+    const int begin = SDL_AddAtomicInt(&pool->nextBegin, pool->grain);
+    if (begin >= pool->count)
+      break;
+
+    const int end = SDL_min(begin + pool->grain, pool->count);
+    pool->function(pool->userdata, begin, end, threadIndex);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int MyThreadPool_worker_main(void *data)
+{
+  MyThreadPoolWorker *worker = (MyThreadPoolWorker *)data;
+  MyThreadPool *pool = worker->pool;
+  Uint64 seenGeneration = 0;
+
+  SDL_LockMutex(pool->mutex);
+  for (;;)
+  {
+    while (!pool->quit && pool->generation == seenGeneration)
+      SDL_WaitCondition(pool->workAvailable, pool->mutex);
+
+    if (pool->quit)
+      break;
+
+    seenGeneration = pool->generation;
+    SDL_UnlockMutex(pool->mutex);
+
+    MyThreadPool_run_blocks(pool, worker->index);
+
+    SDL_LockMutex(pool->mutex);
+    if (--pool->activeWorkers == 0)
+      SDL_SignalCondition(pool->workDone);
+  }
+  SDL_UnlockMutex(pool->mutex);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyThreadPool_parallel_for(MyThreadPool *pool, int count, int grain, MyParallelForFunction function, void *userdata)
+{
+  if (!function || count <= 0)
+    return;
+
+  if (grain <= 0)
+    grain = 1;
+
+  // Sem threads auxiliares (ou trabalho pequeno demais): executa direto.
+  if (!pool || pool->threadCount <= 1 || count <= grain)
+  {
+    function(userdata, 0, count, 0);
+    return;
+  }
+
+  SDL_LockMutex(pool->submitMutex);
+
+  SDL_LockMutex(pool->mutex);
+  pool->function = function;
+  pool->userdata = userdata;
+  pool->count = count;
+  pool->grain = grain;
+  SDL_SetAtomicInt(&pool->nextBegin, 0);
+  pool->activeWorkers = pool->threadCount - 1;
+  ++pool->generation;
+  SDL_BroadcastCondition(pool->workAvailable);
+  SDL_UnlockMutex(pool->mutex);
+
+  MyThreadPool_run_blocks(pool, 0);
+
+  SDL_LockMutex(pool->mutex);
+  while (pool->activeWorkers > 0)
+    SDL_WaitCondition(pool->workDone, pool->mutex);
+  SDL_UnlockMutex(pool->mutex);
+
+  SDL_UnlockMutex(pool->submitMutex);
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Pool de threads simples (SDL_Thread) para laços paralelos.
+//
+// MyThreadPool_parallel_for() divide o intervalo [0, count) em blocos de
+// `grain` itens (ex. linhas da imagem). As threads do pool e a própria thread
+// que chamou a função pegam blocos até que todos sejam processados; a função
+// só retorna depois que todo o intervalo foi processado.
+//
+// Cada chamada de `function` recebe `threadIndex`, no intervalo
+// [0, MyThreadPool_get_thread_count()), que identifica a thread que está
+// executando o bloco (0 é a thread que chamou parallel_for). Com isso, cada
+// thread pode acumular resultados parciais em uma área privada, sem
+// sincronização, e a thread principal faz a redução no final.
+//
+// Observação: `function` não pode chamar MyThreadPool_parallel_for() no mesmo
+// pool (chamadas aninhadas causariam deadlock).
+//------------------------------------------------------------------------------
+#ifndef MY_PARALLEL_H
+#define MY_PARALLEL_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+
+enum parallel_constants
+{
+  MY_THREAD_POOL_MAX_THREADS = 64,
+};
+
+typedef void (*MyParallelForFunction)(void *userdata, int begin, int end, int threadIndex);
+
+typedef struct MyThreadPool MyThreadPool;
+
+typedef struct MyThreadPoolWorker MyThreadPoolWorker;
+struct MyThreadPoolWorker
+{
+  MyThreadPool *pool;
+  SDL_Thread *thread;
+  int index;
+};
+
+struct MyThreadPool
+{
+  MyThreadPoolWorker workers[MY_THREAD_POOL_MAX_THREADS];
+  int threadCount;
+
+  SDL_Mutex *submitMutex;
+  SDL_Mutex *mutex;
+  SDL_Condition *workAvailable;
+  SDL_Condition *workDone;
+  Uint64 generation;
+  int activeWorkers;
+  bool quit;
+
+  MyParallelForFunction function;
+  void *userdata;
+  int count;
+  int grain;
+  SDL_AtomicInt nextBegin;
+};
+
+/**
+ * Cria `threadCount - 1` threads auxiliares (a thread que chama
+ * MyThreadPool_parallel_for() também trabalha). Se `threadCount <= 0`, usa o
+ * número de núcleos lógicos da CPU.
+ */
+bool MyThreadPool_initialize(MyThreadPool *pool, int threadCount);
+void MyThreadPool_destroy(MyThreadPool *pool);
+int MyThreadPool_get_thread_count(const MyThreadPool *pool);
+void MyThreadPool_parallel_for(MyThreadPool *pool, int count, int grain, MyParallelForFunction function, void *userdata);
+
+#endif // MY_PARALLEL_H
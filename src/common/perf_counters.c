@@ -0,0 +1,194 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+// syscall() não faz parte do C23 (-std=c23).
+#if defined(__linux__)
+#define _DEFAULT_SOURCE
+#endif
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "perf_counters.h"
+#include "log.h"
+
+#if defined(__linux__)
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+static const char *COUNTER_NAMES[MY_PERF_COUNTER_COUNT] = {
+  "cycles", "instructions", "L1D-read-misses", "LLC-misses", "branch-misses", "task-clock",
+};
+
+#if defined(__linux__)
+typedef struct MyPerfEvent MyPerfEvent;
+struct MyPerfEvent
+{
+  Uint32 type;
+  Uint64 config;
+};
+
+static const MyPerfEvent EVENTS[MY_PERF_COUNTER_COUNT] = {
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+  { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+};
+#endif
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static bool read_sample(int fd, MyPerfSample *sample);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool read_sample(int fd, MyPerfSample *sample)
+{
+#if defined(__linux__)
+  // Formato de leitura: valor, tempo ligado e tempo ativo (read_format).
+  Uint64 data[3];
+  if (fd < 0 || read(fd, data, sizeof(data)) != (ssize_t)sizeof(data))
+    return false;
+
+  sample->value = data[0];
+  sample->timeEnabled = data[1];
+  sample->timeRunning = data[2];
+  return true;
+#else
+  (void)fd;
+  (void)sample;
+  return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyPerfCounters_open(MyPerfCounters *counters)
+{
+  MY_LOG_TRACE(">>> MyPerfCounters_open()");
+
+  SDL_zerop(counters);
+  for (int i = 0; i < MY_PERF_COUNTER_COUNT; ++i)
+    counters->fds[i] = -1;
+
+#if defined(__linux__)
+  for (int i = 0; i < MY_PERF_COUNTER_COUNT; ++i)
+  {
+    struct perf_event_attr attr;
+    SDL_zero(attr);
+    attr.size = sizeof(attr);
+    attr.type = EVENTS[i].type;
+    attr.config = EVENTS[i].config;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    // pid = 0, cpu = -1: a thread atual (e as criadas depois), em qualquer CPU.
+    const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd < 0)
+    {
+      MY_LOG_DEBUG("\tContador %s indisponível: %s.", COUNTER_NAMES[i], strerror(errno));
+      continue;
+    }
+
+    counters->fds[i] = (int)fd;
+    ++counters->availableCount;
+  }
+#endif
+
+  if (counters->availableCount == 0)
+  {
+    MY_LOG_WARN("\t*** Aviso: Contadores de desempenho indisponíveis (perf_event_open).");
+    MY_LOG_TRACE("<<< MyPerfCounters_open()");
+    return false;
+  }
+
+  MY_LOG_INFO("\tContadores de desempenho: %d de %d disponíveis.", counters->availableCount, (int)MY_PERF_COUNTER_COUNT);
+  MY_LOG_TRACE("<<< MyPerfCounters_open()");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPerfCounters_close(MyPerfCounters *counters)
+{
+  if (!counters)
+    return;
+
+  for (int i = 0; i < MY_PERF_COUNTER_COUNT; ++i)
+  {
+#if defined(__linux__)
+    if (counters->fds[i] >= 0)
+      close(counters->fds[i]);
+#endif
+    counters->fds[i] = -1;
+  }
+
+  counters->availableCount = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPerfCounters_start(MyPerfCounters *counters)
+{
+  // Os contadores ficam sempre ligados; o trecho é a diferença entre duas
+  // leituras (zerar com ioctl não zeraria as cópias das outras threads).
+  for (int i = 0; i < MY_PERF_COUNTER_COUNT; ++i)
+  {
+    if (!read_sample(counters->fds[i], &counters->start[i]))
+      SDL_zero(counters->start[i]);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyPerfCounters_stop(MyPerfCounters *counters, MyPerfValues *values)
+{
+  for (int i = 0; i < MY_PERF_COUNTER_COUNT; ++i)
+  {
+    values->values[i] = 0.0;
+    values->available[i] = false;
+
+    MyPerfSample end;
+    if (!read_sample(counters->fds[i], &end))
+      continue;
+
+    const MyPerfSample *start = &counters->start[i];
+    const Uint64 enabled = end.timeEnabled - start->timeEnabled;
+    const Uint64 running = end.timeRunning - start->timeRunning;
+    if (running == 0)
+      continue;
+
+    // Extrapola pelo tempo em que o contador dividiu o hardware com outros.
+    values->values[i] = (double)(end.value - start->value) * ((double)enabled / (double)running);
+    values->available[i] = true;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const char *MyPerfCounters_get_name(MyPerfCounter counter)
+{
+  if (counter < 0 || counter >= MY_PERF_COUNTER_COUNT)
+    return "?";
+
+  return COUNTER_NAMES[counter];
+}
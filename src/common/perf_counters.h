@@ -0,0 +1,91 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Contadores de desempenho do hardware em um trecho de código (Linux,
+// perf_event_open): ciclos, instruções, faltas na cache L1 de dados e no
+// último nível de cache (LLC), desvios mal previstos e o tempo de CPU.
+//
+// Com ciclos e instruções, o IPC (instruções por ciclo) indica se um kernel
+// está limitado pela computação (IPC alto) ou pela memória (IPC baixo, muitas
+// faltas); as faltas na LLC vezes o tamanho da linha de cache estimam os bytes
+// trazidos da memória.
+//
+// Os contadores contam só o espaço de usuário do processo, na thread que os
+// abre e nas threads criadas depois (ex. as do MyThreadPool, se o pool for
+// criado depois de MyPerfCounters_open()). Cada contador é aberto
+// separadamente: os que o sistema não oferece (máquina virtual, CPU sem o
+// evento, /proc/sys/kernel/perf_event_paranoid restritivo ou outro sistema
+// operacional) ficam marcados como indisponíveis e os demais continuam
+// funcionando. Quando o kernel reveza os contadores (há mais eventos do que
+// contadores físicos), os valores são extrapolados pelo tempo em que cada um
+// ficou ativo.
+//------------------------------------------------------------------------------
+#ifndef MY_PERF_COUNTERS_H
+#define MY_PERF_COUNTERS_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+
+enum perf_counters_constants
+{
+  MY_PERF_CACHE_LINE_SIZE = 64,
+};
+
+typedef enum MyPerfCounter
+{
+  MY_PERF_CYCLES,
+  MY_PERF_INSTRUCTIONS,
+  MY_PERF_L1D_MISSES,       // Faltas de leitura na L1 de dados.
+  MY_PERF_LLC_MISSES,       // Faltas no último nível de cache.
+  MY_PERF_BRANCH_MISSES,
+  MY_PERF_TASK_CLOCK,       // Tempo de CPU (ns) somado entre as threads (contador de software).
+  MY_PERF_COUNTER_COUNT
+} MyPerfCounter;
+
+typedef struct MyPerfValues MyPerfValues;
+struct MyPerfValues
+{
+  double values[MY_PERF_COUNTER_COUNT];
+  bool available[MY_PERF_COUNTER_COUNT];
+};
+
+typedef struct MyPerfSample MyPerfSample;
+struct MyPerfSample
+{
+  Uint64 value;
+  Uint64 timeEnabled;
+  Uint64 timeRunning;
+};
+
+typedef struct MyPerfCounters MyPerfCounters;
+struct MyPerfCounters
+{
+  int fds[MY_PERF_COUNTER_COUNT];           // -1 = indisponível.
+  MyPerfSample start[MY_PERF_COUNTER_COUNT];
+  int availableCount;
+};
+
+/**
+ * Abre e liga os contadores. Retorna false se nenhum estiver disponível; nesse
+ * caso, MyPerfCounters_start() e MyPerfCounters_stop() continuam podendo ser
+ * chamadas (e marcam todos os valores como indisponíveis).
+ */
+bool MyPerfCounters_open(MyPerfCounters *counters);
+
+void MyPerfCounters_close(MyPerfCounters *counters);
+
+/**
+ * Marca o início do trecho medido.
+ */
+void MyPerfCounters_start(MyPerfCounters *counters);
+
+/**
+ * Valores contados desde MyPerfCounters_start(). Contadores indisponíveis (ou
+ * que não chegaram a ficar ativos no trecho) têm `available` false.
+ */
+void MyPerfCounters_stop(MyPerfCounters *counters, MyPerfValues *values);
+
+const char *MyPerfCounters_get_name(MyPerfCounter counter);
+
+#endif // MY_PERF_COUNTERS_H
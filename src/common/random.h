@@ -0,0 +1,28 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Gerador pseudoaleatório xorshift32 (Marsaglia): bem mais rápido que rand()
+// para gerar milhões de valores por quadro (primitivas, partículas,
+// instâncias). Não serve para criptografia.
+//------------------------------------------------------------------------------
+#ifndef MY_RANDOM_H
+#define MY_RANDOM_H
+
+#include <SDL3/SDL.h>
+
+/**
+ * Avança `state` e retorna o novo valor. `state` não pode ser zero (o
+ * gerador ficaria preso em zero).
+ */
+static inline Uint32 my_xorshift32(Uint32 *state)
+{
+  Uint32 x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+#endif // MY_RANDOM_H
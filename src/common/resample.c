@@ -0,0 +1,301 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "resample.h"
+#include "image_pool.h"
+#include "kernels.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+// Custom types, structs, constants, etc.
+//------------------------------------------------------------------------------
+enum
+{
+  RESAMPLE_PIXELS_PER_BLOCK = 1 << 15,
+};
+
+// Tabela de pesos de um eixo: o pixel de saída i usa os pixels de entrada
+// [first[i], first[i] + taps), com pesos weights[i * taps + k].
+typedef struct ResampleAxis ResampleAxis;
+struct ResampleAxis
+{
+  int taps;
+  int *first;
+  float *weights;
+};
+
+typedef struct ResampleJob ResampleJob;
+struct ResampleJob
+{
+  const Uint8 *srcPixels;
+  Uint8 *dstPixels;
+  int srcWidth;
+  int srcPitch;
+  int dstWidth;
+  int dstPitch;
+  bool nearest;
+  ResampleAxis horizontal;
+  ResampleAxis vertical;
+  const MyKernels *kernels;
+  SDL_AtomicInt failed;
+};
+
+static const char *FILTER_NAMES[MY_RESAMPLE_FILTER_COUNT] = { "nearest", "bilinear", "bicubic", "lanczos3" };
+
+// Raio de cada filtro, em pixels de entrada (sem redução).
+static const float FILTER_RADIUS[MY_RESAMPLE_FILTER_COUNT] = { 0.5f, 1.0f, 2.0f, 3.0f };
+
+//------------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------------
+static float filter_weight(MyResampleFilter filter, float x);
+static bool build_axis(MyArena *arena, MyResampleFilter filter, int srcSize, int dstSize, ResampleAxis *axis);
+static void resample_rows(void *userdata, int begin, int end, int threadIndex);
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+float filter_weight(MyResampleFilter filter, float x)
+{
+  x = SDL_fabsf(x);
+
+  switch (filter)
+  {
+  case MY_RESAMPLE_BILINEAR:
+    return x < 1.0f ? 1.0f - x : 0.0f;
+
+  case MY_RESAMPLE_BICUBIC:
+  {
+    // Keys (a = -0.5), o mesmo do Catmull-Rom.
+    const float a = -0.5f;
+    if (x < 1.0f)
+      return ((a + 2.0f) * x - (a + 3.0f)) * x * x + 1.0f;
+    if (x < 2.0f)
+      return ((a * x - 5.0f * a) * x + 8.0f * a) * x - 4.0f * a;
+    return 0.0f;
+  }
+
+  case MY_RESAMPLE_LANCZOS3:
+  {
+    if (x < 1.0e-6f)
+      return 1.0f;
+    if (x >= 3.0f)
+      return 0.0f;
+    const float px = SDL_PI_F * x;
+    return 3.0f * SDL_sinf(px) * SDL_sinf(px / 3.0f) / (px * px);
+  }
+
+  default:
+    return x <= 0.5f ? 1.0f : 0.0f;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Monta a tabela de pesos de um eixo na arena. O pixel de entrada j tem
+// centro em j + 0.5; o de saída i, em (i + 0.5) * scale.
+//------------------------------------------------------------------------------
+bool build_axis(MyArena *arena, MyResampleFilter filter, int srcSize, int dstSize, ResampleAxis *axis)
+{
+  const float scale = (float)srcSize / dstSize;
+
+  if (filter == MY_RESAMPLE_NEAREST)
+  {
+    axis->taps = 1;
+    axis->first = MyArena_push(arena, (size_t)dstSize * sizeof(int), MY_IMAGE_POOL_ALIGNMENT);
+    axis->weights = MyArena_push(arena, (size_t)dstSize * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+    if (!axis->first || !axis->weights)
+      return false;
+
+    for (int i = 0; i < dstSize; ++i)
+    {
+      axis->first[i] = SDL_min((int)((i + 0.5f) * scale), srcSize - 1);
+      axis->weights[i] = 1.0f;
+    }
+    return true;
+  }
+
+  // Na redução, o filtro é alargado pelo fator de escala.
+  const float stretch = SDL_max(scale, 1.0f);
+  const float support = FILTER_RADIUS[filter] * stretch;
+  const int windowSize = (int)SDL_ceilf(2.0f * support) + 1;
+  const int taps = SDL_min(windowSize, srcSize);
+
+  axis->taps = taps;
+  axis->first = MyArena_push(arena, (size_t)dstSize * sizeof(int), MY_IMAGE_POOL_ALIGNMENT);
+  axis->weights = MyArena_push(arena, (size_t)dstSize * taps * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+  if (!axis->first || !axis->weights)
+    return false;
+
+  for (int i = 0; i < dstSize; ++i)
+  {
+    const float center = (i + 0.5f) * scale;
+    const int left = (int)SDL_floorf(center - support);
+
+    // A janela é deslocada para dentro da imagem; os pixels de fora (que
+    // repetem a borda) somam seus pesos aos pesos dos pixels da borda.
+    const int first = SDL_clamp(left, 0, srcSize - taps);
+    float *weights = axis->weights + (size_t)i * taps;
+    SDL_memset(weights, 0, (size_t)taps * sizeof(float));
+
+    float sum = 0.0f;
+    for (int j = left; j < left + windowSize; ++j)
+    {
+      const float w = filter_weight(filter, (j + 0.5f - center) / stretch);
+      weights[SDL_clamp(j, 0, srcSize - 1) - first] += w;
+      sum += w;
+    }
+
+    if (sum != 0.0f)
+    {
+      for (int k = 0; k < taps; ++k)
+        weights[k] /= sum;
+    }
+
+    axis->first[i] = first;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void resample_rows(void *userdata, int begin, int end, int threadIndex)
+{
+  (void)threadIndex;
+  ResampleJob *job = (ResampleJob *)userdata;
+  const MyKernels *kernels = job->kernels;
+
+  // Vizinho mais próximo: só cópia de pixels, sem os passos em float.
+  if (job->nearest)
+  {
+    for (int y = begin; y < end; ++y)
+    {
+      const Uint32 *src = (const Uint32 *)(job->srcPixels + (size_t)job->vertical.first[y] * job->srcPitch);
+      Uint32 *dst = (Uint32 *)(job->dstPixels + (size_t)y * job->dstPitch);
+      for (int x = 0; x < job->dstWidth; ++x)
+        dst[x] = src[job->horizontal.first[x]];
+    }
+    return;
+  }
+
+  // Linha intermediária (resultado do passo vertical), na arena da thread.
+  const size_t rowValues = (size_t)job->srcWidth * 4;
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker arenaMarker = MyArena_get_marker(arena);
+  float *row = MyArena_push(arena, rowValues * sizeof(float), MY_IMAGE_POOL_ALIGNMENT);
+  if (!row)
+  {
+    SDL_SetAtomicInt(&job->failed, 1);
+    MyArena_reset_to_marker(arena, arenaMarker);
+    return;
+  }
+
+  const int tapsY = job->vertical.taps;
+  for (int y = begin; y < end; ++y)
+  {
+    const Uint8 *src = job->srcPixels + (size_t)job->vertical.first[y] * job->srcPitch;
+    kernels->resample_vertical_u8(src, (size_t)job->srcPitch, job->vertical.weights + (size_t)y * tapsY, tapsY, row, rowValues);
+    kernels->resample_horizontal_rgba32(row, job->dstPixels + (size_t)y * job->dstPitch, job->dstWidth,
+      job->horizontal.first, job->horizontal.weights, job->horizontal.taps);
+  }
+
+  MyArena_reset_to_marker(arena, arenaMarker);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyResample_surface(SDL_Surface *src, SDL_Surface *dst, MyResampleFilter filter, MyThreadPool *pool)
+{
+  if (!src || !dst || src == dst || src->w <= 0 || src->h <= 0 || dst->w <= 0 || dst->h <= 0)
+  {
+    MY_LOG_ERROR("\t*** Erro: Superfícies inválidas para o redimensionamento.");
+    return false;
+  }
+
+  if (src->format != SDL_PIXELFORMAT_RGBA32 || dst->format != SDL_PIXELFORMAT_RGBA32)
+  {
+    MY_LOG_ERROR("\t*** Erro: Redimensionamento espera superfícies RGBA32.");
+    return false;
+  }
+
+  if (filter < 0 || filter >= MY_RESAMPLE_FILTER_COUNT)
+  {
+    MY_LOG_ERROR("\t*** Erro: Filtro de redimensionamento inválido (%d).", (int)filter);
+    return false;
+  }
+
+  // As tabelas ficam na arena da thread que chamou a função (que também
+  // processa blocos de linhas, acima do marcador das tabelas).
+  MyArena *arena = MyArena_get_thread_local();
+  MyArenaMarker arenaMarker = MyArena_get_marker(arena);
+
+  ResampleJob job = {
+    .srcWidth = src->w,
+    .srcPitch = src->pitch,
+    .dstWidth = dst->w,
+    .dstPitch = dst->pitch,
+    .nearest = filter == MY_RESAMPLE_NEAREST,
+    .kernels = MyKernels_get(),
+    .failed = { 0 },
+  };
+
+  if (!build_axis(arena, filter, src->w, dst->w, &job.horizontal) || !build_axis(arena, filter, src->h, dst->h, &job.vertical))
+  {
+    MyArena_reset_to_marker(arena, arenaMarker);
+    MY_LOG_ERROR("\t*** Erro: Memória temporária do redimensionamento indisponível.");
+    return false;
+  }
+
+  SDL_LockSurface(src);
+  SDL_LockSurface(dst);
+
+  job.srcPixels = (const Uint8 *)src->pixels;
+  job.dstPixels = (Uint8 *)dst->pixels;
+
+  // Blocos com um número parecido de pixels de entrada lidos.
+  const int rowCost = SDL_max(1, src->w * job.vertical.taps);
+  MyThreadPool_parallel_for(pool, dst->h, SDL_max(1, RESAMPLE_PIXELS_PER_BLOCK * 8 / rowCost), resample_rows, &job);
+
+  SDL_UnlockSurface(dst);
+  SDL_UnlockSurface(src);
+  MyArena_reset_to_marker(arena, arenaMarker);
+
+  if (SDL_GetAtomicInt(&job.failed))
+  {
+    MY_LOG_ERROR("\t*** Erro: Memória temporária do redimensionamento indisponível.");
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyResample_fit_size(int width, int height, int maxWidth, int maxHeight, int *fitWidth, int *fitHeight)
+{
+  *fitWidth = width;
+  *fitHeight = height;
+  if (width <= maxWidth && height <= maxHeight)
+    return;
+
+  const double scale = SDL_min((double)maxWidth / width, (double)maxHeight / height);
+  *fitWidth = SDL_clamp((int)(width * scale + 0.5), 1, SDL_max(maxWidth, 1));
+  *fitHeight = SDL_clamp((int)(height * scale + 0.5), 1, SDL_max(maxHeight, 1));
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const char *MyResample_get_filter_name(MyResampleFilter filter)
+{
+  if (filter < 0 || filter >= MY_RESAMPLE_FILTER_COUNT)
+    return "?";
+
+  return FILTER_NAMES[filter];
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Redimensionamento (resampling) separável de superfícies RGBA32, com filtros
+// vizinho mais próximo, bilinear, bicúbico (Keys, a = -0.5) e Lanczos-3.
+//
+// Os pesos de cada eixo são calculados uma vez por chamada (uma tabela por
+// eixo, com o mesmo número de taps para todos os pixels de saída e as bordas
+// já incorporadas aos pesos dos pixels da borda). Na redução, o filtro é
+// alargado pelo fator de escala, então cada pixel de saída é a média
+// ponderada de todos os pixels que ele cobre (sem aliasing).
+//
+// Cada linha de saída é feita em dois passos, com os kernels SIMD de
+// kernels.h: o passo vertical combina as linhas de entrada em uma linha de
+// floats (na arena da thread) e o passo horizontal combina as colunas dessa
+// linha. As linhas de saída são divididas entre as threads de `pool` (pode
+// ser NULL). Os 4 canais (inclusive o alpha) são filtrados.
+//------------------------------------------------------------------------------
+#ifndef MY_RESAMPLE_H
+#define MY_RESAMPLE_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+#include "parallel.h"
+
+typedef enum MyResampleFilter
+{
+  MY_RESAMPLE_NEAREST,
+  MY_RESAMPLE_BILINEAR,
+  MY_RESAMPLE_BICUBIC,
+  MY_RESAMPLE_LANCZOS3,
+  MY_RESAMPLE_FILTER_COUNT
+} MyResampleFilter;
+
+/**
+ * Redimensiona `src` para o tamanho de `dst` (ambas RGBA32, superfícies
+ * diferentes).
+ */
+bool MyResample_surface(SDL_Surface *src, SDL_Surface *dst, MyResampleFilter filter, MyThreadPool *pool);
+
+/**
+ * Maior tamanho com a proporção de `width x height` que cabe em
+ * `maxWidth x maxHeight`. Imagens que já cabem mantêm o tamanho (nunca
+ * amplia).
+ */
+void MyResample_fit_size(int width, int height, int maxWidth, int maxHeight, int *fitWidth, int *fitHeight);
+
+const char *MyResample_get_filter_name(MyResampleFilter filter);
+
+#endif // MY_RESAMPLE_H
@@ -0,0 +1,78 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "window.h"
+#include "log.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyWindow_initialize(MyWindow *window, const char *title, int width, int height, SDL_WindowFlags window_flags)
+{
+  MY_LOG_TRACE("\tMyWindow_initialize(%s, %d, %d)", title, width, height);
+
+  if (!window)
+  {
+    MY_LOG_ERROR("\t\t*** Erro: Janela/renderizador inválidos (window == NULL).");
+    return false;
+  }
+
+  return SDL_CreateWindowAndRenderer(title, width, height, window_flags, &window->window, &window->renderer);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MyWindow_destroy(MyWindow *window)
+{
+  MY_LOG_TRACE(">>> MyWindow_destroy()");
+
+  if (!window)
+  {
+    MY_LOG_ERROR("\t*** Erro: Janela/renderizador inválidos (window == NULL).");
+    MY_LOG_TRACE("<<< MyWindow_destroy()");
+    return;
+  }
+
+  MY_LOG_DEBUG("\tDestruindo MyWindow->renderer...");
+  SDL_DestroyRenderer(window->renderer);
+  window->renderer = NULL;
+
+  MY_LOG_DEBUG("\tDestruindo MyWindow->window...");
+  SDL_DestroyWindow(window->window);
+  window->window = NULL;
+
+  MY_LOG_TRACE("<<< MyWindow_destroy()");
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool MyWindow_get_max_content_size(const MyWindow *window, int *width, int *height)
+{
+  *width = 0;
+  *height = 0;
+  if (!window || !window->window)
+    return false;
+
+  SDL_Rect bounds;
+  const SDL_DisplayID display = SDL_GetDisplayForWindow(window->window);
+  if (display == 0 || !SDL_GetDisplayUsableBounds(display, &bounds))
+  {
+    SDL_GetWindowSize(window->window, width, height);
+    return false;
+  }
+
+  int top = 0;
+  int left = 0;
+  int bottom = 0;
+  int right = 0;
+  SDL_GetWindowBordersSize(window->window, &top, &left, &bottom, &right);
+
+  *width = SDL_max(1, bounds.w - left - right);
+  *height = SDL_max(1, bounds.h - top - bottom);
+  return true;
+}
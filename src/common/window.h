@@ -0,0 +1,30 @@
+// Copyright (c) 2025 Andre Kishimoto - https://kishimoto.com.br/
+// SPDX-License-Identifier: Apache-2.0
+
+//------------------------------------------------------------------------------
+// Janela + renderizador usados pelos exemplos.
+//------------------------------------------------------------------------------
+#ifndef MY_WINDOW_H
+#define MY_WINDOW_H
+
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+
+typedef struct MyWindow MyWindow;
+struct MyWindow
+{
+  SDL_Window *window;
+  SDL_Renderer *renderer;
+};
+
+bool MyWindow_initialize(MyWindow *window, const char *title, int width, int height, SDL_WindowFlags window_flags);
+void MyWindow_destroy(MyWindow *window);
+
+/**
+ * Maior área de conteúdo que a janela pode ter sem sair da tela: a área útil
+ * do monitor da janela (sem barras de tarefas, etc.) menos as bordas. Se não
+ * for possível consultar o monitor, retorna false e o tamanho atual da janela.
+ */
+bool MyWindow_get_max_content_size(const MyWindow *window, int *width, int *height);
+
+#endif // MY_WINDOW_H